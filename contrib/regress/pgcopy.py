@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""Decode PostgreSQL binary COPY output and check it against CSV output.
+
+The stream written by ``cwevent -fp`` (or ``cwgame``/``cwdaily``) is
+checked against the CSV written by the same command with ``-a``.  Each
+field must be NULL where the CSV value is empty and the field is an
+integer or flag, or otherwise decode to the CSV value as text, as a
+smallint or integer, or as a boolean.
+"""
+
+from __future__ import annotations
+
+import argparse
+import csv
+import io
+import struct
+import sys
+from typing import Optional, Sequence
+
+
+SIGNATURE = b"PGCOPY\n\xff\r\n\x00"
+
+
+class FormatError(Exception):
+    """The stream is not well-formed binary COPY data."""
+
+
+def read_tuples(data: bytes) -> list[list[Optional[bytes]]]:
+    """Return the raw bytes of each field of each tuple; NULL is None."""
+    if not data.startswith(SIGNATURE):
+        raise FormatError("missing PGCOPY signature")
+    pos = len(SIGNATURE)
+    if len(data) < pos + 8:
+        raise FormatError("truncated header")
+    _flags, extension = struct.unpack_from(">iI", data, pos)
+    pos += 8 + extension
+
+    tuples = []
+    while True:
+        if len(data) < pos + 2:
+            raise FormatError("missing trailer")
+        (count,) = struct.unpack_from(">h", data, pos)
+        pos += 2
+        if count == -1:
+            break
+        fields: list[Optional[bytes]] = []
+        for _ in range(count):
+            if len(data) < pos + 4:
+                raise FormatError(f"truncated field in tuple {len(tuples) + 1}")
+            (length,) = struct.unpack_from(">i", data, pos)
+            pos += 4
+            if length == -1:
+                fields.append(None)
+                continue
+            if length < 0 or len(data) < pos + length:
+                raise FormatError(f"bad field length in tuple {len(tuples) + 1}")
+            fields.append(data[pos:pos + length])
+            pos += length
+        tuples.append(fields)
+    if pos != len(data):
+        raise FormatError("data after trailer")
+    return tuples
+
+
+def field_matches(raw: Optional[bytes], text: str) -> bool:
+    """Whether a binary field is consistent with its value in CSV output."""
+    if raw is None:
+        return text == ""
+    if raw.decode("utf-8", errors="replace") == text:
+        return True
+    if len(raw) == 2 and str(struct.unpack(">h", raw)[0]) == text:
+        return True
+    if len(raw) == 4 and str(struct.unpack(">i", raw)[0]) == text:
+        return True
+    return len(raw) == 1 and raw in (b"\x00", b"\x01") and "FT"[raw[0]] == text
+
+
+def compare(data: bytes, csv_text: str) -> list[str]:
+    """Return a description of each difference between the two outputs."""
+    rows = list(csv.reader(io.StringIO(csv_text)))
+    tuples = read_tuples(data)
+    problems = []
+    if len(rows) != len(tuples):
+        problems.append(f"{len(tuples)} tuples but {len(rows)} CSV rows")
+    for number, (fields, row) in enumerate(zip(tuples, rows), start=1):
+        if len(fields) != len(row):
+            problems.append(f"row {number}: {len(fields)} fields but {len(row)} CSV columns")
+            continue
+        for column, (raw, text) in enumerate(zip(fields, row)):
+            if not field_matches(raw, text):
+                problems.append(f"row {number}, column {column}: {raw!r} != {text!r}")
+    return problems
+
+
+def main(argv: Sequence[str] | None = None) -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("stream", help="binary COPY output (-fp)")
+    parser.add_argument("csv", help="CSV output of the same command (-a)")
+    args = parser.parse_args(argv)
+
+    with open(args.stream, "rb") as f:
+        data = f.read()
+    with open(args.csv, encoding="utf-8", newline="") as f:
+        csv_text = f.read()
+    try:
+        problems = compare(data, csv_text)
+    except FormatError as exc:
+        print(f"{args.stream}: {exc}", file=sys.stderr)
+        return 2
+    for problem in problems:
+        print(problem)
+    return 1 if problems else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
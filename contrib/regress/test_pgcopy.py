@@ -0,0 +1,62 @@
+import struct
+import unittest
+
+import pgcopy
+
+
+def stream(*tuples):
+    data = pgcopy.SIGNATURE + struct.pack(">iI", 0, 0)
+    for fields in tuples:
+        data += struct.pack(">h", len(fields))
+        for raw in fields:
+            if raw is None:
+                data += struct.pack(">i", -1)
+            else:
+                data += struct.pack(">i", len(raw)) + raw
+    return data + struct.pack(">h", -1)
+
+
+class ReadTuplesTest(unittest.TestCase):
+    def test_reads_fields_and_nulls(self):
+        data = stream([b"ANA202304010", struct.pack(">h", 7), None], [b"", b"\x01", None])
+        self.assertEqual(
+            pgcopy.read_tuples(data),
+            [[b"ANA202304010", b"\x00\x07", None], [b"", b"\x01", None]],
+        )
+
+    def test_reads_empty_stream(self):
+        self.assertEqual(pgcopy.read_tuples(stream()), [])
+
+    def test_rejects_missing_signature(self):
+        with self.assertRaisesRegex(pgcopy.FormatError, "signature"):
+            pgcopy.read_tuples(b"PGCOPY\n")
+
+    def test_rejects_missing_trailer(self):
+        with self.assertRaisesRegex(pgcopy.FormatError, "trailer"):
+            pgcopy.read_tuples(stream([b"x"])[:-2])
+
+    def test_rejects_truncated_field(self):
+        with self.assertRaisesRegex(pgcopy.FormatError, "tuple 1"):
+            pgcopy.read_tuples(stream([b"abcdef"])[:-5])
+
+
+class CompareTest(unittest.TestCase):
+    def test_accepts_typed_values(self):
+        data = stream(
+            [b"ANA202304010", struct.pack(">h", -3), struct.pack(">i", 44000), b"\x00", None]
+        )
+        self.assertEqual(pgcopy.compare(data, '"ANA202304010",-3,44000,"F",\n'), [])
+
+    def test_reports_differences(self):
+        data = stream([b"ANA", struct.pack(">h", 2)])
+        self.assertEqual(
+            pgcopy.compare(data, '"ANA",3\n'),
+            ["row 1, column 1: b'\\x00\\x02' != '3'"],
+        )
+
+    def test_reports_row_count(self):
+        self.assertEqual(pgcopy.compare(stream(), '"ANA"\n'), ["0 tuples but 1 CSV rows"])
+
+
+if __name__ == "__main__":
+    unittest.main()
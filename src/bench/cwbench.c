@@ -0,0 +1,1064 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/bench/cwbench.c
+ * Chadwick benchmarks of the library and the tools, run by 'make bench'
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Each benchmark is run a number of times over the same event files,
+ * and the fastest run is reported, as one CSV record giving the rates
+ * of games, events and megabytes processed per second.  Rates which do
+ * not apply to a benchmark are left empty.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <utime.h>
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
+#include "cwlib/chadwick.h"
+#include "cwtools/buffer.h"
+
+/* The year of the event files (-y) */
+char year[5] = "";
+
+/* The directory of the tools to run end-to-end (-T) */
+char tool_dir[1024] = "";
+
+/* The directory of the team and roster files, passed to the tools (-D) */
+char data_dir[1024] = "";
+
+/* The number of times each benchmark is run (-r) */
+int reps = 3;
+
+/* The number of threads for the threaded benchmark (-j); not run if 0 */
+int threads = 0;
+
+/* If 'quiet', write no status messages to stderr (-Q) */
+int quiet = 0;
+
+/* The event files, and the games read from them */
+static char **files;
+static int num_files;
+static CWScorebook **scorebooks;
+static long num_games, num_events, num_bytes;
+
+/*
+ * The rates reported for a benchmark: games, events, and megabytes,
+ * either of input or written by the benchmark itself
+ */
+#define CWBENCH_GAMES 1
+#define CWBENCH_EVENTS 2
+#define CWBENCH_INPUT 4
+#define CWBENCH_OUTPUT 8
+
+/* The number of bytes a benchmark writes, if it reports its own output rate */
+static long bytes_written;
+
+/* The number of times a benchmark processes the games: the threaded
+ * benchmark processes them once on each thread */
+static int copies = 1;
+
+void cwbench_print_welcome_message(char *argv0)
+{
+  fprintf(stderr, "\nChadwick benchmarks, version " VERSION);
+  fprintf(stderr, "\n  Type '%s -h' for help.\n", argv0);
+  fprintf(
+    stderr,
+    "Copyright (c) 2002-2026\nDr T L Turocy, Chadwick Baseball Bureau (ted.turocy@gmail.com)\n");
+  fprintf(stderr, "This is free software, "
+                  "subject to the terms of the GNU GPL license.\n\n");
+}
+
+void cwbench_print_help(void)
+{
+  fprintf(stderr, "\n\ncwbench times the library's readers, parser, game iterator,\n");
+  fprintf(stderr, "boxscores and output buffers over a set of event files, and the\n");
+  fprintf(stderr, "tools run end-to-end over the same files.\n");
+  fprintf(stderr, "Usage: cwbench [options] -y year eventfile...\n");
+  fprintf(stderr, "options:\n");
+  fprintf(stderr, "  -h        print this help\n");
+  fprintf(stderr, "  -y year   year of the event files\n");
+  fprintf(stderr, "  -r reps   run each benchmark reps times, reporting the fastest\n");
+  fprintf(stderr, "              (default is 3)\n");
+  fprintf(stderr, "  -T dir    run the tools in dir end-to-end; by default they are not run\n");
+  fprintf(stderr, "  -D dir    read team and roster files from dir, when running the tools\n");
+  fprintf(stderr, "  -j n      also iterate over and compile boxscores of the games on n\n");
+  fprintf(stderr, "              threads at once, checking each gets the same results,\n");
+  fprintf(stderr, "              and total them on n threads, merging the totals\n");
+  fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n\n");
+
+  exit(0);
+}
+
+int cwbench_parse_command_line(int argc, char *argv[])
+{
+  int i;
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-h")) {
+      cwbench_print_welcome_message(argv[0]);
+      cwbench_print_help();
+    }
+    else if (!strcmp(argv[i], "-y")) {
+      if (++i < argc) {
+        strncpy(year, argv[i], sizeof(year) - 1);
+        year[sizeof(year) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-r")) {
+      if (++i < argc && (reps = cw_atoi(argv[i], NULL)) <= 0) {
+        fprintf(stderr, "*** Invalid number of runs '%s'.\n", argv[i]);
+        exit(1);
+      }
+    }
+    else if (!strcmp(argv[i], "-T")) {
+      if (++i < argc) {
+        strncpy(tool_dir, argv[i], sizeof(tool_dir) - 1);
+        tool_dir[sizeof(tool_dir) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-D")) {
+      if (++i < argc) {
+        strncpy(data_dir, argv[i], sizeof(data_dir) - 1);
+        data_dir[sizeof(data_dir) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-j")) {
+      if (++i < argc && (threads = cw_atoi(argv[i], NULL)) < 0) {
+        fprintf(stderr, "*** Invalid number of threads '%s'.\n", argv[i]);
+        exit(1);
+      }
+    }
+    else if (!strcmp(argv[i], "-Q")) {
+      quiet = 1;
+    }
+    else if (argv[i][0] == '-') {
+      fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
+      exit(1);
+    }
+    else {
+      break;
+    }
+  }
+
+  return i;
+}
+
+static double cwbench_now(void)
+{
+  struct timeval tv;
+
+  gettimeofday(&tv, NULL);
+  return (double) tv.tv_sec + (double) tv.tv_usec / 1.0e6;
+}
+
+/*
+ * Read the event files once, keeping their games for the benchmarks
+ * which start from games in memory
+ */
+static void cwbench_load(void)
+{
+  int i;
+
+  scorebooks = (CWScorebook **) malloc(sizeof(CWScorebook *) * (size_t) num_files);
+  if (scorebooks == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for scorebooks\n");
+    exit(1);
+  }
+  for (i = 0; i < num_files; i++) {
+    FILE *file = fopen(files[i], "r");
+    CWGame *game;
+    CWEvent *event;
+
+    scorebooks[i] = cw_scorebook_create();
+    if (file == NULL || cw_scorebook_read(scorebooks[i], file) < 0) {
+      fprintf(stderr, "Error: could not read file '%s'\n", files[i]);
+      exit(1);
+    }
+    fseek(file, 0, SEEK_END);
+    num_bytes += ftell(file);
+    fclose(file);
+
+    for (game = scorebooks[i]->first_game; game != NULL; game = game->next) {
+      num_games++;
+      for (event = game->first_event; event != NULL; event = event->next) {
+        num_events++;
+      }
+    }
+  }
+}
+
+static void cwbench_game_read(void)
+{
+  int i;
+
+  for (i = 0; i < num_files; i++) {
+    FILE *file = fopen(files[i], "r");
+    CWGame *game;
+
+    cw_file_find_first_game(file);
+    while (!feof(file) && (game = cw_game_read(file)) != NULL) {
+      cw_game_cleanup(game);
+      cw_free(CW_ALLOC_GAME, game);
+    }
+    fclose(file);
+  }
+}
+
+static void cwbench_parse_event(void)
+{
+  CWEventData *data = (CWEventData *) malloc(sizeof(CWEventData));
+  CWGame *game;
+  CWEvent *event;
+  int i;
+
+  for (i = 0; i < num_files; i++) {
+    for (game = scorebooks[i]->first_game; game != NULL; game = game->next) {
+      for (event = game->first_event; event != NULL; event = event->next) {
+        cw_parse_event(event->event_text, data);
+      }
+    }
+  }
+  free(data);
+}
+
+static void cwbench_gameiter_next(void)
+{
+  CWGame *game;
+  int i;
+
+  for (i = 0; i < num_files; i++) {
+    for (game = scorebooks[i]->first_game; game != NULL; game = game->next) {
+      CWGameIterator *gameiter = cw_gameiter_create(game);
+
+      while (gameiter->event != NULL) {
+        cw_gameiter_next(gameiter);
+      }
+      cw_gameiter_cleanup(gameiter);
+      cw_free(CW_ALLOC_GAMEITER, gameiter);
+    }
+  }
+}
+
+static void cwbench_box_create(void)
+{
+  CWGame *game;
+  int i;
+
+  for (i = 0; i < num_files; i++) {
+    for (game = scorebooks[i]->first_game; game != NULL; game = game->next) {
+      CWBoxscore *boxscore = cw_box_create(game);
+
+      cw_box_cleanup(boxscore);
+      cw_free(CW_ALLOC_BOX, boxscore);
+    }
+  }
+}
+
+/* Whether the two lists of notable events are the same */
+static int cwbench_box_events_equal(CWBoxEvent *event, CWBoxEvent *other)
+{
+  int i;
+
+  for (; event != NULL && other != NULL; event = event->next, other = other->next) {
+    if (event->num_players != other->num_players || event->inning != other->inning ||
+        event->half_inning != other->half_inning || event->runners != other->runners ||
+        event->pickoff != other->pickoff || event->outs != other->outs ||
+        strcmp(event->location, other->location)) {
+      return 0;
+    }
+    for (i = 0; i < event->num_players; i++) {
+      if (strcmp(event->players[i], other->players[i])) {
+        return 0;
+      }
+    }
+  }
+  return (event == NULL && other == NULL);
+}
+
+/* Whether the two boxscores have the same entries and totals */
+static int cwbench_box_equal(CWBoxscore *boxscore, CWBoxscore *other)
+{
+  CWBoxPlayer *player, *match;
+  CWBoxPitcher *pitcher, *pmatch;
+  int i, t, pos;
+
+  for (t = 0; t <= 1; t++) {
+    for (i = 0; i <= 9; i++) {
+      for (player = boxscore->slots[i][t], match = other->slots[i][t];
+           player != NULL && match != NULL; player = player->prev, match = match->prev) {
+        if (strcmp(player->player_id, match->player_id) ||
+            memcmp(player->batting, match->batting, sizeof(CWBoxBatting)) ||
+            player->ph_inn != match->ph_inn || player->pr_inn != match->pr_inn ||
+            player->start_position != match->start_position ||
+            player->num_positions != match->num_positions ||
+            memcmp(player->positions, match->positions,
+                   sizeof(int) * (size_t) player->num_positions)) {
+          return 0;
+        }
+        for (pos = 0; pos <= 9; pos++) {
+          if ((player->fielding[pos] == NULL) != (match->fielding[pos] == NULL) ||
+              (player->fielding[pos] != NULL &&
+               memcmp(player->fielding[pos], match->fielding[pos], sizeof(CWBoxFielding)))) {
+            return 0;
+          }
+        }
+      }
+      if (player != NULL || match != NULL) {
+        return 0;
+      }
+    }
+    for (pitcher = boxscore->pitchers[t], pmatch = other->pitchers[t];
+         pitcher != NULL && pmatch != NULL; pitcher = pitcher->prev, pmatch = pmatch->prev) {
+      if (strcmp(pitcher->player_id, pmatch->player_id) ||
+          memcmp(pitcher->pitching, pmatch->pitching, sizeof(CWBoxPitching))) {
+        return 0;
+      }
+    }
+    if (pitcher != NULL || pmatch != NULL) {
+      return 0;
+    }
+    if (boxscore->score[t] != other->score[t] || boxscore->hits[t] != other->hits[t] ||
+        boxscore->errors[t] != other->errors[t] || boxscore->dp[t] != other->dp[t] ||
+        boxscore->tp[t] != other->tp[t] || boxscore->lob[t] != other->lob[t] ||
+        boxscore->er[t] != other->er[t] || boxscore->risp_ab[t] != other->risp_ab[t] ||
+        boxscore->risp_h[t] != other->risp_h[t]) {
+      return 0;
+    }
+  }
+  return (!memcmp(boxscore->linescore, other->linescore, sizeof(boxscore->linescore)) &&
+          boxscore->outs_at_end == other->outs_at_end &&
+          boxscore->walk_off == other->walk_off &&
+          cwbench_box_events_equal(boxscore->b2_list, other->b2_list) &&
+          cwbench_box_events_equal(boxscore->b3_list, other->b3_list) &&
+          cwbench_box_events_equal(boxscore->hr_list, other->hr_list) &&
+          cwbench_box_events_equal(boxscore->sb_list, other->sb_list) &&
+          cwbench_box_events_equal(boxscore->cs_list, other->cs_list) &&
+          cwbench_box_events_equal(boxscore->po_list, other->po_list) &&
+          cwbench_box_events_equal(boxscore->sh_list, other->sh_list) &&
+          cwbench_box_events_equal(boxscore->sf_list, other->sf_list) &&
+          cwbench_box_events_equal(boxscore->hp_list, other->hp_list) &&
+          cwbench_box_events_equal(boxscore->ibb_list, other->ibb_list) &&
+          cwbench_box_events_equal(boxscore->wp_list, other->wp_list) &&
+          cwbench_box_events_equal(boxscore->bk_list, other->bk_list) &&
+          cwbench_box_events_equal(boxscore->err_list, other->err_list) &&
+          cwbench_box_events_equal(boxscore->pb_list, other->pb_list) &&
+          cwbench_box_events_equal(boxscore->dp_list, other->dp_list) &&
+          cwbench_box_events_equal(boxscore->tp_list, other->tp_list));
+}
+
+/*
+ * Follow each game as it would be scored live: attach a boxscore to the
+ * game before its first event, append the events one at a time, each
+ * before its substitutions, and advance the boxscore after each.  The
+ * result must be the boxscore created from the whole game.
+ */
+static void cwbench_box_advance(void)
+{
+  CWGame *game;
+  CWEvent *event, *next_event;
+  CWAppearance *first_sub, *last_sub;
+  int i;
+
+  for (i = 0; i < num_files; i++) {
+    for (game = scorebooks[i]->first_game; game != NULL; game = game->next) {
+      CWBoxscore *boxscore, *reference;
+
+      event = game->first_event;
+      game->first_event = game->last_event = NULL;
+      boxscore = cw_box_attach(game);
+      for (; event != NULL; event = next_event) {
+        next_event = event->next;
+        first_sub = event->first_sub;
+        last_sub = event->last_sub;
+        event->next = NULL;
+        event->first_sub = event->last_sub = NULL;
+        if (game->last_event != NULL) {
+          game->last_event->next = event;
+        }
+        else {
+          game->first_event = event;
+        }
+        game->last_event = event;
+        cw_box_advance(boxscore);
+        if (first_sub != NULL) {
+          event->first_sub = first_sub;
+          event->last_sub = last_sub;
+          cw_box_advance(boxscore);
+        }
+      }
+
+      reference = cw_box_create(game);
+      if (!cwbench_box_equal(boxscore, reference)) {
+        fprintf(stderr, "Error: boxscore advanced through %s differs from one created\n",
+                game->game_id);
+        exit(1);
+      }
+      cw_box_cleanup(reference);
+      cw_free(CW_ALLOC_BOX, reference);
+      cw_box_cleanup(boxscore);
+      cw_free(CW_ALLOC_BOX, boxscore);
+    }
+  }
+}
+
+/*
+ * The sort benchmark appends all the games, shuffled, to one scorebook
+ * and sorts it, and fails unless the games come out by date and number,
+ * those with the same date and number in their shuffled order.  The
+ * games are then returned to the scorebooks they were read into.
+ */
+typedef struct cwbench_sort_key_struct {
+  CWGame *game;
+  long index;
+} CWBenchSortKey;
+
+static CWGame **sort_games, **sort_shuffled;
+static CWBenchSortKey *sort_expected;
+static long *sort_file_games;
+
+/* The date or number of 'game', or "" if it has none, as the sort takes it */
+static char *cwbench_sort_key(CWGame *game, char *label)
+{
+  char *value = cw_game_info_lookup(game, label);
+
+  return (value != NULL) ? value : "";
+}
+
+/* Orders games by date, then number, then shuffled position */
+static int cwbench_sort_compare(const void *a, const void *b)
+{
+  const CWBenchSortKey *key1 = (const CWBenchSortKey *) a, *key2 = (const CWBenchSortKey *) b;
+  int result = strcmp(cwbench_sort_key(key1->game, "date"), cwbench_sort_key(key2->game, "date"));
+
+  if (result == 0) {
+    result =
+      strcmp(cwbench_sort_key(key1->game, "number"), cwbench_sort_key(key2->game, "number"));
+  }
+  if (result == 0) {
+    result = (key1->index > key2->index) - (key1->index < key2->index);
+  }
+  return result;
+}
+
+/* Shuffle the games, the same way each time, and find the order to expect */
+static void cwbench_sort_setup(void)
+{
+  unsigned long seed = 1;
+  CWGame *game, *swap;
+  long count = 0, i, j;
+
+  sort_games = (CWGame **) malloc((size_t) (num_games + 1) * sizeof(CWGame *));
+  sort_shuffled = (CWGame **) malloc((size_t) (num_games + 1) * sizeof(CWGame *));
+  sort_expected = (CWBenchSortKey *) malloc((size_t) (num_games + 1) * sizeof(CWBenchSortKey));
+  sort_file_games = (long *) calloc((size_t) num_files, sizeof(long));
+  if (sort_games == NULL || sort_shuffled == NULL || sort_expected == NULL ||
+      sort_file_games == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for sorting\n");
+    exit(1);
+  }
+  for (i = 0; i < num_files; i++) {
+    for (game = scorebooks[i]->first_game; game != NULL; game = game->next) {
+      sort_games[count] = sort_shuffled[count] = game;
+      count++;
+      sort_file_games[i]++;
+    }
+  }
+  for (i = count - 1; i > 0; i--) {
+    seed = seed * 1103515245UL + 12345UL;
+    j = (long) ((seed >> 16) % (unsigned long) (i + 1));
+    swap = sort_shuffled[i];
+    sort_shuffled[i] = sort_shuffled[j];
+    sort_shuffled[j] = swap;
+  }
+  for (i = 0; i < count; i++) {
+    sort_expected[i].game = sort_shuffled[i];
+    sort_expected[i].index = i;
+  }
+  qsort(sort_expected, (size_t) count, sizeof(CWBenchSortKey), cwbench_sort_compare);
+}
+
+/* Link the games back into the scorebooks they were read into, in their order */
+static void cwbench_sort_restore(void)
+{
+  long count = 0, k;
+  int i;
+
+  for (i = 0; i < num_files; i++) {
+    scorebooks[i]->first_game = scorebooks[i]->last_game = NULL;
+    for (k = 0; k < sort_file_games[i]; k++) {
+      cw_scorebook_append_game(scorebooks[i], sort_games[count++]);
+    }
+  }
+}
+
+static void cwbench_sort(void)
+{
+  CWScorebook *scorebook = cw_scorebook_create();
+  CWGame *game;
+  long i;
+
+  for (i = 0; i < num_games; i++) {
+    cw_scorebook_append_game(scorebook, sort_shuffled[i]);
+  }
+  if (!cw_scorebook_sort(scorebook)) {
+    fprintf(stderr, "Error: could not allocate memory for sorting\n");
+    exit(1);
+  }
+  for (game = scorebook->first_game, i = 0; game != NULL; game = game->next, i++) {
+    if (i >= num_games || game != sort_expected[i].game ||
+        game->prev != ((i > 0) ? sort_expected[i - 1].game : NULL)) {
+      fprintf(stderr, "Error: cw_scorebook_sort did not keep games of the same date and "
+                      "number in order\n");
+      exit(1);
+    }
+  }
+  if (i != num_games || scorebook->last_game != sort_expected[num_games - 1].game) {
+    fprintf(stderr, "Error: cw_scorebook_sort lost games\n");
+    exit(1);
+  }
+
+  /* The games are not the scorebook's to free */
+  scorebook->first_game = scorebook->last_game = NULL;
+  cw_scorebook_cleanup(scorebook);
+  cw_free(CW_ALLOC_BOOK, scorebook);
+  cwbench_sort_restore();
+}
+
+/* Write a record for each event, with fields of each kind cwevent writes */
+static void cwbench_buffer_emit(void)
+{
+  char line[4096];
+  CWBuffer buffer;
+  CWGame *game;
+  CWEvent *event;
+  int i;
+
+  for (i = 0; i < num_files; i++) {
+    for (game = scorebooks[i]->first_game; game != NULL; game = game->next) {
+      for (event = game->first_event; event != NULL; event = event->next) {
+        cw_buffer_init(&buffer, line, sizeof(line), 1, ',');
+        cw_buffer_emit_string(&buffer, game->game_id, 12);
+        cw_buffer_emit(&buffer, "%d", event->inning);
+        cw_buffer_emit(&buffer, "%d", event->batting_team);
+        cw_buffer_emit_string(&buffer, event->count, 2);
+        cw_buffer_emit_string(&buffer, event->pitches, 20);
+        cw_buffer_emit_string(&buffer, event->batter, 8);
+        cw_buffer_emit_char(&buffer, event->batter_hand);
+        cw_buffer_emit_string(&buffer, event->event_text, 20);
+        bytes_written += (long) (buffer.current - line) + 1;
+      }
+    }
+  }
+}
+
+/* The event files, as arguments to a tool */
+static char *cwbench_file_arguments(void)
+{
+  size_t size = 1;
+  char *arguments;
+  int i;
+
+  for (i = 0; i < num_files; i++) {
+    size += strlen(files[i]) + 3;
+  }
+  arguments = (char *) malloc(size);
+  if (arguments == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for arguments\n");
+    exit(1);
+  }
+  strcpy(arguments, "");
+  for (i = 0; i < num_files; i++) {
+    strcat(arguments, " \"");
+    strcat(arguments, files[i]);
+    strcat(arguments, "\"");
+  }
+  return arguments;
+}
+
+/* The tool being run end-to-end, with its options */
+static const char *tool_name, *tool_options;
+
+static void cwbench_run_tool(void)
+{
+  char *arguments = cwbench_file_arguments();
+  size_t size = strlen(tool_dir) + strlen(data_dir) + strlen(arguments) + 256;
+  char *command = (char *) malloc(size);
+
+  if (command == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for command\n");
+    exit(1);
+  }
+  snprintf(command, size, "\"%s/%s\" -Q -y %s %s%s%s%s%s > /dev/null", tool_dir, tool_name, year,
+           tool_options, (strcmp(data_dir, "")) ? " -D \"" : "", data_dir,
+           (strcmp(data_dir, "")) ? "\"" : "", arguments);
+  if (system(command) != 0) {
+    fprintf(stderr, "Warning: '%s' did not complete successfully\n", tool_name);
+  }
+  free(command);
+  free(arguments);
+}
+
+/*
+ * Runs the benchmark 'f' the number of times given, and reports its
+ * fastest run.  'items' gives which rates apply (CWBENCH_*).
+ */
+static void cwbench_run(const char *name, void (*f)(void), int items)
+{
+  double best = -1.0, start, seconds;
+  long bytes = 0;
+  int i;
+
+  if (!quiet) {
+    fprintf(stderr, "[Running %s.]\n", name);
+  }
+  for (i = 0; i < reps; i++) {
+    bytes_written = 0;
+    start = cwbench_now();
+    (*f)();
+    seconds = cwbench_now() - start;
+    if (best < 0.0 || seconds < best) {
+      best = seconds;
+      bytes = (items & CWBENCH_OUTPUT) ? bytes_written : num_bytes;
+    }
+  }
+  if (best <= 0.0) {
+    best = 1.0e-6;
+  }
+
+  printf("\"%s\",%d,%.6f,", name, reps, best);
+  if (items & CWBENCH_GAMES) {
+    printf("%.1f", (double) num_games * copies / best);
+  }
+  printf(",");
+  if (items & CWBENCH_EVENTS) {
+    printf("%.1f", (double) num_events * copies / best);
+  }
+  printf(",");
+  if (items & (CWBENCH_INPUT | CWBENCH_OUTPUT)) {
+    printf("%.3f", (double) bytes / 1.0e6 / best);
+  }
+  printf("\n");
+  fflush(stdout);
+}
+
+/* Runs the sort benchmark, returning the games to their scorebooks after */
+static void cwbench_run_sort(void)
+{
+  if (num_games < 1) {
+    return;
+  }
+  cwbench_sort_setup();
+  cwbench_run("cw_scorebook_sort", cwbench_sort, CWBENCH_GAMES);
+  free(sort_games);
+  free(sort_shuffled);
+  free(sort_expected);
+  free(sort_file_games);
+}
+
+#if HAVE_PTHREAD_H
+/*
+ * The threaded benchmark iterates over and compiles a boxscore of every
+ * game on each thread at once, all sharing the same games, and checks
+ * that each thread gets the same results as a single thread does.
+ */
+typedef struct cwbench_thread_struct {
+  pthread_t thread;
+  unsigned long checksum;
+  long long events_parsed;
+} CWBenchThread;
+
+static unsigned long reference_checksum;
+static long long reference_events_parsed;
+
+static unsigned long cwbench_mix(unsigned long checksum, long value)
+{
+  return checksum * 31UL + (unsigned long) value;
+}
+
+/* A checksum of the states and boxscores of all the games */
+static unsigned long cwbench_checksum(void)
+{
+  unsigned long checksum = 0;
+  CWGame *game;
+  int i, t;
+
+  for (i = 0; i < num_files; i++) {
+    for (game = scorebooks[i]->first_game; game != NULL; game = game->next) {
+      CWGameIterator *gameiter = cw_gameiter_create(game);
+      CWBoxscore *boxscore;
+
+      while (gameiter->event != NULL) {
+        checksum = cwbench_mix(checksum, gameiter->event_data->event_type);
+        checksum = cwbench_mix(checksum, gameiter->state->outs);
+        checksum = cwbench_mix(checksum, gameiter->parse_ok);
+        cw_gameiter_next(gameiter);
+      }
+      cw_gameiter_cleanup(gameiter);
+      cw_free(CW_ALLOC_GAMEITER, gameiter);
+
+      boxscore = cw_box_create(game);
+      for (t = 0; t <= 1; t++) {
+        checksum = cwbench_mix(checksum, boxscore->score[t]);
+        checksum = cwbench_mix(checksum, boxscore->hits[t]);
+        checksum = cwbench_mix(checksum, boxscore->errors[t]);
+        checksum = cwbench_mix(checksum, boxscore->lob[t]);
+        checksum = cwbench_mix(checksum, boxscore->er[t]);
+      }
+      cw_box_cleanup(boxscore);
+      cw_free(CW_ALLOC_BOX, boxscore);
+    }
+  }
+  return checksum;
+}
+
+static void *cwbench_thread_main(void *arg)
+{
+  CWBenchThread *thread = (CWBenchThread *) arg;
+  long long events_parsed = cw_stats.events_parsed;
+
+  thread->checksum = cwbench_checksum();
+  /* The library's counters are kept for each thread */
+  thread->events_parsed = cw_stats.events_parsed - events_parsed;
+  return NULL;
+}
+
+static void cwbench_threads(void)
+{
+  CWBenchThread *pool = (CWBenchThread *) calloc((size_t) threads, sizeof(CWBenchThread));
+  int i;
+
+  if (pool == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for threads\n");
+    exit(1);
+  }
+  for (i = 0; i < threads; i++) {
+    if (pthread_create(&pool[i].thread, NULL, cwbench_thread_main, &pool[i]) != 0) {
+      fprintf(stderr, "Error: could not start thread\n");
+      exit(1);
+    }
+  }
+  for (i = 0; i < threads; i++) {
+    pthread_join(pool[i].thread, NULL);
+  }
+  for (i = 0; i < threads; i++) {
+    if (pool[i].checksum != reference_checksum ||
+        pool[i].events_parsed != reference_events_parsed) {
+      fprintf(stderr, "Error: thread %d of %d got different results from a single thread\n",
+              i + 1, threads);
+      exit(1);
+    }
+  }
+  free(pool);
+}
+
+/*
+ * The threaded season benchmark totals the games on several threads at
+ * once, each taking its share of the games into partial totals of its
+ * own, which are merged at the end, and checks that the merged totals
+ * are those of a single pass over the games.
+ */
+typedef struct cwbench_season_thread_struct {
+  pthread_t thread;
+  int index;
+  CWSeason *season;
+} CWBenchSeasonThread;
+
+static CWSeason *reference_season;
+
+/* Add every 'stride'th game, starting from game 'index', to 'season' */
+static void cwbench_season_add(CWSeason *season, int index, int stride)
+{
+  CWGame *game;
+  long count = 0;
+  int i;
+
+  for (i = 0; i < num_files; i++) {
+    for (game = scorebooks[i]->first_game; game != NULL; game = game->next) {
+      if (count++ % stride == index) {
+        CWBoxscore *boxscore = cw_box_create(game);
+
+        cw_season_add_boxscore(season, game, boxscore);
+        cw_box_cleanup(boxscore);
+        cw_free(CW_ALLOC_BOX, boxscore);
+      }
+    }
+  }
+}
+
+/* Whether the two seasons have the same totals for the same players */
+static int cwbench_season_equal(CWSeason *season, CWSeason *other)
+{
+  CWSeasonPlayer *player, *match;
+
+  if (season->num_players != other->num_players || season->num_games != other->num_games) {
+    return 0;
+  }
+  for (player = season->first_player; player != NULL; player = player->next) {
+    match = cw_season_find_player(other, player->player_id, player->team_id, player->year);
+    if (match == NULL || memcmp(&player->batting, &match->batting, sizeof(CWBoxBatting)) ||
+        memcmp(&player->pitching, &match->pitching, sizeof(CWBoxPitching)) ||
+        memcmp(player->fielding, match->fielding, sizeof(player->fielding)) ||
+        memcmp(player->gs, match->gs, sizeof(player->gs)) || player->g_dh != match->g_dh ||
+        player->g_ph != match->g_ph || player->g_pr != match->g_pr || player->g_p != match->g_p) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static void *cwbench_season_thread_main(void *arg)
+{
+  CWBenchSeasonThread *thread = (CWBenchSeasonThread *) arg;
+
+  cwbench_season_add(thread->season, thread->index, threads);
+  return NULL;
+}
+
+static void cwbench_season_threads(void)
+{
+  CWBenchSeasonThread *pool =
+    (CWBenchSeasonThread *) calloc((size_t) threads, sizeof(CWBenchSeasonThread));
+  CWSeason *season = cw_season_create();
+  int i;
+
+  if (pool == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for threads\n");
+    exit(1);
+  }
+  for (i = 0; i < threads; i++) {
+    pool[i].index = i;
+    pool[i].season = cw_season_create();
+    if (pthread_create(&pool[i].thread, NULL, cwbench_season_thread_main, &pool[i]) != 0) {
+      fprintf(stderr, "Error: could not start thread\n");
+      exit(1);
+    }
+  }
+  for (i = 0; i < threads; i++) {
+    pthread_join(pool[i].thread, NULL);
+    cw_season_merge(season, pool[i].season);
+    cw_season_cleanup(pool[i].season);
+    cw_free(CW_ALLOC_SEASON, pool[i].season);
+  }
+  if (!cwbench_season_equal(reference_season, season)) {
+    fprintf(stderr, "Error: season totals merged from %d threads differ from a single pass\n",
+            threads);
+    exit(1);
+  }
+  cw_season_cleanup(season);
+  cw_free(CW_ALLOC_SEASON, season);
+  free(pool);
+}
+
+/* Runs the threaded benchmark, after finding the results to expect */
+static void cwbench_run_threads(void)
+{
+  long long events_parsed = cw_stats.events_parsed;
+  char name[64];
+
+  reference_checksum = cwbench_checksum();
+  reference_events_parsed = cw_stats.events_parsed - events_parsed;
+  snprintf(name, sizeof(name), "cw_box_create x%d threads", threads);
+  copies = threads;
+  cwbench_run(name, cwbench_threads, CWBENCH_GAMES | CWBENCH_EVENTS);
+  copies = 1;
+
+  reference_season = cw_season_create();
+  cwbench_season_add(reference_season, 0, 1);
+  snprintf(name, sizeof(name), "cw_season_merge x%d threads", threads);
+  cwbench_run(name, cwbench_season_threads, CWBENCH_GAMES | CWBENCH_EVENTS);
+  cw_season_cleanup(reference_season);
+  cw_free(CW_ALLOC_SEASON, reference_season);
+}
+#endif /* HAVE_PTHREAD_H */
+
+/* The contents of the file 'filename', of which there are '*size' bytes; result is malloc'd */
+static char *cwbench_read_file(const char *filename, long *size)
+{
+  FILE *file = fopen(filename, "rb");
+  char *contents;
+
+  if (file == NULL || fseek(file, 0, SEEK_END) != 0 || (*size = ftell(file)) < 0) {
+    fprintf(stderr, "Error: could not read '%s'\n", filename);
+    exit(1);
+  }
+  contents = (char *) malloc((size_t) *size + 1);
+  rewind(file);
+  if (contents == NULL || fread(contents, 1, (size_t) *size, file) != (size_t) *size) {
+    fprintf(stderr, "Error: could not read '%s'\n", filename);
+    exit(1);
+  }
+  contents[*size] = '\0';
+  fclose(file);
+  return contents;
+}
+
+static void cwbench_write_file(const char *filename, const char *contents, long size)
+{
+  FILE *file = fopen(filename, "wb");
+
+  if (file == NULL || fwrite(contents, 1, (size_t) size, file) != (size_t) size ||
+      fclose(file) != 0) {
+    fprintf(stderr, "Error: could not write '%s'\n", filename);
+    exit(1);
+  }
+}
+
+/* Run cwgame over 'filename', incrementally if 'incremental', writing to 'output' */
+static void cwbench_run_cwgame(const char *filename, int incremental, const char *output)
+{
+  char command[4096];
+
+  snprintf(command, sizeof(command), "\"%s/cwgame\" -Q -y %s -f 0 %s%s%s%s \"%s\" > \"%s\"",
+           tool_dir, year, (strcmp(data_dir, "")) ? "-D \"" : "", data_dir,
+           (strcmp(data_dir, "")) ? "\"" : "",
+           (incremental) ? " --incremental=bench-incremental" : "", filename, output);
+  if (system(command) != 0) {
+    fprintf(stderr, "Error: 'cwgame' did not complete successfully\n");
+    exit(1);
+  }
+}
+
+/*
+ * Check that an incremental run processes again a file changed without
+ * changing its size or time, as by an edit within the resolution of the
+ * file system's times.  The file is dated ahead of the manifest, so that
+ * only the racy entry check can find the change.
+ */
+static void cwbench_check_incremental(void)
+{
+  const char *copy = "bench-incremental/events";
+  struct utimbuf times;
+  char *contents, *id, *first, *fresh, *kept;
+  long size, first_size, fresh_size, kept_size;
+
+  if (!quiet) {
+    fprintf(stderr, "[Checking incremental runs.]\n");
+  }
+  contents = cwbench_read_file(files[0], &size);
+  id = (!strncmp(contents, "id,", 3)) ? contents : strstr(contents, "\nid,");
+  if (id != NULL && id[0] == '\n') {
+    id++;
+  }
+  if (id == NULL || strlen(id) < 15) {
+    fprintf(stderr, "Error: no game in '%s' to check incremental runs\n", files[0]);
+    exit(1);
+  }
+  if (system("rm -rf bench-incremental && mkdir bench-incremental") != 0) {
+    fprintf(stderr, "Error: could not make directory 'bench-incremental'\n");
+    exit(1);
+  }
+  cwbench_write_file(copy, contents, size);
+  times.actime = times.modtime = time(NULL) + 60;
+  utime(copy, &times);
+  cwbench_run_cwgame(copy, 1, "bench-incremental/first.csv");
+
+  /* Change the first game's ID in its last digit, keeping the size and time */
+  id[14] = (id[14] == '9') ? '8' : '9';
+  cwbench_write_file(copy, contents, size);
+  utime(copy, &times);
+  cwbench_run_cwgame(copy, 1, "bench-incremental/kept.csv");
+  cwbench_run_cwgame(copy, 0, "bench-incremental/fresh.csv");
+
+  first = cwbench_read_file("bench-incremental/first.csv", &first_size);
+  kept = cwbench_read_file("bench-incremental/kept.csv", &kept_size);
+  fresh = cwbench_read_file("bench-incremental/fresh.csv", &fresh_size);
+  if (first_size == fresh_size && !memcmp(first, fresh, (size_t) first_size)) {
+    fprintf(stderr, "Error: changing a game ID in '%s' did not change the output\n", files[0]);
+    exit(1);
+  }
+  if (kept_size != fresh_size || memcmp(kept, fresh, (size_t) kept_size) != 0) {
+    fprintf(stderr, "Error: an incremental run kept the output of a file since changed\n");
+    exit(1);
+  }
+  free(first);
+  free(kept);
+  free(fresh);
+  free(contents);
+}
+
+static void cwbench_run_tool_named(const char *name, const char *options)
+{
+  tool_name = name;
+  tool_options = options;
+  cwbench_run(name, cwbench_run_tool, CWBENCH_GAMES | CWBENCH_EVENTS | CWBENCH_INPUT);
+}
+
+int main(int argc, char *argv[])
+{
+  int i;
+
+  i = cwbench_parse_command_line(argc, argv);
+  if (!quiet) {
+    cwbench_print_welcome_message(argv[0]);
+  }
+  if (!strcmp(year, "") || i >= argc) {
+    fprintf(stderr, "Error: give the year (-y) and the event files\n");
+    exit(1);
+  }
+  files = argv + i;
+  num_files = argc - i;
+
+  cwbench_load();
+  if (!quiet) {
+    fprintf(stderr, "[Read %ld games, %ld events, %ld bytes.]\n", num_games, num_events,
+            num_bytes);
+  }
+
+  printf("\"BENCH\",\"REPS\",\"SECONDS\",\"GAMES_PER_S\",\"EVENTS_PER_S\",\"MB_PER_S\"\n");
+  cwbench_run("cw_game_read", cwbench_game_read,
+              CWBENCH_GAMES | CWBENCH_EVENTS | CWBENCH_INPUT);
+  cwbench_run("cw_parse_event", cwbench_parse_event, CWBENCH_EVENTS);
+  cwbench_run("cw_gameiter_next", cwbench_gameiter_next, CWBENCH_GAMES | CWBENCH_EVENTS);
+  cwbench_run("cw_box_create", cwbench_box_create, CWBENCH_GAMES | CWBENCH_EVENTS);
+  cwbench_run("cw_box_advance", cwbench_box_advance, CWBENCH_GAMES | CWBENCH_EVENTS);
+  cwbench_run("cw_buffer_emit", cwbench_buffer_emit, CWBENCH_EVENTS | CWBENCH_OUTPUT);
+  cwbench_run_sort();
+  if (threads > 0) {
+#if HAVE_PTHREAD_H
+    cwbench_run_threads();
+#else
+    fprintf(stderr, "Warning: threads are not supported; not running the threaded benchmark\n");
+#endif /* HAVE_PTHREAD_H */
+  }
+
+  if (strcmp(tool_dir, "")) {
+    cwbench_run_tool_named("cwevent", "");
+    cwbench_run_tool_named("cwgame", "");
+    cwbench_run_tool_named("cwbox", "");
+    cwbench_run_tool_named("cwdaily", "");
+    cwbench_check_incremental();
+  }
+
+  for (i = 0; i < num_files; i++) {
+    cw_scorebook_cleanup(scorebooks[i]);
+    cw_free(CW_ALLOC_BOOK, scorebooks[i]);
+  }
+  free(scorebooks);
+
+  return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/alloc.c
+ * Implementation of the allocator used by the library
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "alloc.h"
+
+static void *cw_alloc_std_malloc(size_t size, void *context)
+{
+  return malloc(size);
+}
+
+static void *cw_alloc_std_realloc(void *ptr, size_t size, void *context)
+{
+  return realloc(ptr, size);
+}
+
+static void cw_alloc_std_free(void *ptr, void *context)
+{
+  free(ptr);
+}
+
+static CWAllocator cw_allocator = {cw_alloc_std_malloc, cw_alloc_std_realloc, cw_alloc_std_free,
+                                   NULL};
+
+static int cw_alloc_counting = 0;
+
+char *cw_alloc_subsystem_names[CW_ALLOC_NUM_SUBSYSTEMS] = {
+  "book",   "box",  "catalog", "expect", "file",   "game",   "gameiter", "index",
+  "league", "lint", "parse",   "remap",  "roster", "season", "split",    "other"
+};
+
+CW_THREAD_LOCAL CWAllocCounts cw_alloc_counts[CW_ALLOC_NUM_SUBSYSTEMS];
+
+/*
+ * Each block of memory is preceded by a header recording the subsystem
+ * which allocated it, so that reallocating or freeing the block is
+ * counted against that subsystem, whichever one does it.  The other
+ * members only keep the memory following the header aligned.
+ */
+typedef union cw_alloc_header_union {
+  int subsystem;
+  long double align_ld;
+  long long align_ll;
+  void *align_ptr;
+} CWAllocHeader;
+
+/* The subsystem to count a call against; unknown ones count as other */
+static int cw_alloc_subsystem(int subsystem)
+{
+  return (subsystem < 0 || subsystem >= CW_ALLOC_NUM_SUBSYSTEMS) ? CW_ALLOC_OTHER : subsystem;
+}
+
+/*
+ * Public interface
+ */
+void cw_alloc_set_allocator(CWAllocator *allocator)
+{
+  if (allocator != NULL) {
+    cw_allocator = *allocator;
+  }
+  else {
+    cw_allocator.malloc = cw_alloc_std_malloc;
+    cw_allocator.realloc = cw_alloc_std_realloc;
+    cw_allocator.free = cw_alloc_std_free;
+    cw_allocator.context = NULL;
+  }
+}
+
+void cw_alloc_set_counting(int enable)
+{
+  cw_alloc_counting = enable;
+}
+
+void *cw_malloc(int subsystem, size_t size)
+{
+  CWAllocHeader *header;
+
+  subsystem = cw_alloc_subsystem(subsystem);
+  if (cw_alloc_counting) {
+    cw_alloc_counts[subsystem].malloc_calls++;
+    cw_alloc_counts[subsystem].bytes += (long long) size;
+  }
+  if (size > (size_t) -1 - sizeof(CWAllocHeader)) {
+    return NULL;
+  }
+  header = (CWAllocHeader *) (*cw_allocator.malloc)(sizeof(CWAllocHeader) + size,
+                                                    cw_allocator.context);
+  if (header == NULL) {
+    return NULL;
+  }
+  header->subsystem = subsystem;
+  return header + 1;
+}
+
+void *cw_calloc(int subsystem, size_t count, size_t size)
+{
+  void *ptr;
+
+  if (size > 0 && count > (size_t) -1 / size) {
+    return NULL;
+  }
+  ptr = cw_malloc(subsystem, count * size);
+  if (ptr != NULL) {
+    memset(ptr, 0, count * size);
+  }
+  return ptr;
+}
+
+void *cw_realloc(int subsystem, void *ptr, size_t size)
+{
+  CWAllocHeader *header;
+
+  if (ptr == NULL) {
+    return cw_malloc(subsystem, size);
+  }
+  header = (CWAllocHeader *) ptr - 1;
+  if (cw_alloc_counting) {
+    cw_alloc_counts[header->subsystem].realloc_calls++;
+    cw_alloc_counts[header->subsystem].bytes += (long long) size;
+  }
+  if (size > (size_t) -1 - sizeof(CWAllocHeader)) {
+    return NULL;
+  }
+  header = (CWAllocHeader *) (*cw_allocator.realloc)(header, sizeof(CWAllocHeader) + size,
+                                                     cw_allocator.context);
+  return (header != NULL) ? header + 1 : NULL;
+}
+
+void cw_free(int subsystem, void *ptr)
+{
+  CWAllocHeader *header;
+
+  if (ptr == NULL) {
+    return;
+  }
+  header = (CWAllocHeader *) ptr - 1;
+  if (cw_alloc_counting) {
+    cw_alloc_counts[header->subsystem].free_calls++;
+  }
+  (*cw_allocator.free)(header, cw_allocator.context);
+}
+
+char *cw_strdup(int subsystem, const char *text)
+{
+  size_t size = strlen(text) + 1;
+  char *copy = (char *) cw_malloc(subsystem, size);
+
+  if (copy != NULL) {
+    memcpy(copy, text, size);
+  }
+  return copy;
+}
@@ -0,0 +1,127 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/alloc.h
+ * Declaration of the allocator used by the library
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef CW_ALLOC_H
+#define CW_ALLOC_H
+
+#include <stddef.h>
+
+#include "stats.h"
+
+/*
+ * The allocator through which the library allocates and frees all its
+ * memory.  Each function is passed 'context' as its last argument;
+ * 'realloc' and 'free' are only passed pointers returned by 'malloc' or
+ * 'realloc' of the same allocator.  By default the library uses the
+ * standard malloc(), realloc() and free().
+ */
+typedef struct cw_allocator_struct {
+  void *(*malloc)(size_t size, void *context);
+  void *(*realloc)(void *ptr, size_t size, void *context);
+  void (*free)(void *ptr, void *context);
+  void *context;
+} CWAllocator;
+
+/*
+ * Parts of the library, by which allocations are counted.  Allocations
+ * by callers through cw_malloc() and friends are usually counted as
+ * CW_ALLOC_OTHER.
+ */
+enum {
+  CW_ALLOC_BOOK,
+  CW_ALLOC_BOX,
+  CW_ALLOC_CATALOG,
+  CW_ALLOC_EXPECT,
+  CW_ALLOC_FILE,
+  CW_ALLOC_GAME,
+  CW_ALLOC_GAMEITER,
+  CW_ALLOC_INDEX,
+  CW_ALLOC_LEAGUE,
+  CW_ALLOC_LINT,
+  CW_ALLOC_PARSE,
+  CW_ALLOC_REMAP,
+  CW_ALLOC_ROSTER,
+  CW_ALLOC_SEASON,
+  CW_ALLOC_SPLIT,
+  CW_ALLOC_OTHER,
+  CW_ALLOC_NUM_SUBSYSTEMS
+};
+
+/* Names of the subsystems, for reports: "book", "box", and so on */
+extern char *cw_alloc_subsystem_names[CW_ALLOC_NUM_SUBSYSTEMS];
+
+/*
+ * Counts of the calls to allocate, reallocate and free the memory of a
+ * subsystem, and the total number of bytes asked for by those calls to
+ * allocate and reallocate.  Memory belongs to the subsystem which
+ * allocated it: reallocating or freeing it is counted against that
+ * subsystem, whichever one does so, so that allocations less frees is
+ * the number of blocks of the subsystem's still in use.  Frees of NULL
+ * are not counted, and reallocations of NULL count as allocations.
+ */
+typedef struct cw_alloc_counts_struct {
+  long long malloc_calls, realloc_calls, free_calls;
+  long long bytes;
+} CWAllocCounts;
+
+/* Counts for each subsystem, kept while counting is enabled; like
+ * cw_stats, each thread has its own */
+extern CW_THREAD_LOCAL CWAllocCounts cw_alloc_counts[CW_ALLOC_NUM_SUBSYSTEMS];
+
+/*
+ * Sets the allocator used by the library to a copy of 'allocator', or
+ * to the standard one if it is NULL.  This should be done before any
+ * other use of the library, and before starting threads which use it.
+ * The allocator's functions are called from every thread using the
+ * library, so must be thread-safe.
+ */
+void cw_alloc_set_allocator(CWAllocator *allocator);
+
+/*
+ * Enables (if 'enable' is nonzero) or disables counting the allocations
+ * of each subsystem in cw_alloc_counts.  Counting is off by default; it
+ * applies to whichever allocator is in use.  Like the allocator, it
+ * should be set before starting threads.
+ */
+void cw_alloc_set_counting(int enable);
+
+/*
+ * Allocate, reallocate and free memory through the library's allocator,
+ * counting the call if counting is enabled.  New memory belongs to
+ * 'subsystem'; cw_realloc() and cw_free() ignore it, and count against
+ * the subsystem the memory belongs to.  cw_calloc() returns zeroed
+ * memory, and cw_strdup() a copy of 'text'; each returns NULL if the
+ * memory could not be allocated.
+ *
+ * The memory returned starts after a header of the library's, so it
+ * must be freed with cw_free(), never free().  This applies as well to
+ * the objects the library creates for the caller, such as games,
+ * scorebooks and boxscores.
+ */
+void *cw_malloc(int subsystem, size_t size);
+void *cw_calloc(int subsystem, size_t count, size_t size);
+void *cw_realloc(int subsystem, void *ptr, size_t size);
+void cw_free(int subsystem, void *ptr);
+char *cw_strdup(int subsystem, const char *text);
+
+#endif /* CW_ALLOC_H */
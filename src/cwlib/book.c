@@ -28,10 +28,12 @@
 #include "file.h"
 #include "game.h"
 #include "book.h"
+#define CW_SUBSYSTEM CW_ALLOC_BOOK
+#include "util.h"
 
 CWScorebook *cw_scorebook_create(void)
 {
-  CWScorebook *scorebook = (CWScorebook *) malloc(sizeof(CWScorebook));
+  CWScorebook *scorebook = (CWScorebook *) CW_MALLOC(sizeof(CWScorebook));
   scorebook->first_comment = scorebook->last_comment = NULL;
   scorebook->first_game = scorebook->last_game = NULL;
   return scorebook;
@@ -45,14 +47,14 @@ void cw_scorebook_cleanup(CWScorebook *scorebook)
   while (game != NULL) {
     CWGame *next_game = game->next;
     cw_game_cleanup(game);
-    free(game);
+    CW_FREE(game);
     game = next_game;
   }
 
   while (comment != NULL) {
     CWComment *next_comment = comment->next;
-    free(comment->text);
-    free(comment);
+    CW_FREE(comment->text);
+    CW_FREE(comment);
     comment = next_comment;
   }
 }
@@ -75,6 +77,22 @@ int cw_scorebook_append_game(CWScorebook *scorebook, CWGame *game)
   return 1;
 }
 
+/* The date or number of 'game', or "" if it has none, for ordering */
+static char *cw_scorebook_game_key(CWGame *game, char *label)
+{
+  char *value = cw_game_info_lookup(game, label);
+
+  return (value != NULL) ? value : "";
+}
+
+/* Compares games by date, then by number, as strcmp() does */
+static int cw_scorebook_compare_keys(char *date1, char *number1, char *date2, char *number2)
+{
+  int result = strcmp(date1, date2);
+
+  return (result != 0) ? result : strcmp(number1, number2);
+}
+
 int cw_scorebook_insert_game(CWScorebook *scorebook, CWGame *game)
 {
   if (game == NULL) {
@@ -86,11 +104,13 @@ int cw_scorebook_insert_game(CWScorebook *scorebook, CWGame *game)
     scorebook->last_game = game;
   }
   else {
+    char *date = cw_scorebook_game_key(game, "date");
+    char *number = cw_scorebook_game_key(game, "number");
     CWGame *g = scorebook->first_game;
+
     while (g != NULL &&
-           (strcmp(cw_game_info_lookup(g, "date"), cw_game_info_lookup(game, "date")) < 0 ||
-            (strcmp(cw_game_info_lookup(g, "date"), cw_game_info_lookup(game, "date")) == 0 &&
-             strcmp(cw_game_info_lookup(g, "number"), cw_game_info_lookup(game, "number")) < 0))) {
+           cw_scorebook_compare_keys(cw_scorebook_game_key(g, "date"),
+                                     cw_scorebook_game_key(g, "number"), date, number) < 0) {
       g = g->next;
     }
 
@@ -114,6 +134,86 @@ int cw_scorebook_insert_game(CWScorebook *scorebook, CWGame *game)
   return 1;
 }
 
+/* A game with its keys for sorting, looked up once */
+typedef struct cw_scorebook_sort_key_struct {
+  char *date, *number;
+  CWGame *game;
+} CWScorebookSortKey;
+
+/* Stably merge sorts keys[0..count), using 'temp' of the same size */
+static void cw_scorebook_merge_sort(CWScorebookSortKey *keys, CWScorebookSortKey *temp,
+                                    size_t count)
+{
+  size_t middle = count / 2, i = 0, j = middle, k = 0;
+
+  if (count < 2) {
+    return;
+  }
+  cw_scorebook_merge_sort(keys, temp, middle);
+  cw_scorebook_merge_sort(keys + middle, temp, count - middle);
+
+  /* Already in order, as when the games were read in order */
+  if (cw_scorebook_compare_keys(keys[middle - 1].date, keys[middle - 1].number,
+                                keys[middle].date, keys[middle].number) <= 0) {
+    return;
+  }
+  while (i < middle && j < count) {
+    /* On equal keys the earlier game is taken first, keeping the sort stable */
+    if (cw_scorebook_compare_keys(keys[j].date, keys[j].number, keys[i].date,
+                                  keys[i].number) < 0) {
+      temp[k++] = keys[j++];
+    }
+    else {
+      temp[k++] = keys[i++];
+    }
+  }
+  while (i < middle) {
+    temp[k++] = keys[i++];
+  }
+  /* Any remaining keys from the second half are already in place */
+  memcpy(keys, temp, k * sizeof(CWScorebookSortKey));
+}
+
+int cw_scorebook_sort(CWScorebook *scorebook)
+{
+  CWScorebookSortKey *keys, *temp;
+  CWGame *game;
+  size_t count = 0, i;
+
+  for (game = scorebook->first_game; game != NULL; game = game->next) {
+    count++;
+  }
+  if (count < 2) {
+    return 1;
+  }
+
+  keys = (CWScorebookSortKey *) CW_MALLOC(count * sizeof(CWScorebookSortKey));
+  temp = (CWScorebookSortKey *) CW_MALLOC(count * sizeof(CWScorebookSortKey));
+  if (keys == NULL || temp == NULL) {
+    XFREE(keys);
+    XFREE(temp);
+    return 0;
+  }
+
+  for (game = scorebook->first_game, i = 0; game != NULL; game = game->next, i++) {
+    keys[i].date = cw_scorebook_game_key(game, "date");
+    keys[i].number = cw_scorebook_game_key(game, "number");
+    keys[i].game = game;
+  }
+  cw_scorebook_merge_sort(keys, temp, count);
+
+  for (i = 0; i < count; i++) {
+    keys[i].game->prev = (i > 0) ? keys[i - 1].game : NULL;
+    keys[i].game->next = (i + 1 < count) ? keys[i + 1].game : NULL;
+  }
+  scorebook->first_game = keys[0].game;
+  scorebook->last_game = keys[count - 1].game;
+
+  CW_FREE(keys);
+  CW_FREE(temp);
+  return 1;
+}
+
 CWGame *cw_scorebook_remove_game(CWScorebook *scorebook, char *game_id)
 {
   CWGame *game = scorebook->first_game;
@@ -158,8 +258,8 @@ static int cw_scorebook_read_comments(CWScorebook *scorebook, FILE *file)
     com = cw_tokenizer_next(&tok);
 
     if (tag && !strcmp(tag, "com") && com) {
-      CWComment *comment = (CWComment *) malloc(sizeof(CWComment));
-      comment->text = (char *) malloc(sizeof(char) * (strlen(com) + 1));
+      CWComment *comment = (CWComment *) CW_MALLOC(sizeof(CWComment));
+      comment->text = (char *) CW_MALLOC(sizeof(char) * (strlen(com) + 1));
       strcpy(comment->text, com);
       comment->prev = scorebook->last_comment;
       comment->next = NULL;
@@ -204,6 +304,40 @@ int cw_scorebook_read(CWScorebook *scorebook, FILE *file)
   }
 }
 
+int cw_scorebook_read_selected(CWScorebook *scorebook, FILE *file, int (*f)(CWGame *))
+{
+  int game_count = 0;
+  fpos_t filepos;
+
+  if (file == NULL || !cw_scorebook_read_comments(scorebook, file)) {
+    return -1;
+  }
+  cw_file_find_first_game(file);
+  while (!feof(file)) {
+    CWGame *header;
+    int selected;
+
+    fgetpos(file, &filepos);
+    if ((header = cw_game_read_header(file)) == NULL) {
+      break;
+    }
+    selected = (*f)(header);
+    cw_game_cleanup(header);
+    CW_FREE(header);
+
+    if (!selected) {
+      cw_file_skip_game(file);
+      continue;
+    }
+    fsetpos(file, &filepos);
+    if (!cw_scorebook_append_game(scorebook, cw_game_read(file))) {
+      break;
+    }
+    game_count++;
+  }
+  return game_count;
+}
+
 static void cw_scorebook_write_comments(CWScorebook *scorebook, FILE *file)
 {
   CWComment *comment = scorebook->first_comment;
@@ -228,7 +362,7 @@ void cw_scorebook_write(CWScorebook *scorebook, FILE *file)
 
 CWScorebookIterator *cw_scorebook_iterate(CWScorebook *scorebook, int (*f)(CWGame *))
 {
-  CWScorebookIterator *iter = (CWScorebookIterator *) malloc(sizeof(CWScorebookIterator));
+  CWScorebookIterator *iter = (CWScorebookIterator *) CW_MALLOC(sizeof(CWScorebookIterator));
   iter->current = scorebook->first_game;
   iter->f = f;
   return iter;
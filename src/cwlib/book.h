@@ -40,7 +40,7 @@ CWScorebook *cw_scorebook_create(void);
 
 /*
  * Cleans up internal memory allocation associated with 'scorebook'.
- * Caller is responsible for free()ing the scorebook itself.
+ * Caller is responsible for freeing the scorebook itself with cw_free().
  */
 void cw_scorebook_cleanup(CWScorebook *scorebook);
 
@@ -58,6 +58,17 @@ int cw_scorebook_append_game(CWScorebook *scorebook, CWGame *game);
  */
 int cw_scorebook_insert_game(CWScorebook *scorebook, CWGame *game);
 
+/*
+ * Sorts the games of 'scorebook' into chronological order, by date and
+ * then number.  The sort is stable: games with the same date and number
+ * keep their order.  To merge games from several sources, append them
+ * all and then sort, rather than inserting each with
+ * cw_scorebook_insert_game(), which takes time quadratic in the number
+ * of games.  Returns 1 if successful, 0 if memory for sorting could
+ * not be allocated, in which case the scorebook is unchanged.
+ */
+int cw_scorebook_sort(CWScorebook *scorebook);
+
 /*
  * Removes the game with game ID 'game_id' from scorebook.  Returns the
  * game object; the caller becomes responsible for the memory allocated
@@ -74,6 +85,15 @@ CWGame *cw_scorebook_remove_game(CWScorebook *scorebook, char *game_id);
  */
 int cw_scorebook_read(CWScorebook *scorebook, FILE *file);
 
+/*
+ * As cw_scorebook_read(), but reads only the games for which the filter
+ * function 'f' returns nonzero.  'f' is passed a game with only its
+ * 'id', 'version' and 'info' records (see cw_game_read_header()); the
+ * records of games not selected are skipped without being parsed.
+ * Returns the number of games read, or -1 if the file could not be opened.
+ */
+int cw_scorebook_read_selected(CWScorebook *scorebook, FILE *file, int (*f)(CWGame *));
+
 /*
  * Writes the contents of the scorebook to file 'file'.
  */
@@ -95,7 +115,7 @@ CWScorebookIterator *cw_scorebook_iterate(CWScorebook *scorebook, int (*f)(CWGam
 
 /*
  * Cleans up internal memory allocation associated with 'iterator'.
- * Caller is responsible for free()ing the scorebook itself.
+ * Caller is responsible for freeing the iterator itself with cw_free().
  */
 void cw_scorebook_iterator_cleanup(CWScorebookIterator *iterator);
 
@@ -29,14 +29,70 @@
 #include <string.h>
 
 #include "chadwick.h"
+#define CW_SUBSYSTEM CW_ALLOC_BOX
 #include "util.h"
 
+/************************************************************************
+ * Allocation of entries from the boxscore's memory blocks
+ ************************************************************************/
+
+/* Entries are aligned to this many bytes within a block */
+#define CW_BOX_ALIGN 8
+
+/* Blocks are this size, unless one entry needs more */
+#define CW_BOX_BLOCK_SIZE 32768
+
+/*
+ * Allocate 'size' bytes from the boxscore's blocks, moving to the next
+ * block (and allocating a new one, if there is no next) when the current
+ * one is full.
+ */
+static void *cw_box_alloc(CWBoxscore *boxscore, size_t size)
+{
+  CWBoxBlock *block = boxscore->current_block;
+  void *ptr;
+
+  size = (size + CW_BOX_ALIGN - 1) & ~((size_t) CW_BOX_ALIGN - 1);
+  while (block != NULL && block->used + size > block->size) {
+    block = block->next;
+  }
+  if (block == NULL) {
+    size_t block_size = (size > CW_BOX_BLOCK_SIZE) ? size : CW_BOX_BLOCK_SIZE;
+
+    block = (CWBoxBlock *) CW_MALLOC(sizeof(CWBoxBlock) + block_size);
+    block->size = block_size;
+    block->used = 0;
+    block->next = NULL;
+    if (boxscore->current_block == NULL) {
+      boxscore->first_block = block;
+    }
+    else {
+      CWBoxBlock *last = boxscore->current_block;
+      while (last->next != NULL) {
+        last = last->next;
+      }
+      last->next = block;
+    }
+  }
+  boxscore->current_block = block;
+  ptr = (char *) (block + 1) + block->used;
+  block->used += size;
+  return ptr;
+}
+
+static char *cw_box_strdup(CWBoxscore *boxscore, char *text)
+{
+  char *copy = (char *) cw_box_alloc(boxscore, strlen(text) + 1);
+  strcpy(copy, text);
+  return copy;
+}
+
 /*
  * Create an initialize a batting statistic entry
  */
-static CWBoxBatting *cw_box_batting_create(void)
+static CWBoxBatting *cw_box_batting_create(CWBoxscore *boxscore)
 {
-  CWBoxBatting *batting = (CWBoxBatting *) malloc(sizeof(CWBoxBatting));
+  CWBoxBatting *batting = (CWBoxBatting *) cw_box_alloc(boxscore, sizeof(CWBoxBatting));
   batting->g = 0;
   batting->pa = 0;
   batting->ab = 0;
@@ -70,9 +126,9 @@ static CWBoxBatting *cw_box_batting_create(void)
 /*
  * Create an initialize a fielding statistic entry
  */
-static CWBoxFielding *cw_box_fielding_create(void)
+static CWBoxFielding *cw_box_fielding_create(CWBoxscore *boxscore)
 {
-  CWBoxFielding *fielding = (CWBoxFielding *) malloc(sizeof(CWBoxFielding));
+  CWBoxFielding *fielding = (CWBoxFielding *) cw_box_alloc(boxscore, sizeof(CWBoxFielding));
   fielding->g = 0;
   fielding->outs = 0;
   fielding->bip = 0;
@@ -90,9 +146,9 @@ static CWBoxFielding *cw_box_fielding_create(void)
 /*
  * Create an initialize a pitching statistic entry
  */
-static CWBoxPitching *cw_box_pitching_create(void)
+static CWBoxPitching *cw_box_pitching_create(CWBoxscore *boxscore)
 {
-  CWBoxPitching *pitching = (CWBoxPitching *) malloc(sizeof(CWBoxPitching));
+  CWBoxPitching *pitching = (CWBoxPitching *) cw_box_alloc(boxscore, sizeof(CWBoxPitching));
   pitching->g = 0;
   pitching->gs = 0;
   pitching->cg = 0;
@@ -137,59 +193,67 @@ static CWBoxPitching *cw_box_pitching_create(void)
  * Private routines for dealing with auxiliary struct init and dealloc
  ************************************************************************/
 
-static CWBoxPlayer *cw_box_player_create(char *player_id, char *name)
+/*
+ * The bucket of the player and pitcher indexes for 'player_id'
+ */
+static unsigned int cw_box_index_hash(char *player_id)
+{
+  unsigned int hash = 2166136261U;
+
+  while (*player_id != '\0') {
+    hash = (hash ^ (unsigned char) *(player_id++)) * 16777619U;
+  }
+  return hash & (CW_BOX_INDEX_SIZE - 1);
+}
+
+/*
+ * Create a player entry for the slot 'slot' of team 'team', and add it
+ * to the player index.  The caller links it into the slot.
+ */
+static CWBoxPlayer *cw_box_player_create(CWBoxscore *boxscore, char *player_id, char *name,
+                                         int team, int slot)
 {
   int i;
+  unsigned int bucket = cw_box_index_hash(player_id);
 
-  CWBoxPlayer *player = (CWBoxPlayer *) malloc(sizeof(CWBoxPlayer));
-  player->player_id = (char *) malloc(sizeof(char) * (strlen(player_id) + 1));
-  strcpy(player->player_id, player_id);
-  player->name = (char *) malloc(sizeof(char) * (strlen(name) + 1));
-  strcpy(player->name, name);
-  player->batting = cw_box_batting_create();
+  CWBoxPlayer *player = (CWBoxPlayer *) cw_box_alloc(boxscore, sizeof(CWBoxPlayer));
+  player->player_id = cw_box_strdup(boxscore, player_id);
+  player->name = cw_box_strdup(boxscore, name);
+  player->batting = cw_box_batting_create(boxscore);
   player->num_positions = player->ph_inn = player->pr_inn = 0;
   player->start_position = -1;
   for (i = 0; i <= 9; i++) {
     player->fielding[i] = NULL;
   }
+  player->team = team;
+  player->slot = slot;
   player->prev = NULL;
   player->next = NULL;
+  player->hash_next = boxscore->player_index[bucket];
+  boxscore->player_index[bucket] = player;
   return player;
 }
 
-static void cw_box_player_cleanup(CWBoxPlayer *player)
-{
-  int i;
-  for (i = 0; i <= 9; i++) {
-    if (player->fielding[i]) {
-      free(player->fielding[i]);
-    }
-  }
-  free(player->batting);
-  free(player->name);
-  free(player->player_id);
-}
-
-static CWBoxPitcher *cw_box_pitcher_create(char *player_id, char *name)
+/*
+ * Create a pitcher entry for team 'team', and add it to the pitcher index.
+ * The caller links it into the team's pitchers.
+ */
+static CWBoxPitcher *cw_box_pitcher_create(CWBoxscore *boxscore, char *player_id, char *name,
+                                           int team)
 {
-  CWBoxPitcher *pitcher = (CWBoxPitcher *) malloc(sizeof(CWBoxPitcher));
-  pitcher->player_id = (char *) malloc(sizeof(char) * (strlen(player_id) + 1));
-  strcpy(pitcher->player_id, player_id);
-  pitcher->name = (char *) malloc(sizeof(char) * (strlen(name) + 1));
-  strcpy(pitcher->name, name);
-  pitcher->pitching = cw_box_pitching_create();
+  unsigned int bucket = cw_box_index_hash(player_id);
+  CWBoxPitcher *pitcher = (CWBoxPitcher *) cw_box_alloc(boxscore, sizeof(CWBoxPitcher));
+  pitcher->player_id = cw_box_strdup(boxscore, player_id);
+  pitcher->name = cw_box_strdup(boxscore, name);
+  pitcher->pitching = cw_box_pitching_create(boxscore);
+  pitcher->team = team;
   pitcher->prev = NULL;
   pitcher->next = NULL;
+  pitcher->hash_next = boxscore->pitcher_index[bucket];
+  boxscore->pitcher_index[bucket] = pitcher;
   return pitcher;
 }
 
-static void cw_box_pitcher_cleanup(CWBoxPitcher *pitcher)
-{
-  free(pitcher->pitching);
-  free(pitcher->name);
-  free(pitcher->player_id);
-}
-
 /*
  * Initialize slots with starting players
  */
@@ -205,7 +269,7 @@ static void cw_box_enter_starters(CWBoxscore *boxscore, CWGame *game)
         continue;
       }
 
-      boxscore->slots[i][t] = cw_box_player_create(app->player_id, app->name);
+      boxscore->slots[i][t] = cw_box_player_create(boxscore, app->player_id, app->name, t, i);
       sprintf(boxscore->slots[i][t]->date, "%c%c%c%c%c%c%c%c", date[0], date[1], date[2], date[3],
               date[5], date[6], date[8], date[9]);
       boxscore->slots[i][t]->batting->g = 1;
@@ -213,7 +277,7 @@ static void cw_box_enter_starters(CWBoxscore *boxscore, CWGame *game)
       boxscore->slots[i][t]->positions[0] = app->pos;
       boxscore->slots[i][t]->start_position = app->pos;
       if (app->pos < 10) {
-        boxscore->slots[i][t]->fielding[app->pos] = cw_box_fielding_create();
+        boxscore->slots[i][t]->fielding[app->pos] = cw_box_fielding_create(boxscore);
         /* Under modern rules, players only receive credit for a game
 	 *  in the field when they appear there for at least one event.
 	 *
@@ -221,7 +285,7 @@ static void cw_box_enter_starters(CWBoxscore *boxscore, CWGame *game)
 	 */
       }
       if (app->pos == 1) {
-        boxscore->pitchers[t] = cw_box_pitcher_create(app->player_id, app->name);
+        boxscore->pitchers[t] = cw_box_pitcher_create(boxscore, app->player_id, app->name, t);
         boxscore->pitchers[t]->pitching->g = 1;
         boxscore->pitchers[t]->pitching->gs = 1;
       }
@@ -230,7 +294,7 @@ static void cw_box_enter_starters(CWBoxscore *boxscore, CWGame *game)
     /*
     if (!strcmp(cw_game_info_lookup(game, "usedh"), "true")) {
       CWAppearance *app = cw_game_starter_find(game, t, 0);
-      boxscore->pitchers[t] = cw_box_pitcher_create(app->player_id, app->name);
+      boxscore->pitchers[t] = cw_box_pitcher_create(boxscore, app->player_id, app->name);
       boxscore->pitchers[t]->pitching->g = 1;
       boxscore->pitchers[t]->pitching->gs = 1;
     }
@@ -239,12 +303,67 @@ static void cw_box_enter_starters(CWBoxscore *boxscore, CWGame *game)
 }
 
 /*
- * Add a substitute into a slot
+ * Count the runner on 'base' as inherited by 'pitching', and follow the
+ * runner from the current event to find whether the runner scores.
  */
-static void cw_box_add_substitute(CWBoxscore *boxscore, CWGameIterator *gameiter)
+static void cw_box_add_inherited(CWBoxscore *boxscore, CWGameIterator *gameiter,
+                                 CWBoxPitching *pitching, int base)
 {
-  CWAppearance *sub = gameiter->event->first_sub;
+  CWBoxInherited *runner;
 
+  pitching->inr++;
+  base = gameiter->event_data->advance[base];
+  if (base >= 4) {
+    pitching->inrs++;
+  }
+  if (base < 1 || base > 3) {
+    return;
+  }
+
+  runner = (CWBoxInherited *) cw_box_alloc(boxscore, sizeof(CWBoxInherited));
+  runner->pitching = pitching;
+  runner->base = base;
+  runner->inning = gameiter->state->inning;
+  runner->half = gameiter->state->batting_team;
+  runner->next = boxscore->inherited;
+  boxscore->inherited = runner;
+}
+
+/*
+ * Move inherited runners on base by the current event, crediting
+ * pitchers with runners who score.  Runners who are put out, or who are
+ * left on base at the end of the half-inning, are no longer followed.
+ */
+static void cw_box_advance_inherited(CWBoxscore *boxscore, CWGameIterator *gameiter)
+{
+  CWBoxInherited **runner = &(boxscore->inherited);
+
+  while (*runner != NULL) {
+    if (gameiter->state->inning != (*runner)->inning ||
+        gameiter->state->batting_team != (*runner)->half) {
+      *runner = (*runner)->next;
+      continue;
+    }
+    if (strcmp(gameiter->event->event_text, "NP") != 0) {
+      (*runner)->base = gameiter->event_data->advance[(*runner)->base];
+      if ((*runner)->base >= 4) {
+        (*runner)->pitching->inrs++;
+      }
+      if ((*runner)->base < 1 || (*runner)->base > 3) {
+        *runner = (*runner)->next;
+        continue;
+      }
+    }
+    runner = &((*runner)->next);
+  }
+}
+
+/*
+ * Add the substitutes after the current event, starting with 'sub'
+ */
+static void cw_box_add_substitute(CWBoxscore *boxscore, CWGameIterator *gameiter,
+                                  CWAppearance *sub)
+{
   while (sub != NULL) {
     if (sub->slot < 0 || sub->slot > 9) {
       fprintf(stderr, "ERROR: In %s, invalid slot %d for player '%s'.\n", gameiter->game->game_id,
@@ -268,7 +387,8 @@ static void cw_box_add_substitute(CWBoxscore *boxscore, CWGameIterator *gameiter
        * sub players into the 0 slot even though the DH is not in use.
        * Try to do something reasonable here.
        */
-      CWBoxPlayer *player = cw_box_player_create(sub->player_id, sub->name);
+      CWBoxPlayer *player =
+        cw_box_player_create(boxscore, sub->player_id, sub->name, sub->team, sub->slot);
       CW_STRLCPY(player->date, gameiter->state->date);
       player->batting->g = 1;
       boxscore->slots[sub->slot][sub->team] = player;
@@ -289,14 +409,16 @@ static void cw_box_add_substitute(CWBoxscore *boxscore, CWGameIterator *gameiter
         boxscore->slots[0][sub->team] = NULL;
       }
 
-      /* Put player in his new slot */
+      /* Put player in the new slot */
+      player->slot = sub->slot;
       boxscore->slots[sub->slot][sub->team]->next = player;
       player->prev = boxscore->slots[sub->slot][sub->team];
       boxscore->slots[sub->slot][sub->team] = player;
     }
 
     else if (strcmp(sub->player_id, boxscore->slots[sub->slot][sub->team]->player_id) != 0) {
-      CWBoxPlayer *player = cw_box_player_create(sub->player_id, sub->name);
+      CWBoxPlayer *player =
+        cw_box_player_create(boxscore, sub->player_id, sub->name, sub->team, sub->slot);
       CW_STRLCPY(player->date, gameiter->state->date);
       player->batting->g = 1;
       boxscore->slots[sub->slot][sub->team]->next = player;
@@ -314,7 +436,8 @@ static void cw_box_add_substitute(CWBoxscore *boxscore, CWGameIterator *gameiter
     if (sub->pos < 10) {
       CWBoxFielding *fielding = boxscore->slots[sub->slot][sub->team]->fielding[sub->pos];
       if (fielding == NULL) {
-        boxscore->slots[sub->slot][sub->team]->fielding[sub->pos] = cw_box_fielding_create();
+        boxscore->slots[sub->slot][sub->team]->fielding[sub->pos] =
+          cw_box_fielding_create(boxscore);
         /* The mere announcement of a player at a position does not award
          * him a game played at the position (under modern rules).
          * Therefore, the game played is set when processing fielding credits
@@ -353,7 +476,8 @@ static void cw_box_add_substitute(CWBoxscore *boxscore, CWGameIterator *gameiter
         cur_pitcher->xbinn = gameiter->state->inning;
       }
 
-      CWBoxPitcher *pitcher = cw_box_pitcher_create(sub->player_id, sub->name);
+      CWBoxPitcher *pitcher =
+        cw_box_pitcher_create(boxscore, sub->player_id, sub->name, sub->team);
       pitcher->pitching->g = 1;
       boxscore->pitchers[sub->team]->next = pitcher;
       pitcher->prev = boxscore->pitchers[sub->team];
@@ -366,10 +490,7 @@ static void cw_box_add_substitute(CWBoxscore *boxscore, CWGameIterator *gameiter
 
       for (base = 1; base <= 3; base++) {
         if (cw_gamestate_base_occupied(gameiter->state, base)) {
-          pitcher->inr++;
-          if (cw_gameiter_runner_fate(gameiter, base) >= 4) {
-            pitcher->inrs++;
-          }
+          cw_box_add_inherited(boxscore, gameiter, pitcher, base);
         }
       }
     }
@@ -387,24 +508,34 @@ static void cw_box_add_substitute(CWBoxscore *boxscore, CWGameIterator *gameiter
  */
 CWBoxPlayer *cw_box_find_player(CWBoxscore *boxscore, char *player_id, int batter)
 {
-  int i, t;
+  CWBoxPlayer *player, *found = NULL;
 
   if (player_id == NULL) {
     return NULL;
   }
-  for (t = 0; t <= 1; t++) {
-    for (i = (batter) ? 1 : 0; i <= 9; i++) {
-      CWBoxPlayer *player = boxscore->slots[i][t];
-      while (player != NULL) {
-        if (!strcmp(player->player_id, player_id)) {
-          return player;
-        }
-        player = player->prev;
-      }
+  /* Of the player's entries, take the one in the first slot, visitors
+   * before home, as searching the slots in order would */
+  for (player = boxscore->player_index[cw_box_index_hash(player_id)]; player != NULL;
+       player = player->hash_next) {
+    if ((batter && player->slot == 0) || strcmp(player->player_id, player_id) != 0) {
+      continue;
     }
+    if (found == NULL || player->team < found->team ||
+        (player->team == found->team && player->slot < found->slot)) {
+      found = player;
+    }
+  }
+  if (found == NULL) {
+    return NULL;
   }
 
-  return NULL;
+  /* If the player has several entries in the slot, it is the latest in
+   * the slot which is wanted */
+  player = boxscore->slots[found->slot][found->team];
+  while (strcmp(player->player_id, player_id) != 0) {
+    player = player->prev;
+  }
+  return player;
 }
 
 /*
@@ -420,21 +551,25 @@ CWBoxPlayer *cw_box_find_player(CWBoxscore *boxscore, char *player_id, int batte
 static CWBoxPlayer *cw_box_find_current_player(CWBoxscore *boxscore, char *player_id,
                                                int batting_only)
 {
-  int i, t;
+  CWBoxPlayer *player, *found = NULL;
 
   if (player_id == NULL) {
     return NULL;
   }
-  for (t = 0; t <= 1; t++) {
-    for (i = (batting_only) ? 1 : 0; i <= 9; i++) {
-      CWBoxPlayer *player = boxscore->slots[i][t];
-      if (player != NULL && !strcmp(player->player_id, player_id)) {
-        return player;
-      }
+  for (player = boxscore->player_index[cw_box_index_hash(player_id)]; player != NULL;
+       player = player->hash_next) {
+    if ((batting_only && player->slot == 0) ||
+        boxscore->slots[player->slot][player->team] != player ||
+        strcmp(player->player_id, player_id) != 0) {
+      continue;
+    }
+    if (found == NULL || player->team < found->team ||
+        (player->team == found->team && player->slot < found->slot)) {
+      found = player;
     }
   }
 
-  return NULL;
+  return found;
 }
 
 /*
@@ -442,86 +577,79 @@ static CWBoxPlayer *cw_box_find_current_player(CWBoxscore *boxscore, char *playe
  */
 CWBoxPitcher *cw_box_find_pitcher(CWBoxscore *boxscore, char *player_id)
 {
-  int t;
+  CWBoxPitcher *pitcher, *found = NULL;
 
-  for (t = 0; t <= 1; t++) {
-    CWBoxPitcher *pitcher = boxscore->pitchers[t];
-    while (pitcher != NULL && strcmp(pitcher->player_id, player_id) != 0) {
-      pitcher = pitcher->prev;
+  if (player_id == NULL) {
+    return NULL;
+  }
+  /* The latest entry for the player, with the visitors' entries first */
+  for (pitcher = boxscore->pitcher_index[cw_box_index_hash(player_id)]; pitcher != NULL;
+       pitcher = pitcher->hash_next) {
+    if (strcmp(pitcher->player_id, player_id) != 0) {
+      continue;
     }
-
-    if (pitcher != NULL) {
+    if (pitcher->team == 0) {
       return pitcher;
     }
+    if (found == NULL) {
+      found = pitcher;
+    }
   }
 
-  return NULL;
+  return found;
 }
 
 /*
- * Generic routine to add a new "event" entry to the boxscore
+ * Generic routine to add a new "event" entry to the boxscore, appending
+ * it to 'list', of which 'tail' is the last entry.  There is room for
+ * 'count' players, which are initially NULL.
  */
-static CWBoxEvent *cw_box_add_event(CWBoxEvent **list, int inning, int half, int count, ...)
+static CWBoxEvent *cw_box_new_event(CWBoxscore *boxscore, CWBoxEvent **list, CWBoxEvent **tail,
+                                    int inning, int half, int count)
 {
-  int i = 0;
-  va_list arg_list;
-  va_start(arg_list, count);
+  int i;
+  CWBoxEvent *event = (CWBoxEvent *) cw_box_alloc(boxscore, sizeof(CWBoxEvent));
 
-  if (*list == NULL) {
-    *list = (CWBoxEvent *) malloc(sizeof(CWBoxEvent));
-    for (i = 0; i < 20; (*list)->players[i++] = NULL)
-      ;
-    i = 0;
-    while (count--) {
-      (*list)->players[i++] = va_arg(arg_list, char *);
-    }
-    (*list)->inning = inning;
-    (*list)->half_inning = half;
-    (*list)->runners = -1;
-    (*list)->pickoff = -1;
-    (*list)->outs = -1;
-    (*list)->mark = 0;
-    strcpy((*list)->location, "");
-    (*list)->prev = NULL;
-    (*list)->next = NULL;
-    return *list;
+  event->players = (char **) cw_box_alloc(boxscore, sizeof(char *) * (size_t) (count + 1));
+  for (i = 0; i <= count; i++) {
+    event->players[i] = NULL;
+  }
+  event->num_players = count;
+  event->inning = inning;
+  event->half_inning = half;
+  event->runners = -1;
+  event->pickoff = -1;
+  event->outs = -1;
+  event->mark = 0;
+  strcpy(event->location, "");
+  event->prev = *tail;
+  event->next = NULL;
+  if (*tail == NULL) {
+    *list = event;
   }
   else {
-    CWBoxEvent *event = *list;
-    while (event->next != NULL) {
-      event = event->next;
-    }
-
-    event->next = (CWBoxEvent *) malloc(sizeof(CWBoxEvent));
-    for (i = 0; i < 20; event->next->players[i++] = NULL)
-      ;
-    i = 0;
-    while (count--) {
-      event->next->players[i++] = va_arg(arg_list, char *);
-    }
-    event->next->inning = inning;
-    event->next->half_inning = half;
-    event->next->runners = -1;
-    event->next->pickoff = -1;
-    event->next->outs = -1;
-    event->next->mark = 0;
-    strcpy(event->next->location, "");
-    event->next->prev = event;
-    event->next->next = NULL;
-    return event->next;
+    (*tail)->next = event;
   }
+  *tail = event;
+  return event;
 }
 
-static void cw_box_cleanup_event_list(CWBoxEvent **list)
+/*
+ * Add a new "event" entry naming the 'count' players which follow
+ */
+static CWBoxEvent *cw_box_add_event(CWBoxscore *boxscore, CWBoxEvent **list, CWBoxEvent **tail,
+                                    int inning, int half, int count, ...)
 {
-  CWBoxEvent *event = *list;
+  int i;
+  va_list arg_list;
+  CWBoxEvent *event = cw_box_new_event(boxscore, list, tail, inning, half, count);
 
-  while (event != NULL) {
-    CWBoxEvent *next_event = event->next;
-    free(event);
-    event = next_event;
+  va_start(arg_list, count);
+  for (i = 0; i < count; i++) {
+    event->players[i] = va_arg(arg_list, char *);
   }
-  *list = NULL;
+  va_end(arg_list);
+  return event;
 }
 
 /*
@@ -663,21 +791,22 @@ static void cw_box_batter_stats(CWBoxscore *boxscore, CWGameIterator *gameiter)
       }
 
       if (event_data->event_type == CW_EVENT_DOUBLE) {
-        cw_box_add_event(&(boxscore->b2_list), gameiter->state->inning,
-                         gameiter->state->batting_team, 2, player->player_id,
-                         res_pitcher->player_id);
+        cw_box_add_event(boxscore, &(boxscore->b2_list), &(boxscore->b2_tail),
+                         gameiter->state->inning, gameiter->state->batting_team, 2,
+                         player->player_id, res_pitcher->player_id);
         player->batting->b2++;
         res_pitcher->pitching->b2++;
       }
       else if (event_data->event_type == CW_EVENT_TRIPLE) {
-        cw_box_add_event(&(boxscore->b3_list), gameiter->state->inning,
-                         gameiter->state->batting_team, 2, player->player_id,
-                         res_pitcher->player_id);
+        cw_box_add_event(boxscore, &(boxscore->b3_list), &(boxscore->b3_tail),
+                         gameiter->state->inning, gameiter->state->batting_team, 2,
+                         player->player_id, res_pitcher->player_id);
         player->batting->b3++;
         res_pitcher->pitching->b3++;
       }
       else if (event_data->event_type == CW_EVENT_HOMERUN) {
-        CWBoxEvent *event = cw_box_add_event(&(boxscore->hr_list), gameiter->state->inning,
+        CWBoxEvent *event = cw_box_add_event(boxscore, &(boxscore->hr_list), &(boxscore->hr_tail),
+                                             gameiter->state->inning,
                                              gameiter->state->batting_team, 2, player->player_id,
                                              res_pitcher->player_id);
         event->runners = cw_event_runs_on_play(gameiter->event_data);
@@ -707,21 +836,21 @@ static void cw_box_batter_stats(CWBoxscore *boxscore, CWGameIterator *gameiter)
     if (event_data->event_type == CW_EVENT_INTENTIONALWALK) {
       player->batting->ibb++;
       res_pitcher->pitching->ibb++;
-      cw_box_add_event(&(boxscore->ibb_list), gameiter->state->inning,
-                       gameiter->state->batting_team, 2, player->player_id,
-                       res_pitcher->player_id);
+      cw_box_add_event(boxscore, &(boxscore->ibb_list), &(boxscore->ibb_tail),
+                       gameiter->state->inning, gameiter->state->batting_team, 2,
+                       player->player_id, res_pitcher->player_id);
     }
   }
   else if (event_data->event_type == CW_EVENT_HITBYPITCH) {
     player->batting->hp++;
     res_pitcher->pitching->hb++;
-    cw_box_add_event(&(boxscore->hp_list), gameiter->state->inning, gameiter->state->batting_team,
-                     2, player->player_id, res_pitcher->player_id);
+    cw_box_add_event(boxscore, &(boxscore->hp_list), &(boxscore->hp_tail), gameiter->state->inning,
+                     gameiter->state->batting_team, 2, player->player_id, res_pitcher->player_id);
   }
   else if (event_data->event_type == CW_EVENT_BALK) {
     res_pitcher->pitching->bk++;
-    cw_box_add_event(&(boxscore->bk_list), gameiter->state->inning, gameiter->state->batting_team,
-                     1, res_pitcher->player_id);
+    cw_box_add_event(boxscore, &(boxscore->bk_list), &(boxscore->bk_tail), gameiter->state->inning,
+                     gameiter->state->batting_team, 1, res_pitcher->player_id);
   }
   else if (event_data->event_type == CW_EVENT_INTERFERENCE) {
     player->batting->xi++;
@@ -749,22 +878,22 @@ static void cw_box_batter_stats(CWBoxscore *boxscore, CWGameIterator *gameiter)
       fprintf(stderr, "      Skipping statistics tabulation for this play.\n");
       return;
     }
-    cw_box_add_event(&(boxscore->wp_list), gameiter->state->inning, gameiter->state->batting_team,
-                     2, pitcher->player_id, catcher->player_id);
+    cw_box_add_event(boxscore, &(boxscore->wp_list), &(boxscore->wp_tail), gameiter->state->inning,
+                     gameiter->state->batting_team, 2, pitcher->player_id, catcher->player_id);
     pitcher->pitching->wp++;
   }
 
   if (event_data->sh_flag) {
     player->batting->sh++;
     res_pitcher->pitching->sh++;
-    cw_box_add_event(&(boxscore->sh_list), gameiter->state->inning, gameiter->state->batting_team,
-                     2, player->player_id, res_pitcher->player_id);
+    cw_box_add_event(boxscore, &(boxscore->sh_list), &(boxscore->sh_tail), gameiter->state->inning,
+                     gameiter->state->batting_team, 2, player->player_id, res_pitcher->player_id);
   }
   if (event_data->sf_flag) {
     player->batting->sf++;
     res_pitcher->pitching->sf++;
-    cw_box_add_event(&(boxscore->sf_list), gameiter->state->inning, gameiter->state->batting_team,
-                     2, player->player_id, res_pitcher->player_id);
+    cw_box_add_event(boxscore, &(boxscore->sf_list), &(boxscore->sf_tail), gameiter->state->inning,
+                     gameiter->state->batting_team, 2, player->player_id, res_pitcher->player_id);
   }
 
   if (event_data->advance[0] >= 4) {
@@ -877,18 +1006,20 @@ static void cw_box_runner_stats(CWBoxscore *boxscore, CWGameIterator *gameiter)
       boxscore, cw_gamestate_charged_pitcher(gameiter->state, gameiter->event_data));
 
     if (gameiter->event_data->sb_flag[base]) {
-      CWBoxEvent *event = cw_box_add_event(&(boxscore->sb_list), gameiter->state->inning,
-                                           gameiter->state->batting_team, 3, player->player_id,
-                                           pitcher->player_id, catcher->player_id);
+      CWBoxEvent *event = cw_box_add_event(boxscore, &(boxscore->sb_list), &(boxscore->sb_tail),
+                                           gameiter->state->inning, gameiter->state->batting_team,
+                                           3, player->player_id, pitcher->player_id,
+                                           catcher->player_id);
       event->runners = base;
       player->batting->sb++;
       event->pickoff = (gameiter->event_data->po_flag[base]) ? 1 : 0;
     }
 
     if (gameiter->event_data->cs_flag[base]) {
-      CWBoxEvent *event = cw_box_add_event(&(boxscore->cs_list), gameiter->state->inning,
-                                           gameiter->state->batting_team, 3, player->player_id,
-                                           pitcher->player_id, catcher->player_id);
+      CWBoxEvent *event = cw_box_add_event(boxscore, &(boxscore->cs_list), &(boxscore->cs_tail),
+                                           gameiter->state->inning, gameiter->state->batting_team,
+                                           3, player->player_id, pitcher->player_id,
+                                           catcher->player_id);
       event->runners = base;
       player->batting->cs++;
       if (gameiter->event_data->po_flag[base]) {
@@ -905,14 +1036,14 @@ static void cw_box_runner_stats(CWBoxscore *boxscore, CWGameIterator *gameiter)
     else if (gameiter->event_data->po_flag[base]) {
       CWBoxEvent *event;
       if (gameiter->event_data->play[base][0] == '2') {
-        event = cw_box_add_event(&(boxscore->po_list), gameiter->state->inning,
-                                 gameiter->state->batting_team, 2, player->player_id,
-                                 catcher->player_id);
+        event = cw_box_add_event(boxscore, &(boxscore->po_list), &(boxscore->po_tail),
+                                 gameiter->state->inning, gameiter->state->batting_team, 2,
+                                 player->player_id, catcher->player_id);
       }
       else {
-        event = cw_box_add_event(&(boxscore->po_list), gameiter->state->inning,
-                                 gameiter->state->batting_team, 2, player->player_id,
-                                 pitcher->player_id);
+        event = cw_box_add_event(boxscore, &(boxscore->po_list), &(boxscore->po_tail),
+                                 gameiter->state->inning, gameiter->state->batting_team, 2,
+                                 player->player_id, pitcher->player_id);
       }
       event->pickoff = (gameiter->event_data->play[base][0] - '0');
       if (event->pickoff == 1) {
@@ -999,8 +1130,9 @@ static void cw_box_fielder_stats(CWBoxscore *boxscore, CWGameIterator *gameiter)
     for (i = 0; i < 10; i++) {
       if (gameiter->event_data->errors[i] == pos) {
         fielding->e++;
-        cw_box_add_event(&(boxscore->err_list), gameiter->state->inning,
-                         gameiter->state->batting_team, 1, player->player_id);
+        cw_box_add_event(boxscore, &(boxscore->err_list), &(boxscore->err_tail),
+                         gameiter->state->inning, gameiter->state->batting_team, 1,
+                         player->player_id);
       }
     }
 
@@ -1015,8 +1147,9 @@ static void cw_box_fielder_stats(CWBoxscore *boxscore, CWGameIterator *gameiter)
       CWBoxPitcher *pitcher = cw_box_find_pitcher(
         boxscore, cw_gamestate_charged_pitcher(gameiter->state, gameiter->event_data));
       fielding->pb++;
-      cw_box_add_event(&(boxscore->pb_list), gameiter->state->inning,
-                       gameiter->state->batting_team, 2, pitcher->player_id, player->player_id);
+      cw_box_add_event(boxscore, &(boxscore->pb_list), &(boxscore->pb_tail),
+                       gameiter->state->inning, gameiter->state->batting_team, 2,
+                       pitcher->player_id, player->player_id);
     }
 
     if (pos == 2 && gameiter->event_data->event_type == CW_EVENT_INTERFERENCE &&
@@ -1026,8 +1159,9 @@ static void cw_box_fielder_stats(CWBoxscore *boxscore, CWGameIterator *gameiter)
   }
 
   if (gameiter->event_data->dp_flag) {
-    CWBoxEvent *event = cw_box_add_event(&(boxscore->dp_list), gameiter->state->inning,
-                                         gameiter->state->batting_team, 0);
+    CWBoxEvent *event = cw_box_new_event(boxscore, &(boxscore->dp_list), &(boxscore->dp_tail),
+                                         gameiter->state->inning, gameiter->state->batting_team,
+                                         gameiter->event_data->num_touches);
     for (i = 0; i < gameiter->event_data->num_touches; i++) {
       pos = gameiter->event_data->touches[i];
       CWBoxPlayer *player = cw_box_find_current_player(
@@ -1036,8 +1170,9 @@ static void cw_box_fielder_stats(CWBoxscore *boxscore, CWGameIterator *gameiter)
     }
   }
   else if (gameiter->event_data->tp_flag) {
-    CWBoxEvent *event = cw_box_add_event(&(boxscore->tp_list), gameiter->state->inning,
-                                         gameiter->state->batting_team, 0);
+    CWBoxEvent *event = cw_box_new_event(boxscore, &(boxscore->tp_list), &(boxscore->tp_tail),
+                                         gameiter->state->inning, gameiter->state->batting_team,
+                                         gameiter->event_data->num_touches);
     for (i = 0; i < gameiter->event_data->num_touches; i++) {
       pos = gameiter->event_data->touches[i];
       CWBoxPlayer *player = cw_box_find_current_player(
@@ -1048,49 +1183,81 @@ static void cw_box_fielder_stats(CWBoxscore *boxscore, CWGameIterator *gameiter)
 }
 
 /*
- * Iterate through the game, building the boxscore
+ * Add the statistics of the current event to the boxscore
  */
-static void cw_box_iterate_game(CWBoxscore *boxscore, CWGame *game)
+static void cw_box_event_stats(CWBoxscore *boxscore, CWGameIterator *gameiter)
 {
-  int t, lead_change = 0;
-  CWGameIterator *gameiter = cw_gameiter_create(game);
+  if (boxscore->linescore[gameiter->state->inning][gameiter->state->batting_team] < 0) {
+    boxscore->linescore[gameiter->state->inning][gameiter->state->batting_team] = 0;
+  }
+
+  cw_box_advance_inherited(boxscore, gameiter);
+  cw_box_pitch_stats(boxscore, gameiter);
+  if (strcmp(gameiter->event->event_text, "NP") != 0) {
+    cw_box_batter_stats(boxscore, gameiter);
+    cw_box_runner_stats(boxscore, gameiter);
+    cw_box_fielder_stats(boxscore, gameiter);
+    if (gameiter->event_data->dp_flag) {
+      boxscore->dp[1 - gameiter->state->batting_team]++;
+    }
+    if (gameiter->event_data->tp_flag) {
+      boxscore->tp[1 - gameiter->state->batting_team]++;
+    }
+    boxscore->linescore[gameiter->state->inning][gameiter->state->batting_team] +=
+      cw_event_runs_on_play(gameiter->event_data);
+    if (gameiter->state->score[gameiter->state->batting_team] +
+            cw_event_runs_on_play(gameiter->event_data) >
+          gameiter->state->score[1 - gameiter->state->batting_team] &&
+        gameiter->state->score[gameiter->state->batting_team] -
+            gameiter->state->score[1 - gameiter->state->batting_team] <=
+          0) {
+      boxscore->lead_change = 1;
+    }
+    else {
+      boxscore->lead_change = 0;
+    }
+  }
+}
+
+/*
+ * Apply the events from the current one on.  The iterator is left on
+ * the last event of the game, not moved past it, so that substitutions
+ * and events appended to the game later can still be applied.
+ */
+static int cw_box_apply_events(CWBoxscore *boxscore, CWGameIterator *gameiter)
+{
+  int count = 0;
 
   while (gameiter->event != NULL) {
-    if (boxscore->linescore[gameiter->state->inning][gameiter->state->batting_team] < 0) {
-      boxscore->linescore[gameiter->state->inning][gameiter->state->batting_team] = 0;
+    if (gameiter->event != boxscore->last_event) {
+      cw_box_event_stats(boxscore, gameiter);
+      boxscore->last_event = gameiter->event;
+      boxscore->last_sub = NULL;
+      count++;
     }
+    cw_box_add_substitute(boxscore, gameiter,
+                          (boxscore->last_sub != NULL) ? boxscore->last_sub->next
+                                                       : gameiter->event->first_sub);
+    boxscore->last_sub = gameiter->event->last_sub;
 
-    cw_box_pitch_stats(boxscore, gameiter);
-    if (strcmp(gameiter->event->event_text, "NP") != 0) {
-      cw_box_batter_stats(boxscore, gameiter);
-      cw_box_runner_stats(boxscore, gameiter);
-      cw_box_fielder_stats(boxscore, gameiter);
-      if (gameiter->event_data->dp_flag) {
-        boxscore->dp[1 - gameiter->state->batting_team]++;
-      }
-      if (gameiter->event_data->tp_flag) {
-        boxscore->tp[1 - gameiter->state->batting_team]++;
-      }
-      boxscore->linescore[gameiter->state->inning][gameiter->state->batting_team] +=
-        cw_event_runs_on_play(gameiter->event_data);
-      if (gameiter->state->score[gameiter->state->batting_team] +
-              cw_event_runs_on_play(gameiter->event_data) >
-            gameiter->state->score[1 - gameiter->state->batting_team] &&
-          gameiter->state->score[gameiter->state->batting_team] -
-              gameiter->state->score[1 - gameiter->state->batting_team] <=
-            0) {
-        lead_change = 1;
-      }
-      else {
-        lead_change = 0;
-      }
+    if (gameiter->event->next == NULL) {
+      break;
     }
-    cw_box_add_substitute(boxscore, gameiter);
     cw_gameiter_next(gameiter);
   }
 
+  return count;
+}
+
+/*
+ * Set the team totals from 'gameiter', which is past the last event
+ */
+static void cw_box_game_totals(CWBoxscore *boxscore, CWGameIterator *gameiter)
+{
+  int t;
+
   boxscore->outs_at_end = gameiter->state->outs;
-  boxscore->walk_off = lead_change;
+  boxscore->walk_off = boxscore->lead_change;
 
   for (t = 0; t <= 1; t++) {
     boxscore->lob[t] = (gameiter->state->num_batters[t] + gameiter->state->num_auto_runners[t] -
@@ -1099,9 +1266,21 @@ static void cw_box_iterate_game(CWBoxscore *boxscore, CWGame *game)
     boxscore->hits[t] = gameiter->state->hits[t];
     boxscore->errors[t] = gameiter->state->errors[t];
   }
+}
+
+/*
+ * Iterate through the game, building the boxscore
+ */
+static void cw_box_iterate_game(CWBoxscore *boxscore, CWGame *game)
+{
+  CWGameIterator *gameiter = cw_gameiter_create(game);
+
+  cw_box_apply_events(boxscore, gameiter);
+  cw_gameiter_next(gameiter);
+  cw_box_game_totals(boxscore, gameiter);
 
   cw_gameiter_cleanup(gameiter);
-  free(gameiter);
+  CW_FREE(gameiter);
 }
 
 /*
@@ -1167,7 +1346,7 @@ void cw_box_process_boxscore_file(CWBoxscore *boxscore, CWGame *game)
         player = cw_box_get_starter(boxscore, team, slot);
       }
       else {
-        player = cw_box_player_create(stat->data[1], "");
+        player = cw_box_player_create(boxscore, stat->data[1], "", team, slot);
         sprintf(player->date, "%c%c%c%c%c%c%c%c", date[0], date[1], date[2], date[3], date[5],
                 date[6], date[8], date[9]);
         player->batting->g = 1;
@@ -1184,26 +1363,31 @@ void cw_box_process_boxscore_file(CWBoxscore *boxscore, CWGame *game)
       boxscore->hits[team] += player->batting->h;
       player->batting->b2 = cw_data_get_item_int(stat, 8);
       for (i = 1; i <= player->batting->b2; i++) {
-        cw_box_add_event(&(boxscore->b2_list), -1, -1, 2, player->player_id, "");
+        cw_box_add_event(boxscore, &(boxscore->b2_list), &(boxscore->b2_tail), -1, -1, 2,
+                         player->player_id, "");
       }
       player->batting->b3 = cw_data_get_item_int(stat, 9);
       for (i = 1; i <= player->batting->b3; i++) {
-        cw_box_add_event(&(boxscore->b3_list), -1, -1, 2, player->player_id, "");
+        cw_box_add_event(boxscore, &(boxscore->b3_list), &(boxscore->b3_tail), -1, -1, 2,
+                         player->player_id, "");
       }
       player->batting->hr = cw_data_get_item_int(stat, 10);
       for (i = 1; i <= player->batting->hr; i++) {
-        cw_box_add_event(&(boxscore->hr_list), -1, -1, 2, player->player_id, "");
+        cw_box_add_event(boxscore, &(boxscore->hr_list), &(boxscore->hr_tail), -1, -1, 2,
+                         player->player_id, "");
       }
       player->batting->hrslam = -1;
       player->batting->bi = cw_data_get_item_int(stat, 11);
       player->batting->bi2out = -1;
       player->batting->sh = cw_data_get_item_int(stat, 12);
       for (i = 1; i <= player->batting->sh; i++) {
-        cw_box_add_event(&(boxscore->sh_list), -1, -1, 2, player->player_id, "");
+        cw_box_add_event(boxscore, &(boxscore->sh_list), &(boxscore->sh_tail), -1, -1, 2,
+                         player->player_id, "");
       }
       player->batting->sf = cw_data_get_item_int(stat, 13);
       for (i = 1; i <= player->batting->sf; i++) {
-        cw_box_add_event(&(boxscore->sf_list), -1, -1, 2, player->player_id, "");
+        cw_box_add_event(boxscore, &(boxscore->sf_list), &(boxscore->sf_tail), -1, -1, 2,
+                         player->player_id, "");
       }
       player->batting->hp = cw_data_get_item_int(stat, 14);
       player->batting->bb = cw_data_get_item_int(stat, 15);
@@ -1211,13 +1395,15 @@ void cw_box_process_boxscore_file(CWBoxscore *boxscore, CWGame *game)
       player->batting->so = cw_data_get_item_int(stat, 17);
       player->batting->sb = cw_data_get_item_int(stat, 18);
       for (i = 1; i <= player->batting->sb; i++) {
-        event = cw_box_add_event(&(boxscore->sb_list), -1, -1, 2, player->player_id, "", "");
+        event = cw_box_add_event(boxscore, &(boxscore->sb_list), &(boxscore->sb_tail), -1, -1, 2,
+                                 player->player_id, "", "");
         event->runners = -1;
         event->pickoff = -1;
       }
       player->batting->cs = cw_data_get_item_int(stat, 19);
       for (i = 1; i <= player->batting->cs; i++) {
-        event = cw_box_add_event(&(boxscore->cs_list), -1, -1, 2, player->player_id, "", "");
+        event = cw_box_add_event(boxscore, &(boxscore->cs_list), &(boxscore->cs_tail), -1, -1, 2,
+                                 player->player_id, "", "");
         event->runners = -1;
         event->pickoff = -1;
       }
@@ -1237,7 +1423,7 @@ void cw_box_process_boxscore_file(CWBoxscore *boxscore, CWGame *game)
         pitcher->pitching->gs = 1;
       }
       else {
-        pitcher = cw_box_pitcher_create(stat->data[1], "");
+        pitcher = cw_box_pitcher_create(boxscore, stat->data[1], "", team);
         boxscore->pitchers[team]->next = pitcher;
         pitcher->prev = boxscore->pitchers[team];
         boxscore->pitchers[team] = pitcher;
@@ -1287,7 +1473,7 @@ void cw_box_process_boxscore_file(CWBoxscore *boxscore, CWGame *game)
       }
       player->positions[seq - 1] = pos;
       if (player->fielding[pos] == NULL) {
-        player->fielding[pos] = cw_box_fielding_create();
+        player->fielding[pos] = cw_box_fielding_create(boxscore);
       }
       player->fielding[pos]->g = 1;
       player->fielding[pos]->outs = cw_data_get_item_int(stat, 5);
@@ -1348,7 +1534,8 @@ void cw_box_process_boxscore_file(CWBoxscore *boxscore, CWGame *game)
     if (!strcmp(stat->data[0], "dpline")) {
       team = cw_data_get_item_int(stat, 1);
       cw_box_validate_boxscore_value(game, "dpline event", "team", team, 0, 1);
-      event = cw_box_add_event(&(boxscore->dp_list), -1, 1 - team, 0);
+      event = cw_box_new_event(boxscore, &(boxscore->dp_list), &(boxscore->dp_tail), -1, 1 - team,
+                               stat->num_data - 2);
       for (i = 2; i < stat->num_data; i++) {
         event->players[i - 2] = stat->data[i];
       }
@@ -1356,7 +1543,8 @@ void cw_box_process_boxscore_file(CWBoxscore *boxscore, CWGame *game)
     else if (!strcmp(stat->data[0], "tpline")) {
       team = cw_data_get_item_int(stat, 1);
       cw_box_validate_boxscore_value(game, "tpline event", "team", team, 0, 1);
-      event = cw_box_add_event(&(boxscore->tp_list), -1, 1 - team, 0);
+      event = cw_box_new_event(boxscore, &(boxscore->tp_list), &(boxscore->tp_tail), -1, 1 - team,
+                               stat->num_data - 2);
       for (i = 2; i < stat->num_data; i++) {
         event->players[i - 2] = stat->data[i];
       }
@@ -1365,14 +1553,13 @@ void cw_box_process_boxscore_file(CWBoxscore *boxscore, CWGame *game)
 }
 
 /*
- * Compile a boxscore for game 'game'.
+ * Empty the boxscore, rewinding its memory blocks so entries for the
+ * next game reuse them.
  */
-CWBoxscore *cw_box_create(CWGame *game)
+void cw_box_reset(CWBoxscore *boxscore)
 {
   int i, t;
-  CWBoxscore *boxscore = (CWBoxscore *) malloc(sizeof(CWBoxscore));
-  CWBoxPitcher *pitcher = NULL;
-  CWBoxPlayer *batter = NULL;
+  CWBoxBlock *block;
 
   for (t = 0; t <= 1; t++) {
     for (i = 0; i <= 9; i++) {
@@ -1395,6 +1582,11 @@ CWBoxscore *cw_box_create(CWGame *game)
     boxscore->risp_h[t] = 0;
   }
 
+  for (i = 0; i < CW_BOX_INDEX_SIZE; i++) {
+    boxscore->player_index[i] = NULL;
+    boxscore->pitcher_index[i] = NULL;
+  }
+
   boxscore->outs_at_end = 0;
   boxscore->walk_off = 0;
 
@@ -1415,14 +1607,48 @@ CWBoxscore *cw_box_create(CWGame *game)
   boxscore->dp_list = NULL;
   boxscore->tp_list = NULL;
 
-  cw_box_enter_starters(boxscore, game);
-  if (game->first_event != NULL) {
-    cw_box_iterate_game(boxscore, game);
+  boxscore->b2_tail = NULL;
+  boxscore->b3_tail = NULL;
+  boxscore->hr_tail = NULL;
+  boxscore->sb_tail = NULL;
+  boxscore->cs_tail = NULL;
+  boxscore->po_tail = NULL;
+  boxscore->sh_tail = NULL;
+  boxscore->sf_tail = NULL;
+  boxscore->hp_tail = NULL;
+  boxscore->ibb_tail = NULL;
+  boxscore->wp_tail = NULL;
+  boxscore->bk_tail = NULL;
+  boxscore->pb_tail = NULL;
+  boxscore->err_tail = NULL;
+  boxscore->dp_tail = NULL;
+  boxscore->tp_tail = NULL;
+
+  boxscore->inherited = NULL;
+  boxscore->lead_change = 0;
+  boxscore->last_event = NULL;
+  boxscore->last_sub = NULL;
+  if (boxscore->gameiter != NULL) {
+    cw_gameiter_cleanup(boxscore->gameiter);
+    CW_FREE(boxscore->gameiter);
+    boxscore->gameiter = NULL;
   }
-  else {
-    /* There is no play-by-play; this is a new "boxscore event file" */
-    cw_box_process_boxscore_file(boxscore, game);
+
+  for (block = boxscore->first_block; block != NULL; block = block->next) {
+    block->used = 0;
   }
+  boxscore->current_block = boxscore->first_block;
+}
+
+/*
+ * Credit the decisions, complete games and games finished, which are
+ * known once all the events have been applied.
+ */
+static void cw_box_finish(CWBoxscore *boxscore, CWGame *game)
+{
+  int t;
+  CWBoxPitcher *pitcher = NULL;
+  CWBoxPlayer *batter = NULL;
 
   for (t = 0; t <= 1; t++) {
     if (boxscore->pitchers[t] == NULL) {
@@ -1462,55 +1688,160 @@ CWBoxscore *cw_box_create(CWGame *game)
       batter->batting->gw = 1;
     }
   }
-  return boxscore;
 }
 
 /*
- * Memory cleanup of 'boxscore'
+ * Undo cw_box_finish, before more events are applied
  */
-void cw_box_cleanup(CWBoxscore *boxscore)
+static void cw_box_unfinish(CWBoxscore *boxscore)
 {
   int i, t;
-
-  cw_box_cleanup_event_list(&(boxscore->tp_list));
-  cw_box_cleanup_event_list(&(boxscore->dp_list));
-  cw_box_cleanup_event_list(&(boxscore->pb_list));
-  cw_box_cleanup_event_list(&(boxscore->err_list));
-  cw_box_cleanup_event_list(&(boxscore->bk_list));
-  cw_box_cleanup_event_list(&(boxscore->wp_list));
-  cw_box_cleanup_event_list(&(boxscore->po_list));
-  cw_box_cleanup_event_list(&(boxscore->cs_list));
-  cw_box_cleanup_event_list(&(boxscore->sb_list));
-  cw_box_cleanup_event_list(&(boxscore->ibb_list));
-  cw_box_cleanup_event_list(&(boxscore->hp_list));
-  cw_box_cleanup_event_list(&(boxscore->sf_list));
-  cw_box_cleanup_event_list(&(boxscore->sh_list));
-  cw_box_cleanup_event_list(&(boxscore->hr_list));
-  cw_box_cleanup_event_list(&(boxscore->b3_list));
-  cw_box_cleanup_event_list(&(boxscore->b2_list));
+  CWBoxPitcher *pitcher;
+  CWBoxPlayer *player;
 
   for (t = 0; t <= 1; t++) {
-    CWBoxPitcher *pitcher = boxscore->pitchers[t];
-    while (pitcher != NULL) {
-      CWBoxPitcher *prev_pitcher = pitcher->prev;
-      cw_box_pitcher_cleanup(pitcher);
-      free(pitcher);
-      pitcher = prev_pitcher;
+    for (pitcher = boxscore->pitchers[t]; pitcher != NULL; pitcher = pitcher->prev) {
+      pitcher->pitching->cg = 0;
+      pitcher->pitching->sho = 0;
+      pitcher->pitching->gf = 0;
+      pitcher->pitching->w = 0;
+      pitcher->pitching->l = 0;
+      pitcher->pitching->sv = 0;
     }
-
     for (i = 0; i <= 9; i++) {
-      CWBoxPlayer *player = boxscore->slots[i][t];
-
-      while (player != NULL) {
-        CWBoxPlayer *prev_player = player->prev;
-        cw_box_player_cleanup(player);
-        free(player);
-        player = prev_player;
+      for (player = boxscore->slots[i][t]; player != NULL; player = player->prev) {
+        player->batting->gw = -1;
       }
+    }
+  }
+}
 
-      boxscore->slots[i][t] = NULL;
+/*
+ * Set the team totals of the attached 'boxscore' as of its last event
+ */
+static void cw_box_attached_totals(CWBoxscore *boxscore)
+{
+  CWGameIterator *gameiter;
+
+  if (boxscore->gameiter->event == NULL) {
+    /* No plays yet.  cw_box_create treats such a game as a boxscore
+     * file, which are assumed to end with the conclusion of an inning. */
+    boxscore->outs_at_end = 3;
+    return;
+  }
+
+  /* The attached iterator stays on the last event, so step a copy past it */
+  gameiter = cw_gameiter_copy(boxscore->gameiter);
+  cw_gameiter_next(gameiter);
+  cw_box_game_totals(boxscore, gameiter);
+  cw_gameiter_cleanup(gameiter);
+  CW_FREE(gameiter);
+}
+
+/*
+ * Compile a boxscore for game 'game' into 'boxscore'.
+ */
+void cw_box_rebuild(CWBoxscore *boxscore, CWGame *game)
+{
+  cw_box_reset(boxscore);
+
+  cw_box_enter_starters(boxscore, game);
+  if (game->first_event != NULL) {
+    cw_box_iterate_game(boxscore, game);
+  }
+  else {
+    /* There is no play-by-play; this is a new "boxscore event file" */
+    cw_box_process_boxscore_file(boxscore, game);
+  }
+  cw_box_finish(boxscore, game);
+}
+
+/*
+ * Compile a boxscore for game 'game'.
+ */
+CWBoxscore *cw_box_create(CWGame *game)
+{
+  CWBoxscore *boxscore = (CWBoxscore *) CW_MALLOC(sizeof(CWBoxscore));
+
+  boxscore->first_block = NULL;
+  boxscore->current_block = NULL;
+  boxscore->gameiter = NULL;
+  cw_box_rebuild(boxscore, game);
+  return boxscore;
+}
+
+/*
+ * Compile a boxscore for game 'game', keeping an iterator over its
+ * events so that events appended later can be added.
+ */
+CWBoxscore *cw_box_attach(CWGame *game)
+{
+  CWBoxscore *boxscore = (CWBoxscore *) CW_MALLOC(sizeof(CWBoxscore));
+
+  boxscore->first_block = NULL;
+  boxscore->current_block = NULL;
+  boxscore->gameiter = NULL;
+  cw_box_reset(boxscore);
+
+  cw_box_enter_starters(boxscore, game);
+  if (game->first_event == NULL && game->first_stat != NULL) {
+    /* A boxscore event file has no events to add later */
+    cw_box_process_boxscore_file(boxscore, game);
+  }
+  else {
+    boxscore->gameiter = cw_gameiter_create(game);
+    cw_box_apply_events(boxscore, boxscore->gameiter);
+    cw_box_attached_totals(boxscore);
+  }
+  cw_box_finish(boxscore, game);
+  return boxscore;
+}
+
+/*
+ * Add the events appended to an attached boxscore's game
+ */
+int cw_box_advance(CWBoxscore *boxscore)
+{
+  int count;
+  CWGameIterator *gameiter = boxscore->gameiter;
+
+  if (gameiter == NULL) {
+    return 0;
+  }
+  if (gameiter->event == NULL) {
+    if (gameiter->game->first_event == NULL) {
+      return 0;
     }
+    /* The first events have been appended since the boxscore was attached */
+    cw_gameiter_reset(gameiter);
+  }
+  else if (gameiter->event->next == NULL &&
+           gameiter->event->last_sub == boxscore->last_sub) {
+    return 0;
+  }
+
+  cw_box_unfinish(boxscore);
+  count = cw_box_apply_events(boxscore, gameiter);
+  cw_box_attached_totals(boxscore);
+  cw_box_finish(boxscore, gameiter->game);
+  return count;
+}
+
+/*
+ * Memory cleanup of 'boxscore'
+ */
+void cw_box_cleanup(CWBoxscore *boxscore)
+{
+  CWBoxBlock *block = boxscore->first_block;
+
+  cw_box_reset(boxscore);
+  while (block != NULL) {
+    CWBoxBlock *next_block = block->next;
+    CW_FREE(block);
+    block = next_block;
   }
+  boxscore->first_block = NULL;
+  boxscore->current_block = NULL;
 }
 
 CWBoxPlayer *cw_box_get_starter(CWBoxscore *boxscore, int team, int slot)
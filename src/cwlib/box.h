@@ -26,7 +26,10 @@
 #ifndef CW_BOX_H
 #define CW_BOX_H
 
+#include <stddef.h>
+
 #include "game.h"
+#include "gameiter.h"
 
 typedef struct cw_box_batting_struct {
   int g, pa, ab, r, h, b2, b3, hr, hrslam, bi, bi2out, gw, bb, ibb, so, gdp, hp, sh, sf, sb, cs,
@@ -55,7 +58,11 @@ typedef struct cw_box_player_struct {
   int positions[40];
   /* Fielding statistics per position (uses usual position numbering) */
   CWBoxFielding *fielding[10];
+  /* The team and batting order slot the entry is in */
+  int team, slot;
   struct cw_box_player_struct *prev, *next;
+  /* The next entry in the same bucket of the boxscore's player index */
+  struct cw_box_player_struct *hash_next;
 } CWBoxPlayer;
 
 typedef struct cw_box_pitching_struct {
@@ -83,22 +90,49 @@ typedef struct cw_box_pitching_struct {
 typedef struct cw_box_pitcher_struct {
   char *player_id, *name;
   CWBoxPitching *pitching;
-  struct cw_box_pitcher_struct *prev, *next;
+  int team;
+  struct cw_box_pitcher_struct *prev, *next, *hash_next;
 } CWBoxPitcher;
 
 /*
  * Data structure for storing information about notable events
  * (extra-base hits, wild pitches, etc.)
  * The 'players' entry may contain a variable number of entries,
- * depending on the type of event this is reporting.
+ * depending on the type of event this is reporting; there are
+ * 'num_players' of them, followed by a NULL.
  */
 typedef struct cw_box_event_struct {
-  char *players[20];
+  char **players;
+  int num_players;
   int inning, half_inning, runners, pickoff, outs, mark;
   char location[10];
   struct cw_box_event_struct *prev, *next;
 } CWBoxEvent;
 
+/*
+ * A block of memory from which a boxscore's entries are allocated.
+ * The entries occupy the 'size' bytes following this header, of which
+ * 'used' are in use.
+ */
+typedef struct cw_box_block_struct {
+  size_t size, used;
+  struct cw_box_block_struct *next;
+} CWBoxBlock;
+
+/*
+ * A runner on base when a pitcher entered the game, whose fate is not
+ * yet known.  The runner is followed from base to base until scoring,
+ * being put out, or the end of the half-inning.
+ */
+typedef struct cw_box_inherited_struct {
+  CWBoxPitching *pitching;
+  int base, inning, half;
+  struct cw_box_inherited_struct *next;
+} CWBoxInherited;
+
+/* The number of buckets in a boxscore's player and pitcher indexes */
+#define CW_BOX_INDEX_SIZE 64
+
 /*
  * The boxscore.
  * - 'slots' refers to batting order slots.  The pointer points to the
@@ -125,6 +159,29 @@ typedef struct cw_boxscore_struct {
   CWBoxEvent *sh_list, *sf_list, *hp_list, *ibb_list;
   CWBoxEvent *wp_list, *bk_list, *err_list, *pb_list;
   CWBoxEvent *dp_list, *tp_list;
+  /* The last event in each of the lists above, for appending */
+  CWBoxEvent *b2_tail, *b3_tail, *hr_tail, *sb_tail, *cs_tail, *po_tail;
+  CWBoxEvent *sh_tail, *sf_tail, *hp_tail, *ibb_tail;
+  CWBoxEvent *wp_tail, *bk_tail, *err_tail, *pb_tail;
+  CWBoxEvent *dp_tail, *tp_tail;
+  /* Memory for the entries above.  The blocks are kept when the boxscore
+   * is reset, and reused for the next game. */
+  CWBoxBlock *first_block, *current_block;
+  /* All player and pitcher entries, hashed on player ID, so that entries
+   * are found without walking the slots.  Within a bucket, the most
+   * recently created entry is first. */
+  CWBoxPlayer *player_index[CW_BOX_INDEX_SIZE];
+  CWBoxPitcher *pitcher_index[CW_BOX_INDEX_SIZE];
+  /* Inherited runners still on base after the last event applied */
+  CWBoxInherited *inherited;
+  /* Whether the lead changed on the last event applied */
+  int lead_change;
+  /* The last event applied, and the last of its substitutions applied */
+  CWEvent *last_event;
+  CWAppearance *last_sub;
+  /* For a boxscore attached to its game, the iterator over the game's
+   * events, which stays on the last event applied; NULL otherwise */
+  CWGameIterator *gameiter;
 } CWBoxscore;
 
 /*
@@ -132,9 +189,39 @@ typedef struct cw_boxscore_struct {
  */
 CWBoxscore *cw_box_create(CWGame *game);
 
+/*
+ * Create a boxscore from the game 'game', which stays attached to the
+ * game so that events appended to it later can be added with
+ * cw_box_advance.
+ */
+CWBoxscore *cw_box_attach(CWGame *game);
+
+/*
+ * Add to the attached boxscore 'boxscore' the events appended to its
+ * game, and the substitutions appended to its last event, since the
+ * boxscore was attached or last advanced.  Afterwards, the boxscore is
+ * the same as one created from the game with cw_box_create.
+ * Returns the number of events added.
+ */
+int cw_box_advance(CWBoxscore *boxscore);
+
+/*
+ * Empty 'boxscore', so that it has no players, pitchers or events,
+ * detaching it from its game if it is attached.
+ * The memory used by its entries is kept for reuse.
+ */
+void cw_box_reset(CWBoxscore *boxscore);
+
+/*
+ * Compile the boxscore of 'game' into 'boxscore', replacing its contents.
+ * Processing many games with one boxscore, rebuilt for each, avoids
+ * allocating memory once the boxscore has grown to fit the largest game.
+ */
+void cw_box_rebuild(CWBoxscore *boxscore, CWGame *game);
+
 /*
  * Cleans up internal memory allocation associated with 'boxscore'.
- * Caller is responsible for free()ing the boxscore itself
+ * Caller is responsible for freeing the boxscore itself with cw_free()
  */
 void cw_box_cleanup(CWBoxscore *boxscore);
 
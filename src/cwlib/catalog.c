@@ -0,0 +1,280 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/catalog.c
+ * Implementation of a catalog of the games in a set of event files
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "catalog.h"
+#include "file.h"
+#define CW_SUBSYSTEM CW_ALLOC_CATALOG
+#include "util.h"
+
+static void *cw_catalog_grow(void *array, int *max, int count, size_t size)
+{
+  if (count < *max) {
+    return array;
+  }
+  *max = (*max > 0) ? 2 * *max : 16;
+  array = CW_REALLOC(array, (size_t) *max * size);
+  if (array == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for catalog\n");
+    exit(1);
+  }
+  return array;
+}
+
+static CWCatalogFile *cw_catalog_add_file_entry(CWCatalog *catalog, char *filename)
+{
+  CWCatalogFile *file;
+
+  catalog->files = (CWCatalogFile *) cw_catalog_grow(catalog->files, &catalog->max_files,
+                                                     catalog->num_files, sizeof(CWCatalogFile));
+  file = &catalog->files[catalog->num_files++];
+  XCOPY(file->filename, filename);
+  file->first_entry = catalog->num_entries;
+  file->num_entries = 0;
+  return file;
+}
+
+/* Add an entry for a game in file number 'file', with no info values */
+static CWCatalogEntry *cw_catalog_add_entry(CWCatalog *catalog, int file, char *game_id,
+                                            long offset)
+{
+  CWCatalogEntry *entry;
+
+  catalog->entries =
+    (CWCatalogEntry *) cw_catalog_grow(catalog->entries, &catalog->max_entries,
+                                       catalog->num_entries, sizeof(CWCatalogEntry));
+  entry = &catalog->entries[catalog->num_entries++];
+  XCOPY(entry->game_id, game_id);
+  XCOPY(entry->date, "");
+  XCOPY(entry->number, "");
+  XCOPY(entry->visteam, "");
+  XCOPY(entry->hometeam, "");
+  XCOPY(entry->site, "");
+  entry->file = file;
+  entry->offset = offset;
+  if (catalog->files[file].num_entries++ == 0) {
+    catalog->files[file].first_entry = catalog->num_entries - 1;
+  }
+  return entry;
+}
+
+/* Set the entry's value for the info record 'label', if it is one kept */
+static void cw_catalog_set_info(CWCatalogEntry *entry, char *label, char *data)
+{
+  char **value = NULL;
+
+  if (!strcmp(label, "date")) {
+    value = &entry->date;
+  }
+  else if (!strcmp(label, "number")) {
+    value = &entry->number;
+  }
+  else if (!strcmp(label, "visteam")) {
+    value = &entry->visteam;
+  }
+  else if (!strcmp(label, "hometeam")) {
+    value = &entry->hometeam;
+  }
+  else if (!strcmp(label, "site")) {
+    value = &entry->site;
+  }
+  if (value != NULL) {
+    XFREE(*value);
+    XCOPY(*value, data);
+  }
+}
+
+/*
+ * Public interface
+ */
+CWCatalog *cw_catalog_create(void)
+{
+  CWCatalog *catalog = (CWCatalog *) CW_CALLOC(1, sizeof(CWCatalog));
+
+  if (catalog == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for catalog\n");
+    exit(1);
+  }
+  return catalog;
+}
+
+void cw_catalog_cleanup(CWCatalog *catalog)
+{
+  int i;
+
+  for (i = 0; i < catalog->num_entries; i++) {
+    XFREE(catalog->entries[i].game_id);
+    XFREE(catalog->entries[i].date);
+    XFREE(catalog->entries[i].number);
+    XFREE(catalog->entries[i].visteam);
+    XFREE(catalog->entries[i].hometeam);
+    XFREE(catalog->entries[i].site);
+  }
+  XFREE(catalog->entries);
+  catalog->num_entries = catalog->max_entries = 0;
+  for (i = 0; i < catalog->num_files; i++) {
+    XFREE(catalog->files[i].filename);
+  }
+  XFREE(catalog->files);
+  catalog->num_files = catalog->max_files = 0;
+}
+
+int cw_catalog_add_file(CWCatalog *catalog, char *filename)
+{
+  FILE *file = fopen(filename, "r");
+  CWRecordReader r;
+  CWTokenizer tok;
+  CWCatalogEntry *entry = NULL;
+  long offset;
+  int number;
+
+  if (file == NULL) {
+    return -1;
+  }
+  number = (int) (cw_catalog_add_file_entry(catalog, filename) - catalog->files);
+
+  cw_record_reader_init(&r, file);
+  while ((offset = ftell(file)) >= 0 && cw_record_reader_next(&r) == 1) {
+    char *tag, *label, *data;
+
+    cw_tokenizer_init(&tok, (char *) cw_record_reader_line(&r));
+    tag = cw_tokenizer_next(&tok);
+    if (tag == NULL) {
+      continue;
+    }
+    if (!strcmp(tag, "id")) {
+      char *game_id = cw_tokenizer_next(&tok);
+
+      entry = (game_id != NULL) ? cw_catalog_add_entry(catalog, number, game_id, offset) : NULL;
+    }
+    else if (!strcmp(tag, "info") && entry != NULL) {
+      label = cw_tokenizer_next(&tok);
+      data = cw_tokenizer_next(&tok);
+      if (label != NULL) {
+        cw_catalog_set_info(entry, label, (data != NULL) ? data : "");
+      }
+    }
+  }
+  cw_record_reader_cleanup(&r);
+  fclose(file);
+  return catalog->files[number].num_entries;
+}
+
+CWCatalogFile *cw_catalog_find_file(CWCatalog *catalog, char *filename)
+{
+  int i;
+
+  for (i = 0; i < catalog->num_files; i++) {
+    if (!strcmp(catalog->files[i].filename, filename)) {
+      return &catalog->files[i];
+    }
+  }
+  return NULL;
+}
+
+CWGame *cw_catalog_read_game(CWCatalogEntry *entry, FILE *file)
+{
+  CWGame *game;
+
+  if (fseek(file, entry->offset, SEEK_SET) != 0) {
+    return NULL;
+  }
+  game = cw_game_read(file);
+  if (game != NULL && strcmp(game->game_id, entry->game_id) != 0) {
+    cw_game_cleanup(game);
+    CW_FREE(game);
+    return NULL;
+  }
+  return game;
+}
+
+void cw_catalog_write(CWCatalog *catalog, FILE *file)
+{
+  int i;
+
+  fprintf(file, "catalog,1\n");
+  for (i = 0; i < catalog->num_files; i++) {
+    fprintf(file, "file,\"%s\"\n", catalog->files[i].filename);
+  }
+  for (i = 0; i < catalog->num_entries; i++) {
+    CWCatalogEntry *entry = &catalog->entries[i];
+
+    fprintf(file, "game,\"%s\",\"%s\",\"%s\",\"%s\",\"%s\",\"%s\",%d,%ld\n", entry->game_id,
+            entry->date, entry->number, entry->visteam, entry->hometeam, entry->site, entry->file,
+            entry->offset);
+  }
+}
+
+int cw_catalog_read(CWCatalog *catalog, FILE *file)
+{
+  CWRecordReader r;
+  CWTokenizer tok;
+  char *tag, *tokens[8];
+  int i, result = -1, first = 1;
+
+  cw_record_reader_init(&r, file);
+  while (cw_record_reader_next(&r) == 1) {
+    cw_tokenizer_init(&tok, (char *) cw_record_reader_line(&r));
+    tag = cw_tokenizer_next(&tok);
+    for (i = 0; i < 8; i++) {
+      tokens[i] = (tag != NULL) ? cw_tokenizer_next(&tok) : NULL;
+    }
+    if (tag == NULL) {
+      continue;
+    }
+
+    if (first) {
+      if (strcmp(tag, "catalog") != 0 || tokens[0] == NULL || strcmp(tokens[0], "1") != 0) {
+        break;
+      }
+      first = 0;
+      result = 0;
+    }
+    else if (!strcmp(tag, "file") && tokens[0] != NULL) {
+      cw_catalog_add_file_entry(catalog, tokens[0]);
+    }
+    else if (!strcmp(tag, "game") && tokens[7] != NULL) {
+      int number = cw_atoi(tokens[6], NULL);
+      CWCatalogEntry *entry;
+
+      /* Games are written in the order of their files, so each belongs
+       * to the last file with a game so far, or a later one */
+      if (number < 0 || number >= catalog->num_files ||
+          (catalog->num_entries > 0 &&
+           number < catalog->entries[catalog->num_entries - 1].file)) {
+        continue;
+      }
+      entry = cw_catalog_add_entry(catalog, number, tokens[0], strtol(tokens[7], NULL, 10));
+      cw_catalog_set_info(entry, "date", tokens[1]);
+      cw_catalog_set_info(entry, "number", tokens[2]);
+      cw_catalog_set_info(entry, "visteam", tokens[3]);
+      cw_catalog_set_info(entry, "hometeam", tokens[4]);
+      cw_catalog_set_info(entry, "site", tokens[5]);
+    }
+  }
+  cw_record_reader_cleanup(&r);
+  return result;
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/catalog.h
+ * Declaration of a catalog of the games in a set of event files
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef CW_CATALOG_H
+#define CW_CATALOG_H
+
+#include <stdio.h>
+
+#include "game.h"
+
+/*
+ * A game in the catalog, with the values of its 'info' records for
+ * date, number (of a doubleheader), visiting and home teams, and site.
+ * Values missing from the game are empty strings.  'offset' is that of
+ * the game's 'id' record in its file.
+ */
+typedef struct cw_catalog_entry_struct {
+  char *game_id, *date, *number, *visteam, *hometeam, *site;
+  int file;
+  long offset;
+} CWCatalogEntry;
+
+/*
+ * A file in the catalog: its games are 'num_entries' consecutive
+ * entries of the catalog, in the order of the file.
+ */
+typedef struct cw_catalog_file_struct {
+  char *filename;
+  int first_entry, num_entries;
+} CWCatalogFile;
+
+typedef struct cw_catalog_struct {
+  CWCatalogFile *files;
+  int num_files, max_files;
+  CWCatalogEntry *entries;
+  int num_entries, max_entries;
+} CWCatalog;
+
+/*
+ * Allocates and initializes a new CWCatalog, with no files.
+ * Caller is responsible for memory management of the created pointer.
+ */
+CWCatalog *cw_catalog_create(void);
+
+/*
+ * Cleans up internal memory allocation associated with 'catalog'.
+ * Caller is responsible for freeing the catalog itself with cw_free().
+ */
+void cw_catalog_cleanup(CWCatalog *catalog);
+
+/*
+ * Adds the games in the event file 'filename' to the catalog.  Only
+ * 'id' and 'info' records are examined; games are not parsed.  The name
+ * is kept as given.  Returns the number of games added, or -1 if the
+ * file could not be read.
+ */
+int cw_catalog_add_file(CWCatalog *catalog, char *filename);
+
+/*
+ * Finds the file 'filename' (as given when it was added) in the
+ * catalog; returns NULL if it is not there.
+ */
+CWCatalogFile *cw_catalog_find_file(CWCatalog *catalog, char *filename);
+
+/*
+ * Reads the game for 'entry' from 'file', the event file it is in,
+ * seeking directly to it.  Returns NULL if the game there is not the
+ * one catalogued, as when the file has changed since.
+ * Caller is responsible for memory management of the returned game.
+ */
+CWGame *cw_catalog_read_game(CWCatalogEntry *entry, FILE *file);
+
+/*
+ * Writes the catalog to 'file'.
+ */
+void cw_catalog_write(CWCatalog *catalog, FILE *file);
+
+/*
+ * Reads a catalog written by cw_catalog_write() from 'file' into
+ * 'catalog', which should be empty.  Returns 0 on success, or -1 if the
+ * file is not a catalog.
+ */
+int cw_catalog_read(CWCatalog *catalog, FILE *file);
+
+#endif /* CW_CATALOG_H */
@@ -24,6 +24,29 @@
 #ifndef CW_CHADWICK_H
 #define CW_CHADWICK_H
 
+/*
+ * Thread safety
+ *
+ * The library keeps no state between calls except in the objects it is
+ * passed, and may be used from many threads at once, subject to these
+ * rules:
+ *
+ * - An object (scorebook, game, iterator, boxscore, roster, league,
+ *   season, and so on) may be changed by only one thread at a time,
+ *   and not while other threads use it.  Objects which are not being
+ *   changed may be used by any number of threads at once: many threads
+ *   may iterate over, and compile boxscores of, the same games, since
+ *   neither changes the game.  Reading a game from a file changes the
+ *   file's position, so a FILE should be read by one thread at a time.
+ *
+ * - The allocator (cw_alloc_set_allocator()) and allocation counting
+ *   (cw_alloc_set_counting()) are set for the whole process, and should
+ *   be set before starting threads which use the library.
+ *
+ * - The counters cw_stats and cw_alloc_counts are kept for each thread,
+ *   and count only the work of the thread reading them.
+ */
+
 #include "file.h"
 #include "game.h"
 #include "book.h"
@@ -32,5 +55,13 @@
 #include "parse.h"
 #include "gameiter.h"
 #include "box.h"
+#include "season.h"
+#include "split.h"
+#include "expect.h"
+#include "index.h"
+#include "catalog.h"
+#include "remap.h"
+#include "stats.h"
+#include "alloc.h"
 
 #endif /* CW_CHADWICK_H */
@@ -0,0 +1,195 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/expect.c
+ * Implementation of run and win expectancy tables accumulated from play-by-play
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "expect.h"
+#define CW_SUBSYSTEM CW_ALLOC_EXPECT
+#include "util.h"
+
+/*
+ * Make room for at least 'num_events' events of the current game.
+ */
+static void cw_expect_reserve(CWExpectancy *expect, int num_events)
+{
+  int max_events = (expect->max_events > 0) ? expect->max_events : 128;
+
+  if (num_events <= expect->max_events) {
+    return;
+  }
+  while (max_events < num_events) {
+    max_events *= 2;
+  }
+  expect->event_states =
+    (int *) CW_REALLOC(expect->event_states, (size_t) max_events * sizeof(int));
+  expect->event_runs = (int *) CW_REALLOC(expect->event_runs, (size_t) max_events * sizeof(int));
+  expect->event_wins = (int *) CW_REALLOC(expect->event_wins, (size_t) max_events * sizeof(int));
+  if (expect->event_states == NULL || expect->event_runs == NULL ||
+      expect->event_wins == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for expectancy tables\n");
+    exit(1);
+  }
+  expect->max_events = max_events;
+}
+
+/*
+ * Record the state at the start of the current event as event 'n' of
+ * the game: its base-out state, runs on the play, and the cell of the
+ * win expectancy table it counts in once the winner is known.
+ */
+static void cw_expect_record_event(CWExpectancy *expect, CWGameIterator *gameiter, int n)
+{
+  CWGameState *state = gameiter->state;
+  int bases = 0, base, inning, lead;
+
+  for (base = 1; base <= 3; base++) {
+    if (cw_gamestate_base_occupied(state, base)) {
+      bases |= 1 << (base - 1);
+    }
+  }
+  inning = (state->inning < CW_EXPECT_INNINGS) ? state->inning : CW_EXPECT_INNINGS;
+  lead = state->score[1] - state->score[0];
+  if (lead > CW_EXPECT_MAX_LEAD) {
+    lead = CW_EXPECT_MAX_LEAD;
+  }
+  else if (lead < -CW_EXPECT_MAX_LEAD) {
+    lead = -CW_EXPECT_MAX_LEAD;
+  }
+
+  expect->event_states[n] = 3 * bases + ((state->outs < 2) ? state->outs : 2);
+  expect->event_runs[n] = cw_event_runs_on_play(gameiter->event_data);
+  expect->event_wins[n] =
+    (((inning - 1) * 2 + state->batting_team) * CW_EXPECT_LEADS + lead + CW_EXPECT_MAX_LEAD) *
+      CW_EXPECT_BASE_OUT_STATES +
+    expect->event_states[n];
+}
+
+/*
+ * Count the events 'first' through 'last' of the game, which make up a
+ * half-inning, in the run expectancy table.  Runs to the end of the
+ * half-inning are summed from the last event back.
+ */
+static void cw_expect_add_half_inning(CWExpectancy *expect, int first, int last)
+{
+  int i, runs = 0;
+
+  for (i = last; i >= first; i--) {
+    CWExpectRuns *cell = &expect->runs[expect->event_states[i]];
+
+    runs += expect->event_runs[i];
+    cell->events++;
+    cell->runs += runs;
+    cell->scored += (runs > 0);
+  }
+}
+
+/*
+ * Public interface
+ */
+CWExpectancy *cw_expect_create(void)
+{
+  CWExpectancy *expect = (CWExpectancy *) CW_CALLOC(1, sizeof(CWExpectancy));
+
+  if (expect == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for expectancy tables\n");
+    exit(1);
+  }
+  return expect;
+}
+
+void cw_expect_cleanup(CWExpectancy *expect)
+{
+  if (expect->event_states != NULL) {
+    CW_FREE(expect->event_states);
+    expect->event_states = NULL;
+  }
+  if (expect->event_runs != NULL) {
+    CW_FREE(expect->event_runs);
+    expect->event_runs = NULL;
+  }
+  if (expect->event_wins != NULL) {
+    CW_FREE(expect->event_wins);
+    expect->event_wins = NULL;
+  }
+  expect->max_events = 0;
+}
+
+void cw_expect_add_game(CWExpectancy *expect, CWGame *game)
+{
+  CWGameIterator *gameiter = cw_gameiter_create(game);
+  CWExpectWins *wins = &expect->wins[0][0][0][0];
+  int num_events = 0, half_start = 0, half_outs = 0, i, winner;
+
+  while (gameiter->event != NULL) {
+    CWGameState *state = gameiter->state;
+    int inning = state->inning, batting_team = state->batting_team;
+
+    if (strcmp(gameiter->event->event_text, "NP") != 0) {
+      cw_expect_reserve(expect, num_events + 1);
+      cw_expect_record_event(expect, gameiter, num_events++);
+      half_outs = state->outs + cw_event_outs_on_play(gameiter->event_data);
+    }
+
+    cw_gameiter_next(gameiter);
+    if ((gameiter->event == NULL || state->inning != inning ||
+         state->batting_team != batting_team) &&
+        num_events > half_start) {
+      if (half_outs >= 3) {
+        cw_expect_add_half_inning(expect, half_start, num_events - 1);
+      }
+      half_start = num_events;
+    }
+  }
+
+  if (gameiter->state->score[1] != gameiter->state->score[0]) {
+    winner = (gameiter->state->score[1] > gameiter->state->score[0]);
+    for (i = 0; i < num_events; i++) {
+      wins[expect->event_wins[i]].events++;
+      wins[expect->event_wins[i]].wins += winner;
+    }
+  }
+
+  cw_gameiter_cleanup(gameiter);
+  CW_FREE(gameiter);
+  expect->num_games++;
+}
+
+void cw_expect_merge(CWExpectancy *expect, CWExpectancy *partial)
+{
+  CWExpectWins *wins = &expect->wins[0][0][0][0];
+  CWExpectWins *partial_wins = &partial->wins[0][0][0][0];
+  int i;
+
+  for (i = 0; i < CW_EXPECT_BASE_OUT_STATES; i++) {
+    expect->runs[i].events += partial->runs[i].events;
+    expect->runs[i].runs += partial->runs[i].runs;
+    expect->runs[i].scored += partial->runs[i].scored;
+  }
+  for (i = 0; i < (int) (sizeof(expect->wins) / sizeof(CWExpectWins)); i++) {
+    wins[i].events += partial_wins[i].events;
+    wins[i].wins += partial_wins[i].wins;
+  }
+  expect->num_games += partial->num_games;
+}
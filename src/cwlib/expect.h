@@ -0,0 +1,102 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/expect.h
+ * Declaration of run and win expectancy tables accumulated from play-by-play
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef CW_EXPECT_H
+#define CW_EXPECT_H
+
+#include "gameiter.h"
+
+/*
+ * Base-out states are numbered 3 * bases + outs, where bases has 1 for
+ * a runner on first, 2 for second and 4 for third.
+ */
+#define CW_EXPECT_BASE_OUT_STATES 24
+
+/*
+ * Win expectancy is kept by inning (the last counting all extra
+ * innings together), half-inning, and the home team's lead (with leads
+ * of CW_EXPECT_MAX_LEAD runs or more, either way, counted together).
+ */
+#define CW_EXPECT_INNINGS 10
+#define CW_EXPECT_MAX_LEAD 10
+#define CW_EXPECT_LEADS (2 * CW_EXPECT_MAX_LEAD + 1)
+
+/*
+ * The times a base-out state was seen at the start of an event, with
+ * the runs scored from then to the end of the half-inning, and the
+ * times at least one run scored.  Only half-innings completed with
+ * three outs are counted.
+ */
+typedef struct cw_expect_runs_struct {
+  int events, runs, scored;
+} CWExpectRuns;
+
+/*
+ * The times a state was seen at the start of an event, and the times
+ * the home team went on to win.  Only games which end with a winner
+ * are counted.
+ */
+typedef struct cw_expect_wins_struct {
+  int events, wins;
+} CWExpectWins;
+
+/*
+ * Run and win expectancy tables over the games added.  Events are all
+ * events of the games except NP.
+ */
+typedef struct cw_expectancy_struct {
+  CWExpectRuns runs[CW_EXPECT_BASE_OUT_STATES];
+  CWExpectWins wins[CW_EXPECT_INNINGS][2][CW_EXPECT_LEADS][CW_EXPECT_BASE_OUT_STATES];
+  int num_games;
+  /* Base-out states, runs on play, and win expectancy cells of the
+   * events of the game being added; kept between games for reuse */
+  int *event_states, *event_runs, *event_wins, max_events;
+} CWExpectancy;
+
+/*
+ * Allocates and initializes a new CWExpectancy, with no games.
+ * Caller is responsible for memory management of the created pointer.
+ */
+CWExpectancy *cw_expect_create(void);
+
+/*
+ * Cleans up internal memory allocation associated with 'expect'.
+ * Caller is responsible for freeing the tables themselves with cw_free().
+ */
+void cw_expect_cleanup(CWExpectancy *expect);
+
+/*
+ * Add the events of 'game' to the tables, in one pass through the game.
+ * Games without play-by-play add nothing.
+ */
+void cw_expect_add_game(CWExpectancy *expect, CWGame *game);
+
+/*
+ * Add the tables in 'partial' to those in 'expect'.  The two must have
+ * been accumulated from different games; for instance, tables kept
+ * separately for each part of a set of files, possibly in different
+ * threads, can be merged at the end.  'partial' is unchanged.
+ */
+void cw_expect_merge(CWExpectancy *expect, CWExpectancy *partial);
+
+#endif /* CW_EXPECT_H */
@@ -29,6 +29,9 @@
 #include <limits.h>
 
 #include "file.h"
+#include "stats.h"
+#define CW_SUBSYSTEM CW_ALLOC_FILE
+#include "util.h"
 
 /*
  * Internal helper: A portable version of `getline`.
@@ -37,19 +40,20 @@ static ssize_t cw_getline(char **line, size_t *cap, FILE *fp)
 {
   if (*line == NULL || *cap == 0) {
     *cap = 256;
-    *line = malloc(*cap);
+    *line = CW_MALLOC(*cap);
     if (!*line) {
       return -1;
     }
   }
 
-  size_t len = 0;
+  size_t len = 0, consumed = 0;
   int c;
 
   while ((c = fgetc(fp)) != EOF) {
+    consumed++;
     if (len + 1 >= *cap) {
       size_t newcap = *cap * 2;
-      char *tmp = realloc(*line, newcap);
+      char *tmp = CW_REALLOC(*line, newcap);
       if (!tmp) {
         return -1;
       }
@@ -65,6 +69,7 @@ static ssize_t cw_getline(char **line, size_t *cap, FILE *fp)
     }
   }
 
+  cw_stats.bytes_read += (long long) consumed;
   if (c == EOF && len == 0) {
     return -1;
   }
@@ -82,7 +87,7 @@ void cw_record_reader_init(CWRecordReader *r, FILE *fp)
 
 void cw_record_reader_cleanup(CWRecordReader *r)
 {
-  free(r->line);
+  CW_FREE(r->line);
   r->line = NULL;
   r->capacity = 0;
 }
@@ -155,6 +160,31 @@ char *cw_tokenizer_next(CWTokenizer *t)
   return start;
 }
 
+/*
+ * A reentrant strtok(): the position reached is kept in '*state'
+ */
+char *cw_strtok(char *text, const char *delimiters, char **state)
+{
+  char *start = (text != NULL) ? text : *state;
+
+  if (start == NULL) {
+    return NULL;
+  }
+  start += strspn(start, delimiters);
+  if (*start == '\0') {
+    *state = NULL;
+    return NULL;
+  }
+  *state = start + strcspn(start, delimiters);
+  if (**state != '\0') {
+    *(*state)++ = '\0';
+  }
+  else {
+    *state = NULL;
+  }
+  return start;
+}
+
 /*
  * This replacement for atoi() does validity checking on the input,
  * and returns -1 (which is used by Retrosheet as the null value)
@@ -242,3 +272,52 @@ int cw_file_find_first_game(FILE *file)
   cw_record_reader_cleanup(&r);
   return 0;
 }
+
+/*
+ * Whether the record starting 'line' ends a game: it is blank, or its
+ * tag is 'id'.  Only the start of the record is examined.
+ */
+static int cw_file_ends_game(char *line)
+{
+  char *s = line;
+
+  while (*s == ' ' || *s == '\t') {
+    s++;
+  }
+  if (*s == '\r' || *s == '\n' || *s == '\0') {
+    return 1;
+  }
+  if (!strncmp(s, "\"id\"", 4)) {
+    s += 4;
+  }
+  else if (!strncmp(s, "id", 2)) {
+    s += 2;
+  }
+  else {
+    return 0;
+  }
+  return (*s == ',' || *s == '\r' || *s == '\n' || *s == '\0');
+}
+
+int cw_file_skip_game(FILE *file)
+{
+  char buffer[1024];
+  fpos_t filepos;
+  int line_start = 1;
+
+  while (1) {
+    if (line_start) {
+      fgetpos(file, &filepos);
+    }
+    if (fgets(buffer, sizeof(buffer), file) == NULL) {
+      return 0;
+    }
+    if (line_start && cw_file_ends_game(buffer)) {
+      fsetpos(file, &filepos);
+      return 1;
+    }
+    cw_stats.bytes_read += (long long) strlen(buffer);
+    /* A record longer than the buffer is read in pieces */
+    line_start = (strchr(buffer, '\n') != NULL);
+  }
+}
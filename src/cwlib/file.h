@@ -73,6 +73,15 @@ void cw_tokenizer_init(CWTokenizer *t, char *line);
  */
 char *cw_tokenizer_next(CWTokenizer *t);
 
+/*
+ * A reentrant version of the standard C `strtok`, for splitting text
+ * such as comments on 'delimiters': runs of delimiters are skipped, so
+ * no token is empty.  Pass 'text' on the first call and NULL after; the
+ * position reached is kept in '*state' rather than in static storage.
+ * Mutates the provided buffer.
+ */
+char *cw_strtok(char *text, const char *delimiters, char **state);
+
 /*
  * A replacement for C atoi(), which does validity checking and returns
  * -1 as the "null" value for invalid inputs.
@@ -93,4 +102,12 @@ int cw_file_find_game(char *game_id, FILE *file);
  */
 int cw_file_find_first_game(FILE *file);
 
+/*
+ * Skips the rest of the current game in 'file' without parsing its
+ * records; sets the file pointer to the next 'id' record, or to the
+ * next blank record, which ends the games of a file as for
+ * cw_game_read().  Returns nonzero if such a record is found.
+ */
+int cw_file_skip_game(FILE *file);
+
 #endif /* CW_FILE_H */
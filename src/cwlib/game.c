@@ -26,9 +26,11 @@ press *
 #include <string.h>
 #include <ctype.h>
 
+#define CW_SUBSYSTEM CW_ALLOC_GAME
 #include "util.h"
 #include "game.h"
 #include "file.h"
+#include "stats.h"
 
 int cw_data_get_item_int(CWData *data, unsigned int index)
 {
@@ -40,12 +42,13 @@ int cw_data_get_item_int(CWData *data, unsigned int index)
 
 CWGame *cw_game_create(char *game_id)
 {
-  CWGame *game = (CWGame *) malloc(sizeof(CWGame));
+  CWGame *game = (CWGame *) CW_MALLOC(sizeof(CWGame));
 
   XCOPY(game->game_id, game_id)
   game->version = NULL;
   game->first_info = NULL;
   game->last_info = NULL;
+  memset(game->info_slots, 0, sizeof(game->info_slots));
   game->first_starter = NULL;
   game->last_starter = NULL;
   game->first_event = NULL;
@@ -74,14 +77,15 @@ static void cw_game_cleanup_tags(CWGame *game)
   CWInfo *info = game->first_info;
   while (info != NULL) {
     CWInfo *next_info = info->next;
-    free(info->label);
-    free(info->data);
-    free(info);
+    CW_FREE(info->label);
+    CW_FREE(info->data);
+    CW_FREE(info);
     info = next_info;
   }
 
   game->first_info = NULL;
   game->last_info = NULL;
+  memset(game->info_slots, 0, sizeof(game->info_slots));
 }
 
 /*
@@ -93,9 +97,9 @@ static void cw_game_cleanup_starters(CWGame *game)
 
   while (starter != NULL) {
     CWAppearance *next_starter = starter->next;
-    free(starter->player_id);
-    free(starter->name);
-    free(starter);
+    CW_FREE(starter->player_id);
+    CW_FREE(starter->name);
+    CW_FREE(starter);
     starter = next_starter;
   }
 
@@ -124,29 +128,29 @@ static void cw_game_cleanup_events(CWGame *game, CWEvent *event)
     CWEvent *next_event = event->next;
     CWAppearance *sub = event->first_sub;
     CWComment *comment = event->first_comment;
-    free(event->batter);
-    free(event->count);
-    free(event->pitches);
-    free(event->event_text);
+    CW_FREE(event->batter);
+    CW_FREE(event->count);
+    CW_FREE(event->pitches);
+    CW_FREE(event->event_text);
     if (event->pitcher_hand_id) {
-      free(event->pitcher_hand_id);
+      CW_FREE(event->pitcher_hand_id);
     }
     if (event->auto_runner_id) {
-      free(event->auto_runner_id);
+      CW_FREE(event->auto_runner_id);
     }
     for (i = 1; i <= 3; i++) {
       XFREE(event->presadj[i])
     }
     while (sub != NULL) {
       CWAppearance *next_sub = sub->next;
-      free(sub->player_id);
-      free(sub->name);
-      free(sub);
+      CW_FREE(sub->player_id);
+      CW_FREE(sub->name);
+      CW_FREE(sub);
       sub = next_sub;
     }
     while (comment != NULL) {
       CWComment *next_comment = comment->next;
-      free(comment->text);
+      CW_FREE(comment->text);
       XFREE(comment->ejection.person_id)
       XFREE(comment->ejection.person_role)
       XFREE(comment->ejection.umpire_id)
@@ -154,10 +158,10 @@ static void cw_game_cleanup_events(CWGame *game, CWEvent *event)
       XFREE(comment->umpchange.inning)
       XFREE(comment->umpchange.position)
       XFREE(comment->umpchange.person_id)
-      free(comment);
+      CW_FREE(comment);
       comment = next_comment;
     }
-    free(event);
+    CW_FREE(event);
     event = next_event;
   }
 }
@@ -172,9 +176,10 @@ static void cw_game_cleanup_data(CWGame *game)
     int i;
     CWData *next_data = data->next;
 
-    for (i = 0; i < data->num_data; free(data->data[i++]))
+    for (i = 0; i < data->num_data; CW_FREE(data->data[i++]))
       ;
-    free(data->data);
+    CW_FREE(data->data);
+    CW_FREE(data);
     data = next_data;
   }
 
@@ -192,9 +197,10 @@ static void cw_game_cleanup_stat(CWGame *game)
     int i;
     CWData *next_data = data->next;
 
-    for (i = 0; i < data->num_data; free(data->data[i++]))
+    for (i = 0; i < data->num_data; CW_FREE(data->data[i++]))
       ;
-    free(data->data);
+    CW_FREE(data->data);
+    CW_FREE(data);
     data = next_data;
   }
 
@@ -212,9 +218,10 @@ static void cw_game_cleanup_evdata(CWGame *game)
     int i;
     CWData *next_data = data->next;
 
-    for (i = 0; i < data->num_data; free(data->data[i++]))
+    for (i = 0; i < data->num_data; CW_FREE(data->data[i++]))
       ;
-    free(data->data);
+    CW_FREE(data->data);
+    CW_FREE(data);
     data = next_data;
   }
 
@@ -232,9 +239,10 @@ static void cw_game_cleanup_line(CWGame *game)
     int i;
     CWData *next_data = data->next;
 
-    for (i = 0; i < data->num_data; free(data->data[i++]))
+    for (i = 0; i < data->num_data; CW_FREE(data->data[i++]))
       ;
-    free(data->data);
+    CW_FREE(data->data);
+    CW_FREE(data);
     data = next_data;
   }
 
@@ -255,9 +263,9 @@ void cw_game_cleanup(CWGame *game)
   cw_game_cleanup_line(game);
   cw_game_cleanup_evdata(game);
 
-  free(game->version);
+  CW_FREE(game->version);
   game->version = NULL;
-  free(game->game_id);
+  CW_FREE(game->game_id);
   game->game_id = NULL;
 }
 
@@ -266,9 +274,48 @@ void cw_game_set_version(CWGame *game, char *version)
   XCOPY(game->version, version)
 }
 
+/*
+ * The standard info labels, whose records are kept in a game's
+ * info_slots; the order is that of strcmp(), for binary search.
+ */
+static const char *const cw_game_info_labels[CW_GAME_INFO_SLOTS] = {
+  "attendance",    "date",       "daynight",   "edittime",  "fieldcond", "gametype",
+  "gwrbi",         "hometeam",   "howentered", "howscored", "htbf",      "innings",
+  "inputprogvers", "inputter",   "inputtime",  "league",    "level",     "lp",
+  "number",        "oscorer",    "pitches",    "precip",    "publisher", "save",
+  "scorer",        "season",     "site",       "sky",       "starttime", "temp",
+  "tiebreaker",    "timeofgame", "translator", "ump1b",     "ump2b",     "ump3b",
+  "umphome",       "umplf",      "umprf",      "usedh",     "visteam",   "winddir",
+  "windspeed",     "wp"
+};
+
+/* The slot for 'label', or -1 if it is not a standard label */
+static int cw_game_info_slot(const char *label)
+{
+  int low = 0, high = CW_GAME_INFO_SLOTS - 1;
+
+  while (low <= high) {
+    int middle = (low + high) / 2;
+    int result = strcmp(label, cw_game_info_labels[middle]);
+
+    if (result == 0) {
+      return middle;
+    }
+    else if (result < 0) {
+      high = middle - 1;
+    }
+    else {
+      low = middle + 1;
+    }
+  }
+  return -1;
+}
+
 void cw_game_info_append(CWGame *game, char *label, char *data)
 {
-  CWInfo *info = (CWInfo *) malloc(sizeof(CWInfo));
+  CWInfo *info = (CWInfo *) CW_MALLOC(sizeof(CWInfo));
+  int slot = cw_game_info_slot(label);
+
   XCOPY(info->label, label)
   XCOPY(info->data, data)
   info->prev = game->last_info;
@@ -281,6 +328,9 @@ void cw_game_info_append(CWGame *game, char *label, char *data)
     game->last_info->next = info;
   }
   game->last_info = info;
+  if (slot >= 0) {
+    game->info_slots[slot] = info;
+  }
 }
 
 void cw_game_info_set(CWGame *game, char *label, char *data)
@@ -289,7 +339,7 @@ void cw_game_info_set(CWGame *game, char *label, char *data)
 
   while (info != NULL) {
     if (!strcmp(info->label, label)) {
-      free(info->data);
+      CW_FREE(info->data);
       XCOPY(info->data, data)
       return;
     }
@@ -313,6 +363,11 @@ void cw_game_info_set(CWGame *game, char *label, char *data)
 char *cw_game_info_lookup(CWGame *game, char *label)
 {
   CWInfo *info;
+  int slot = cw_game_info_slot(label);
+
+  if (slot >= 0) {
+    return (game->info_slots[slot] != NULL) ? game->info_slots[slot]->data : NULL;
+  }
   for (info = game->last_info; info; info = info->prev) {
     if (!strcmp(info->label, label)) {
       return info->data;
@@ -324,7 +379,7 @@ char *cw_game_info_lookup(CWGame *game, char *label)
 
 void cw_game_starter_append(CWGame *game, char *player_id, char *name, int team, int slot, int pos)
 {
-  CWAppearance *starter = (CWAppearance *) malloc(sizeof(CWAppearance));
+  CWAppearance *starter = (CWAppearance *) CW_MALLOC(sizeof(CWAppearance));
   XCOPY(starter->player_id, player_id)
   XCOPY(starter->name, name)
   starter->team = team;
@@ -371,7 +426,7 @@ CWAppearance *cw_game_starter_find_by_position(CWGame *game, int team, int pos)
 void cw_game_event_append(CWGame *game, int inning, int batting_team, char *batter, char *count,
                           char *pitches, char *event_text)
 {
-  CWEvent *event = (CWEvent *) malloc(sizeof(CWEvent));
+  CWEvent *event = (CWEvent *) CW_MALLOC(sizeof(CWEvent));
   event->inning = inning;
   event->batting_team = batting_team;
   XCOPY(event->batter, batter)
@@ -413,7 +468,7 @@ void cw_game_truncate(CWGame *game, CWEvent *event)
 void cw_game_substitute_append(CWGame *game, char *player_id, char *name, int team, int slot,
                                int pos)
 {
-  CWAppearance *sub = (CWAppearance *) malloc(sizeof(CWAppearance));
+  CWAppearance *sub = (CWAppearance *) CW_MALLOC(sizeof(CWAppearance));
   XCOPY(sub->player_id, player_id)
   XCOPY(sub->name, name)
   sub->team = team;
@@ -433,10 +488,10 @@ void cw_game_substitute_append(CWGame *game, char *player_id, char *name, int te
 void cw_game_data_append(CWGame *game, int num_data, char **data)
 {
   int i;
-  CWData *d = (CWData *) malloc(sizeof(CWData));
+  CWData *d = (CWData *) CW_MALLOC(sizeof(CWData));
 
   d->num_data = num_data;
-  d->data = (char **) malloc(sizeof(char *) * num_data);
+  d->data = (char **) CW_MALLOC(sizeof(char *) * num_data);
   d->next = NULL;
 
   for (i = 0; i < num_data; i++) {
@@ -461,8 +516,8 @@ void cw_game_data_set_er(CWGame *game, char *playerID, int er)
 
   while (data != NULL) {
     if (data->num_data >= 3 && !strcmp(data->data[0], "er") && !strcmp(data->data[1], playerID)) {
-      free(data->data[2]);
-      data->data[2] = (char *) malloc(10 * sizeof(char));
+      CW_FREE(data->data[2]);
+      data->data[2] = (char *) CW_MALLOC(10 * sizeof(char));
       sprintf(data->data[2], "%d", er);
       return;
     }
@@ -479,10 +534,10 @@ void cw_game_data_set_er(CWGame *game, char *playerID, int er)
 void cw_game_stat_append(CWGame *game, int num_data, char **data)
 {
   int i;
-  CWData *d = (CWData *) malloc(sizeof(CWData));
+  CWData *d = (CWData *) CW_MALLOC(sizeof(CWData));
 
   d->num_data = num_data;
-  d->data = (char **) malloc(sizeof(char *) * num_data);
+  d->data = (char **) CW_MALLOC(sizeof(char *) * num_data);
   d->next = NULL;
 
   for (i = 0; i < num_data; i++) {
@@ -502,10 +557,10 @@ void cw_game_stat_append(CWGame *game, int num_data, char **data)
 void cw_game_evdata_append(CWGame *game, int num_data, char **data)
 {
   int i;
-  CWData *d = (CWData *) malloc(sizeof(CWData));
+  CWData *d = (CWData *) CW_MALLOC(sizeof(CWData));
 
   d->num_data = num_data;
-  d->data = (char **) malloc(sizeof(char *) * num_data);
+  d->data = (char **) CW_MALLOC(sizeof(char *) * num_data);
   d->next = NULL;
 
   for (i = 0; i < num_data; i++) {
@@ -525,10 +580,10 @@ void cw_game_evdata_append(CWGame *game, int num_data, char **data)
 void cw_game_line_append(CWGame *game, int num_data, char **data)
 {
   int i;
-  CWData *d = (CWData *) malloc(sizeof(CWData));
+  CWData *d = (CWData *) CW_MALLOC(sizeof(CWData));
 
   d->num_data = num_data;
-  d->data = (char **) malloc(sizeof(char *) * num_data);
+  d->data = (char **) CW_MALLOC(sizeof(char *) * num_data);
   d->next = NULL;
 
   for (i = 0; i < num_data; i++) {
@@ -547,19 +602,22 @@ void cw_game_line_append(CWGame *game, int num_data, char **data)
 
 void cw_game_comment_append(CWGame *game, char *text)
 {
-  CWComment *comment = (CWComment *) malloc(sizeof(CWComment));
-  char *tok = NULL;
+  CWComment *comment = (CWComment *) CW_MALLOC(sizeof(CWComment));
+  char *fields = NULL, *state = NULL, *tok = NULL;
 
   XCOPY(comment->text, text)
+  /* The fields are split from a copy, leaving 'text' as it was */
   if (strstr(comment->text, "ej,") == comment->text) {
-    tok = strtok(&(text[3]), ",");
+    XCOPY(fields, comment->text)
+    tok = cw_strtok(&(fields[3]), ",", &state);
     XCOPY(comment->ejection.person_id, tok)
-    tok = strtok(NULL, ",");
+    tok = cw_strtok(NULL, ",", &state);
     XCOPY(comment->ejection.person_role, tok)
-    tok = strtok(NULL, ",");
+    tok = cw_strtok(NULL, ",", &state);
     XCOPY(comment->ejection.umpire_id, tok)
-    tok = strtok(NULL, ",");
+    tok = cw_strtok(NULL, ",", &state);
     XCOPY(comment->ejection.reason, tok)
+    XFREE(fields)
   }
   else {
     comment->ejection.person_id = NULL;
@@ -568,12 +626,14 @@ void cw_game_comment_append(CWGame *game, char *text)
     comment->ejection.reason = NULL;
   }
   if (strstr(comment->text, "umpchange,") == comment->text) {
-    tok = strtok(&(text[10]), ",");
+    XCOPY(fields, comment->text)
+    tok = cw_strtok(&(fields[10]), ",", &state);
     XCOPY(comment->umpchange.inning, tok)
-    tok = strtok(NULL, ",");
+    tok = cw_strtok(NULL, ",", &state);
     XCOPY(comment->umpchange.position, tok)
-    tok = strtok(NULL, ",");
+    tok = cw_strtok(NULL, ",", &state);
     XCOPY(comment->umpchange.person_id, tok)
+    XFREE(fields)
   }
   else {
     comment->umpchange.inning = NULL;
@@ -612,20 +672,20 @@ void cw_game_replace_player(CWGame *game, char *key_old, char *key_new)
 
   for (sub = game->first_starter; sub != NULL; sub = sub->next) {
     if (!strcmp(sub->player_id, key_old)) {
-      free(sub->player_id);
+      CW_FREE(sub->player_id);
       XCOPY(sub->player_id, key_new)
     }
   }
 
   for (event = game->first_event; event != NULL; event = event->next) {
     if (!strcmp(event->batter, key_old)) {
-      free(event->batter);
+      CW_FREE(event->batter);
       XCOPY(event->batter, key_new)
     }
 
     for (sub = event->first_sub; sub != NULL; sub = sub->next) {
       if (!strcmp(sub->player_id, key_old)) {
-        free(sub->player_id);
+        CW_FREE(sub->player_id);
         XCOPY(sub->player_id, key_new)
       }
     }
@@ -633,7 +693,7 @@ void cw_game_replace_player(CWGame *game, char *key_old, char *key_new)
 
   for (data = game->first_data; data != NULL; data = data->next) {
     if (data->num_data >= 3 && !strcmp(data->data[0], "er") && !strcmp(data->data[1], key_old)) {
-      free(data->data[1]);
+      CW_FREE(data->data[1]);
       XCOPY(data->data[1], key_new)
     }
   }
@@ -689,6 +749,7 @@ CWGame *cw_game_read(FILE *file)
       char *game_id = cw_tokenizer_next(&tok);
       if (game_id) {
         game = cw_game_create(game_id);
+        cw_stats.games_read++;
       }
       else {
         return NULL;
@@ -705,13 +766,13 @@ CWGame *cw_game_read(FILE *file)
       break;
     }
     char *line = (char *) cw_record_reader_line(&r);
-    line_copy = strdup(line);
+    line_copy = CW_STRDUP(line);
     cw_tokenizer_init(&tok, line);
     tok0 = cw_tokenizer_next(&tok);
 
     if (!tok0 || !strcmp(tok0, "id")) {
       fsetpos(file, &filepos);
-      free(line_copy);
+      CW_FREE(line_copy);
       break;
     }
     else if (!strcmp(tok0, "version")) {
@@ -745,6 +806,7 @@ CWGame *cw_game_read(FILE *file)
       char *count = cw_tokenizer_next(&tok);
       char *pitches = cw_tokenizer_next(&tok);
       char *play = cw_tokenizer_next(&tok);
+      cw_stats.events_read++;
       if (inning && batting_team && batter && count && pitches && play) {
         cw_game_event_append(game, cw_atoi(inning, NULL), cw_atoi(batting_team, NULL), batter,
                              count, pitches, play);
@@ -905,7 +967,54 @@ CWGame *cw_game_read(FILE *file)
     else {
       cw_game_warn_invalid_record(game, line);
     }
-    free(line_copy);
+    CW_FREE(line_copy);
+  }
+  cw_record_reader_cleanup(&r);
+  return game;
+}
+
+CWGame *cw_game_read_header(FILE *file)
+{
+  CWRecordReader r;
+  CWTokenizer tok;
+  char *tok0, *game_id;
+  fpos_t filepos;
+  CWGame *game = NULL;
+
+  cw_record_reader_init(&r, file);
+  if (cw_record_reader_next(&r) == 1) {
+    cw_tokenizer_init(&tok, (char *) cw_record_reader_line(&r));
+    tok0 = cw_tokenizer_next(&tok);
+    if (tok0 && !strcmp(tok0, "id") && (game_id = cw_tokenizer_next(&tok)) != NULL) {
+      game = cw_game_create(game_id);
+    }
+  }
+
+  while (game != NULL) {
+    fgetpos(file, &filepos);
+    if (cw_record_reader_next(&r) != 1) {
+      break;
+    }
+    cw_tokenizer_init(&tok, (char *) cw_record_reader_line(&r));
+    tok0 = cw_tokenizer_next(&tok);
+
+    if (tok0 && !strcmp(tok0, "version")) {
+      char *version = cw_tokenizer_next(&tok);
+      if (version) {
+        cw_game_set_version(game, version);
+      }
+    }
+    else if (tok0 && !strcmp(tok0, "info")) {
+      char *field = cw_tokenizer_next(&tok);
+      char *value = cw_tokenizer_next(&tok);
+      if (field) {
+        cw_game_info_append(game, field, (value) ? value : "");
+      }
+    }
+    else if (!tok0 || strcmp(tok0, "com") != 0) {
+      fsetpos(file, &filepos);
+      break;
+    }
   }
   cw_record_reader_cleanup(&r);
   return game;
@@ -1029,6 +1138,22 @@ static void cw_game_write_line(CWGame *game, FILE *file)
   }
 }
 
+static void cw_game_write_evdata(CWGame *game, FILE *file)
+{
+  CWData *data = game->first_evdata;
+
+  while (data != NULL) {
+    int i;
+
+    fprintf(file, "event");
+    for (i = 0; i < data->num_data; i++) {
+      fprintf(file, ",%s", data->data[i]);
+    }
+    fprintf(file, "\n");
+    data = data->next;
+  }
+}
+
 static void cw_game_write_data(CWGame *game, FILE *file)
 {
   CWData *data = game->first_data;
@@ -1053,12 +1178,13 @@ void cw_game_write(CWGame *game, FILE *file)
   cw_game_write_events(game, file);
   cw_game_write_stat(game, file);
   cw_game_write_line(game, file);
+  cw_game_write_evdata(game, file);
   cw_game_write_data(game, file);
 }
 
 void cw_event_comment_append(CWEvent *event, char *text)
 {
-  CWComment *comment = (CWComment *) malloc(sizeof(CWComment));
+  CWComment *comment = (CWComment *) CW_MALLOC(sizeof(CWComment));
   XCOPY(comment->text, text)
   comment->next = NULL;
   comment->prev = event->last_comment;
@@ -91,9 +91,17 @@ typedef struct cw_data_struct {
   struct cw_data_struct *prev, *next;
 } CWData;
 
+/*
+ * The number of standard info labels (date, visteam, hometeam, and so
+ * on) for which a game keeps the record cw_game_info_lookup() returns,
+ * so that looking them up does not scan the list of records.
+ */
+#define CW_GAME_INFO_SLOTS 44
+
 typedef struct cw_game_struct {
   char *game_id, *version;
   CWInfo *first_info, *last_info;
+  CWInfo *info_slots[CW_GAME_INFO_SLOTS]; /* last record for each standard label */
   CWAppearance *first_starter, *last_starter;
   CWEvent *first_event, *last_event;
   CWData *first_data, *last_data, *first_stat, *last_stat;
@@ -115,6 +123,15 @@ CWGame *cw_game_create(char *game_id);
  */
 CWGame *cw_game_read(FILE *file);
 
+/*
+ * Reads only the 'id', 'version' and 'info' records at the start of a
+ * game in a file, passing over comments among them, and leaves the file
+ * pointer at the first other record; returns a null pointer if read is
+ * unsuccessful.  The game has no starters, events or comments; it is
+ * enough to decide whether to read the whole game.
+ */
+CWGame *cw_game_read_header(FILE *file);
+
 /*
  * Writes 'game' to 'file'.
  */
@@ -122,7 +139,7 @@ void cw_game_write(CWGame *game, FILE *file);
 
 /*
  * Cleans up internal memory allocation associated with 'game'.
- * Caller is responsible for free()ing the game itself
+ * Caller is responsible for freeing the game itself with cw_free()
  */
 void cw_game_cleanup(CWGame *game);
 
@@ -145,8 +162,9 @@ void cw_game_info_set(CWGame *game, char *label, char *data);
  * Scans the info records for 'label' and returns the associated data.
  * The pointer returned is internal to the CWGame structure, so it
  * should not be deleted, nor its contents changed.
- * The list is scanned from the tail first, to return the last seen
- * record in the case of multiple records.
+ * The last record with the label is returned in the case of multiple
+ * records.  Standard labels are found without scanning the records;
+ * others by scanning the list from the tail.
  */
 char *cw_game_info_lookup(CWGame *game, char *label);
 
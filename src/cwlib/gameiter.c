@@ -25,9 +25,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define CW_SUBSYSTEM CW_ALLOC_GAMEITER
 #include "util.h"
+#include "file.h"
 #include "parse.h"
 #include "gameiter.h"
+#include "stats.h"
 
 /***********************************************************************
  * This suite of functions implements abstractions of manipulation of
@@ -207,8 +210,9 @@ void cw_gamestate_initialize(CWGameState *state)
 CWGameState *cw_gamestate_copy(CWGameState *orig_state)
 {
   int i, t;
-  CWGameState *state = (CWGameState *) malloc(sizeof(CWGameState));
+  CWGameState *state = (CWGameState *) CW_MALLOC(sizeof(CWGameState));
 
+  CW_STRLCPY(state->date, orig_state->date);
   state->event_count = orig_state->event_count;
   state->inning = orig_state->inning;
   state->batting_team = orig_state->batting_team;
@@ -224,6 +228,7 @@ CWGameState *cw_gamestate_copy(CWGameState *orig_state)
     state->next_batter[t] = orig_state->next_batter[t];
     state->num_batters[t] = orig_state->num_batters[t];
     state->dh_slot[t] = orig_state->dh_slot[t];
+    state->num_auto_runners[t] = orig_state->num_auto_runners[t];
   }
 
   state->is_leadoff = orig_state->is_leadoff;
@@ -236,6 +241,7 @@ CWGameState *cw_gamestate_copy(CWGameState *orig_state)
   XCOPY(state->walk_pitcher, orig_state->walk_pitcher)
   XCOPY(state->strikeout_batter, orig_state->strikeout_batter)
   state->strikeout_batter_hand = orig_state->strikeout_batter_hand;
+  state->removed_position = orig_state->removed_position;
   XCOPY(state->go_ahead_rbi, orig_state->go_ahead_rbi)
 
   for (i = 0; i <= 3; i++) {
@@ -246,6 +252,7 @@ CWGameState *cw_gamestate_copy(CWGameState *orig_state)
     for (i = 0; i <= 9; i++) {
       XCOPY(state->lineups[i][t].player_id, orig_state->lineups[i][t].player_id)
       XCOPY(state->lineups[i][t].name, orig_state->lineups[i][t].name)
+      state->lineups[i][t].position = orig_state->lineups[i][t].position;
       XCOPY(state->fielders[i][t], orig_state->fielders[i][t])
     }
   }
@@ -293,11 +300,11 @@ static void cw_gamestate_check_go_ahead_rbi(CWGameState *state, char *batter,
       if (diff == 1) {
         /* This was the go-ahead run */
         if (event_data->rbi_flag[base]) {
-          state->go_ahead_rbi = (char *) malloc(strlen(batter) + 1);
+          state->go_ahead_rbi = (char *) CW_MALLOC(strlen(batter) + 1);
           strcpy(state->go_ahead_rbi, batter);
         }
         else if (state->go_ahead_rbi) {
-          free(state->go_ahead_rbi);
+          CW_FREE(state->go_ahead_rbi);
           state->go_ahead_rbi = NULL;
         }
         return;
@@ -305,7 +312,7 @@ static void cw_gamestate_check_go_ahead_rbi(CWGameState *state, char *batter,
       else if (diff == 0) {
         /* This was the tying run */
         if (state->go_ahead_rbi) {
-          free(state->go_ahead_rbi);
+          CW_FREE(state->go_ahead_rbi);
           state->go_ahead_rbi = NULL;
         }
       }
@@ -421,62 +428,75 @@ static void cw_gamestate_substitute(CWGameState *state, char *batter, char *coun
   char *removedPlayer = state->lineups[slot][team].player_id;
   int removedPosition = state->lineups[slot][team].position;
 
-  state->lineups[slot][team].player_id = (char *) malloc(sizeof(char) * (strlen(player_id) + 1));
+  state->lineups[slot][team].player_id =
+    (char *) CW_MALLOC(sizeof(char) * (strlen(player_id) + 1));
   strcpy(state->lineups[slot][team].player_id, player_id);
 
-  free(state->lineups[slot][team].name);
-  state->lineups[slot][team].name = (char *) malloc(sizeof(char) * (strlen(name) + 1));
+  CW_FREE(state->lineups[slot][team].name);
+  state->lineups[slot][team].name = (char *) CW_MALLOC(sizeof(char) * (strlen(name) + 1));
   strcpy(state->lineups[slot][team].name, name);
 
   state->lineups[slot][team].position = pos;
 
   if (strlen(count) == 2 && count[0] != '?' && count[1] != '?') {
     if (pos == 1 && (!strcmp(count, "20") || !strcmp(count, "21") || count[0] == '3')) {
-      state->walk_pitcher = (char *) malloc((strlen(state->fielders[1][team]) + 1) * sizeof(char));
+      state->walk_pitcher =
+        (char *) CW_MALLOC((strlen(state->fielders[1][team]) + 1) * sizeof(char));
       strcpy(state->walk_pitcher, state->fielders[1][team]);
     }
     else if (pos == DWARE_POS_PH && state->strikeout_batter == NULL && count[1] == '2') {
-      state->strikeout_batter = (char *) malloc((strlen(batter) + 1) * sizeof(char));
+      state->strikeout_batter = (char *) CW_MALLOC((strlen(batter) + 1) * sizeof(char));
       strcpy(state->strikeout_batter, batter);
       state->strikeout_batter_hand = state->batter_hand;
     }
   }
 
   if (pos <= DWARE_POS_MAX) {
-    free(state->fielders[pos][team]);
-    state->fielders[pos][team] = (char *) malloc(sizeof(char) * (strlen(player_id) + 1));
+    CW_FREE(state->fielders[pos][team]);
+    state->fielders[pos][team] = (char *) CW_MALLOC(sizeof(char) * (strlen(player_id) + 1));
     strcpy(state->fielders[pos][team], player_id);
     if (pos == 1 && slot > 0 && state->lineups[0][team].player_id != NULL) {
       /* Substituting a pitcher into the batting order, eliminating
        * the DH.  Clear out slot zero.
        */
-      free(state->lineups[0][team].player_id);
+      CW_FREE(state->lineups[0][team].player_id);
       state->lineups[0][team].player_id = NULL;
-      free(state->lineups[0][team].name);
+      CW_FREE(state->lineups[0][team].name);
       state->lineups[0][team].name = NULL;
       state->dh_slot[team] = 0;
     }
   }
   else if (pos == DWARE_POS_PH) {
+    XFREE(state->removed_for_ph)
     state->removed_for_ph = removedPlayer;
     state->ph_flag = 1;
     state->removed_position = removedPosition;
   }
   else if (pos == DWARE_POS_PR) {
     if (!strcmp(state->runners[1].runner, removedPlayer)) {
+      XFREE(state->removed_for_pr[1])
       state->removed_for_pr[1] = removedPlayer;
       cw_gamestate_replace_runner(state, 1, player_id);
     }
     else if (!strcmp(state->runners[2].runner, removedPlayer)) {
+      XFREE(state->removed_for_pr[2])
       state->removed_for_pr[2] = removedPlayer;
       cw_gamestate_replace_runner(state, 2, player_id);
     }
     else if (!strcmp(state->runners[3].runner, removedPlayer)) {
+      XFREE(state->removed_for_pr[3])
       state->removed_for_pr[3] = removedPlayer;
       cw_gamestate_replace_runner(state, 3, player_id);
     }
   }
 
+  /* Unless kept as the player removed for a pinch-hitter or -runner,
+   * the removed player's ID is no longer needed */
+  if (removedPlayer != state->removed_for_ph && removedPlayer != state->removed_for_pr[1] &&
+      removedPlayer != state->removed_for_pr[2] && removedPlayer != state->removed_for_pr[3]) {
+    CW_FREE(removedPlayer);
+  }
+
   if (slot > 0 && state->lineups[0][team].player_id != NULL &&
       !strcmp(state->lineups[0][team].player_id, player_id)) {
     /* Substituting a pitcher into the batting order, eliminating
@@ -485,9 +505,9 @@ static void cw_gamestate_substitute(CWGameState *state, char *batter, char *coun
        * on at least one occasion, on 1976/9/5 when Catfish Hunter
        * came in as a pinch-hitter for a player other than the DH.
        */
-    free(state->lineups[0][team].player_id);
+    CW_FREE(state->lineups[0][team].player_id);
     state->lineups[0][team].player_id = NULL;
-    free(state->lineups[0][team].name);
+    CW_FREE(state->lineups[0][team].name);
     state->lineups[0][team].name = NULL;
     state->dh_slot[team] = 0;
   }
@@ -723,18 +743,18 @@ static void cw_gameiter_lineup_setup(CWGameIterator *gameiter)
 
   while (starter != NULL) {
     gameiter->state->lineups[starter->slot][starter->team].player_id =
-      (char *) malloc(sizeof(char) * (strlen(starter->player_id) + 1));
+      (char *) CW_MALLOC(sizeof(char) * (strlen(starter->player_id) + 1));
     strcpy(gameiter->state->lineups[starter->slot][starter->team].player_id, starter->player_id);
 
     gameiter->state->lineups[starter->slot][starter->team].name =
-      (char *) malloc(sizeof(char) * (strlen(starter->name) + 1));
+      (char *) CW_MALLOC(sizeof(char) * (strlen(starter->name) + 1));
     strcpy(gameiter->state->lineups[starter->slot][starter->team].name, starter->name);
 
     gameiter->state->lineups[starter->slot][starter->team].position = starter->pos;
 
     if (starter->pos <= 9) {
       gameiter->state->fielders[starter->pos][starter->team] =
-        (char *) malloc(sizeof(char) * (strlen(starter->player_id) + 1));
+        (char *) CW_MALLOC(sizeof(char) * (strlen(starter->player_id) + 1));
       strcpy(gameiter->state->fielders[starter->pos][starter->team], starter->player_id);
     }
     else if (starter->pos == 10) {
@@ -770,6 +790,8 @@ void cw_gameiter_reset(CWGameIterator *gameiter)
       gameiter->state->batter_hand = gameiter->event->batter_hand;
       gameiter->state->pitcher_hand = gameiter->event->pitcher_hand;
       gameiter->parse_ok = cw_parse_event(gameiter->event->event_text, gameiter->event_data);
+      cw_stats.events_parsed++;
+      cw_stats.parse_failures += !gameiter->parse_ok;
     }
     else {
       /* There are some very rare instances with an NP as the first play */
@@ -780,11 +802,11 @@ void cw_gameiter_reset(CWGameIterator *gameiter)
 
 CWGameIterator *cw_gameiter_create(CWGame *game)
 {
-  CWGameIterator *gameiter = (CWGameIterator *) malloc(sizeof(CWGameIterator));
+  CWGameIterator *gameiter = (CWGameIterator *) CW_MALLOC(sizeof(CWGameIterator));
   gameiter->game = game;
 
-  gameiter->event_data = (CWEventData *) malloc(sizeof(CWEventData));
-  gameiter->state = (CWGameState *) malloc(sizeof(CWGameState));
+  gameiter->event_data = (CWEventData *) CW_MALLOC(sizeof(CWEventData));
+  gameiter->state = (CWGameState *) CW_MALLOC(sizeof(CWGameState));
 
   /* Initialize before reset, since initialization checks for cleanup */
   cw_gamestate_initialize(gameiter->state);
@@ -795,12 +817,12 @@ CWGameIterator *cw_gameiter_create(CWGame *game)
 
 CWGameIterator *cw_gameiter_copy(CWGameIterator *orig_gameiter)
 {
-  CWGameIterator *gameiter = (CWGameIterator *) malloc(sizeof(CWGameIterator));
+  CWGameIterator *gameiter = (CWGameIterator *) CW_MALLOC(sizeof(CWGameIterator));
 
   gameiter->game = orig_gameiter->game;
   gameiter->event = orig_gameiter->event;
 
-  gameiter->event_data = (CWEventData *) malloc(sizeof(CWEventData));
+  gameiter->event_data = (CWEventData *) CW_MALLOC(sizeof(CWEventData));
   cw_event_data_copy(gameiter->event_data, orig_gameiter->event_data);
 
   gameiter->parse_ok = orig_gameiter->parse_ok;
@@ -829,14 +851,17 @@ static void cw_gameiter_process_subs(CWGameIterator *gameiter)
 
 static void cw_gameiter_process_comments(CWGameIterator *gameiter)
 {
-  char *token;
+  char *text, *state, *token;
   CWComment *comment = gameiter->event->first_comment;
 
   while (comment != NULL) {
     if (strstr(comment->text, "suspended,") == comment->text) {
-      strtok(comment->text, ",");
-      token = strtok(NULL, ",");
+      /* Split a copy, so that the game is not changed by iterating it */
+      XCOPY(text, comment->text)
+      cw_strtok(text, ",", &state);
+      token = cw_strtok(NULL, ",", &state);
       CW_STRLCPY(gameiter->state->date, token);
+      XFREE(text)
     }
     comment = comment->next;
   }
@@ -903,6 +928,8 @@ void cw_gameiter_next(CWGameIterator *gameiter)
     gameiter->state->batter_hand = gameiter->event->batter_hand;
     gameiter->state->pitcher_hand = gameiter->event->pitcher_hand;
     gameiter->parse_ok = cw_parse_event(gameiter->event->event_text, gameiter->event_data);
+    cw_stats.events_parsed++;
+    cw_stats.parse_failures += !gameiter->parse_ok;
     for (i = DWARE_BASE_FIRST; i <= DWARE_BASE_THIRD; i++) {
       if (gameiter->event_data->advance[i] == 0 &&
           cw_gamestate_base_occupied(gameiter->state, i) &&
@@ -961,6 +988,6 @@ int cw_gameiter_runner_fate(CWGameIterator *orig_gameiter, int base)
     cw_gameiter_next(gameiter);
   }
   cw_gameiter_cleanup(gameiter);
-  free(gameiter);
+  CW_FREE(gameiter);
   return base;
 }
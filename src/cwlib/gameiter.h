@@ -26,6 +26,7 @@
 
 #include "roster.h"
 #include "game.h"
+#include "parse.h"
 
 typedef struct cw_game_state {
   char date[9]; /* Updates on game resumption after suspension */
@@ -168,7 +169,7 @@ CWGameIterator *cw_gameiter_copy(CWGameIterator *gameiter);
 
 /*
  * Cleans up a CWGameIterator, deallocating internal memory.
- * Caller is responsible for free()ing of gameiter itself
+ * Caller is responsible for freeing gameiter itself with cw_free()
  */
 void cw_gameiter_cleanup(CWGameIterator *gameiter);
 
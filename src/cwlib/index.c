@@ -0,0 +1,434 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/index.c
+ * Implementation of an index from players to the games and events they appear in
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "file.h"
+#include "index.h"
+#define CW_SUBSYSTEM CW_ALLOC_INDEX
+#include "util.h"
+
+/* The letters for the roles in index files, in the order of the role bits */
+static const char cw_index_role_codes[CW_INDEX_ROLES] = {'B', 'P', 'F', 'R'};
+
+static void *cw_index_grow(void *array, int *max, int count, size_t size)
+{
+  if (count < *max) {
+    return array;
+  }
+  *max = (*max > 0) ? 2 * *max : 16;
+  array = CW_REALLOC(array, (size_t) *max * size);
+  if (array == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for index\n");
+    exit(1);
+  }
+  return array;
+}
+
+static unsigned int cw_index_hash(char *player_id)
+{
+  unsigned int hash = 2166136261U;
+  char *c;
+
+  for (c = player_id; *c != '\0'; c++) {
+    hash = (hash ^ (unsigned char) *c) * 16777619U;
+  }
+  return hash;
+}
+
+static void cw_index_rehash(CWPlayerIndex *index, int num_buckets)
+{
+  CWIndexPlayer *player;
+
+  CW_FREE(index->buckets);
+  index->buckets = (CWIndexPlayer **) CW_CALLOC((size_t) num_buckets, sizeof(CWIndexPlayer *));
+  if (index->buckets == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for index\n");
+    exit(1);
+  }
+  index->num_buckets = num_buckets;
+  for (player = index->first_player; player != NULL; player = player->next) {
+    unsigned int bucket = cw_index_hash(player->player_id) & (unsigned int) (num_buckets - 1);
+    player->hash_next = index->buckets[bucket];
+    index->buckets[bucket] = player;
+  }
+}
+
+/*
+ * Find the postings for the player, adding an entry with none if there
+ * is none.
+ */
+static CWIndexPlayer *cw_index_get_player(CWPlayerIndex *index, char *player_id)
+{
+  CWIndexPlayer *player = cw_index_find_player(index, player_id);
+  unsigned int bucket;
+
+  if (player != NULL) {
+    return player;
+  }
+
+  player = (CWIndexPlayer *) CW_CALLOC(1, sizeof(CWIndexPlayer));
+  if (player == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for index\n");
+    exit(1);
+  }
+  XCOPY(player->player_id, player_id);
+  if (index->last_player != NULL) {
+    index->last_player->next = player;
+  }
+  else {
+    index->first_player = player;
+  }
+  index->last_player = player;
+
+  bucket = cw_index_hash(player_id) & (unsigned int) (index->num_buckets - 1);
+  player->hash_next = index->buckets[bucket];
+  index->buckets[bucket] = player;
+  if (++index->num_players > index->num_buckets) {
+    cw_index_rehash(index, 2 * index->num_buckets);
+  }
+  return player;
+}
+
+/*
+ * Record that 'player_id' has 'role' in event 'event' of game 'game',
+ * extending the player's posting for the game and role if there is one.
+ */
+static void cw_index_post(CWPlayerIndex *index, char *player_id, int role, int game, int event)
+{
+  CWIndexPlayer *player;
+  CWIndexPosting *posting;
+  int i;
+
+  if (player_id == NULL || player_id[0] == '\0') {
+    return;
+  }
+  player = cw_index_get_player(index, player_id);
+
+  /* A player has at most one posting for each role in a game, and
+   * those for the current game are the last ones */
+  for (i = player->num_postings - 1; i >= 0 && player->postings[i].game == game; i--) {
+    if (player->postings[i].role == role) {
+      player->postings[i].last_event = event;
+      player->postings[i].num_events++;
+      return;
+    }
+  }
+
+  player->postings = (CWIndexPosting *) cw_index_grow(
+    player->postings, &player->max_postings, player->num_postings, sizeof(CWIndexPosting));
+  posting = &player->postings[player->num_postings++];
+  posting->game = game;
+  posting->role = role;
+  posting->first_event = event;
+  posting->last_event = event;
+  posting->num_events = 1;
+}
+
+/*
+ * Add the postings of the players in 'game', which is game number
+ * 'number' in the index.
+ */
+static void cw_index_add_game(CWPlayerIndex *index, CWGame *game, int number)
+{
+  CWGameIterator *gameiter = cw_gameiter_create(game);
+  int event = 0, pos, base;
+
+  for (; gameiter->event != NULL; cw_gameiter_next(gameiter), event++) {
+    CWGameState *state = gameiter->state;
+    int fielding_team = 1 - state->batting_team;
+
+    if (!strcmp(gameiter->event->event_text, "NP")) {
+      continue;
+    }
+    cw_index_post(index, gameiter->event->batter, CW_INDEX_BATTING, number, event);
+    cw_index_post(index, state->fielders[1][fielding_team], CW_INDEX_PITCHING, number, event);
+    for (pos = 2; pos <= 9; pos++) {
+      cw_index_post(index, state->fielders[pos][fielding_team], CW_INDEX_FIELDING, number,
+                    event);
+    }
+    for (base = 1; base <= 3; base++) {
+      if (cw_gamestate_base_occupied(state, base)) {
+        cw_index_post(index, state->runners[base].runner, CW_INDEX_RUNNING, number, event);
+      }
+    }
+  }
+
+  cw_gameiter_cleanup(gameiter);
+  CW_FREE(gameiter);
+}
+
+static int cw_index_add_game_entry(CWPlayerIndex *index, char *game_id, int file, long offset)
+{
+  CWIndexGame *entry;
+
+  index->games = (CWIndexGame *) cw_index_grow(index->games, &index->max_games,
+                                               index->num_games, sizeof(CWIndexGame));
+  entry = &index->games[index->num_games];
+  XCOPY(entry->game_id, game_id);
+  entry->file = file;
+  entry->offset = offset;
+  return index->num_games++;
+}
+
+static int cw_index_add_file_entry(CWPlayerIndex *index, char *filename)
+{
+  index->files =
+    (char **) cw_index_grow(index->files, &index->max_files, index->num_files, sizeof(char *));
+  XCOPY(index->files[index->num_files], filename);
+  return index->num_files++;
+}
+
+static int cw_index_role_number(int role)
+{
+  int i;
+
+  for (i = 0; i < CW_INDEX_ROLES; i++) {
+    if (role == (1 << i)) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+static int cw_index_compare_players(const void *a, const void *b)
+{
+  const CWIndexPlayer *player1 = *(const CWIndexPlayer *const *) a;
+  const CWIndexPlayer *player2 = *(const CWIndexPlayer *const *) b;
+
+  return strcmp(player1->player_id, player2->player_id);
+}
+
+/*
+ * Public interface
+ */
+CWPlayerIndex *cw_index_create(void)
+{
+  CWPlayerIndex *index = (CWPlayerIndex *) CW_CALLOC(1, sizeof(CWPlayerIndex));
+
+  if (index == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for index\n");
+    exit(1);
+  }
+  cw_index_rehash(index, 256);
+  index->file_number = -1;
+  return index;
+}
+
+void cw_index_cleanup(CWPlayerIndex *index)
+{
+  CWIndexPlayer *player = index->first_player;
+  int i;
+
+  while (player != NULL) {
+    CWIndexPlayer *next = player->next;
+
+    XFREE(player->player_id);
+    XFREE(player->postings);
+    CW_FREE(player);
+    player = next;
+  }
+  index->first_player = NULL;
+  index->last_player = NULL;
+  index->num_players = 0;
+  XFREE(index->buckets);
+  index->num_buckets = 0;
+
+  for (i = 0; i < index->num_games; i++) {
+    XFREE(index->games[i].game_id);
+  }
+  XFREE(index->games);
+  index->num_games = index->max_games = 0;
+  for (i = 0; i < index->num_files; i++) {
+    XFREE(index->files[i]);
+  }
+  XFREE(index->files);
+  index->num_files = index->max_files = 0;
+
+  if (index->file != NULL) {
+    fclose(index->file);
+    index->file = NULL;
+  }
+  index->file_number = -1;
+}
+
+int cw_index_add_file(CWPlayerIndex *index, char *filename)
+{
+  FILE *file = fopen(filename, "r");
+  CWGame *game;
+  int number, count = 0;
+  long offset;
+
+  if (file == NULL) {
+    return -1;
+  }
+  number = cw_index_add_file_entry(index, filename);
+  if (cw_file_find_first_game(file)) {
+    while ((offset = ftell(file)) >= 0 && (game = cw_game_read(file)) != NULL) {
+      int entry = cw_index_add_game_entry(index, game->game_id, number, offset);
+
+      cw_index_add_game(index, game, entry);
+      cw_game_cleanup(game);
+      CW_FREE(game);
+      count++;
+    }
+  }
+  fclose(file);
+  return count;
+}
+
+CWIndexPlayer *cw_index_find_player(CWPlayerIndex *index, char *player_id)
+{
+  CWIndexPlayer *player;
+  unsigned int bucket = cw_index_hash(player_id) & (unsigned int) (index->num_buckets - 1);
+
+  for (player = index->buckets[bucket]; player != NULL; player = player->hash_next) {
+    if (!strcmp(player->player_id, player_id)) {
+      return player;
+    }
+  }
+  return NULL;
+}
+
+CWGame *cw_index_read_game(CWPlayerIndex *index, int game)
+{
+  CWIndexGame *entry;
+
+  if (game < 0 || game >= index->num_games) {
+    return NULL;
+  }
+  entry = &index->games[game];
+  if (entry->file < 0 || entry->file >= index->num_files) {
+    return NULL;
+  }
+  if (entry->file != index->file_number) {
+    if (index->file != NULL) {
+      fclose(index->file);
+    }
+    index->file = fopen(index->files[entry->file], "r");
+    index->file_number = (index->file != NULL) ? entry->file : -1;
+  }
+  if (index->file == NULL || fseek(index->file, entry->offset, SEEK_SET) != 0) {
+    return NULL;
+  }
+  return cw_game_read(index->file);
+}
+
+void cw_index_write(CWPlayerIndex *index, FILE *file)
+{
+  CWIndexPlayer **players, *player;
+  int i, j;
+
+  fprintf(file, "index,1\n");
+  for (i = 0; i < index->num_files; i++) {
+    fprintf(file, "file,\"%s\"\n", index->files[i]);
+  }
+  for (i = 0; i < index->num_games; i++) {
+    fprintf(file, "game,%s,%d,%ld\n", index->games[i].game_id, index->games[i].file,
+            index->games[i].offset);
+  }
+
+  players =
+    (CWIndexPlayer **) CW_MALLOC((size_t) (index->num_players + 1) * sizeof(CWIndexPlayer *));
+  if (players == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for index\n");
+    exit(1);
+  }
+  for (i = 0, player = index->first_player; player != NULL; player = player->next) {
+    players[i++] = player;
+  }
+  qsort(players, (size_t) i, sizeof(CWIndexPlayer *), cw_index_compare_players);
+
+  for (i = 0; i < index->num_players; i++) {
+    fprintf(file, "player,%s\n", players[i]->player_id);
+    for (j = 0; j < players[i]->num_postings; j++) {
+      CWIndexPosting *posting = &players[i]->postings[j];
+
+      fprintf(file, "posting,%c,%d,%d,%d,%d\n",
+              cw_index_role_codes[cw_index_role_number(posting->role)], posting->game,
+              posting->first_event, posting->last_event, posting->num_events);
+    }
+  }
+  CW_FREE(players);
+}
+
+int cw_index_read(CWPlayerIndex *index, FILE *file)
+{
+  CWRecordReader r;
+  CWTokenizer tok;
+  CWIndexPlayer *player = NULL;
+  char *tag, *tokens[5];
+  int i, role, result = -1, first = 1;
+
+  cw_record_reader_init(&r, file);
+  while (cw_record_reader_next(&r) == 1) {
+    cw_tokenizer_init(&tok, (char *) cw_record_reader_line(&r));
+    tag = cw_tokenizer_next(&tok);
+    for (i = 0; i < 5; i++) {
+      tokens[i] = (tag != NULL) ? cw_tokenizer_next(&tok) : NULL;
+    }
+    if (tag == NULL) {
+      continue;
+    }
+
+    if (first) {
+      if (strcmp(tag, "index") != 0 || tokens[0] == NULL || strcmp(tokens[0], "1") != 0) {
+        break;
+      }
+      first = 0;
+      result = 0;
+    }
+    else if (!strcmp(tag, "file") && tokens[0] != NULL) {
+      cw_index_add_file_entry(index, tokens[0]);
+    }
+    else if (!strcmp(tag, "game") && tokens[2] != NULL) {
+      cw_index_add_game_entry(index, tokens[0], cw_atoi(tokens[1], NULL),
+                              strtol(tokens[2], NULL, 10));
+    }
+    else if (!strcmp(tag, "player") && tokens[0] != NULL) {
+      player = cw_index_get_player(index, tokens[0]);
+    }
+    else if (!strcmp(tag, "posting") && player != NULL && tokens[4] != NULL) {
+      CWIndexPosting *posting;
+
+      for (role = 0; role < CW_INDEX_ROLES && tokens[0][0] != cw_index_role_codes[role];
+           role++)
+        ;
+      if (role == CW_INDEX_ROLES) {
+        continue;
+      }
+      player->postings = (CWIndexPosting *) cw_index_grow(
+        player->postings, &player->max_postings, player->num_postings, sizeof(CWIndexPosting));
+      posting = &player->postings[player->num_postings++];
+      posting->role = 1 << role;
+      posting->game = cw_atoi(tokens[1], NULL);
+      posting->first_event = cw_atoi(tokens[2], NULL);
+      posting->last_event = cw_atoi(tokens[3], NULL);
+      posting->num_events = cw_atoi(tokens[4], NULL);
+    }
+  }
+  cw_record_reader_cleanup(&r);
+  return result;
+}
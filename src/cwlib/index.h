@@ -0,0 +1,132 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/index.h
+ * Declaration of an index from players to the games and events they appear in
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef CW_INDEX_H
+#define CW_INDEX_H
+
+#include "gameiter.h"
+
+/*
+ * The roles in which a player takes part in an event: batting, pitching,
+ * fielding (at a position other than pitcher), or on base at the start
+ * of the event.
+ */
+#define CW_INDEX_BATTING 1
+#define CW_INDEX_PITCHING 2
+#define CW_INDEX_FIELDING 4
+#define CW_INDEX_RUNNING 8
+#define CW_INDEX_ROLES 4
+
+/*
+ * A game in the index: the file it is in (as a number in the index's
+ * list of files), and the offset of its 'id' record in the file.
+ */
+typedef struct cw_index_game_struct {
+  char *game_id;
+  int file;
+  long offset;
+} CWIndexGame;
+
+/*
+ * The events of one game in which a player had one role.  Events are
+ * numbered from zero in the order of the game's play records (including
+ * NP); 'first_event' and 'last_event' are the first and last in the
+ * role, and 'num_events' the number of events in the role between them.
+ */
+typedef struct cw_index_posting_struct {
+  int game, role;
+  int first_event, last_event, num_events;
+} CWIndexPosting;
+
+/*
+ * A player's postings, in the order of the games in the index.
+ */
+typedef struct cw_index_player_struct {
+  char *player_id;
+  CWIndexPosting *postings;
+  int num_postings, max_postings;
+  struct cw_index_player_struct *next, *hash_next;
+} CWIndexPlayer;
+
+/*
+ * An index of the games in a set of event files, and of the players who
+ * appear in them.
+ */
+typedef struct cw_player_index_struct {
+  char **files;
+  int num_files, max_files;
+  CWIndexGame *games;
+  int num_games, max_games;
+  CWIndexPlayer *first_player, *last_player;
+  CWIndexPlayer **buckets;
+  int num_buckets, num_players;
+  /* The file last opened by cw_index_read_game() */
+  FILE *file;
+  int file_number;
+} CWPlayerIndex;
+
+/*
+ * Allocates and initializes a new CWPlayerIndex, with no files.
+ * Caller is responsible for memory management of the created pointer.
+ */
+CWPlayerIndex *cw_index_create(void);
+
+/*
+ * Cleans up internal memory allocation associated with 'index'.
+ * Caller is responsible for freeing the index itself with cw_free().
+ */
+void cw_index_cleanup(CWPlayerIndex *index);
+
+/*
+ * Adds the games in the event file 'filename' to the index, reading it
+ * once.  The name is kept as given, to open the file again later.
+ * Returns the number of games added, or -1 if the file could not be read.
+ */
+int cw_index_add_file(CWPlayerIndex *index, char *filename);
+
+/*
+ * Finds the postings for 'player_id'; returns NULL if the player does
+ * not appear in any game in the index.
+ */
+CWIndexPlayer *cw_index_find_player(CWPlayerIndex *index, char *player_id);
+
+/*
+ * Reads game number 'game' of the index from its event file, seeking
+ * directly to it.  Returns NULL if the game cannot be read.
+ * Caller is responsible for memory management of the returned game.
+ */
+CWGame *cw_index_read_game(CWPlayerIndex *index, int game);
+
+/*
+ * Writes the index to 'file', with players in order of ID.
+ */
+void cw_index_write(CWPlayerIndex *index, FILE *file);
+
+/*
+ * Reads an index written by cw_index_write() from 'file' into 'index',
+ * which should be empty.  Returns 0 on success, or -1 if the file is
+ * not an index.
+ */
+int cw_index_read(CWPlayerIndex *index, FILE *file);
+
+#endif /* CW_INDEX_H */
@@ -28,10 +28,12 @@
 
 #include "file.h" /* for file-reading and tokenizing */
 #include "league.h"
+#define CW_SUBSYSTEM CW_ALLOC_LEAGUE
+#include "util.h"
 
 CWLeague *cw_league_create(void)
 {
-  CWLeague *rosterList = (CWLeague *) malloc(sizeof(CWLeague));
+  CWLeague *rosterList = (CWLeague *) CW_MALLOC(sizeof(CWLeague));
   rosterList->first_roster = NULL;
   rosterList->last_roster = NULL;
 
@@ -45,7 +47,7 @@ void cw_league_cleanup(CWLeague *rosterList)
   while (roster) {
     CWRoster *nextRoster = roster->next;
     cw_roster_cleanup(roster);
-    free(roster);
+    CW_FREE(roster);
     roster = nextRoster;
   }
 
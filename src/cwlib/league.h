@@ -39,7 +39,7 @@ CWLeague *cw_league_create(void);
 
 /*
  * Cleans up internal memory associated with 'league'.
- * Caller is responsible for free()ing the 'league' pointer.
+ * Caller is responsible for freeing the 'league' pointer with cw_free().
  */
 void cw_league_cleanup(CWLeague *league);
 
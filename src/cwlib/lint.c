@@ -27,6 +27,8 @@
 #include <string.h>
 
 #include "chadwick.h"
+#define CW_SUBSYSTEM CW_ALLOC_LINT
+#include "util.h"
 
 /*
  * Check for errors in game starter records
@@ -139,6 +141,7 @@ int cw_game_lint(CWGame *game)
     cw_gameiter_next(gameiter);
   }
 
-  free(gameiter);
+  cw_gameiter_cleanup(gameiter);
+  CW_FREE(gameiter);
   return ok;
 }
@@ -26,6 +26,7 @@
 #include <ctype.h>
 
 #include "parse.h"
+#define CW_SUBSYSTEM CW_ALLOC_PARSE
 #include "util.h"
 
 /**************************************************************************
@@ -173,7 +174,7 @@ static void cw_parse_initialize(CWParserState *state, const char *input)
   size_t write_pos = 0;
   char *c;
 
-  state->inputString = (char *) malloc(strlen(input) + 1);
+  state->inputString = (char *) CW_MALLOC(strlen(input) + 1);
   for (read_pos = 0; input[read_pos] != '\0'; read_pos++) {
     unsigned char ch = (unsigned char) input[read_pos];
 
@@ -200,7 +201,7 @@ static void cw_parse_initialize(CWParserState *state, const char *input)
  */
 static void cw_parse_cleanup(CWParserState *state)
 {
-  free(state->inputString);
+  CW_FREE(state->inputString);
   state->inputString = NULL;
 }
 
@@ -650,7 +651,7 @@ static int cw_parse_advance_modifier(CWParserState *state, CWEventData *event, i
   }
 }
 
-static char locations[][20] = {
+static const char locations[][20] = {
   "1", "13", "15", "1S", "2", "2F", "23", "23F", "25", "25F", "3SF", "3F", "3DF", "3S", "3", "3D",
   "34S", "34", "34D", "4S", "4", "4D", "4MS", "4M", "4MD", "6MS", "6M", "6MD", "6S", "6", "6D",
   "56S", "56", "56D", "5S", "5", "5D", "5SF", "5F", "5DF", "7LSF", "7LS", "7S", "78S", "8S", "89S",
@@ -2014,7 +2015,7 @@ typedef struct {
 
 int cw_parse_event(char *text, CWEventData *event)
 {
-  static cw_parse_table_entry primary_table[] = {
+  static const cw_parse_table_entry primary_table[] = {
     {CW_EVENT_BALK, "BK", cw_parse_balk},
     {CW_EVENT_INTERFERENCE, "C", cw_parse_interference},
     {CW_EVENT_CAUGHTSTEALING, "CS", cw_parse_caught_stealing},
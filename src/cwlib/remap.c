@@ -0,0 +1,243 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/remap.c
+ * Implementation of maps of player IDs to replace in games
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "file.h"
+#include "remap.h"
+#define CW_SUBSYSTEM CW_ALLOC_REMAP
+#include "util.h"
+
+static unsigned int cw_player_map_hash(char *player_id)
+{
+  unsigned int hash = 2166136261U;
+  char *c;
+
+  for (c = player_id; *c != '\0'; c++) {
+    hash = (hash ^ (unsigned char) *c) * 16777619U;
+  }
+  return hash;
+}
+
+static void cw_player_map_rehash(CWPlayerMap *map, int num_buckets)
+{
+  CWPlayerMapEntry *entry;
+
+  CW_FREE(map->buckets);
+  map->buckets =
+    (CWPlayerMapEntry **) CW_CALLOC((size_t) num_buckets, sizeof(CWPlayerMapEntry *));
+  if (map->buckets == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for player map\n");
+    exit(1);
+  }
+  map->num_buckets = num_buckets;
+  for (entry = map->first_entry; entry != NULL; entry = entry->next) {
+    unsigned int bucket = cw_player_map_hash(entry->old_id) & (unsigned int) (num_buckets - 1);
+    entry->hash_next = map->buckets[bucket];
+    map->buckets[bucket] = entry;
+  }
+}
+
+static CWPlayerMapEntry *cw_player_map_find(CWPlayerMap *map, char *player_id)
+{
+  CWPlayerMapEntry *entry;
+  unsigned int bucket = cw_player_map_hash(player_id) & (unsigned int) (map->num_buckets - 1);
+
+  for (entry = map->buckets[bucket]; entry != NULL; entry = entry->hash_next) {
+    if (!strcmp(entry->old_id, player_id)) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Replace the ID '*player_id' if the map replaces it; returns 1 if it
+ * was replaced and 0 if not
+ */
+static int cw_player_map_apply(CWPlayerMap *map, char **player_id)
+{
+  char *new_id;
+
+  if (*player_id == NULL || (new_id = cw_player_map_lookup(map, *player_id)) == NULL) {
+    return 0;
+  }
+  CW_FREE(*player_id);
+  XCOPY(*player_id, new_id);
+  return 1;
+}
+
+/*
+ * Public interface
+ */
+CWPlayerMap *cw_player_map_create(void)
+{
+  CWPlayerMap *map = (CWPlayerMap *) CW_CALLOC(1, sizeof(CWPlayerMap));
+
+  if (map == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for player map\n");
+    exit(1);
+  }
+  cw_player_map_rehash(map, 1024);
+  return map;
+}
+
+void cw_player_map_cleanup(CWPlayerMap *map)
+{
+  CWPlayerMapEntry *entry = map->first_entry;
+
+  while (entry != NULL) {
+    CWPlayerMapEntry *next = entry->next;
+
+    XFREE(entry->old_id);
+    XFREE(entry->new_id);
+    CW_FREE(entry);
+    entry = next;
+  }
+  map->first_entry = map->last_entry = NULL;
+  XFREE(map->buckets);
+  map->num_buckets = map->num_entries = 0;
+}
+
+void cw_player_map_add(CWPlayerMap *map, char *old_id, char *new_id)
+{
+  CWPlayerMapEntry *entry = cw_player_map_find(map, old_id);
+  unsigned int bucket;
+
+  if (entry != NULL) {
+    XFREE(entry->new_id);
+    XCOPY(entry->new_id, new_id);
+    return;
+  }
+
+  entry = (CWPlayerMapEntry *) CW_CALLOC(1, sizeof(CWPlayerMapEntry));
+  if (entry == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for player map\n");
+    exit(1);
+  }
+  XCOPY(entry->old_id, old_id);
+  XCOPY(entry->new_id, new_id);
+  if (map->last_entry != NULL) {
+    map->last_entry->next = entry;
+  }
+  else {
+    map->first_entry = entry;
+  }
+  map->last_entry = entry;
+
+  bucket = cw_player_map_hash(old_id) & (unsigned int) (map->num_buckets - 1);
+  entry->hash_next = map->buckets[bucket];
+  map->buckets[bucket] = entry;
+  if (++map->num_entries > map->num_buckets) {
+    cw_player_map_rehash(map, 2 * map->num_buckets);
+  }
+}
+
+char *cw_player_map_lookup(CWPlayerMap *map, char *player_id)
+{
+  CWPlayerMapEntry *entry = cw_player_map_find(map, player_id);
+
+  return (entry != NULL) ? entry->new_id : NULL;
+}
+
+int cw_player_map_read(CWPlayerMap *map, FILE *file)
+{
+  CWRecordReader r;
+  CWTokenizer tok;
+  int count = 0;
+
+  cw_record_reader_init(&r, file);
+  while (cw_record_reader_next(&r) == 1) {
+    char *old_id, *new_id;
+
+    cw_tokenizer_init(&tok, (char *) cw_record_reader_line(&r));
+    old_id = cw_tokenizer_next(&tok);
+    new_id = (old_id != NULL) ? cw_tokenizer_next(&tok) : NULL;
+    if (old_id != NULL && new_id != NULL && old_id[0] != '\0' && new_id[0] != '\0') {
+      cw_player_map_add(map, old_id, new_id);
+      count++;
+    }
+  }
+  cw_record_reader_cleanup(&r);
+  return count;
+}
+
+int cw_game_remap_players(CWGame *game, CWPlayerMap *map)
+{
+  CWInfo *info;
+  CWAppearance *sub;
+  CWEvent *event;
+  CWData *data;
+  int count = 0, base;
+
+  for (info = game->first_info; info != NULL; info = info->next) {
+    if (!strcmp(info->label, "wp") || !strcmp(info->label, "lp") ||
+        !strcmp(info->label, "save") || !strcmp(info->label, "gwrbi")) {
+      count += cw_player_map_apply(map, &info->data);
+    }
+  }
+
+  for (sub = game->first_starter; sub != NULL; sub = sub->next) {
+    count += cw_player_map_apply(map, &sub->player_id);
+  }
+
+  for (event = game->first_event; event != NULL; event = event->next) {
+    count += cw_player_map_apply(map, &event->batter);
+    count += cw_player_map_apply(map, &event->pitcher_hand_id);
+    count += cw_player_map_apply(map, &event->auto_runner_id);
+    for (base = 1; base <= 3; base++) {
+      count += cw_player_map_apply(map, &event->presadj[base]);
+    }
+    for (sub = event->first_sub; sub != NULL; sub = sub->next) {
+      count += cw_player_map_apply(map, &sub->player_id);
+    }
+  }
+
+  for (data = game->first_data; data != NULL; data = data->next) {
+    if (data->num_data >= 3 && !strcmp(data->data[0], "er")) {
+      count += cw_player_map_apply(map, &data->data[1]);
+    }
+  }
+
+  /* Boxscore event files: the player lines give the player first... */
+  for (data = game->first_stat; data != NULL; data = data->next) {
+    if (data->num_data >= 2 &&
+        (!strcmp(data->data[0], "bline") || !strcmp(data->data[0], "pline") ||
+         !strcmp(data->data[0], "dline") || !strcmp(data->data[0], "phline") ||
+         !strcmp(data->data[0], "prline"))) {
+      count += cw_player_map_apply(map, &data->data[1]);
+    }
+  }
+
+  /* ...and the event lines give the team, then the players involved.  Some
+   * (hrline, sbline, and the like) follow these with an inning or other
+   * count, which no map entry will match. */
+  for (data = game->first_evdata; data != NULL; data = data->next) {
+    for (base = 2; base < data->num_data; base++) {
+      count += cw_player_map_apply(map, &data->data[base]);
+    }
+  }
+  return count;
+}
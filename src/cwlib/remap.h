@@ -0,0 +1,88 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/remap.h
+ * Declaration of maps of player IDs to replace in games
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef CW_REMAP_H
+#define CW_REMAP_H
+
+#include <stdio.h>
+
+#include "game.h"
+
+typedef struct cw_player_map_entry_struct {
+  char *old_id, *new_id;
+  struct cw_player_map_entry_struct *next, *hash_next;
+} CWPlayerMapEntry;
+
+/*
+ * A map of player IDs to the IDs to replace them with, in the order
+ * the replacements were added.
+ */
+typedef struct cw_player_map_struct {
+  CWPlayerMapEntry *first_entry, *last_entry;
+  CWPlayerMapEntry **buckets;
+  int num_buckets, num_entries;
+} CWPlayerMap;
+
+/*
+ * Allocates and initializes a new CWPlayerMap, with no replacements.
+ * Caller is responsible for memory management of the created pointer.
+ */
+CWPlayerMap *cw_player_map_create(void);
+
+/*
+ * Cleans up internal memory allocation associated with 'map'.
+ * Caller is responsible for freeing the map itself with cw_free().
+ */
+void cw_player_map_cleanup(CWPlayerMap *map);
+
+/*
+ * Adds the replacement of 'old_id' by 'new_id' to the map.  A later
+ * replacement of the same ID takes the place of an earlier one.
+ */
+void cw_player_map_add(CWPlayerMap *map, char *old_id, char *new_id);
+
+/*
+ * Returns the ID to replace 'player_id' with, or NULL if the map does
+ * not replace it.  The pointer returned is internal to the map.
+ */
+char *cw_player_map_lookup(CWPlayerMap *map, char *player_id);
+
+/*
+ * Reads replacements from 'file', one to a record of the form
+ * "old_id,new_id"; records with fewer fields are ignored.  Returns the
+ * number of replacements read.
+ */
+int cw_player_map_read(CWPlayerMap *map, FILE *file);
+
+/*
+ * Replaces the player IDs in 'game' which 'map' replaces, in a single
+ * pass over the game: those of starters and substitutes, batters, the
+ * pitchers and runners of 'padj', 'radj' and 'presadj' records, the
+ * players of 'er' data records, the values of the 'wp', 'lp',
+ * 'save' and 'gwrbi' info records, and, for boxscore event files, the
+ * players of 'stat' and 'event' records.  Comments are not changed.
+ * Returns the number of IDs replaced.
+ */
+int cw_game_remap_players(CWGame *game, CWPlayerMap *map);
+
+#endif /* CW_REMAP_H */
@@ -26,18 +26,20 @@
 #include <string.h>
 #include "roster.h"
 #include "file.h"
+#define CW_SUBSYSTEM CW_ALLOC_ROSTER
+#include "util.h"
 
 CWPlayer *cw_player_create(char *player_id, char *last_name, char *first_name, char bats,
                            char throws)
 {
-  CWPlayer *player = (CWPlayer *) malloc(sizeof(CWPlayer));
-  player->player_id = (char *) malloc(sizeof(char) * (strlen(player_id) + 1));
+  CWPlayer *player = (CWPlayer *) CW_MALLOC(sizeof(CWPlayer));
+  player->player_id = (char *) CW_MALLOC(sizeof(char) * (strlen(player_id) + 1));
   strcpy(player->player_id, player_id);
 
-  player->last_name = (char *) malloc(sizeof(char) * (strlen(last_name) + 1));
+  player->last_name = (char *) CW_MALLOC(sizeof(char) * (strlen(last_name) + 1));
   strcpy(player->last_name, last_name);
 
-  player->first_name = (char *) malloc(sizeof(char) * (strlen(first_name) + 1));
+  player->first_name = (char *) CW_MALLOC(sizeof(char) * (strlen(first_name) + 1));
   strcpy(player->first_name, first_name);
 
   player->bats = bats;
@@ -50,46 +52,46 @@ CWPlayer *cw_player_create(char *player_id, char *last_name, char *first_name, c
 
 void cw_player_cleanup(CWPlayer *player)
 {
-  free(player->player_id);
-  free(player->last_name);
-  free(player->first_name);
+  CW_FREE(player->player_id);
+  CW_FREE(player->last_name);
+  CW_FREE(player->first_name);
 }
 
 void cw_player_set_first_name(CWPlayer *player, char *name)
 {
-  char *x = (char *) malloc(sizeof(char) * (strlen(name) + 1));
+  char *x = (char *) CW_MALLOC(sizeof(char) * (strlen(name) + 1));
   if (x == NULL) {
     return;
   }
   strcpy(x, name);
-  free(player->first_name);
+  CW_FREE(player->first_name);
   player->first_name = x;
 }
 
 void cw_player_set_last_name(CWPlayer *player, char *name)
 {
-  char *x = (char *) malloc(sizeof(char) * (strlen(name) + 1));
+  char *x = (char *) CW_MALLOC(sizeof(char) * (strlen(name) + 1));
   if (x == NULL) {
     return;
   }
   strcpy(x, name);
-  free(player->last_name);
+  CW_FREE(player->last_name);
   player->last_name = x;
 }
 
 CWRoster *cw_roster_create(char *team_id, int year, char *league, char *city, char *nickname)
 {
-  CWRoster *roster = (CWRoster *) malloc(sizeof(CWRoster));
-  roster->team_id = (char *) malloc(sizeof(char) * (strlen(team_id) + 1));
+  CWRoster *roster = (CWRoster *) CW_MALLOC(sizeof(CWRoster));
+  roster->team_id = (char *) CW_MALLOC(sizeof(char) * (strlen(team_id) + 1));
   strcpy(roster->team_id, team_id);
 
-  roster->city = (char *) malloc(sizeof(char) * (strlen(city) + 1));
+  roster->city = (char *) CW_MALLOC(sizeof(char) * (strlen(city) + 1));
   strcpy(roster->city, city);
 
-  roster->nickname = (char *) malloc(sizeof(char) * (strlen(nickname) + 1));
+  roster->nickname = (char *) CW_MALLOC(sizeof(char) * (strlen(nickname) + 1));
   strcpy(roster->nickname, nickname);
 
-  roster->league = (char *) malloc(sizeof(char) * (strlen(league) + 1));
+  roster->league = (char *) CW_MALLOC(sizeof(char) * (strlen(league) + 1));
   strcpy(roster->league, league);
 
   roster->year = year;
@@ -109,46 +111,46 @@ void cw_roster_cleanup(CWRoster *roster)
   while (player != NULL) {
     CWPlayer *next_player = player->next;
     cw_player_cleanup(player);
-    free(player);
+    CW_FREE(player);
     player = next_player;
   }
 
-  free(roster->team_id);
-  free(roster->city);
-  free(roster->nickname);
-  free(roster->league);
+  CW_FREE(roster->team_id);
+  CW_FREE(roster->city);
+  CW_FREE(roster->nickname);
+  CW_FREE(roster->league);
 }
 
 void cw_roster_set_city(CWRoster *roster, char *city)
 {
-  char *x = (char *) malloc(sizeof(char) * (strlen(city) + 1));
+  char *x = (char *) CW_MALLOC(sizeof(char) * (strlen(city) + 1));
   if (x == NULL) {
     return;
   }
   strcpy(x, city);
-  free(roster->city);
+  CW_FREE(roster->city);
   roster->city = x;
 }
 
 void cw_roster_set_nickname(CWRoster *roster, char *nickname)
 {
-  char *x = (char *) malloc(sizeof(char) * (strlen(nickname) + 1));
+  char *x = (char *) CW_MALLOC(sizeof(char) * (strlen(nickname) + 1));
   if (x == NULL) {
     return;
   }
   strcpy(x, nickname);
-  free(roster->nickname);
+  CW_FREE(roster->nickname);
   roster->nickname = x;
 }
 
 void cw_roster_set_league(CWRoster *roster, char *league)
 {
-  char *x = (char *) malloc(sizeof(char) * (strlen(league) + 1));
+  char *x = (char *) CW_MALLOC(sizeof(char) * (strlen(league) + 1));
   if (x == NULL) {
     return;
   }
   strcpy(x, league);
-  free(roster->league);
+  CW_FREE(roster->league);
   roster->league = x;
 }
 
@@ -39,7 +39,7 @@ CWPlayer *cw_player_create(char *player_id, char *last_name, char *first_name, c
 
 /*
  * Cleans up memory allocated internally by 'player'.
- * Caller is responsible for free()ing 'player' itself
+ * Caller is responsible for freeing 'player' itself with cw_free()
  */
 void cw_player_cleanup(CWPlayer *player);
 
@@ -68,7 +68,7 @@ CWRoster *cw_roster_create(char *team_id, int year, char *league, char *city, ch
 
 /*
  * Cleans up memory allocated internally to 'roster'.  Caller is
- * responsible for free()ing 'roster' itself.
+ * responsible for freeing 'roster' itself with cw_free().
  */
 void cw_roster_cleanup(CWRoster *roster);
 
@@ -0,0 +1,395 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/season.c
+ * Implementation of season totals accumulated from boxscores
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "file.h"
+#include "season.h"
+#define CW_SUBSYSTEM CW_ALLOC_SEASON
+#include "util.h"
+
+/*
+ * Bits in the flags recording which games have been counted for a
+ * player in the game being added
+ */
+#define CW_SEASON_BATTING_GAME (1U << 0)
+#define CW_SEASON_PITCHING_GAME (1U << 1)
+#define CW_SEASON_DH_GAME (1U << 2)
+#define CW_SEASON_PH_GAME (1U << 3)
+#define CW_SEASON_PR_GAME (1U << 4)
+#define CW_SEASON_P_GAME (1U << 5)
+/* Fielding games use one bit per position, starting here */
+#define CW_SEASON_FIELDING_GAME (1U << 6)
+
+/*
+ * Add 'value' to the total; once either is negative (null), the total is.
+ */
+static void cw_season_add_stat(int *total, int value)
+{
+  if (*total < 0) {
+    return;
+  }
+  *total = (value < 0) ? -1 : *total + value;
+}
+
+/*
+ * Count a game in 'total', unless it has already been counted for this
+ * player in the game being added.
+ */
+static void cw_season_add_game(CWSeasonPlayer *player, unsigned int flag, int *total, int value)
+{
+  if (value > 0 && !(player->game_flags & flag)) {
+    player->game_flags |= flag;
+    cw_season_add_stat(total, 1);
+  }
+}
+
+/* Add all batting statistics other than games */
+static void cw_season_add_batting(CWBoxBatting *total, CWBoxBatting *stat)
+{
+  cw_season_add_stat(&total->pa, stat->pa);
+  cw_season_add_stat(&total->ab, stat->ab);
+  cw_season_add_stat(&total->r, stat->r);
+  cw_season_add_stat(&total->h, stat->h);
+  cw_season_add_stat(&total->b2, stat->b2);
+  cw_season_add_stat(&total->b3, stat->b3);
+  cw_season_add_stat(&total->hr, stat->hr);
+  cw_season_add_stat(&total->hrslam, stat->hrslam);
+  cw_season_add_stat(&total->bi, stat->bi);
+  cw_season_add_stat(&total->bi2out, stat->bi2out);
+  cw_season_add_stat(&total->gw, stat->gw);
+  cw_season_add_stat(&total->bb, stat->bb);
+  cw_season_add_stat(&total->ibb, stat->ibb);
+  cw_season_add_stat(&total->so, stat->so);
+  cw_season_add_stat(&total->gdp, stat->gdp);
+  cw_season_add_stat(&total->hp, stat->hp);
+  cw_season_add_stat(&total->sh, stat->sh);
+  cw_season_add_stat(&total->sf, stat->sf);
+  cw_season_add_stat(&total->sb, stat->sb);
+  cw_season_add_stat(&total->cs, stat->cs);
+  cw_season_add_stat(&total->xi, stat->xi);
+  cw_season_add_stat(&total->lisp, stat->lisp);
+  cw_season_add_stat(&total->movedup, stat->movedup);
+  cw_season_add_stat(&total->pitches, stat->pitches);
+  cw_season_add_stat(&total->strikes, stat->strikes);
+}
+
+/* Add all pitching statistics other than games, and the 'xb' notes */
+static void cw_season_add_pitching(CWBoxPitching *total, CWBoxPitching *stat)
+{
+  cw_season_add_stat(&total->gs, stat->gs);
+  cw_season_add_stat(&total->cg, stat->cg);
+  cw_season_add_stat(&total->sho, stat->sho);
+  cw_season_add_stat(&total->gf, stat->gf);
+  cw_season_add_stat(&total->outs, stat->outs);
+  cw_season_add_stat(&total->ab, stat->ab);
+  cw_season_add_stat(&total->r, stat->r);
+  cw_season_add_stat(&total->er, stat->er);
+  cw_season_add_stat(&total->h, stat->h);
+  cw_season_add_stat(&total->b2, stat->b2);
+  cw_season_add_stat(&total->b3, stat->b3);
+  cw_season_add_stat(&total->hr, stat->hr);
+  cw_season_add_stat(&total->hrslam, stat->hrslam);
+  cw_season_add_stat(&total->bb, stat->bb);
+  cw_season_add_stat(&total->ibb, stat->ibb);
+  cw_season_add_stat(&total->so, stat->so);
+  cw_season_add_stat(&total->bf, stat->bf);
+  cw_season_add_stat(&total->bk, stat->bk);
+  cw_season_add_stat(&total->wp, stat->wp);
+  cw_season_add_stat(&total->hb, stat->hb);
+  cw_season_add_stat(&total->gdp, stat->gdp);
+  cw_season_add_stat(&total->sh, stat->sh);
+  cw_season_add_stat(&total->sf, stat->sf);
+  cw_season_add_stat(&total->xi, stat->xi);
+  cw_season_add_stat(&total->pk, stat->pk);
+  cw_season_add_stat(&total->w, stat->w);
+  cw_season_add_stat(&total->l, stat->l);
+  cw_season_add_stat(&total->sv, stat->sv);
+  cw_season_add_stat(&total->inr, stat->inr);
+  cw_season_add_stat(&total->inrs, stat->inrs);
+  cw_season_add_stat(&total->gb, stat->gb);
+  cw_season_add_stat(&total->fb, stat->fb);
+  cw_season_add_stat(&total->pitches, stat->pitches);
+  cw_season_add_stat(&total->strikes, stat->strikes);
+}
+
+/* Add all fielding statistics other than games */
+static void cw_season_add_fielding(CWBoxFielding *total, CWBoxFielding *stat)
+{
+  cw_season_add_stat(&total->outs, stat->outs);
+  cw_season_add_stat(&total->bip, stat->bip);
+  cw_season_add_stat(&total->bf, stat->bf);
+  cw_season_add_stat(&total->po, stat->po);
+  cw_season_add_stat(&total->a, stat->a);
+  cw_season_add_stat(&total->e, stat->e);
+  cw_season_add_stat(&total->dp, stat->dp);
+  cw_season_add_stat(&total->tp, stat->tp);
+  cw_season_add_stat(&total->pb, stat->pb);
+  cw_season_add_stat(&total->xi, stat->xi);
+}
+
+static unsigned int cw_season_hash(char *player_id, char *team_id, int year)
+{
+  unsigned int hash = 2166136261U;
+  char *c;
+
+  for (c = player_id; *c != '\0'; c++) {
+    hash = (hash ^ (unsigned char) *c) * 16777619U;
+  }
+  hash = (hash ^ (unsigned char) ',') * 16777619U;
+  for (c = team_id; *c != '\0'; c++) {
+    hash = (hash ^ (unsigned char) *c) * 16777619U;
+  }
+  return (hash ^ (unsigned int) year) * 16777619U;
+}
+
+static void cw_season_rehash(CWSeason *season, int num_buckets)
+{
+  CWSeasonPlayer *player;
+
+  CW_FREE(season->buckets);
+  season->buckets = (CWSeasonPlayer **) CW_CALLOC((size_t) num_buckets, sizeof(CWSeasonPlayer *));
+  season->num_buckets = num_buckets;
+  for (player = season->first_player; player != NULL; player = player->next) {
+    unsigned int bucket = cw_season_hash(player->player_id, player->team_id, player->year) &
+                          (unsigned int) (num_buckets - 1);
+    player->hash_next = season->buckets[bucket];
+    season->buckets[bucket] = player;
+  }
+}
+
+/*
+ * Find the totals for the player, adding an entry with no statistics if
+ * there is none.
+ */
+static CWSeasonPlayer *cw_season_get_player(CWSeason *season, char *player_id, char *team_id,
+                                            int year)
+{
+  CWSeasonPlayer *player = cw_season_find_player(season, player_id, team_id, year);
+  unsigned int bucket;
+
+  if (player != NULL) {
+    return player;
+  }
+
+  player = (CWSeasonPlayer *) CW_CALLOC(1, sizeof(CWSeasonPlayer));
+  XCOPY(player->player_id, player_id);
+  XCOPY(player->team_id, team_id);
+  player->year = year;
+  player->last_game = -1;
+
+  if (season->last_player == NULL) {
+    season->first_player = player;
+  }
+  else {
+    season->last_player->next = player;
+  }
+  player->prev = season->last_player;
+  season->last_player = player;
+  season->num_players++;
+
+  if (season->num_players > season->num_buckets) {
+    cw_season_rehash(season, 2 * season->num_buckets);
+  }
+  else {
+    bucket =
+      cw_season_hash(player_id, team_id, year) & (unsigned int) (season->num_buckets - 1);
+    player->hash_next = season->buckets[bucket];
+    season->buckets[bucket] = player;
+  }
+  return player;
+}
+
+/*
+ * Start counting games for 'player' in the game being added.
+ */
+static void cw_season_begin_game(CWSeason *season, CWSeasonPlayer *player)
+{
+  if (player->last_game != season->num_games) {
+    player->last_game = season->num_games;
+    player->game_flags = 0;
+  }
+}
+
+static void cw_season_add_player(CWSeason *season, CWBoxPlayer *entry, char *team_id, int year,
+                                 int pitch_data)
+{
+  CWSeasonPlayer *player = cw_season_get_player(season, entry->player_id, team_id, year);
+  CWBoxBatting batting = *entry->batting;
+  int i, pos;
+
+  cw_season_begin_game(season, player);
+  if (!pitch_data) {
+    batting.pitches = -1;
+    batting.strikes = -1;
+  }
+  cw_season_add_game(player, CW_SEASON_BATTING_GAME, &player->batting.g, batting.g);
+  cw_season_add_batting(&player->batting, &batting);
+
+  for (i = 0; i < entry->num_positions; i++) {
+    if (entry->positions[i] == 10) {
+      cw_season_add_game(player, CW_SEASON_DH_GAME, &player->g_dh, 1);
+    }
+  }
+  cw_season_add_game(player, CW_SEASON_PH_GAME, &player->g_ph, entry->ph_inn);
+  cw_season_add_game(player, CW_SEASON_PR_GAME, &player->g_pr, entry->pr_inn);
+  if (entry->start_position >= 1 && entry->start_position <= 10) {
+    player->gs[entry->start_position]++;
+  }
+
+  if (entry->fielding[1] != NULL) {
+    cw_season_add_game(player, CW_SEASON_P_GAME, &player->g_p, 1);
+  }
+  for (pos = 1; pos <= 9; pos++) {
+    if (entry->fielding[pos] != NULL) {
+      cw_season_add_game(player, CW_SEASON_FIELDING_GAME << pos, &player->fielding[pos].g,
+                         entry->fielding[pos]->g);
+      cw_season_add_fielding(&player->fielding[pos], entry->fielding[pos]);
+    }
+  }
+}
+
+static void cw_season_add_pitcher(CWSeason *season, CWBoxPitcher *entry, char *team_id, int year,
+                                  int pitch_data)
+{
+  CWSeasonPlayer *player = cw_season_get_player(season, entry->player_id, team_id, year);
+  CWBoxPitching pitching = *entry->pitching;
+
+  cw_season_begin_game(season, player);
+  if (!pitch_data) {
+    pitching.pitches = -1;
+    pitching.strikes = -1;
+  }
+  cw_season_add_game(player, CW_SEASON_PITCHING_GAME, &player->pitching.g, pitching.g);
+  cw_season_add_pitching(&player->pitching, &pitching);
+}
+
+/*
+ * Public interface
+ */
+CWSeason *cw_season_create(void)
+{
+  CWSeason *season = (CWSeason *) CW_CALLOC(1, sizeof(CWSeason));
+
+  cw_season_rehash(season, 256);
+  return season;
+}
+
+void cw_season_cleanup(CWSeason *season)
+{
+  CWSeasonPlayer *player = season->first_player;
+
+  while (player != NULL) {
+    CWSeasonPlayer *next = player->next;
+
+    XFREE(player->player_id);
+    XFREE(player->team_id);
+    CW_FREE(player);
+    player = next;
+  }
+  season->first_player = NULL;
+  season->last_player = NULL;
+  season->num_players = 0;
+  XFREE(season->buckets);
+  season->num_buckets = 0;
+}
+
+CWSeasonPlayer *cw_season_find_player(CWSeason *season, char *player_id, char *team_id,
+                                      int year)
+{
+  CWSeasonPlayer *player;
+  unsigned int bucket =
+    cw_season_hash(player_id, team_id, year) & (unsigned int) (season->num_buckets - 1);
+
+  for (player = season->buckets[bucket]; player != NULL; player = player->hash_next) {
+    if (player->year == year && !strcmp(player->player_id, player_id) &&
+        !strcmp(player->team_id, team_id)) {
+      return player;
+    }
+  }
+  return NULL;
+}
+
+void cw_season_add_boxscore(CWSeason *season, CWGame *game, CWBoxscore *box)
+{
+  char *date = cw_game_info_lookup(game, "date");
+  char *pitches = cw_game_info_lookup(game, "pitches");
+  char *team_id;
+  char year_text[5] = "";
+  int year, slot, t;
+  int pitch_data = (pitches != NULL && !strcmp(pitches, "pitches"));
+
+  if (date != NULL) {
+    strncpy(year_text, date, 4);
+    year_text[4] = '\0';
+  }
+  year = cw_atoi(year_text, NULL);
+
+  for (t = 0; t <= 1; t++) {
+    CWBoxPlayer *player;
+    CWBoxPitcher *pitcher;
+
+    team_id = cw_game_info_lookup(game, (t == 0) ? "visteam" : "hometeam");
+    if (team_id == NULL) {
+      team_id = "";
+    }
+    for (slot = 0; slot <= 9; slot++) {
+      for (player = box->slots[slot][t]; player != NULL; player = player->prev) {
+        cw_season_add_player(season, player, team_id, year, pitch_data);
+      }
+    }
+    for (pitcher = box->pitchers[t]; pitcher != NULL; pitcher = pitcher->prev) {
+      cw_season_add_pitcher(season, pitcher, team_id, year, pitch_data);
+    }
+  }
+  season->num_games++;
+}
+
+void cw_season_merge(CWSeason *season, CWSeason *partial)
+{
+  CWSeasonPlayer *source, *player;
+  int pos;
+
+  for (source = partial->first_player; source != NULL; source = source->next) {
+    player = cw_season_get_player(season, source->player_id, source->team_id, source->year);
+
+    cw_season_add_stat(&player->batting.g, source->batting.g);
+    cw_season_add_batting(&player->batting, &source->batting);
+    player->g_dh += source->g_dh;
+    player->g_ph += source->g_ph;
+    player->g_pr += source->g_pr;
+    player->g_p += source->g_p;
+    cw_season_add_stat(&player->pitching.g, source->pitching.g);
+    cw_season_add_pitching(&player->pitching, &source->pitching);
+    for (pos = 1; pos <= 9; pos++) {
+      cw_season_add_stat(&player->fielding[pos].g, source->fielding[pos].g);
+      cw_season_add_fielding(&player->fielding[pos], &source->fielding[pos]);
+    }
+    for (pos = 1; pos <= 10; pos++) {
+      player->gs[pos] += source->gs[pos];
+    }
+  }
+  season->num_games += partial->num_games;
+}
@@ -0,0 +1,103 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/season.h
+ * Declaration of season totals accumulated from boxscores
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef CW_SEASON_H
+#define CW_SEASON_H
+
+#include "box.h"
+
+/*
+ * A player's totals for one team in one season.  The statistics are
+ * the sums of those in the player's boxscore entries, except that games
+ * (batting->g, pitching->g) count each game once, even if the player has
+ * more than one entry in it.  A negative total is null: it means some
+ * game's value was unknown, as happens with boxscore files.  The
+ * pitching 'xb' and 'xbinn' notes are not accumulated.
+ */
+typedef struct cw_season_player_struct {
+  char *player_id, *team_id;
+  int year;
+  CWBoxBatting batting;
+  /* Games as designated hitter, pinch-hitter, and pinch-runner */
+  int g_dh, g_ph, g_pr;
+  /* Games with an entry at pitcher, including those in which the
+   * pitcher was on the field for no event, which fielding[1].g does
+   * not count */
+  int g_p;
+  CWBoxPitching pitching;
+  /* Fielding statistics per position (uses usual position numbering) */
+  CWBoxFielding fielding[10];
+  /* Games started at each position; 10 is designated hitter */
+  int gs[11];
+  /* The number of the last game the player appeared in, and which games
+   * (batting, pitching, ...) have been counted in it, so that each is
+   * counted once */
+  int last_game;
+  unsigned int game_flags;
+  struct cw_season_player_struct *prev, *next, *hash_next;
+} CWSeasonPlayer;
+
+/*
+ * Totals for all players in the games added.  Players are kept in the
+ * order they were first seen, and hashed on player, team and year for
+ * lookup.
+ */
+typedef struct cw_season_struct {
+  CWSeasonPlayer *first_player, *last_player;
+  CWSeasonPlayer **buckets;
+  int num_buckets, num_players, num_games;
+} CWSeason;
+
+/*
+ * Allocates and initializes a new CWSeason, with no games.
+ * Caller is responsible for memory management of the created pointer.
+ */
+CWSeason *cw_season_create(void);
+
+/*
+ * Cleans up internal memory allocation associated with 'season'.
+ * Caller is responsible for freeing the season itself with cw_free().
+ */
+void cw_season_cleanup(CWSeason *season);
+
+/*
+ * Find the totals for 'player_id' with 'team_id' in 'year'; returns NULL
+ * if the player has not appeared for that team in that year.
+ */
+CWSeasonPlayer *cw_season_find_player(CWSeason *season, char *player_id, char *team_id,
+                                      int year);
+
+/*
+ * Add the statistics in the boxscore 'box' of 'game' to the totals.
+ */
+void cw_season_add_boxscore(CWSeason *season, CWGame *game, CWBoxscore *box);
+
+/*
+ * Add the totals in 'partial' to those in 'season'.  The two must have
+ * been accumulated from different games; for instance, partial totals
+ * kept separately for each part of a set of files can be merged at the
+ * end.  'partial' is unchanged.
+ */
+void cw_season_merge(CWSeason *season, CWSeason *partial);
+
+#endif /* CW_SEASON_H */
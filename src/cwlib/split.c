@@ -0,0 +1,319 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/split.c
+ * Implementation of split statistics accumulated from play-by-play
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "file.h"
+#include "split.h"
+#define CW_SUBSYSTEM CW_ALLOC_SPLIT
+#include "util.h"
+
+/*
+ * The line for the plate appearance at the current event, counted as
+ * in the boxscore.
+ */
+static void cw_splits_event_line(CWSplitLine *line, CWEventData *event_data)
+{
+  memset(line, 0, sizeof(CWSplitLine));
+  line->pa = 1;
+  line->outs = cw_event_outs_on_play(event_data);
+  line->bi = cw_event_rbi_on_play(event_data);
+
+  if (cw_event_is_official_ab(event_data)) {
+    line->ab = 1;
+    if (event_data->event_type >= CW_EVENT_SINGLE && event_data->event_type <= CW_EVENT_HOMERUN) {
+      line->h = 1;
+      line->b2 = (event_data->event_type == CW_EVENT_DOUBLE);
+      line->b3 = (event_data->event_type == CW_EVENT_TRIPLE);
+      line->hr = (event_data->event_type == CW_EVENT_HOMERUN);
+    }
+    else if (event_data->event_type == CW_EVENT_STRIKEOUT) {
+      line->so = 1;
+    }
+    else if (event_data->gdp_flag) {
+      line->gdp = 1;
+    }
+  }
+  else if (event_data->event_type == CW_EVENT_WALK ||
+           event_data->event_type == CW_EVENT_INTENTIONALWALK) {
+    line->bb = 1;
+    line->ibb = (event_data->event_type == CW_EVENT_INTENTIONALWALK);
+  }
+  else if (event_data->event_type == CW_EVENT_HITBYPITCH) {
+    line->hp = 1;
+  }
+  else if (event_data->event_type == CW_EVENT_INTERFERENCE) {
+    line->xi = 1;
+  }
+  line->sh = (event_data->sh_flag != 0);
+  line->sf = (event_data->sf_flag != 0);
+}
+
+static int cw_splits_hand(char hand)
+{
+  switch (hand) {
+  case 'L':
+    return CW_SPLIT_HAND_LEFT;
+  case 'R':
+    return CW_SPLIT_HAND_RIGHT;
+  default:
+    return CW_SPLIT_HAND_UNKNOWN;
+  }
+}
+
+/*
+ * The situations the plate appearance at the current event is counted
+ * in; returns the number of them.
+ */
+static int cw_splits_event_situations(CWGameIterator *gameiter, int *situations)
+{
+  CWGameState *state = gameiter->state;
+  char *count = gameiter->event->count;
+  int bases = 0, runners = 0, lead, base, n = 0;
+
+  for (base = 1; base <= 3; base++) {
+    if (cw_gamestate_base_occupied(state, base)) {
+      bases |= 1 << (base - 1);
+      runners++;
+    }
+  }
+  situations[n++] = CW_SPLIT_BASE_OUT + 3 * bases + ((state->outs < 2) ? state->outs : 2);
+
+  if (count != NULL && count[0] >= '0' && count[0] <= '3' && count[1] >= '0' &&
+      count[1] <= '2') {
+    situations[n++] = CW_SPLIT_COUNT + 3 * (count[0] - '0') + (count[1] - '0');
+  }
+  else {
+    situations[n++] = CW_SPLIT_COUNT_UNKNOWN;
+  }
+
+  situations[n++] =
+    (state->inning <= 9) ? CW_SPLIT_INNING + state->inning - 1 : CW_SPLIT_EXTRA_INNINGS;
+
+  lead = state->score[state->batting_team] - state->score[1 - state->batting_team];
+  if (state->inning >= 7 && ((lead >= 0) ? lead <= 1 : -lead <= runners + 2)) {
+    situations[n++] = CW_SPLIT_LATE_CLOSE;
+  }
+
+  return n;
+}
+
+static unsigned int cw_splits_hash(char *player_id, int year)
+{
+  unsigned int hash = 2166136261U;
+  char *c;
+
+  for (c = player_id; *c != '\0'; c++) {
+    hash = (hash ^ (unsigned char) *c) * 16777619U;
+  }
+  return (hash ^ (unsigned int) year) * 16777619U;
+}
+
+static void cw_splits_rehash(CWSplits *splits, int num_buckets)
+{
+  CWSplitPlayer *player;
+
+  CW_FREE(splits->buckets);
+  splits->buckets = (CWSplitPlayer **) CW_CALLOC((size_t) num_buckets, sizeof(CWSplitPlayer *));
+  splits->num_buckets = num_buckets;
+  for (player = splits->first_player; player != NULL; player = player->next) {
+    unsigned int bucket =
+      cw_splits_hash(player->player_id, player->year) & (unsigned int) (num_buckets - 1);
+    player->hash_next = splits->buckets[bucket];
+    splits->buckets[bucket] = player;
+  }
+}
+
+/*
+ * Find the splits for the player, adding an entry with no plate
+ * appearances if there is none.
+ */
+static CWSplitPlayer *cw_splits_get_player(CWSplits *splits, char *player_id, int year)
+{
+  CWSplitPlayer *player = cw_splits_find_player(splits, player_id, year);
+  unsigned int bucket;
+
+  if (player != NULL) {
+    return player;
+  }
+
+  player = (CWSplitPlayer *) CW_CALLOC(1, sizeof(CWSplitPlayer));
+  if (player == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for splits\n");
+    exit(1);
+  }
+  XCOPY(player->player_id, player_id);
+  player->year = year;
+
+  player->prev = splits->last_player;
+  if (splits->last_player != NULL) {
+    splits->last_player->next = player;
+  }
+  else {
+    splits->first_player = player;
+  }
+  splits->last_player = player;
+
+  bucket = cw_splits_hash(player_id, year) & (unsigned int) (splits->num_buckets - 1);
+  player->hash_next = splits->buckets[bucket];
+  splits->buckets[bucket] = player;
+  if (++splits->num_players > splits->num_buckets) {
+    cw_splits_rehash(splits, 2 * splits->num_buckets);
+  }
+  return player;
+}
+
+/*
+ * Public interface
+ */
+CWSplits *cw_splits_create(void)
+{
+  CWSplits *splits = (CWSplits *) CW_CALLOC(1, sizeof(CWSplits));
+
+  cw_splits_rehash(splits, 256);
+  return splits;
+}
+
+void cw_splits_cleanup(CWSplits *splits)
+{
+  CWSplitPlayer *player = splits->first_player;
+
+  while (player != NULL) {
+    CWSplitPlayer *next = player->next;
+
+    XFREE(player->player_id);
+    CW_FREE(player);
+    player = next;
+  }
+  splits->first_player = NULL;
+  splits->last_player = NULL;
+  splits->num_players = 0;
+  XFREE(splits->buckets);
+  splits->num_buckets = 0;
+}
+
+CWSplitPlayer *cw_splits_find_player(CWSplits *splits, char *player_id, int year)
+{
+  CWSplitPlayer *player;
+  unsigned int bucket =
+    cw_splits_hash(player_id, year) & (unsigned int) (splits->num_buckets - 1);
+
+  for (player = splits->buckets[bucket]; player != NULL; player = player->hash_next) {
+    if (player->year == year && !strcmp(player->player_id, player_id)) {
+      return player;
+    }
+  }
+  return NULL;
+}
+
+void cw_splits_add_line(CWSplitLine *total, CWSplitLine *line)
+{
+  total->pa += line->pa;
+  total->ab += line->ab;
+  total->h += line->h;
+  total->b2 += line->b2;
+  total->b3 += line->b3;
+  total->hr += line->hr;
+  total->bi += line->bi;
+  total->bb += line->bb;
+  total->ibb += line->ibb;
+  total->hp += line->hp;
+  total->so += line->so;
+  total->sh += line->sh;
+  total->sf += line->sf;
+  total->gdp += line->gdp;
+  total->xi += line->xi;
+  total->outs += line->outs;
+}
+
+void cw_splits_add_game(CWSplits *splits, CWGame *game, CWRoster *visitors, CWRoster *home)
+{
+  char *date = cw_game_info_lookup(game, "date");
+  char year_text[5] = "";
+  int year, i, n, situations[4];
+  CWGameIterator *gameiter;
+
+  if (date != NULL) {
+    strncpy(year_text, date, 4);
+    year_text[4] = '\0';
+  }
+  year = cw_atoi(year_text, NULL);
+
+  gameiter = cw_gameiter_create(game);
+  while (gameiter->event != NULL) {
+    char *batter_id = NULL, *pitcher_id = NULL;
+
+    if (strcmp(gameiter->event->event_text, "NP") != 0 &&
+        cw_event_is_batter(gameiter->event_data)) {
+      batter_id = cw_gamestate_charged_batter(gameiter->state, gameiter->event->batter,
+                                              gameiter->event_data);
+      pitcher_id = cw_gamestate_charged_pitcher(gameiter->state, gameiter->event_data);
+    }
+    if (batter_id != NULL && pitcher_id != NULL) {
+      CWRoster *offense = (gameiter->state->batting_team == 0) ? visitors : home;
+      CWRoster *defense = (gameiter->state->batting_team == 0) ? home : visitors;
+      CWSplitPlayer *batter = cw_splits_get_player(splits, batter_id, year);
+      CWSplitPlayer *pitcher = cw_splits_get_player(splits, pitcher_id, year);
+      int batter_hand = cw_splits_hand(cw_gamestate_charged_batter_hand(
+        gameiter->state, gameiter->event->batter, gameiter->event_data, offense, defense));
+      int pitcher_hand =
+        cw_splits_hand((gameiter->state->pitcher_hand != ' ')
+                         ? gameiter->state->pitcher_hand
+                         : cw_roster_throwing_hand(defense, pitcher_id));
+      CWSplitLine line;
+
+      cw_splits_event_line(&line, gameiter->event_data);
+      n = cw_splits_event_situations(gameiter, situations);
+      for (i = 0; i < n; i++) {
+        cw_splits_add_line(&batter->batting[pitcher_hand][situations[i]], &line);
+        cw_splits_add_line(&pitcher->pitching[batter_hand][situations[i]], &line);
+      }
+    }
+    cw_gameiter_next(gameiter);
+  }
+  cw_gameiter_cleanup(gameiter);
+  CW_FREE(gameiter);
+
+  splits->num_games++;
+}
+
+void cw_splits_merge(CWSplits *splits, CWSplits *partial)
+{
+  CWSplitPlayer *source, *player;
+  int hand, situation;
+
+  for (source = partial->first_player; source != NULL; source = source->next) {
+    player = cw_splits_get_player(splits, source->player_id, source->year);
+    for (hand = 0; hand < CW_SPLIT_HANDS; hand++) {
+      for (situation = 0; situation < CW_SPLIT_SITUATIONS; situation++) {
+        cw_splits_add_line(&player->batting[hand][situation],
+                           &source->batting[hand][situation]);
+        cw_splits_add_line(&player->pitching[hand][situation],
+                           &source->pitching[hand][situation]);
+      }
+    }
+  }
+  splits->num_games += partial->num_games;
+}
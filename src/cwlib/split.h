@@ -0,0 +1,132 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/split.h
+ * Declaration of split statistics accumulated from play-by-play
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef CW_SPLIT_H
+#define CW_SPLIT_H
+
+#include "gameiter.h"
+#include "roster.h"
+
+/*
+ * The hand of the opponent: the pitcher for batting lines, and the
+ * batter (taking switch-hitters to bat from the opposite side) for
+ * pitching lines.
+ */
+#define CW_SPLIT_HAND_LEFT 0
+#define CW_SPLIT_HAND_RIGHT 1
+#define CW_SPLIT_HAND_UNKNOWN 2
+#define CW_SPLIT_HANDS 3
+
+/*
+ * The situations in which plate appearances are counted.  Each plate
+ * appearance is counted in one base-out state, one count and one
+ * inning, and also as late and close if it is.  Totals over all plate
+ * appearances are the sum over the base-out states (or the counts, or
+ * the innings).
+ *
+ * Base-out states are numbered 3 * bases + outs, where bases has 1 for
+ * a runner on first, 2 for second and 4 for third.  Counts are numbered
+ * 3 * balls + strikes, with the count unknown last.  Innings are 1
+ * through 9, then all extra innings.  Late and close is the seventh
+ * inning or later, with the batting team tied, ahead by one, or with
+ * the tying run at least on deck.
+ */
+#define CW_SPLIT_BASE_OUT 0
+#define CW_SPLIT_COUNT 24
+#define CW_SPLIT_COUNT_UNKNOWN 36
+#define CW_SPLIT_INNING 37
+#define CW_SPLIT_EXTRA_INNINGS 46
+#define CW_SPLIT_LATE_CLOSE 47
+#define CW_SPLIT_SITUATIONS 48
+
+/*
+ * The statistics of the plate appearances in one split.  'outs' are the
+ * outs made on the plays.
+ */
+typedef struct cw_split_line_struct {
+  int pa, ab, h, b2, b3, hr, bi, bb, ibb, hp, so, sh, sf, gdp, xi, outs;
+} CWSplitLine;
+
+/*
+ * A player's splits in one season, as a batter and as a pitcher, by
+ * hand of the opponent and situation.  Plate appearances are credited
+ * to the charged batter and pitcher.
+ */
+typedef struct cw_split_player_struct {
+  char *player_id;
+  int year;
+  CWSplitLine batting[CW_SPLIT_HANDS][CW_SPLIT_SITUATIONS];
+  CWSplitLine pitching[CW_SPLIT_HANDS][CW_SPLIT_SITUATIONS];
+  struct cw_split_player_struct *prev, *next, *hash_next;
+} CWSplitPlayer;
+
+/*
+ * Splits for all players in the games added.  Players are kept in the
+ * order they were first seen, and hashed on player and year for lookup.
+ */
+typedef struct cw_splits_struct {
+  CWSplitPlayer *first_player, *last_player;
+  CWSplitPlayer **buckets;
+  int num_buckets, num_players, num_games;
+} CWSplits;
+
+/*
+ * Allocates and initializes a new CWSplits, with no games.
+ * Caller is responsible for memory management of the created pointer.
+ */
+CWSplits *cw_splits_create(void);
+
+/*
+ * Cleans up internal memory allocation associated with 'splits'.
+ * Caller is responsible for freeing the splits themselves with cw_free().
+ */
+void cw_splits_cleanup(CWSplits *splits);
+
+/*
+ * Find the splits for 'player_id' in 'year'; returns NULL if the player
+ * has no plate appearances in that year.
+ */
+CWSplitPlayer *cw_splits_find_player(CWSplits *splits, char *player_id, int year);
+
+/*
+ * Add the statistics of 'line' to 'total', as in combining the lines of
+ * several situations or hands into one.
+ */
+void cw_splits_add_line(CWSplitLine *total, CWSplitLine *line);
+
+/*
+ * Add the plate appearances of 'game' to the splits.  The rosters
+ * 'visitors' and 'home' (either may be NULL) give the hands of players,
+ * where the game does not.  Games without play-by-play add nothing.
+ */
+void cw_splits_add_game(CWSplits *splits, CWGame *game, CWRoster *visitors, CWRoster *home);
+
+/*
+ * Add the lines in 'partial' to those in 'splits'.  The two must have
+ * been accumulated from different games; for instance, splits kept
+ * separately for each part of a set of files, possibly in different
+ * threads, can be merged at the end.  'partial' is unchanged.
+ */
+void cw_splits_merge(CWSplits *splits, CWSplits *partial);
+
+#endif /* CW_SPLIT_H */
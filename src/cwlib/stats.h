@@ -0,0 +1,63 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwlib/stats.h
+ * Declaration of counts of the work done by the library
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef CW_STATS_H
+#define CW_STATS_H
+
+/*
+ * Storage class for the library's counters, of which each thread has
+ * its own copy, so that threads count without locking or interfering.
+ */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define CW_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define CW_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define CW_THREAD_LOCAL __declspec(thread)
+#else
+#define CW_THREAD_LOCAL
+#endif
+
+/*
+ * Counts of the work done by the library, for reporting throughput.
+ * The counts are kept for each thread, and only ever increase; the
+ * counts for some piece of work are the differences between the counts
+ * before and after it.
+ *
+ * 'bytes_read' counts the bytes read by record readers, from event
+ * files, rosters and the like, and by cw_file_skip_game(); a record read
+ * again after seeking back to it is counted again.  'games_read' and
+ * 'events_read' count games, and their 'play' records, read by
+ * cw_game_read().  'events_parsed' and 'parse_failures' count the event
+ * texts parsed by game iterators, and those which could not be; an
+ * event is counted each time its game is iterated over.
+ */
+typedef struct cw_stats_struct {
+  long long bytes_read;
+  long long games_read, events_read;
+  long long events_parsed, parse_failures;
+} CWStats;
+
+extern CW_THREAD_LOCAL CWStats cw_stats;
+
+#endif /* CW_STATS_H */
@@ -21,11 +21,26 @@
  * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
  */
 
+#include "alloc.h"
+
+/* Memory is allocated and freed through the library's allocator (see
+ * alloc.h), counted against CW_SUBSYSTEM, which a source file defines
+ * before including this one; otherwise it is counted as "other". */
+#ifndef CW_SUBSYSTEM
+#define CW_SUBSYSTEM CW_ALLOC_OTHER
+#endif
+
+#define CW_MALLOC(size) cw_malloc(CW_SUBSYSTEM, (size))
+#define CW_CALLOC(count, size) cw_calloc(CW_SUBSYSTEM, (count), (size))
+#define CW_REALLOC(ptr, size) cw_realloc(CW_SUBSYSTEM, (ptr), (size))
+#define CW_FREE(ptr) cw_free(CW_SUBSYSTEM, (ptr))
+#define CW_STRDUP(text) cw_strdup(CW_SUBSYSTEM, (text))
+
 /* This macro is a convenient shorthand for free()ing and NULLing a pointer
  * if it's not currently NULL. */
 #define XFREE(var)                                                                                \
   if (var) {                                                                                      \
-    free((var));                                                                                  \
+    CW_FREE((var));                                                                               \
     (var) = NULL;                                                                                 \
   }
 
@@ -33,8 +48,7 @@
  * pointer to a string, if it's not currently NULL */
 #define XCOPY(dest, src)                                                                          \
   if (src) {                                                                                      \
-    dest = (char *) malloc(sizeof(char) * (strlen(src) + 1));                                     \
-    strcpy(dest, src);                                                                            \
+    dest = CW_STRDUP(src);                                                                        \
   }                                                                                               \
   else {                                                                                          \
     dest = NULL;                                                                                  \
@@ -0,0 +1,754 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/arrowwrite.c
+ * Implementation of API for generating Apache Arrow IPC stream output
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+#include "arrowwrite.h"
+
+/*
+ * Constants from the Arrow flatbuffer schemas (Message.fbs, Schema.fbs)
+ */
+#define ARROW_METADATA_V5 4
+
+#define ARROW_HEADER_SCHEMA 1
+#define ARROW_HEADER_DICTIONARY_BATCH 2
+#define ARROW_HEADER_RECORD_BATCH 3
+
+#define ARROW_TYPE_INT 2
+#define ARROW_TYPE_UTF8 5
+#define ARROW_TYPE_BOOL 6
+
+/* Largest number of fields in any table we write */
+#define ARROW_FB_MAX_FIELDS 8
+
+/*
+ * A growable array of bytes.  This holds flatbuffer metadata and message
+ * bodies while they are built, and the buffers of each column.  Multi-byte
+ * values are always stored little-endian, as Arrow requires.
+ */
+typedef struct arrow_bytes_struct {
+  unsigned char *data;
+  size_t length, capacity;
+} ArrowBytes;
+
+/*
+ * The dictionary of an ID column.  Entries are kept for the whole stream;
+ * those from 'written' onwards have not yet been sent in a dictionary batch.
+ * Successive events mostly repeat the same IDs, so the entry last looked
+ * up is checked before the hash table.
+ */
+typedef struct arrow_dictionary_struct {
+  ArrowBytes data;
+  int32_t *offsets;
+  int count, capacity, written, last;
+  int *slots, num_slots;
+} ArrowDictionary;
+
+struct arrow_column_struct {
+  char *name;
+  CWFieldType type;
+  int width, null_count;
+  /* 'values' holds fixed-width values of 'width' bytes, flag bits, or
+   * utf8 offsets; 'data' holds the utf8 characters of text columns.
+   * 'validity' and 'values' are allocated for a full batch up front. */
+  ArrowBytes validity, values, data;
+  ArrowDictionary *dictionary;
+};
+
+typedef struct arrow_column_struct ArrowColumn;
+
+struct arrow_stream_struct {
+  FILE *f;
+  int batch_size, rows, batches, started;
+  int num_columns;
+  ArrowColumn *columns;
+  /* Scratch space for building messages */
+  ArrowBytes meta, body, nodes, buffers, offsets;
+};
+
+/*
+ * A field of a flatbuffer table to be written.  A size of zero means the
+ * field is absent; an offset field is written as a placeholder, to be
+ * patched once the object it refers to has been written.
+ */
+typedef struct arrow_fb_field_struct {
+  int size, is_offset;
+  uint64_t value;
+} ArrowFBField;
+
+/*
+ * Private auxiliary functions for byte arrays
+ */
+static void arrow_bytes_reserve(ArrowBytes *b, size_t n)
+{
+  size_t capacity;
+  unsigned char *data;
+
+  if (b->length + n <= b->capacity) {
+    return;
+  }
+  capacity = (b->capacity > 0) ? b->capacity : 1024;
+  while (b->length + n > capacity) {
+    capacity *= 2;
+  }
+  data = (unsigned char *) realloc(b->data, capacity);
+  if (data == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for Arrow output\n");
+    exit(1);
+  }
+  b->data = data;
+  b->capacity = capacity;
+}
+
+static void arrow_bytes_append(ArrowBytes *b, const void *src, size_t n)
+{
+  arrow_bytes_reserve(b, n);
+  if (n > 0) {
+    memcpy(b->data + b->length, src, n);
+  }
+  b->length += n;
+}
+
+static void arrow_bytes_append_zeros(ArrowBytes *b, size_t n)
+{
+  arrow_bytes_reserve(b, n);
+  memset(b->data + b->length, 0, n);
+  b->length += n;
+}
+
+static void arrow_bytes_pad(ArrowBytes *b, size_t align)
+{
+  if (b->length % align != 0) {
+    arrow_bytes_append_zeros(b, align - b->length % align);
+  }
+}
+
+static void arrow_bytes_put(ArrowBytes *b, size_t pos, uint64_t value, int size)
+{
+  int i;
+
+  for (i = 0; i < size; i++) {
+    b->data[pos + (size_t) i] = (unsigned char) (value >> (8 * i));
+  }
+}
+
+static void arrow_bytes_append_int(ArrowBytes *b, uint64_t value, int size)
+{
+  arrow_bytes_reserve(b, (size_t) size);
+  arrow_bytes_put(b, b->length, value, size);
+  b->length += (size_t) size;
+}
+
+static void arrow_bytes_cleanup(ArrowBytes *b)
+{
+  free(b->data);
+  b->data = NULL;
+  b->length = b->capacity = 0;
+}
+
+/*
+ * Private auxiliary functions for building flatbuffers.
+ *
+ * Objects are laid out front to back: the root offset comes first, and
+ * every object is written after the table which refers to it, so that
+ * offsets (which must point forward) can be patched in as each object
+ * is written.
+ */
+static void arrow_fb_patch(ArrowBytes *b, size_t slot, size_t target)
+{
+  arrow_bytes_put(b, slot, (uint64_t) (target - slot), 4);
+}
+
+/* Write a table, storing the positions of its offset fields in 'slots' */
+static size_t arrow_fb_table(ArrowBytes *b, const ArrowFBField *fields, int count, size_t *slots)
+{
+  size_t position[ARROW_FB_MAX_FIELDS];
+  size_t size = 4, vtable, table;
+  int i, width;
+
+  /* Fields are placed largest first; as the table itself starts at 4
+   * modulo 8, this aligns all of them naturally */
+  for (width = 8; width >= 1; width /= 2) {
+    for (i = 0; i < count; i++) {
+      if (fields[i].size == width) {
+        position[i] = size;
+        size += (size_t) width;
+      }
+    }
+  }
+
+  arrow_bytes_pad(b, 2);
+  vtable = b->length;
+  arrow_bytes_append_int(b, 4 + 2 * (uint64_t) count, 2);
+  arrow_bytes_append_int(b, size, 2);
+  for (i = 0; i < count; i++) {
+    arrow_bytes_append_int(b, (fields[i].size > 0) ? position[i] : 0, 2);
+  }
+
+  arrow_bytes_pad(b, 4);
+  if (b->length % 8 == 0) {
+    arrow_bytes_append_zeros(b, 4);
+  }
+  table = b->length;
+  arrow_bytes_append_zeros(b, size);
+  arrow_bytes_put(b, table, table - vtable, 4);
+  for (i = 0; i < count; i++) {
+    if (fields[i].size > 0) {
+      arrow_bytes_put(b, table + position[i], fields[i].value, fields[i].size);
+      if (fields[i].is_offset) {
+        slots[i] = table + position[i];
+      }
+    }
+  }
+  return table;
+}
+
+static size_t arrow_fb_string(ArrowBytes *b, const char *s)
+{
+  size_t length = strlen(s), vector;
+
+  arrow_bytes_pad(b, 4);
+  vector = b->length;
+  arrow_bytes_append_int(b, length, 4);
+  arrow_bytes_append(b, s, length + 1);
+  return vector;
+}
+
+/* Write a vector of 'count' offsets; element i is at the returned position + 4 + 4i */
+static size_t arrow_fb_offset_vector(ArrowBytes *b, int count)
+{
+  size_t vector;
+
+  arrow_bytes_pad(b, 4);
+  vector = b->length;
+  arrow_bytes_append_int(b, (uint64_t) count, 4);
+  arrow_bytes_append_zeros(b, 4 * (size_t) count);
+  return vector;
+}
+
+/* Write a vector of the 16-byte structs (FieldNode or Buffer) held in 'structs' */
+static size_t arrow_fb_struct_vector(ArrowBytes *b, const ArrowBytes *structs)
+{
+  size_t vector;
+
+  arrow_bytes_pad(b, 4);
+  if (b->length % 8 == 0) {
+    arrow_bytes_append_zeros(b, 4);
+  }
+  vector = b->length;
+  arrow_bytes_append_int(b, structs->length / 16, 4);
+  arrow_bytes_append(b, structs->data, structs->length);
+  return vector;
+}
+
+static size_t arrow_fb_int_type(ArrowBytes *b, int bit_width)
+{
+  ArrowFBField fields[2] = {{4, 0, (uint64_t) bit_width}, {1, 0, 1}};
+
+  return arrow_fb_table(b, fields, 2, NULL);
+}
+
+/*
+ * Start a new message in 'b', returning the slot for the offset of the
+ * message header.
+ */
+static size_t arrow_fb_message(ArrowBytes *b, int header_type, size_t body_length)
+{
+  ArrowFBField fields[4] = {
+    {2, 0, ARROW_METADATA_V5}, {1, 0, (uint64_t) header_type}, {4, 1, 0}, {8, 0, body_length}};
+  size_t slots[4], table;
+
+  b->length = 0;
+  arrow_bytes_append_zeros(b, 4);
+  table = arrow_fb_table(b, fields, 4, slots);
+  arrow_fb_patch(b, 0, table);
+  return slots[2];
+}
+
+/*
+ * Write a RecordBatch table describing the nodes and buffers collected
+ * in the stream's scratch space.
+ */
+static size_t arrow_fb_record_batch(ArrowStream *stream, int length)
+{
+  ArrowFBField fields[3] = {{8, 0, (uint64_t) length}, {4, 1, 0}, {4, 1, 0}};
+  size_t slots[3], table;
+
+  table = arrow_fb_table(&stream->meta, fields, 3, slots);
+  arrow_fb_patch(&stream->meta, slots[1], arrow_fb_struct_vector(&stream->meta, &stream->nodes));
+  arrow_fb_patch(&stream->meta, slots[2], arrow_fb_struct_vector(&stream->meta, &stream->buffers));
+  return table;
+}
+
+/*
+ * Private auxiliary functions for writing messages
+ */
+static void arrow_stream_write_message(ArrowStream *stream)
+{
+  unsigned char prefix[8];
+
+  arrow_bytes_pad(&stream->meta, 8);
+  prefix[0] = prefix[1] = prefix[2] = prefix[3] = 0xFF;
+  prefix[4] = (unsigned char) (stream->meta.length & 0xFF);
+  prefix[5] = (unsigned char) ((stream->meta.length >> 8) & 0xFF);
+  prefix[6] = (unsigned char) ((stream->meta.length >> 16) & 0xFF);
+  prefix[7] = (unsigned char) ((stream->meta.length >> 24) & 0xFF);
+  fwrite(prefix, 1, sizeof(prefix), stream->f);
+  fwrite(stream->meta.data, 1, stream->meta.length, stream->f);
+  if (stream->body.length > 0) {
+    fwrite(stream->body.data, 1, stream->body.length, stream->f);
+  }
+}
+
+static void arrow_stream_begin_body(ArrowStream *stream)
+{
+  stream->body.length = 0;
+  stream->nodes.length = 0;
+  stream->buffers.length = 0;
+}
+
+static void arrow_stream_add_node(ArrowStream *stream, int length, int null_count)
+{
+  arrow_bytes_append_int(&stream->nodes, (uint64_t) length, 8);
+  arrow_bytes_append_int(&stream->nodes, (uint64_t) null_count, 8);
+}
+
+static void arrow_stream_add_buffer(ArrowStream *stream, const unsigned char *data, size_t length)
+{
+  arrow_bytes_append_int(&stream->buffers, stream->body.length, 8);
+  arrow_bytes_append_int(&stream->buffers, length, 8);
+  arrow_bytes_append(&stream->body, data, length);
+  arrow_bytes_pad(&stream->body, 8);
+}
+
+static void arrow_stream_write_schema(ArrowStream *stream)
+{
+  ArrowBytes *b = &stream->meta;
+  ArrowFBField schema_fields[2] = {{2, 0, 0}, {4, 1, 0}};
+  size_t slots[ARROW_FB_MAX_FIELDS], header, vector;
+  int i;
+
+  arrow_stream_begin_body(stream);
+  header = arrow_fb_message(b, ARROW_HEADER_SCHEMA, 0);
+  arrow_fb_patch(b, header, arrow_fb_table(b, schema_fields, 2, slots));
+  vector = arrow_fb_offset_vector(b, stream->num_columns);
+  arrow_fb_patch(b, slots[1], vector);
+
+  for (i = 0; i < stream->num_columns; i++) {
+    ArrowColumn *column = stream->columns + i;
+    int type_type = ARROW_TYPE_UTF8, bit_width = 0;
+    ArrowFBField fields[6] = {{4, 1, 0}, {1, 0, 1}, {1, 0, 0},
+                              {4, 1, 0}, {0, 1, 0}, {4, 1, 0}};
+
+    switch (column->type) {
+    case CW_FIELD_FLAG:
+      type_type = ARROW_TYPE_BOOL;
+      break;
+    case CW_FIELD_INT8:
+      type_type = ARROW_TYPE_INT;
+      bit_width = 8;
+      break;
+    case CW_FIELD_INT16:
+      type_type = ARROW_TYPE_INT;
+      bit_width = 16;
+      break;
+    case CW_FIELD_INT32:
+      type_type = ARROW_TYPE_INT;
+      bit_width = 32;
+      break;
+    case CW_FIELD_ID:
+      fields[4].size = 4;
+      break;
+    default:
+      break;
+    }
+    fields[2].value = (uint64_t) type_type;
+
+    arrow_fb_patch(b, vector + 4 + 4 * (size_t) i, arrow_fb_table(b, fields, 6, slots));
+    arrow_fb_patch(b, slots[0], arrow_fb_string(b, column->name));
+    if (bit_width > 0) {
+      arrow_fb_patch(b, slots[3], arrow_fb_int_type(b, bit_width));
+    }
+    else {
+      arrow_fb_patch(b, slots[3], arrow_fb_table(b, NULL, 0, NULL));
+    }
+    if (column->dictionary != NULL) {
+      /* Dictionary indices are int32; the dictionary ID is the column number */
+      ArrowFBField encoding[3] = {{8, 0, (uint64_t) i}, {4, 1, 0}, {1, 0, 0}};
+      size_t dict_slots[3];
+
+      arrow_fb_patch(b, slots[4], arrow_fb_table(b, encoding, 3, dict_slots));
+      arrow_fb_patch(b, dict_slots[1], arrow_fb_int_type(b, 32));
+    }
+    arrow_fb_patch(b, slots[5], arrow_fb_offset_vector(b, 0));
+  }
+
+  arrow_stream_write_message(stream);
+}
+
+static void arrow_stream_write_dictionary(ArrowStream *stream, int column)
+{
+  ArrowDictionary *dictionary = stream->columns[column].dictionary;
+  ArrowFBField fields[3] = {
+    {8, 0, (uint64_t) column}, {4, 1, 0}, {1, 0, (stream->batches > 0) ? 1 : 0}};
+  size_t slots[3], header;
+  int32_t base = dictionary->offsets[dictionary->written];
+  int count = dictionary->count - dictionary->written, i;
+
+  arrow_stream_begin_body(stream);
+  arrow_stream_add_node(stream, count, 0);
+  arrow_stream_add_buffer(stream, NULL, 0);
+  stream->offsets.length = 0;
+  for (i = dictionary->written; i <= dictionary->count; i++) {
+    arrow_bytes_append_int(&stream->offsets, (uint32_t) (dictionary->offsets[i] - base), 4);
+  }
+  arrow_stream_add_buffer(stream, stream->offsets.data, stream->offsets.length);
+  arrow_stream_add_buffer(stream, dictionary->data.data + base,
+                          (size_t) (dictionary->offsets[dictionary->count] - base));
+
+  header = arrow_fb_message(&stream->meta, ARROW_HEADER_DICTIONARY_BATCH, stream->body.length);
+  arrow_fb_patch(&stream->meta, header, arrow_fb_table(&stream->meta, fields, 3, slots));
+  arrow_fb_patch(&stream->meta, slots[1], arrow_fb_record_batch(stream, count));
+  arrow_stream_write_message(stream);
+  dictionary->written = dictionary->count;
+}
+
+static void arrow_column_reset(ArrowColumn *column)
+{
+  column->null_count = 0;
+  column->data.length = 0;
+  /* Bitmaps are cleared, so that appending need only set bits */
+  memset(column->validity.data, 0, column->validity.capacity);
+  column->values.length = 0;
+  if (column->type == CW_FIELD_FLAG) {
+    memset(column->values.data, 0, column->values.capacity);
+  }
+  else if (column->type == CW_FIELD_TEXT) {
+    arrow_bytes_append_int(&column->values, 0, 4);
+  }
+}
+
+static void arrow_stream_write_batch(ArrowStream *stream)
+{
+  size_t header;
+  int i;
+
+  if (!stream->started) {
+    arrow_stream_write_schema(stream);
+    stream->started = 1;
+  }
+
+  /* The first dictionary batch for each column must be sent even if it
+   * is empty; later ones carry only the new entries, as deltas */
+  for (i = 0; i < stream->num_columns; i++) {
+    ArrowDictionary *dictionary = stream->columns[i].dictionary;
+    if (dictionary != NULL && (stream->batches == 0 || dictionary->count > dictionary->written)) {
+      arrow_stream_write_dictionary(stream, i);
+    }
+  }
+
+  arrow_stream_begin_body(stream);
+  for (i = 0; i < stream->num_columns; i++) {
+    ArrowColumn *column = stream->columns + i;
+
+    size_t bitmap_length = ((size_t) stream->rows + 7) / 8;
+
+    arrow_stream_add_node(stream, stream->rows, column->null_count);
+    arrow_stream_add_buffer(stream, column->validity.data,
+                            (column->null_count > 0) ? bitmap_length : 0);
+    arrow_stream_add_buffer(stream, column->values.data,
+                            (column->type == CW_FIELD_FLAG) ? bitmap_length
+                                                            : column->values.length);
+    if (column->type == CW_FIELD_TEXT) {
+      arrow_stream_add_buffer(stream, column->data.data, column->data.length);
+    }
+  }
+  header = arrow_fb_message(&stream->meta, ARROW_HEADER_RECORD_BATCH, stream->body.length);
+  arrow_fb_patch(&stream->meta, header, arrow_fb_record_batch(stream, stream->rows));
+  arrow_stream_write_message(stream);
+
+  for (i = 0; i < stream->num_columns; i++) {
+    arrow_column_reset(stream->columns + i);
+  }
+  stream->rows = 0;
+  stream->batches++;
+}
+
+/*
+ * Private auxiliary functions for appending values
+ */
+static uint32_t arrow_hash(const char *s, size_t length)
+{
+  uint32_t hash = 2166136261U;
+  size_t i;
+
+  for (i = 0; i < length; i++) {
+    hash = (hash ^ (unsigned char) s[i]) * 16777619U;
+  }
+  return hash;
+}
+
+static void arrow_dictionary_grow_slots(ArrowDictionary *dictionary)
+{
+  int num_slots = (dictionary->num_slots > 0) ? 2 * dictionary->num_slots : 256, i;
+  int *slots = (int *) malloc((size_t) num_slots * sizeof(int));
+
+  if (slots == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for Arrow output\n");
+    exit(1);
+  }
+  for (i = 0; i < num_slots; i++) {
+    slots[i] = -1;
+  }
+  for (i = 0; i < dictionary->count; i++) {
+    int32_t start = dictionary->offsets[i];
+    uint32_t slot =
+      arrow_hash((char *) dictionary->data.data + start,
+                 (size_t) (dictionary->offsets[i + 1] - start)) & (uint32_t) (num_slots - 1);
+    while (slots[slot] >= 0) {
+      slot = (slot + 1) & (uint32_t) (num_slots - 1);
+    }
+    slots[slot] = i;
+  }
+  free(dictionary->slots);
+  dictionary->slots = slots;
+  dictionary->num_slots = num_slots;
+}
+
+/* Find the index of a string in a dictionary, adding it if it is new */
+static int arrow_dictionary_lookup(ArrowDictionary *dictionary, const char *s, size_t length)
+{
+  uint32_t mask, slot;
+  int last = dictionary->last;
+
+  if (last >= 0 &&
+      (size_t) (dictionary->offsets[last + 1] - dictionary->offsets[last]) == length &&
+      !memcmp(dictionary->data.data + dictionary->offsets[last], s, length)) {
+    return last;
+  }
+
+  if (2 * (dictionary->count + 1) > dictionary->num_slots) {
+    arrow_dictionary_grow_slots(dictionary);
+  }
+  mask = (uint32_t) (dictionary->num_slots - 1);
+  slot = arrow_hash(s, length) & mask;
+  while (dictionary->slots[slot] >= 0) {
+    int entry = dictionary->slots[slot];
+    int32_t start = dictionary->offsets[entry];
+    if ((size_t) (dictionary->offsets[entry + 1] - start) == length &&
+        !memcmp(dictionary->data.data + start, s, length)) {
+      return (dictionary->last = entry);
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  if (dictionary->count + 1 >= dictionary->capacity) {
+    int capacity = 2 * dictionary->capacity;
+    int32_t *offsets =
+      (int32_t *) realloc(dictionary->offsets, (size_t) capacity * sizeof(int32_t));
+    if (offsets == NULL) {
+      fprintf(stderr, "Error: could not allocate memory for Arrow output\n");
+      exit(1);
+    }
+    dictionary->offsets = offsets;
+    dictionary->capacity = capacity;
+  }
+  arrow_bytes_append(&dictionary->data, s, length);
+  dictionary->slots[slot] = dictionary->count;
+  dictionary->offsets[++dictionary->count] = (int32_t) dictionary->data.length;
+  return (dictionary->last = dictionary->count - 1);
+}
+
+/*
+ * Public interface
+ */
+ArrowStream *arrow_stream_create(FILE *f, int batch_size)
+{
+  ArrowStream *stream = (ArrowStream *) calloc(1, sizeof(ArrowStream));
+
+  if (stream == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for Arrow output\n");
+    exit(1);
+  }
+#if defined(_WIN32)
+  _setmode(_fileno(f), _O_BINARY);
+#endif
+  stream->f = f;
+  stream->batch_size = (batch_size > 0) ? batch_size : ARROW_DEFAULT_BATCH_SIZE;
+  return stream;
+}
+
+void arrow_stream_add_column(ArrowStream *stream, const char *name, CWFieldType type)
+{
+  ArrowColumn *columns, *column;
+
+  columns = (ArrowColumn *) realloc(stream->columns,
+                                    (size_t) (stream->num_columns + 1) * sizeof(ArrowColumn));
+  if (columns == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for Arrow output\n");
+    exit(1);
+  }
+  stream->columns = columns;
+  column = stream->columns + stream->num_columns++;
+  memset(column, 0, sizeof(ArrowColumn));
+  column->name = (char *) malloc(strlen(name) + 1);
+  if (column->name == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for Arrow output\n");
+    exit(1);
+  }
+  strcpy(column->name, name);
+  column->type = type;
+  column->width = (type == CW_FIELD_INT8) ? 1 : (type == CW_FIELD_INT16) ? 2 : 4;
+  arrow_bytes_reserve(&column->validity, ((size_t) stream->batch_size + 7) / 8);
+  if (type == CW_FIELD_FLAG) {
+    arrow_bytes_reserve(&column->values, ((size_t) stream->batch_size + 7) / 8);
+  }
+  else {
+    arrow_bytes_reserve(&column->values,
+                        (size_t) column->width * ((size_t) stream->batch_size + 1));
+  }
+  if (type == CW_FIELD_ID) {
+    column->dictionary = (ArrowDictionary *) calloc(1, sizeof(ArrowDictionary));
+    if (column->dictionary == NULL) {
+      fprintf(stderr, "Error: could not allocate memory for Arrow output\n");
+      exit(1);
+    }
+    /* Reserve space for entries, so the data pointer is never null */
+    arrow_bytes_reserve(&column->dictionary->data, 1024);
+    column->dictionary->capacity = 256;
+    column->dictionary->last = -1;
+    column->dictionary->offsets = (int32_t *) calloc(256, sizeof(int32_t));
+    if (column->dictionary->offsets == NULL) {
+      fprintf(stderr, "Error: could not allocate memory for Arrow output\n");
+      exit(1);
+    }
+  }
+  arrow_column_reset(column);
+}
+
+void arrow_stream_append(ArrowStream *stream, int column_index, const char *text)
+{
+  ArrowColumn *column = stream->columns + column_index;
+  size_t length = strlen(text);
+  int row = stream->rows, valid = 1;
+  long value = 0;
+
+  if (length >= 2 && text[0] == '"' && text[length - 1] == '"') {
+    text++;
+    length -= 2;
+  }
+
+  switch (column->type) {
+  case CW_FIELD_TEXT:
+    arrow_bytes_append(&column->data, text, length);
+    value = (long) column->data.length;
+    break;
+  case CW_FIELD_ID:
+    if (length > 0) {
+      value = arrow_dictionary_lookup(column->dictionary, text, length);
+    }
+    else {
+      valid = 0;
+    }
+    break;
+  case CW_FIELD_FLAG:
+    if (length == 1 && text[0] == 'T') {
+      column->values.data[row / 8] |= (unsigned char) (1U << (row % 8));
+    }
+    else if (length != 1 || text[0] != 'F') {
+      valid = 0;
+    }
+    break;
+  default:
+    if (!cw_parse_int(text, length, &value)) {
+      valid = 0;
+      value = 0;
+    }
+    else if ((column->type == CW_FIELD_INT8 && (value < INT8_MIN || value > INT8_MAX)) ||
+             (column->type == CW_FIELD_INT16 && (value < INT16_MIN || value > INT16_MAX))) {
+      fprintf(stderr, "Error: value %ld out of range for column %s\n", value, column->name);
+      exit(1);
+    }
+    break;
+  }
+
+  /* Space for a full batch of values was reserved when the column was created */
+  if (column->type != CW_FIELD_FLAG) {
+    arrow_bytes_put(&column->values, column->values.length, (uint64_t) value, column->width);
+    column->values.length += (size_t) column->width;
+  }
+  if (valid) {
+    column->validity.data[row / 8] |= (unsigned char) (1U << (row % 8));
+  }
+  else {
+    column->null_count++;
+  }
+}
+
+void arrow_stream_end_row(ArrowStream *stream)
+{
+  if (++stream->rows == stream->batch_size) {
+    arrow_stream_write_batch(stream);
+  }
+}
+
+void arrow_stream_cleanup(ArrowStream *stream)
+{
+  static const unsigned char end_of_stream[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0};
+  int i;
+
+  if (stream->rows > 0 || !stream->started) {
+    arrow_stream_write_batch(stream);
+  }
+  fwrite(end_of_stream, 1, sizeof(end_of_stream), stream->f);
+  fflush(stream->f);
+
+  for (i = 0; i < stream->num_columns; i++) {
+    ArrowColumn *column = stream->columns + i;
+    free(column->name);
+    arrow_bytes_cleanup(&column->validity);
+    arrow_bytes_cleanup(&column->values);
+    arrow_bytes_cleanup(&column->data);
+    if (column->dictionary != NULL) {
+      arrow_bytes_cleanup(&column->dictionary->data);
+      free(column->dictionary->offsets);
+      free(column->dictionary->slots);
+      free(column->dictionary);
+    }
+  }
+  free(stream->columns);
+  arrow_bytes_cleanup(&stream->meta);
+  arrow_bytes_cleanup(&stream->body);
+  arrow_bytes_cleanup(&stream->nodes);
+  arrow_bytes_cleanup(&stream->buffers);
+  arrow_bytes_cleanup(&stream->offsets);
+  free(stream);
+}
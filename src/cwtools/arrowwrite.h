@@ -0,0 +1,86 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/arrowwrite.h
+ * Utility API for generating Apache Arrow IPC stream output
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef ARROWWRITE_H
+#define ARROWWRITE_H
+
+#include <stdio.h>
+
+#include "buffer.h"
+
+/*
+ * This file defines a small API for writing tables in the Apache Arrow
+ * IPC streaming format, without depending on the Arrow libraries.
+ * Columns are declared once, then values are appended row by row as
+ * the text the field functions emit; rows are collected into record
+ * batches of a fixed number of rows, which are written as they fill.
+ *
+ * Column types follow the CWFieldType of the field:
+ * - CW_FIELD_TEXT is a utf8 column;
+ * - CW_FIELD_ID is a utf8 column dictionary-encoded with int32 indices;
+ *   new dictionary entries are written as delta dictionary batches
+ *   ahead of the record batch which first uses them;
+ * - CW_FIELD_FLAG is a bool column ('T' or 'F');
+ * - CW_FIELD_INT8, CW_FIELD_INT16 and CW_FIELD_INT32 are signed
+ *   integer columns of the corresponding width.
+ * An empty value is written as null, except in text columns, where it
+ * is an empty string.
+ */
+
+/* Number of rows in each record batch, unless otherwise specified */
+#define ARROW_DEFAULT_BATCH_SIZE 65536
+
+typedef struct arrow_stream_struct ArrowStream;
+
+/*
+ * Create a stream writing to 'f', with at most 'batch_size' rows in each
+ * record batch.  On Windows, the file is switched to binary mode.
+ */
+ArrowStream *arrow_stream_create(FILE *f, int batch_size);
+
+/*
+ * Declare a column.  All columns must be added before the first value
+ * is appended.  The name is copied.
+ */
+void arrow_stream_add_column(ArrowStream *stream, const char *name, CWFieldType type);
+
+/*
+ * Append a value to 'column' of the current row.  'text' is the value
+ * as written by a field function in delimited (-a) mode; surrounding
+ * quotes are removed.  Values must be appended to each column in
+ * order.
+ */
+void arrow_stream_append(ArrowStream *stream, int column, const char *text);
+
+/*
+ * Complete the current row, writing a record batch if it is full.
+ */
+void arrow_stream_end_row(ArrowStream *stream);
+
+/*
+ * Write any remaining rows and the end-of-stream marker, and free
+ * the stream.  The file is not closed.
+ */
+void arrow_stream_cleanup(ArrowStream *stream);
+
+#endif /* ARROWWRITE_H */
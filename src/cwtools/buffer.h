@@ -28,6 +28,49 @@
 #include <stdarg.h>
 #include <stdio.h>
 
+/*
+ * The kind of value a field writes.  Text output formats do not need this,
+ * but typed output formats (e.g., Arrow) use it to choose column types.
+ * CW_FIELD_ID is for short strings which repeat heavily, such as player,
+ * team and game IDs.
+ */
+typedef enum cw_field_type {
+  CW_FIELD_TEXT,
+  CW_FIELD_ID,
+  CW_FIELD_FLAG,
+  CW_FIELD_INT8,
+  CW_FIELD_INT16,
+  CW_FIELD_INT32
+} CWFieldType;
+
+/*
+ * Parse the text of an integer field, 'length' characters at 'text': an
+ * optional minus sign and at most nine digits.  Returns zero if the text
+ * is not one.
+ */
+static inline int cw_parse_int(const char *text, size_t length, long *value)
+{
+  size_t i = 0;
+  int negative = 0;
+  long result = 0;
+
+  if (length > 0 && text[0] == '-') {
+    negative = 1;
+    i++;
+  }
+  if (i == length || length - i > 9) {
+    return 0;
+  }
+  for (; i < length; i++) {
+    if (text[i] < '0' || text[i] > '9') {
+      return 0;
+    }
+    result = 10 * result + (text[i] - '0');
+  }
+  *value = negative ? -result : result;
+  return 1;
+}
+
 typedef struct cw_buffer {
   char *current;
   char *end;
@@ -36,6 +79,9 @@ typedef struct cw_buffer {
   int field_open;
   int use_delimiter;
   char delimiter;
+  /* If not NULL, the start of each field is recorded here (see cw_buffer_track_fields) */
+  char **field_starts;
+  int num_fields, max_fields;
 } CWBuffer;
 
 static inline void cw_buffer_init(CWBuffer *buf, char *storage, size_t size, int use_delimiter,
@@ -48,11 +94,53 @@ static inline void cw_buffer_init(CWBuffer *buf, char *storage, size_t size, int
   buf->field_open = 0;
   buf->use_delimiter = use_delimiter;
   buf->delimiter = delimiter;
+  buf->field_starts = NULL;
+  buf->num_fields = 0;
+  buf->max_fields = 0;
   if (size > 0) {
     storage[0] = '\0';
   }
 }
 
+/*
+ * Record the position at which each field starts, in 'starts', which has
+ * room for 'max' fields.  After the line is complete, cw_buffer_split_fields
+ * separates it into one string per field.  This lets output formats which
+ * are not delimited text reuse the field functions.
+ */
+static inline void cw_buffer_track_fields(CWBuffer *buf, char **starts, int max)
+{
+  buf->field_starts = starts;
+  buf->num_fields = 0;
+  buf->max_fields = max;
+}
+
+static inline void cw_buffer_mark_field(CWBuffer *buf)
+{
+  if (buf->field_starts != NULL) {
+    if (buf->num_fields < buf->max_fields) {
+      buf->field_starts[buf->num_fields++] = buf->current;
+    }
+    else {
+      buf->truncated = 1;
+    }
+  }
+}
+
+/*
+ * Terminate each tracked field in place, by overwriting the delimiter which
+ * follows it.  Returns the number of fields.
+ */
+static inline int cw_buffer_split_fields(CWBuffer *buf)
+{
+  int i;
+
+  for (i = 1; i < buf->num_fields; i++) {
+    *(buf->field_starts[i] - 1) = '\0';
+  }
+  return buf->num_fields;
+}
+
 static inline int cw_buffer_emit(CWBuffer *buf, const char *fmt, ...)
 {
   if (buf->current >= buf->end) {
@@ -73,6 +161,7 @@ static inline int cw_buffer_emit(CWBuffer *buf, const char *fmt, ...)
   }
   if (!buf->field_open) {
     buf->need_sep = 1;
+    cw_buffer_mark_field(buf);
   }
 
   va_list ap;
@@ -106,6 +195,7 @@ static inline void cw_buffer_begin_field(CWBuffer *buf)
   }
   buf->need_sep = 0;
   buf->field_open = 1;
+  cw_buffer_mark_field(buf);
 }
 
 static inline void cw_buffer_end_field(CWBuffer *buf)
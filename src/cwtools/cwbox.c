@@ -45,8 +45,10 @@ char program_name[] = "cwbox";
 
 extern char year[], first_date[], last_date[], game_id[];
 extern char data_dir[1024];
+extern char catalog_file[1024];
 extern int ascii;
 extern int quiet;
+extern int output_by_file;
 
 XMLDoc *doc = NULL;
 
@@ -80,11 +82,21 @@ void cwbox_print_help(void)
   fprintf(stderr, "  -y year   Year to process (for teamyyyy and aaayyyy.ros).\n");
   fprintf(stderr,
           "  -D dir    Directory to find team and roster files (default is current directory)\n");
+  fprintf(stderr, "  -C file   Catalog of games (from cwcatalog), to read only selected games\n");
   fprintf(stderr, "  -s start  Earliest date to process (mmdd).\n");
   fprintf(stderr, "  -e end    Last date to process (mmdd).\n");
   fprintf(stderr, "  -X        output boxscores as XML.\n");
   fprintf(stderr, "  -S        output boxscores as SportsML.\n");
   fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n");
+  fprintf(stderr, "  --team=list  only process games of the teams listed (IDs separated\n");
+  fprintf(stderr, "            by commas)\n");
+  fprintf(stderr, "  --park=list  only process games at the parks listed\n");
+  fprintf(stderr, "  --stats[=file]  report counts and phase timings at exit,\n");
+  fprintf(stderr, "            to stderr, or as JSON to file\n");
+  fprintf(stderr, "  --serve=socket  read the games once, and answer requests\n");
+  fprintf(stderr, "            for them on a Unix-domain socket\n");
+  fprintf(stderr, "  --incremental=dir  keep the output for each file in dir,\n");
+  fprintf(stderr, "            and reuse it while the file is unchanged\n");
   exit(0);
 }
 
@@ -135,6 +147,12 @@ int cwbox_parse_command_line(int argc, char *argv[])
         data_dir[sizeof(data_dir) - 1] = '\0';
       }
     }
+    else if (!strcmp(argv[i], "-C")) {
+      if (++i < argc) {
+        strncpy(catalog_file, argv[i], sizeof(catalog_file) - 1);
+        catalog_file[sizeof(catalog_file) - 1] = '\0';
+      }
+    }
     /* This part is cwbox-specific */
     else if (!strcmp(argv[i], "-X")) {
       use_xml = 1;
@@ -823,6 +841,9 @@ void cwbox_print_text(CWGame *game, CWBoxscore *boxscore, CWRoster *visitors, CW
 extern void cwbox_print_xml(CWGame *, CWBoxscore *, CWRoster *, CWRoster *);
 extern void cwbox_print_sportsml(XMLDoc *doc, CWGame *, CWBoxscore *, CWRoster *, CWRoster *);
 
+/* One boxscore is rebuilt for each game, so its memory is reused */
+static CWBoxscore *game_box = NULL;
+
 void cwbox_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
 {
   CWBoxscore *boxscore;
@@ -832,13 +853,19 @@ void cwbox_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
     return;
   }
 
-  boxscore = cw_box_create(game);
+  if (game_box == NULL) {
+    game_box = cw_box_create(game);
+  }
+  else {
+    cw_box_rebuild(game_box, game);
+  }
+  boxscore = game_box;
 
   if (!visitors) {
     fprintf(stderr, "WARNING: In game %s, could not find roster for visiting team.\n",
             game->game_id);
     /* cw_box_cleanup(boxscore);
-    free(boxscore);
+    cw_free(CW_ALLOC_BOX, boxscore);
     return;
     */
   }
@@ -847,7 +874,7 @@ void cwbox_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
     fprintf(stderr, "WARNING: In game %s, could not find roster for home team.\n", game->game_id);
     /*
     cw_box_cleanup(boxscore);
-    free(boxscore);
+    cw_free(CW_ALLOC_BOX, boxscore);
     return;
     */
   }
@@ -861,9 +888,6 @@ void cwbox_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
   else {
     cwbox_print_text(game, boxscore, visitors, home);
   }
-
-  cw_box_cleanup(boxscore);
-  free(boxscore);
 }
 
 void (*cwtools_process_game)(CWGame *, CWRoster *, CWRoster *) = cwbox_process_game;
@@ -871,7 +895,9 @@ void (*cwtools_process_game)(CWGame *, CWRoster *, CWRoster *) = cwbox_process_g
 void cwbox_initialize(void)
 {
   if (use_sportsml) {
+    /* All the games are in one document */
     doc = xml_document_create(stdout, "sports-content-set");
+    output_by_file = 0;
   }
 }
 
@@ -879,6 +905,11 @@ void (*cwtools_initialize)(void) = cwbox_initialize;
 
 void cwbox_cleanup(void)
 {
+  if (game_box != NULL) {
+    cw_box_cleanup(game_box);
+    cw_free(CW_ALLOC_BOX, game_box);
+    game_box = NULL;
+  }
   if (use_sportsml) {
     xml_document_cleanup(doc);
   }
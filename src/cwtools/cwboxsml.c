@@ -234,7 +234,7 @@ static void cwbox_player(XMLNode *parent, CWGame *game, CWBoxPlayer *player,
   XMLNode *node = NULL, *statsNode = NULL, *statsBaseballNode = NULL;
 
   node = xml_node_open(parent, "player");
-  xml_node_attribute_fmt(node, "id", "p.%s", player->player_id);
+  xml_node_attribute_prefixed(node, "id", "p.", player->player_id);
 
   cwbox_player_metadata(node, player, slot, seq, roster);
 
@@ -508,7 +508,7 @@ static void cwbox_official(XMLNode *parent, CWGame *game, char *infoLabel, char
     umpNode = xml_node_open(parent, "official");
     umpDataNode = xml_node_open(umpNode, "official-metadata");
     xml_node_attribute(umpDataNode, "position", metaLabel);
-    xml_node_attribute_fmt(umpDataNode, "official-key", "p.%s", umpID);
+    xml_node_attribute_prefixed(umpDataNode, "official-key", "p.", umpID);
   }
 }
 
@@ -913,7 +913,8 @@ static void cwbox_action_baseball_play(XMLNode *parent, CWGameIterator *gameiter
   }
 
   if (cw_gamestate_base_occupied(gameiter->state, 1)) {
-    xml_node_attribute_fmt(node, "runner-on-first-idref", "p.%s", gameiter->state->runners[1]);
+    xml_node_attribute_prefixed(node, "runner-on-first-idref", "p.",
+                                gameiter->state->runners[1].runner);
     if (gameiter->event_data->advance[1] >= 1 && gameiter->event_data->advance[1] <= 3) {
       xml_node_attribute_int(node, "runner-on-first-advance", gameiter->event_data->advance[1]);
     }
@@ -926,7 +927,8 @@ static void cwbox_action_baseball_play(XMLNode *parent, CWGameIterator *gameiter
     }
   }
   if (cw_gamestate_base_occupied(gameiter->state, 2)) {
-    xml_node_attribute_fmt(node, "runner-on-second-idref", "p.%s", gameiter->state->runners[2]);
+    xml_node_attribute_prefixed(node, "runner-on-second-idref", "p.",
+                                gameiter->state->runners[2].runner);
     if (gameiter->event_data->advance[2] >= 1 && gameiter->event_data->advance[2] <= 3) {
       xml_node_attribute_int(node, "runner-on-second-advance", gameiter->event_data->advance[2]);
     }
@@ -939,8 +941,8 @@ static void cwbox_action_baseball_play(XMLNode *parent, CWGameIterator *gameiter
     }
   }
   if (cw_gamestate_base_occupied(gameiter->state, 3)) {
-    xml_node_attribute_fmt(node, "runner-on-third-idref", "p.%s",
-                           gameiter->state->runners[3].runner);
+    xml_node_attribute_prefixed(node, "runner-on-third-idref", "p.",
+                                gameiter->state->runners[3].runner);
     if (gameiter->event_data->advance[3] >= 1 && gameiter->event_data->advance[3] <= 3) {
       xml_node_attribute_int(node, "runner-on-third-advance", gameiter->event_data->advance[3]);
     }
@@ -957,10 +959,10 @@ static void cwbox_action_baseball_play(XMLNode *parent, CWGameIterator *gameiter
    * charged batter and pitcher, which might not be the ones who
    * took the final action!
    */
-  xml_node_attribute_fmt(node, "pitcher-idref", "p.%s",
-                         cw_gamestate_charged_pitcher(gameiter->state, gameiter->event_data));
-  xml_node_attribute_fmt(
-    node, "batter-idref", "p.%s",
+  xml_node_attribute_prefixed(node, "pitcher-idref", "p.",
+                              cw_gamestate_charged_pitcher(gameiter->state, gameiter->event_data));
+  xml_node_attribute_prefixed(
+    node, "batter-idref", "p.",
     cw_gamestate_charged_batter(gameiter->state, gameiter->event->batter, gameiter->event_data));
 
   batHand = cw_gamestate_charged_batter_hand(
@@ -1145,8 +1147,8 @@ static void cwbox_action_baseball_substitution(XMLNode *parent, CWGameIterator *
   xml_node_attribute_int(node, "outs", gameiter->state->outs);
   xml_node_attribute(node, "person-type", "player");
 
-  xml_node_attribute_fmt(node, "person-original-idref", "p.%s",
-                         gameiter->state->lineups[sub->slot][sub->team].player_id);
+  xml_node_attribute_prefixed(node, "person-original-idref", "p.",
+                              gameiter->state->lineups[sub->slot][sub->team].player_id);
 
   switch (gameiter->state->lineups[sub->slot][sub->team].position) {
   case 10:
@@ -1172,7 +1174,7 @@ static void cwbox_action_baseball_substitution(XMLNode *parent, CWGameIterator *
   else {
     xml_node_attribute_int(node, "person-original-lineup-slot", sub->slot);
   }
-  xml_node_attribute_fmt(node, "person-replacing-idref", "p.%s", sub->player_id);
+  xml_node_attribute_prefixed(node, "person-replacing-idref", "p.", sub->player_id);
 
   if (gameiter->state->lineups[sub->slot][sub->team].position == 10 &&
       gameiter->state->batting_team == sub->team) {
@@ -1245,6 +1247,9 @@ static void cwbox_actions(XMLNode *parent, CWGame *game, CWBoxscore *boxscore, C
 
     cw_gameiter_next(gameiter);
   }
+
+  cw_gameiter_cleanup(gameiter);
+  cw_free(CW_ALLOC_GAMEITER, gameiter);
 }
 
 /*
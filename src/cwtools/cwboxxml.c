@@ -128,7 +128,7 @@ void cwbox_xml_player(CWGame *game, CWBoxPlayer *player, int slot, int seq, CWRo
     printf("outs=\"%d\" po=\"%d\" a=\"%d\" e=\"%d\" dp=\"%d\" tp=\"%d\" ",
            player->fielding[pos]->outs, player->fielding[pos]->po, player->fielding[pos]->a,
            player->fielding[pos]->e, player->fielding[pos]->dp, player->fielding[pos]->tp);
-    if (player->positions[pos] == 2) {
+    if (pos == 2) {
       printf("pb=\"%d\" ", player->fielding[pos]->pb);
     }
     printf("bip=\"%d\" bf=\"%d\" ", player->fielding[pos]->bip, player->fielding[pos]->bf);
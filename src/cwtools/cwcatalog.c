@@ -0,0 +1,132 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/cwcatalog.c
+ * Chadwick game catalog builder
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Like cwindex, cwcatalog does not use the common driver in cwtools.c,
+ * since it needs the offset of each game in its file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cwlib/chadwick.h"
+
+/* File to write the catalog to (-o); standard output if empty */
+char output_file[1024] = "";
+
+/* If 'quiet', write no status messages to stderr (-Q) */
+int quiet = 0;
+
+void cwcatalog_print_welcome_message(char *argv0)
+{
+  fprintf(stderr, "\nChadwick game catalog builder, version " VERSION);
+  fprintf(stderr, "\n  Type '%s -h' for help.\n", argv0);
+  fprintf(
+    stderr,
+    "Copyright (c) 2002-2026\nDr T L Turocy, Chadwick Baseball Bureau (ted.turocy@gmail.com)\n");
+  fprintf(stderr, "This is free software, "
+                  "subject to the terms of the GNU GPL license.\n\n");
+}
+
+void cwcatalog_print_help(void)
+{
+  fprintf(stderr, "\n\ncwcatalog builds a catalog of the games in a set of event files.\n");
+  fprintf(stderr, "Given the catalog with -C, the other tools read only the games selected.\n");
+  fprintf(stderr, "Usage: cwcatalog [options] eventfile...\n");
+  fprintf(stderr, "options:\n");
+  fprintf(stderr, "  -h        print this help\n");
+  fprintf(stderr, "  -o file   write the catalog to file (default is standard output)\n");
+  fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n\n");
+
+  exit(0);
+}
+
+int cwcatalog_parse_command_line(int argc, char *argv[])
+{
+  int i;
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-h")) {
+      cwcatalog_print_welcome_message(argv[0]);
+      cwcatalog_print_help();
+    }
+    else if (!strcmp(argv[i], "-o")) {
+      if (++i < argc) {
+        strncpy(output_file, argv[i], sizeof(output_file) - 1);
+        output_file[sizeof(output_file) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-Q")) {
+      quiet = 1;
+    }
+    else if (argv[i][0] == '-') {
+      fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
+      exit(1);
+    }
+    else {
+      break;
+    }
+  }
+
+  return i;
+}
+
+int main(int argc, char *argv[])
+{
+  CWCatalog *catalog;
+  FILE *output = stdout;
+  int i;
+
+  i = cwcatalog_parse_command_line(argc, argv);
+  if (!quiet) {
+    cwcatalog_print_welcome_message(argv[0]);
+  }
+
+  catalog = cw_catalog_create();
+  for (; i < argc; i++) {
+    if (!quiet) {
+      fprintf(stderr, "[Processing file %s.]\n", argv[i]);
+    }
+    if (cw_catalog_add_file(catalog, argv[i]) < 0) {
+      fprintf(stderr, "Warning: could not open file '%s'\n", argv[i]);
+    }
+  }
+
+  if (strcmp(output_file, "") != 0) {
+    output = fopen(output_file, "w");
+    if (output == NULL) {
+      fprintf(stderr, "Error: could not open catalog file '%s' for writing\n", output_file);
+      exit(1);
+    }
+  }
+  cw_catalog_write(catalog, output);
+  if (output != stdout) {
+    fclose(output);
+  }
+
+  cw_catalog_cleanup(catalog);
+  cw_free(CW_ALLOC_CATALOG, catalog);
+
+  return 0;
+}
@@ -27,6 +27,8 @@
 #include <ctype.h>
 
 #include "cwlib/chadwick.h"
+#include "buffer.h"
+#include "jsonwrite.h"
 
 /*************************************************************************
  * Global variables for command-line options
@@ -43,6 +45,10 @@ char program_name[20] = "cwcomment";
 
 int print_header = 0;
 
+/* Write one JSON object per comment instead of text (-J) */
+int json_output = 0;
+JSONWriter *json_writer = NULL;
+
 /*************************************************************************
  * Functions to output fields
  *************************************************************************/
@@ -163,47 +169,73 @@ DECLARE_FIELDFUNC(cwcomment_umpchange_person_id)
 typedef struct field_struct {
   field_func f;
   char *header, *description;
+  CWFieldType type;
 } field_struct;
 
 static field_struct field_data[] = {
-  /* 0 */ {cwcomment_game_id, "GAME_ID", "game id"},
-  /* 1 */ {cwcomment_event_number, "EVENT_ID", "event num"},
-  /* 2 */ {cwcomment_comment, "COMMENT_TX", "comment text"},
-  /* 3 */ {cwcomment_eject_person_id, "EJECT_PERSON_ID", "ID of person ejected"},
-  /* 4 */ {cwcomment_eject_person_role_cd, "EJECT_PERSON_ROLE_CD", "role of person ejected"},
-  /* 5 */ {cwcomment_eject_umpire_id, "EJECT_UMPIRE_ID", "ID of ejecting umpire"},
-  /* 6 */ {cwcomment_eject_reason, "EJECT_REASON_TX", "reason for ejection"},
-  /* 7 */ {cwcomment_umpchange_inning, "UMPCHANGE_INN_CT", "inning of umpire change"},
-  /* 8 */ {cwcomment_umpchange_position, "UMPCHANGE_POS_CD", "position umpire assumed"},
+  /* 0 */ {cwcomment_game_id, "GAME_ID", "game id", CW_FIELD_ID},
+  /* 1 */ {cwcomment_event_number, "EVENT_ID", "event num", CW_FIELD_INT16},
+  /* 2 */ {cwcomment_comment, "COMMENT_TX", "comment text", CW_FIELD_TEXT},
+  /* 3 */ {cwcomment_eject_person_id, "EJECT_PERSON_ID", "ID of person ejected", CW_FIELD_ID},
+  /* 4 */
+  {cwcomment_eject_person_role_cd, "EJECT_PERSON_ROLE_CD", "role of person ejected",
+   CW_FIELD_TEXT},
+  /* 5 */ {cwcomment_eject_umpire_id, "EJECT_UMPIRE_ID", "ID of ejecting umpire", CW_FIELD_ID},
+  /* 6 */ {cwcomment_eject_reason, "EJECT_REASON_TX", "reason for ejection", CW_FIELD_TEXT},
+  /* 7 */
+  {cwcomment_umpchange_inning, "UMPCHANGE_INN_CT", "inning of umpire change", CW_FIELD_INT8},
+  /* 8 */
+  {cwcomment_umpchange_position, "UMPCHANGE_POS_CD", "position umpire assumed", CW_FIELD_TEXT},
   /* 9 */
-  {cwcomment_umpchange_person_id, "UMPCHANGE_PERSON_ID", "ID of umpire assuming position"}};
+  {cwcomment_umpchange_person_id, "UMPCHANGE_PERSON_ID", "ID of umpire assuming position",
+   CW_FIELD_ID}};
 
-void cwcomment_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
+/*
+ * For JSON output, fields are separated by a null character instead of
+ * a comma, and the start of each is recorded here.
+ */
+static char *column_values[sizeof(field_data) / sizeof(field_data[0])];
+
+/*
+ * Write the fields of one comment record
+ */
+static void cwcomment_write_record(CWGameIterator *gameiter, int beginning, CWComment *comment)
 {
   char *buf;
   char output_line[4096];
-  int i, comma;
+  int i, comma = 0, column = 0;
+
+  strcpy(output_line, "");
+  buf = output_line;
+  for (i = 0; i <= max_field; i++) {
+    if (fields[i]) {
+      if (ascii && comma) {
+        *(buf++) = json_output ? '\0' : ',';
+      }
+      else {
+        comma = 1;
+      }
+      column_values[column++] = buf;
+      buf += (*field_data[i].f)(buf, gameiter, beginning, comment);
+    }
+  }
+  if (json_output) {
+    json_writer_write_row(json_writer, column_values, column);
+  }
+  else {
+    printf("%s\n", output_line);
+  }
+}
+
+void cwcomment_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
+{
   CWGameIterator *gameiter = cw_gameiter_create(game);
   CWComment *comment = NULL;
 
   if (gameiter->game->first_comment != NULL) {
     comment = gameiter->game->first_comment;
     while (comment) {
-      comma = 0;
-      strcpy(output_line, "");
-      buf = output_line;
-      for (i = 0; i <= max_field; i++) {
-        if (fields[i]) {
-          if (ascii && comma) {
-            *(buf++) = ',';
-          }
-          else {
-            comma = 1;
-          }
-          buf += (*field_data[i].f)(buf, gameiter, 1, comment);
-        }
-      }
-      printf("%s\n", output_line);
+      cwcomment_write_record(gameiter, 1, comment);
       if (comment->ejection.person_id || comment->umpchange.person_id) {
         comment = comment->next;
       }
@@ -221,21 +253,7 @@ void cwcomment_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
   while (gameiter->event != NULL) {
     comment = gameiter->event->first_comment;
     while (comment) {
-      comma = 0;
-      strcpy(output_line, "");
-      buf = output_line;
-      for (i = 0; i <= max_field; i++) {
-        if (fields[i]) {
-          if (ascii && comma) {
-            *(buf++) = ',';
-          }
-          else {
-            comma = 1;
-          }
-          buf += (*field_data[i].f)(buf, gameiter, 0, comment);
-        }
-      }
-      printf("%s\n", output_line);
+      cwcomment_write_record(gameiter, 0, comment);
       if (comment->ejection.person_id || comment->umpchange.person_id) {
         comment = comment->next;
       }
@@ -252,7 +270,7 @@ void cwcomment_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
   }
 
   cw_gameiter_cleanup(gameiter);
-  free(gameiter);
+  cw_free(CW_ALLOC_GAMEITER, gameiter);
 }
 
 void (*cwtools_process_game)(CWGame *, CWRoster *, CWRoster *) = cwcomment_process_game;
@@ -269,15 +287,26 @@ void cwcomment_print_help(void)
   fprintf(stderr, "  -y year   Year to process (for teamyyyy and aaayyyy.ros).\n");
   fprintf(stderr,
           "  -D dir    Directory to find team and roster files (default is current directory)\n");
+  fprintf(stderr, "  -C file   Catalog of games (from cwcatalog), to read only selected games\n");
   fprintf(stderr, "  -s start  Earliest date to process (mmdd).\n");
   fprintf(stderr, "  -e end    Last date to process (mmdd).\n");
   fprintf(stderr, "  -a        generate Ascii-delimited format files (default)\n");
   fprintf(stderr, "  -ft       generate Fortran format files\n");
+  fprintf(stderr, "  -J        generate JSON Lines, one object per comment\n");
   fprintf(stderr, "  -m        use master player file instead of local roster files\n");
   fprintf(stderr, "  -f flist  give list of fields to output\n");
   fprintf(stderr, "              Default is 0-9.\n");
   fprintf(stderr, "  -d        print list of field numbers and descriptions\n\n");
   fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n");
+  fprintf(stderr, "  --team=list  only process games of the teams listed (IDs separated\n");
+  fprintf(stderr, "            by commas)\n");
+  fprintf(stderr, "  --park=list  only process games at the parks listed\n");
+  fprintf(stderr, "  --stats[=file]  report counts and phase timings at exit,\n");
+  fprintf(stderr, "            to stderr, or as JSON to file\n");
+  fprintf(stderr, "  --serve=socket  read the games once, and answer requests\n");
+  fprintf(stderr, "            for them on a Unix-domain socket\n");
+  fprintf(stderr, "  --incremental=dir  keep the output for each file in dir,\n");
+  fprintf(stderr, "            and reuse it while the file is unchanged\n");
   fprintf(stderr, "  -n        print field names in first row of output\n\n");
 
   exit(0);
@@ -322,6 +351,16 @@ void cwcomment_initialize(void)
   char output_line[4096];
   char *buf;
 
+  if (json_output) {
+    json_writer = json_writer_create(stdout);
+    for (i = 0; i <= max_field; i++) {
+      if (fields[i]) {
+        json_writer_add_column(json_writer, field_data[i].header, field_data[i].type);
+      }
+    }
+    return;
+  }
+
   if (!ascii || !print_header) {
     return;
   }
@@ -348,6 +387,10 @@ void (*cwtools_initialize)(void) = cwcomment_initialize;
 
 void cwcomment_cleanup(void)
 {
+  if (json_writer != NULL) {
+    json_writer_cleanup(json_writer);
+    json_writer = NULL;
+  }
 }
 
 void (*cwtools_cleanup)(void) = cwcomment_cleanup;
@@ -357,6 +400,7 @@ extern char first_date[5];
 extern char last_date[5];
 extern char game_id[20];
 extern char data_dir[1024];
+extern char catalog_file[1024];
 extern int quiet;
 
 extern void cwtools_parse_field_list(char *text, int max_field, int *fields);
@@ -369,6 +413,7 @@ int cwcomment_parse_command_line(int argc, char *argv[])
   for (i = 1; i < argc; i++) {
     if (!strcmp(argv[i], "-a")) {
       ascii = 1;
+      json_output = 0;
     }
     else if (!strcmp(argv[i], "-d")) {
       (*cwtools_print_welcome_message)(argv[0]);
@@ -401,6 +446,11 @@ int cwcomment_parse_command_line(int argc, char *argv[])
     }
     else if (!strcmp(argv[i], "-ft")) {
       ascii = 0;
+      json_output = 0;
+    }
+    else if (!strcmp(argv[i], "-J")) {
+      ascii = 1;
+      json_output = 1;
     }
     else if (!strcmp(argv[i], "-s")) {
       if (++i < argc) {
@@ -418,6 +468,12 @@ int cwcomment_parse_command_line(int argc, char *argv[])
         data_dir[sizeof(data_dir) - 1] = '\0';
       }
     }
+    else if (!strcmp(argv[i], "-C")) {
+      if (++i < argc) {
+        strncpy(catalog_file, argv[i], sizeof(catalog_file) - 1);
+        catalog_file[sizeof(catalog_file) - 1] = '\0';
+      }
+    }
     else if (argv[i][0] == '-') {
       fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
       exit(1);
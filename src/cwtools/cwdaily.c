@@ -27,12 +27,15 @@
 #include <ctype.h>
 
 #include "cwlib/chadwick.h"
+#include "buffer.h"
+#include "pgcopy.h"
 
 /*************************************************************************
  * Global variables for command-line options
  *************************************************************************/
 
 extern int ascii;
+extern int pgcopy;
 
 /* Fields to display (-f) */
 int fields[154] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
@@ -74,6 +77,7 @@ typedef int (*field_func)(char *, CWGameIterator *, CWBoxscore *, int, int, int,
 typedef struct field_struct {
   field_func f;
   char *header, *description;
+  CWFieldType type;
 } field_struct;
 
 /*
@@ -498,173 +502,199 @@ DECLARE_FIELDING_CATEGORY(cwdaily_F_RF_DP, 9, dp)
 DECLARE_FIELDING_CATEGORY(cwdaily_F_RF_TP, 9, tp)
 
 static field_struct field_data[] = {
-  /*  0 */ {cwdaily_game_id, "GAME_ID", "game id"},
-  /*  1 */ {cwdaily_date, "GAME_DT", "date"},
-  /*  2 */ {cwdaily_number, "GAME_CT", "game number (0 = no double header)"},
-  /*  3 */ {cwdaily_app_date, "APPEAR_DT", "apperance date"},
-  {cwdaily_team_id, "TEAM_ID", "team id"},
-  {cwdaily_player_id, "PLAYER_ID", "player id"},
-  {cwdaily_player_slot, "SLOT_CT", "player slot in batting order"},
-  {cwdaily_player_seq, "SEQ_CT", "sequence in batting order slot"},
-  {cwdaily_home_fl, "HOME_FL", "home flag"},
-  {cwdaily_opponent_id, "OPPONENT_ID", "opponent id"},
-  {cwdaily_site, "PARK_ID", "park id"},
-  {cwdaily_B_G, "B_G", "B_G:   games played"},
-  {cwdaily_B_PA, "B_PA", "B_PA:  plate appearances"},
-  {cwdaily_B_AB, "B_AB", "B_AB:  at bats"},
-  {cwdaily_B_R, "B_R", "B_R:   runs"},
-  {cwdaily_B_H, "B_H", "B_H:   hits"},
-  {cwdaily_B_TB, "B_TB", "B_TB:  total bases"},
-  {cwdaily_B_2B, "B_2B", "B_2B:  doubles"},
-  {cwdaily_B_3B, "B_3B", "B_3B:  triples"},
-  {cwdaily_B_HR, "B_HR", "B_HR:  home runs"},
-  {cwdaily_B_HR4, "B_HR4", "B_HR4: grand slams"},
-  {cwdaily_B_RBI, "B_RBI", "B_RBI: runs batted in"},
-  {cwdaily_B_GW, "B_GW", "B_GW:  game winning RBI"},
-  {cwdaily_B_BB, "B_BB", "B_BB:  walks"},
-  {cwdaily_B_IBB, "B_IBB", "B_IBB: intentional walks"},
-  {cwdaily_B_SO, "B_SO", "B_SO:  strikeouts"},
-  {cwdaily_B_GDP, "B_GDP", "B_GDP: grounded into DP"},
-  {cwdaily_B_HP, "B_HP", "B_HP:  hit by pitch"},
-  {cwdaily_B_SH, "B_SH", "B_SH:  sacrifice hits"},
-  {cwdaily_B_SF, "B_SF", "B_SF:  sacrifice flies"},
-  {cwdaily_B_SB, "B_SB", "B_SB:  stolen bases"},
-  {cwdaily_B_CS, "B_CS", "B_CS:  caught stealing"},
-  {cwdaily_B_XI, "B_XI", "B_XI:  reached on interference"},
-  {cwdaily_B_G_DH, "B_G_DH", "B_G_DH: games as DH"},
-  {cwdaily_B_G_PH, "B_G_PH", "B_G_PH: games as PH"},
-  {cwdaily_B_G_PR, "B_G_PR", "B_G_PR: games as PR"},
-  {cwdaily_P_G, "P_G", "P_G:   games pitched"},
-  {cwdaily_P_GS, "P_GS", "P_GS:  games started"},
-  {cwdaily_P_CG, "P_CG", "P_CG:  complete games"},
-  {cwdaily_P_SHO, "P_SHO", "P_SHO: shutouts"},
-  {cwdaily_P_GF, "P_GF", "P_GF:  games finished"},
-  {cwdaily_P_W, "P_W", "P_W:  wins"},
-  {cwdaily_P_L, "P_L", "P_L:  losses"},
-  {cwdaily_P_SV, "P_SV", "P_SV:  saves"},
-  {cwdaily_P_OUT, "P_OUT", "P_OUT: outs recorded (innings pitched times 3)"},
-  {cwdaily_P_TBF, "P_TBF", "P_TBF: batters faced"},
-  {cwdaily_P_AB, "P_AB", "P_AB:  at bats"},
-  {cwdaily_P_R, "P_R", "P_R:   runs allowed"},
-  {cwdaily_P_ER, "P_ER", "P_ER:  earned runs allowed"},
-  {cwdaily_P_H, "P_H", "P_H:   hits allowed"},
-  {cwdaily_P_TB, "P_TB", "P_TB:  total bases allowed"},
-  {cwdaily_P_2B, "P_2B", "P_2B:  doubles allowed"},
-  {cwdaily_P_3B, "P_3B", "P_3B:  triples allowed"},
-  {cwdaily_P_HR, "P_HR", "P_HR:  home runs allowed"},
-  {cwdaily_P_HR4, "P_HR4", "P_HR4:  grand slams allowed"},
-  {cwdaily_P_BB, "P_BB", "P_BB:  walks allowed"},
-  {cwdaily_P_IBB, "P_IBB", "P_IBB: intentional walks allowed"},
-  {cwdaily_P_SO, "P_SO", "P_SO:  strikeouts"},
-  {cwdaily_P_GDP, "P_GDP", "P_GDP: grounded into double play"},
-  {cwdaily_P_HP, "P_HP", "P_HP:  hit batsmen"},
-  {cwdaily_P_SH, "P_SH", "P_SH:  sacrifice hits against"},
-  {cwdaily_P_SF, "P_SF", "P_SF:  sacrifice flies against"},
-  {cwdaily_P_XI, "P_XI", "P_XI:  reached on interference"},
-  {cwdaily_P_WP, "P_WP", "P_WP:  wild pitches"},
-  {cwdaily_P_BK, "P_BK", "P_BK:  balks"},
-  {cwdaily_P_IR, "P_IR", "P_IR:  inherited runners"},
-  {cwdaily_P_IRS, "P_IRS", "P_IRS: inherited runners scored"},
-  {cwdaily_P_GO, "P_GO", "P_GO:  ground outs"},
-  {cwdaily_P_AO, "P_AO", "P_AO:  air outs"},
-  {cwdaily_P_PITCH, "P_PITCH", "P_PITCH:  pitches"},
-  {cwdaily_P_STRIKE, "P_STRIKE", "P_STRIKE: strikes"},
-  {cwdaily_P_G, "F_P_G", "F_P_G:    games at P"},
-  {cwdaily_P_GS, "F_P_GS", "F_P_GS:   games started at P"},
-  {cwdaily_F_P_OUT, "F_P_OUT", "F_P_OUT:  outs recorded at P (innings fielded times 3)"},
-  {cwdaily_F_P_TC, "F_P_TC", "F_P_TC:   total chances at P"},
-  {cwdaily_F_P_PO, "F_P_PO", "F_P_PO:   putouts at P"},
-  {cwdaily_F_P_A, "F_P_A", "F_P_A:    assists at P"},
-  {cwdaily_F_P_E, "F_P_E", "F_P_E:    errors at P"},
-  {cwdaily_F_P_DP, "F_P_DP", "F_P_DP:   double plays at P"},
-  {cwdaily_F_P_TP, "F_P_TP", "F_P_TP:   triple plays at P"},
-  {cwdaily_F_C_G, "F_C_G", "F_C_G:    games at C"},
-  {cwdaily_F_C_GS, "F_C_GS", "F_C_GS:   games started at C"},
-  {cwdaily_F_C_OUT, "F_C_OUT", "F_C_OUT:  outs recorded at C (innings fielded times 3)"},
-  {cwdaily_F_C_TC, "F_C_TC", "F_C_TC:   total chances at C"},
-  {cwdaily_F_C_PO, "F_C_PO", "F_C_PO:   putouts at C"},
-  {cwdaily_F_C_A, "F_C_A", "F_C_A:    assists at C"},
-  {cwdaily_F_C_E, "F_C_E", "F_C_E:    errors at C"},
-  {cwdaily_F_C_DP, "F_C_DP", "F_C_DP:   double plays at C"},
-  {cwdaily_F_C_TP, "F_C_TP", "F_C_TP:   triple plays at C"},
-  {cwdaily_F_C_PB, "F_C_PB", "F_C_PB:   passed balls at C"},
-  {cwdaily_F_C_XI, "F_C_XI", "F_C_IX:   catcher's interference at C"},
-  {cwdaily_F_1B_G, "F_1B_G", "F_1B_G:   games at 1B"},
-  {cwdaily_F_1B_GS, "F_1B_GS", "F_1B_GS:  games started at 1B"},
-  {cwdaily_F_1B_OUT, "F_1B_OUT", "F_1B_OUT: outs recorded at 1B (innings fielded times 3)"},
-  {cwdaily_F_1B_TC, "F_1B_TC", "F_1B_TC:  total chances at 1B"},
-  {cwdaily_F_1B_PO, "F_1B_PO", "F_1B_PO:  putouts at 1B"},
-  {cwdaily_F_1B_A, "F_1B_A", "F_1B_A:   assists at 1B"},
-  {cwdaily_F_1B_E, "F_1B_E", "F_1B_E:   errors at 1B"},
-  {cwdaily_F_1B_DP, "F_1B_DP", "F_1B_DP:  double plays at 1B"},
-  {cwdaily_F_1B_TP, "F_1B_TP", "F_1B_TP:  triple plays at 1B"},
-  {cwdaily_F_2B_G, "F_2B_G", "F_2B_G:   games at 2B"},
-  {cwdaily_F_2B_GS, "F_2B_GS", "F_2B_GS:  games started at 2B"},
-  {cwdaily_F_2B_OUT, "F_2B_OUT", "F_2B_OUT: outs recorded at 2B (innings fielded times 3)"},
-  {cwdaily_F_2B_TC, "F_2B_TC", "F_2B_TC:  total chances at 2B"},
-  {cwdaily_F_2B_PO, "F_2B_PO", "F_2B_PO:  putouts at 2B"},
-  {cwdaily_F_2B_A, "F_2B_A", "F_2B_A:   assists at 2B"},
-  {cwdaily_F_2B_E, "F_2B_E", "F_2B_E:   errors at 2B"},
-  {cwdaily_F_2B_DP, "F_2B_DP", "F_2B_DP:  double plays at 2B"},
-  {cwdaily_F_2B_TP, "F_2B_TP", "F_2B_TP:  triple plays at 2B"},
-  {cwdaily_F_3B_G, "F_3B_G", "F_3B_G:   games at 3B"},
-  {cwdaily_F_3B_GS, "F_3B_GS", "F_3B_GS:  games started at 3B"},
-  {cwdaily_F_3B_OUT, "F_3B_OUT", "F_3B_OUT: outs recorded at 3B (innings fielded times 3)"},
-  {cwdaily_F_3B_TC, "F_3B_TC", "F_3B_TC:  total chances at 3B"},
-  {cwdaily_F_3B_PO, "F_3B_PO", "F_3B_PO:  putouts at 3B"},
-  {cwdaily_F_3B_A, "F_3B_A", "F_3B_A:   assists at 3B"},
-  {cwdaily_F_3B_E, "F_3B_E", "F_3B_E:   errors at 3B"},
-  {cwdaily_F_3B_DP, "F_3B_DP", "F_3B_DP:  double plays at 3B"},
-  {cwdaily_F_3B_TP, "F_3B_TP", "F_3B_TP:  triple plays at 3B"},
-  {cwdaily_F_SS_G, "F_SS_G", "F_SS_G:    games at SS"},
-  {cwdaily_F_SS_GS, "F_SS_GS", "F_SS_GS:  games started at SS"},
-  {cwdaily_F_SS_OUT, "F_SS_OUT", "F_SS_OUT: outs recorded at SS (innings fielded times 3)"},
-  {cwdaily_F_SS_TC, "F_SS_TC", "F_SS_TC:  total chances at SS"},
-  {cwdaily_F_SS_PO, "F_SS_PO", "F_SS_PO:  putouts at SS"},
-  {cwdaily_F_SS_A, "F_SS_A", "F_SS_A:   assists at SS"},
-  {cwdaily_F_SS_E, "F_SS_E", "F_SS_E:   errors at SS"},
-  {cwdaily_F_SS_DP, "F_SS_DP", "F_SS_DP:  double plays at SS"},
-  {cwdaily_F_SS_TP, "F_SS_TP", "F_SS_TP:  triple plays at SS"},
-  {cwdaily_F_LF_G, "F_LF_G", "F_LF_G:   games at LF"},
-  {cwdaily_F_LF_GS, "F_LF_GS", "F_LF_GS:  games started at LF"},
-  {cwdaily_F_LF_OUT, "F_LF_OUT", "F_LF_OUT: outs recorded at LF (innings fielded times 3)"},
-  {cwdaily_F_LF_TC, "F_LF_TC", "F_LF_TC:  total chances at LF"},
-  {cwdaily_F_LF_PO, "F_LF_PO", "F_LF_PO:  putouts at LF"},
-  {cwdaily_F_LF_A, "F_LF_A", "F_LF_A:   assists at LF"},
-  {cwdaily_F_LF_E, "F_LF_E", "F_LF_E:   errors at LF"},
-  {cwdaily_F_LF_DP, "F_LF_DP", "F_LF_DP:  double plays at LF"},
-  {cwdaily_F_LF_TP, "F_LF_TP", "F_LF_TP:  triple plays at LF"},
-  {cwdaily_F_CF_G, "F_CF_G", "F_CF_G:   games at CF"},
-  {cwdaily_F_CF_GS, "F_CF_GS", "F_CF_GS:  games started at CF"},
-  {cwdaily_F_CF_OUT, "F_CF_OUT", "F_CF_OUT: outs recorded at CF (innings fielded times 3)"},
-  {cwdaily_F_CF_TC, "F_CF_TC", "F_CF_TC:  total chances at CF"},
-  {cwdaily_F_CF_PO, "F_CF_PO", "F_CF_PO:  putouts at CF"},
-  {cwdaily_F_CF_A, "F_CF_A", "F_CF_A:   assists at CF"},
-  {cwdaily_F_CF_E, "F_CF_E", "F_CF_E:   errors at CF"},
-  {cwdaily_F_CF_DP, "F_CF_DP", "F_CF_DP:  double plays at CF"},
-  {cwdaily_F_CF_TP, "F_CF_TP", "F_CF_TP:  triple plays at CF"},
-  {cwdaily_F_RF_G, "F_RF_G", "F_RF_G:   games at RF"},
-  {cwdaily_F_RF_GS, "F_RF_GS", "F_RF_GS:  games started at RF"},
-  {cwdaily_F_RF_OUT, "F_RF_OUT", "F_RF_OUT: outs recorded at RF (innings fielded times 3)"},
-  {cwdaily_F_RF_TC, "F_RF_TC", "F_RF_TC:  total chances at RF"},
-  {cwdaily_F_RF_PO, "F_RF_PO", "F_RF_PO:  putouts at RF"},
-  {cwdaily_F_RF_A, "F_RF_A", "F_RF_A:   assists at RF"},
-  {cwdaily_F_RF_E, "F_RF_E", "F_RF_E:   errors at RF"},
-  {cwdaily_F_RF_DP, "F_RF_DP", "F_RF_DP:  double plays at RF"},
-  {cwdaily_F_RF_TP, "F_RF_TP", "F_RF_TP:  triple plays at RF"}};
+  /*  0 */ {cwdaily_game_id, "GAME_ID", "game id", CW_FIELD_ID},
+  /*  1 */ {cwdaily_date, "GAME_DT", "date", CW_FIELD_TEXT},
+  /*  2 */ {cwdaily_number, "GAME_CT", "game number (0 = no double header)", CW_FIELD_INT16},
+  /*  3 */ {cwdaily_app_date, "APPEAR_DT", "apperance date", CW_FIELD_TEXT},
+  {cwdaily_team_id, "TEAM_ID", "team id", CW_FIELD_ID},
+  {cwdaily_player_id, "PLAYER_ID", "player id", CW_FIELD_ID},
+  {cwdaily_player_slot, "SLOT_CT", "player slot in batting order", CW_FIELD_INT8},
+  {cwdaily_player_seq, "SEQ_CT", "sequence in batting order slot", CW_FIELD_INT8},
+  {cwdaily_home_fl, "HOME_FL", "home flag", CW_FIELD_INT8},
+  {cwdaily_opponent_id, "OPPONENT_ID", "opponent id", CW_FIELD_ID},
+  {cwdaily_site, "PARK_ID", "park id", CW_FIELD_ID},
+  {cwdaily_B_G, "B_G", "B_G:   games played", CW_FIELD_INT16},
+  {cwdaily_B_PA, "B_PA", "B_PA:  plate appearances", CW_FIELD_INT16},
+  {cwdaily_B_AB, "B_AB", "B_AB:  at bats", CW_FIELD_INT16},
+  {cwdaily_B_R, "B_R", "B_R:   runs", CW_FIELD_INT16},
+  {cwdaily_B_H, "B_H", "B_H:   hits", CW_FIELD_INT16},
+  {cwdaily_B_TB, "B_TB", "B_TB:  total bases", CW_FIELD_INT16},
+  {cwdaily_B_2B, "B_2B", "B_2B:  doubles", CW_FIELD_INT16},
+  {cwdaily_B_3B, "B_3B", "B_3B:  triples", CW_FIELD_INT16},
+  {cwdaily_B_HR, "B_HR", "B_HR:  home runs", CW_FIELD_INT16},
+  {cwdaily_B_HR4, "B_HR4", "B_HR4: grand slams", CW_FIELD_INT16},
+  {cwdaily_B_RBI, "B_RBI", "B_RBI: runs batted in", CW_FIELD_INT16},
+  {cwdaily_B_GW, "B_GW", "B_GW:  game winning RBI", CW_FIELD_INT16},
+  {cwdaily_B_BB, "B_BB", "B_BB:  walks", CW_FIELD_INT16},
+  {cwdaily_B_IBB, "B_IBB", "B_IBB: intentional walks", CW_FIELD_INT16},
+  {cwdaily_B_SO, "B_SO", "B_SO:  strikeouts", CW_FIELD_INT16},
+  {cwdaily_B_GDP, "B_GDP", "B_GDP: grounded into DP", CW_FIELD_INT16},
+  {cwdaily_B_HP, "B_HP", "B_HP:  hit by pitch", CW_FIELD_INT16},
+  {cwdaily_B_SH, "B_SH", "B_SH:  sacrifice hits", CW_FIELD_INT16},
+  {cwdaily_B_SF, "B_SF", "B_SF:  sacrifice flies", CW_FIELD_INT16},
+  {cwdaily_B_SB, "B_SB", "B_SB:  stolen bases", CW_FIELD_INT16},
+  {cwdaily_B_CS, "B_CS", "B_CS:  caught stealing", CW_FIELD_INT16},
+  {cwdaily_B_XI, "B_XI", "B_XI:  reached on interference", CW_FIELD_INT16},
+  {cwdaily_B_G_DH, "B_G_DH", "B_G_DH: games as DH", CW_FIELD_INT16},
+  {cwdaily_B_G_PH, "B_G_PH", "B_G_PH: games as PH", CW_FIELD_INT16},
+  {cwdaily_B_G_PR, "B_G_PR", "B_G_PR: games as PR", CW_FIELD_INT16},
+  {cwdaily_P_G, "P_G", "P_G:   games pitched", CW_FIELD_INT16},
+  {cwdaily_P_GS, "P_GS", "P_GS:  games started", CW_FIELD_INT16},
+  {cwdaily_P_CG, "P_CG", "P_CG:  complete games", CW_FIELD_INT16},
+  {cwdaily_P_SHO, "P_SHO", "P_SHO: shutouts", CW_FIELD_INT16},
+  {cwdaily_P_GF, "P_GF", "P_GF:  games finished", CW_FIELD_INT16},
+  {cwdaily_P_W, "P_W", "P_W:  wins", CW_FIELD_INT16},
+  {cwdaily_P_L, "P_L", "P_L:  losses", CW_FIELD_INT16},
+  {cwdaily_P_SV, "P_SV", "P_SV:  saves", CW_FIELD_INT16},
+  {cwdaily_P_OUT, "P_OUT", "P_OUT: outs recorded (innings pitched times 3)", CW_FIELD_INT16},
+  {cwdaily_P_TBF, "P_TBF", "P_TBF: batters faced", CW_FIELD_INT16},
+  {cwdaily_P_AB, "P_AB", "P_AB:  at bats", CW_FIELD_INT16},
+  {cwdaily_P_R, "P_R", "P_R:   runs allowed", CW_FIELD_INT16},
+  {cwdaily_P_ER, "P_ER", "P_ER:  earned runs allowed", CW_FIELD_INT16},
+  {cwdaily_P_H, "P_H", "P_H:   hits allowed", CW_FIELD_INT16},
+  {cwdaily_P_TB, "P_TB", "P_TB:  total bases allowed", CW_FIELD_INT16},
+  {cwdaily_P_2B, "P_2B", "P_2B:  doubles allowed", CW_FIELD_INT16},
+  {cwdaily_P_3B, "P_3B", "P_3B:  triples allowed", CW_FIELD_INT16},
+  {cwdaily_P_HR, "P_HR", "P_HR:  home runs allowed", CW_FIELD_INT16},
+  {cwdaily_P_HR4, "P_HR4", "P_HR4:  grand slams allowed", CW_FIELD_INT16},
+  {cwdaily_P_BB, "P_BB", "P_BB:  walks allowed", CW_FIELD_INT16},
+  {cwdaily_P_IBB, "P_IBB", "P_IBB: intentional walks allowed", CW_FIELD_INT16},
+  {cwdaily_P_SO, "P_SO", "P_SO:  strikeouts", CW_FIELD_INT16},
+  {cwdaily_P_GDP, "P_GDP", "P_GDP: grounded into double play", CW_FIELD_INT16},
+  {cwdaily_P_HP, "P_HP", "P_HP:  hit batsmen", CW_FIELD_INT16},
+  {cwdaily_P_SH, "P_SH", "P_SH:  sacrifice hits against", CW_FIELD_INT16},
+  {cwdaily_P_SF, "P_SF", "P_SF:  sacrifice flies against", CW_FIELD_INT16},
+  {cwdaily_P_XI, "P_XI", "P_XI:  reached on interference", CW_FIELD_INT16},
+  {cwdaily_P_WP, "P_WP", "P_WP:  wild pitches", CW_FIELD_INT16},
+  {cwdaily_P_BK, "P_BK", "P_BK:  balks", CW_FIELD_INT16},
+  {cwdaily_P_IR, "P_IR", "P_IR:  inherited runners", CW_FIELD_INT16},
+  {cwdaily_P_IRS, "P_IRS", "P_IRS: inherited runners scored", CW_FIELD_INT16},
+  {cwdaily_P_GO, "P_GO", "P_GO:  ground outs", CW_FIELD_INT16},
+  {cwdaily_P_AO, "P_AO", "P_AO:  air outs", CW_FIELD_INT16},
+  {cwdaily_P_PITCH, "P_PITCH", "P_PITCH:  pitches", CW_FIELD_INT16},
+  {cwdaily_P_STRIKE, "P_STRIKE", "P_STRIKE: strikes", CW_FIELD_INT16},
+  {cwdaily_P_G, "F_P_G", "F_P_G:    games at P", CW_FIELD_INT16},
+  {cwdaily_P_GS, "F_P_GS", "F_P_GS:   games started at P", CW_FIELD_INT16},
+  {cwdaily_F_P_OUT, "F_P_OUT",
+   "F_P_OUT:  outs recorded at P (innings fielded times 3)", CW_FIELD_INT16},
+  {cwdaily_F_P_TC, "F_P_TC", "F_P_TC:   total chances at P", CW_FIELD_INT16},
+  {cwdaily_F_P_PO, "F_P_PO", "F_P_PO:   putouts at P", CW_FIELD_INT16},
+  {cwdaily_F_P_A, "F_P_A", "F_P_A:    assists at P", CW_FIELD_INT16},
+  {cwdaily_F_P_E, "F_P_E", "F_P_E:    errors at P", CW_FIELD_INT16},
+  {cwdaily_F_P_DP, "F_P_DP", "F_P_DP:   double plays at P", CW_FIELD_INT16},
+  {cwdaily_F_P_TP, "F_P_TP", "F_P_TP:   triple plays at P", CW_FIELD_INT16},
+  {cwdaily_F_C_G, "F_C_G", "F_C_G:    games at C", CW_FIELD_INT16},
+  {cwdaily_F_C_GS, "F_C_GS", "F_C_GS:   games started at C", CW_FIELD_INT16},
+  {cwdaily_F_C_OUT, "F_C_OUT",
+   "F_C_OUT:  outs recorded at C (innings fielded times 3)", CW_FIELD_INT16},
+  {cwdaily_F_C_TC, "F_C_TC", "F_C_TC:   total chances at C", CW_FIELD_INT16},
+  {cwdaily_F_C_PO, "F_C_PO", "F_C_PO:   putouts at C", CW_FIELD_INT16},
+  {cwdaily_F_C_A, "F_C_A", "F_C_A:    assists at C", CW_FIELD_INT16},
+  {cwdaily_F_C_E, "F_C_E", "F_C_E:    errors at C", CW_FIELD_INT16},
+  {cwdaily_F_C_DP, "F_C_DP", "F_C_DP:   double plays at C", CW_FIELD_INT16},
+  {cwdaily_F_C_TP, "F_C_TP", "F_C_TP:   triple plays at C", CW_FIELD_INT16},
+  {cwdaily_F_C_PB, "F_C_PB", "F_C_PB:   passed balls at C", CW_FIELD_INT16},
+  {cwdaily_F_C_XI, "F_C_XI", "F_C_IX:   catcher's interference at C", CW_FIELD_INT16},
+  {cwdaily_F_1B_G, "F_1B_G", "F_1B_G:   games at 1B", CW_FIELD_INT16},
+  {cwdaily_F_1B_GS, "F_1B_GS", "F_1B_GS:  games started at 1B", CW_FIELD_INT16},
+  {cwdaily_F_1B_OUT, "F_1B_OUT",
+   "F_1B_OUT: outs recorded at 1B (innings fielded times 3)", CW_FIELD_INT16},
+  {cwdaily_F_1B_TC, "F_1B_TC", "F_1B_TC:  total chances at 1B", CW_FIELD_INT16},
+  {cwdaily_F_1B_PO, "F_1B_PO", "F_1B_PO:  putouts at 1B", CW_FIELD_INT16},
+  {cwdaily_F_1B_A, "F_1B_A", "F_1B_A:   assists at 1B", CW_FIELD_INT16},
+  {cwdaily_F_1B_E, "F_1B_E", "F_1B_E:   errors at 1B", CW_FIELD_INT16},
+  {cwdaily_F_1B_DP, "F_1B_DP", "F_1B_DP:  double plays at 1B", CW_FIELD_INT16},
+  {cwdaily_F_1B_TP, "F_1B_TP", "F_1B_TP:  triple plays at 1B", CW_FIELD_INT16},
+  {cwdaily_F_2B_G, "F_2B_G", "F_2B_G:   games at 2B", CW_FIELD_INT16},
+  {cwdaily_F_2B_GS, "F_2B_GS", "F_2B_GS:  games started at 2B", CW_FIELD_INT16},
+  {cwdaily_F_2B_OUT, "F_2B_OUT",
+   "F_2B_OUT: outs recorded at 2B (innings fielded times 3)", CW_FIELD_INT16},
+  {cwdaily_F_2B_TC, "F_2B_TC", "F_2B_TC:  total chances at 2B", CW_FIELD_INT16},
+  {cwdaily_F_2B_PO, "F_2B_PO", "F_2B_PO:  putouts at 2B", CW_FIELD_INT16},
+  {cwdaily_F_2B_A, "F_2B_A", "F_2B_A:   assists at 2B", CW_FIELD_INT16},
+  {cwdaily_F_2B_E, "F_2B_E", "F_2B_E:   errors at 2B", CW_FIELD_INT16},
+  {cwdaily_F_2B_DP, "F_2B_DP", "F_2B_DP:  double plays at 2B", CW_FIELD_INT16},
+  {cwdaily_F_2B_TP, "F_2B_TP", "F_2B_TP:  triple plays at 2B", CW_FIELD_INT16},
+  {cwdaily_F_3B_G, "F_3B_G", "F_3B_G:   games at 3B", CW_FIELD_INT16},
+  {cwdaily_F_3B_GS, "F_3B_GS", "F_3B_GS:  games started at 3B", CW_FIELD_INT16},
+  {cwdaily_F_3B_OUT, "F_3B_OUT",
+   "F_3B_OUT: outs recorded at 3B (innings fielded times 3)", CW_FIELD_INT16},
+  {cwdaily_F_3B_TC, "F_3B_TC", "F_3B_TC:  total chances at 3B", CW_FIELD_INT16},
+  {cwdaily_F_3B_PO, "F_3B_PO", "F_3B_PO:  putouts at 3B", CW_FIELD_INT16},
+  {cwdaily_F_3B_A, "F_3B_A", "F_3B_A:   assists at 3B", CW_FIELD_INT16},
+  {cwdaily_F_3B_E, "F_3B_E", "F_3B_E:   errors at 3B", CW_FIELD_INT16},
+  {cwdaily_F_3B_DP, "F_3B_DP", "F_3B_DP:  double plays at 3B", CW_FIELD_INT16},
+  {cwdaily_F_3B_TP, "F_3B_TP", "F_3B_TP:  triple plays at 3B", CW_FIELD_INT16},
+  {cwdaily_F_SS_G, "F_SS_G", "F_SS_G:    games at SS", CW_FIELD_INT16},
+  {cwdaily_F_SS_GS, "F_SS_GS", "F_SS_GS:  games started at SS", CW_FIELD_INT16},
+  {cwdaily_F_SS_OUT, "F_SS_OUT",
+   "F_SS_OUT: outs recorded at SS (innings fielded times 3)", CW_FIELD_INT16},
+  {cwdaily_F_SS_TC, "F_SS_TC", "F_SS_TC:  total chances at SS", CW_FIELD_INT16},
+  {cwdaily_F_SS_PO, "F_SS_PO", "F_SS_PO:  putouts at SS", CW_FIELD_INT16},
+  {cwdaily_F_SS_A, "F_SS_A", "F_SS_A:   assists at SS", CW_FIELD_INT16},
+  {cwdaily_F_SS_E, "F_SS_E", "F_SS_E:   errors at SS", CW_FIELD_INT16},
+  {cwdaily_F_SS_DP, "F_SS_DP", "F_SS_DP:  double plays at SS", CW_FIELD_INT16},
+  {cwdaily_F_SS_TP, "F_SS_TP", "F_SS_TP:  triple plays at SS", CW_FIELD_INT16},
+  {cwdaily_F_LF_G, "F_LF_G", "F_LF_G:   games at LF", CW_FIELD_INT16},
+  {cwdaily_F_LF_GS, "F_LF_GS", "F_LF_GS:  games started at LF", CW_FIELD_INT16},
+  {cwdaily_F_LF_OUT, "F_LF_OUT",
+   "F_LF_OUT: outs recorded at LF (innings fielded times 3)", CW_FIELD_INT16},
+  {cwdaily_F_LF_TC, "F_LF_TC", "F_LF_TC:  total chances at LF", CW_FIELD_INT16},
+  {cwdaily_F_LF_PO, "F_LF_PO", "F_LF_PO:  putouts at LF", CW_FIELD_INT16},
+  {cwdaily_F_LF_A, "F_LF_A", "F_LF_A:   assists at LF", CW_FIELD_INT16},
+  {cwdaily_F_LF_E, "F_LF_E", "F_LF_E:   errors at LF", CW_FIELD_INT16},
+  {cwdaily_F_LF_DP, "F_LF_DP", "F_LF_DP:  double plays at LF", CW_FIELD_INT16},
+  {cwdaily_F_LF_TP, "F_LF_TP", "F_LF_TP:  triple plays at LF", CW_FIELD_INT16},
+  {cwdaily_F_CF_G, "F_CF_G", "F_CF_G:   games at CF", CW_FIELD_INT16},
+  {cwdaily_F_CF_GS, "F_CF_GS", "F_CF_GS:  games started at CF", CW_FIELD_INT16},
+  {cwdaily_F_CF_OUT, "F_CF_OUT",
+   "F_CF_OUT: outs recorded at CF (innings fielded times 3)", CW_FIELD_INT16},
+  {cwdaily_F_CF_TC, "F_CF_TC", "F_CF_TC:  total chances at CF", CW_FIELD_INT16},
+  {cwdaily_F_CF_PO, "F_CF_PO", "F_CF_PO:  putouts at CF", CW_FIELD_INT16},
+  {cwdaily_F_CF_A, "F_CF_A", "F_CF_A:   assists at CF", CW_FIELD_INT16},
+  {cwdaily_F_CF_E, "F_CF_E", "F_CF_E:   errors at CF", CW_FIELD_INT16},
+  {cwdaily_F_CF_DP, "F_CF_DP", "F_CF_DP:  double plays at CF", CW_FIELD_INT16},
+  {cwdaily_F_CF_TP, "F_CF_TP", "F_CF_TP:  triple plays at CF", CW_FIELD_INT16},
+  {cwdaily_F_RF_G, "F_RF_G", "F_RF_G:   games at RF", CW_FIELD_INT16},
+  {cwdaily_F_RF_GS, "F_RF_GS", "F_RF_GS:  games started at RF", CW_FIELD_INT16},
+  {cwdaily_F_RF_OUT, "F_RF_OUT",
+   "F_RF_OUT: outs recorded at RF (innings fielded times 3)", CW_FIELD_INT16},
+  {cwdaily_F_RF_TC, "F_RF_TC", "F_RF_TC:  total chances at RF", CW_FIELD_INT16},
+  {cwdaily_F_RF_PO, "F_RF_PO", "F_RF_PO:  putouts at RF", CW_FIELD_INT16},
+  {cwdaily_F_RF_A, "F_RF_A", "F_RF_A:   assists at RF", CW_FIELD_INT16},
+  {cwdaily_F_RF_E, "F_RF_E", "F_RF_E:   errors at RF", CW_FIELD_INT16},
+  {cwdaily_F_RF_DP, "F_RF_DP", "F_RF_DP:  double plays at RF", CW_FIELD_INT16},
+  {cwdaily_F_RF_TP, "F_RF_TP", "F_RF_TP:  triple plays at RF", CW_FIELD_INT16}};
+
+/*
+ * For PostgreSQL binary COPY output, fields are separated by a null
+ * character instead of a comma, and the start of each is recorded here.
+ */
+static char *column_values[sizeof(field_data) / sizeof(field_data[0])];
+static CWFieldType column_types[sizeof(field_data) / sizeof(field_data[0])];
+
+/* One boxscore is rebuilt for each game, so its memory is reused */
+static CWBoxscore *game_box = NULL;
 
 void cwdaily_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
 {
   char *buf;
   char output_line[4096];
-  int i, j, t, seq, comma;
+  int i, j, t, seq, comma, column;
   CWGameIterator *gameiter = cw_gameiter_create(game);
-  CWBoxscore *box = cw_box_create(game);
+  CWBoxscore *box;
   CWBoxPlayer *player;
 
   while (gameiter->event != NULL) {
     cw_gameiter_next(gameiter);
   }
+  if (game_box == NULL) {
+    game_box = cw_box_create(game);
+  }
+  else {
+    cw_box_rebuild(game_box, game);
+  }
+  box = game_box;
 
   for (t = 0; t <= 1; t++) {
     for (j = 1; j <= 10; j++) {
@@ -675,18 +705,25 @@ void cwdaily_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
         strcpy(output_line, "");
         buf = output_line;
         comma = 0;
+        column = 0;
         for (i = 0; i <= max_field; i++) {
           if (fields[i]) {
             if (ascii && comma) {
-              *(buf++) = ',';
+              *(buf++) = pgcopy ? '\0' : ',';
             }
             else {
               comma = 1;
             }
+            column_values[column++] = buf;
             buf += (*field_data[i].f)(buf, gameiter, box, t, j, seq, player, visitors, home);
           }
         }
-        printf("%s\n", output_line);
+        if (pgcopy) {
+          cw_pgcopy_write_row(stdout, column_values, column_types, column);
+        }
+        else {
+          printf("%s\n", output_line);
+        }
         player = player->next;
         seq++;
       }
@@ -694,7 +731,7 @@ void cwdaily_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
   }
 
   cw_gameiter_cleanup(gameiter);
-  free(gameiter);
+  cw_free(CW_ALLOC_GAMEITER, gameiter);
 }
 
 void (*cwtools_process_game)(CWGame *, CWRoster *, CWRoster *) = cwdaily_process_game;
@@ -711,14 +748,25 @@ void cwdaily_print_help(void)
   fprintf(stderr, "  -y year   Year to process (for teamyyyy and aaayyyy.ros).\n");
   fprintf(stderr,
           "  -D dir    Directory to find team and roster files (default is current directory)\n");
+  fprintf(stderr, "  -C file   Catalog of games (from cwcatalog), to read only selected games\n");
   fprintf(stderr, "  -s start  Earliest date to process (mmdd).\n");
   fprintf(stderr, "  -e end    Last date to process (mmdd).\n");
   fprintf(stderr, "  -a        generate Ascii-delimited format files (default)\n");
   fprintf(stderr, "  -ft       generate Fortran format files\n");
+  fprintf(stderr, "  -fp       generate PostgreSQL binary COPY format\n");
   fprintf(stderr, "  -f flist  give list of fields to output\n");
   fprintf(stderr, "              Default is 0-153\n");
   fprintf(stderr, "  -d        print list of field numbers and descriptions\n");
   fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n");
+  fprintf(stderr, "  --team=list  only process games of the teams listed (IDs separated\n");
+  fprintf(stderr, "            by commas)\n");
+  fprintf(stderr, "  --park=list  only process games at the parks listed\n");
+  fprintf(stderr, "  --stats[=file]  report counts and phase timings at exit,\n");
+  fprintf(stderr, "            to stderr, or as JSON to file\n");
+  fprintf(stderr, "  --serve=socket  read the games once, and answer requests\n");
+  fprintf(stderr, "            for them on a Unix-domain socket\n");
+  fprintf(stderr, "  --incremental=dir  keep the output for each file in dir,\n");
+  fprintf(stderr, "            and reuse it while the file is unchanged\n");
   fprintf(stderr, "  -n        print field names in first row of output\n\n");
 
   exit(0);
@@ -760,11 +808,17 @@ void (*cwtools_print_welcome_message)(char *) = cwdaily_print_welcome_message;
 
 void cwdaily_initialize(void)
 {
-  int i, comma = 0;
+  int i, comma = 0, column = 0;
   char output_line[4096];
   char *buf;
 
-  if (!ascii || !print_header) {
+  for (i = 0; i <= max_field; i++) {
+    if (fields[i]) {
+      column_types[column++] = field_data[i].type;
+    }
+  }
+
+  if (!ascii || pgcopy || !print_header) {
     return;
   }
 
@@ -791,6 +845,11 @@ void (*cwtools_initialize)(void) = cwdaily_initialize;
 
 void cwdaily_cleanup(void)
 {
+  if (game_box != NULL) {
+    cw_box_cleanup(game_box);
+    cw_free(CW_ALLOC_BOX, game_box);
+    game_box = NULL;
+  }
 }
 
 void (*cwtools_cleanup)(void) = cwdaily_cleanup;
@@ -800,6 +859,7 @@ extern char first_date[5];
 extern char last_date[5];
 extern char game_id[20];
 extern char data_dir[1024];
+extern char catalog_file[1024];
 extern int quiet;
 
 extern void cwtools_parse_field_list(char *text, int max_field, int *fields);
@@ -812,6 +872,7 @@ int cwdaily_parse_command_line(int argc, char *argv[])
   for (i = 1; i < argc; i++) {
     if (!strcmp(argv[i], "-a")) {
       ascii = 1;
+      pgcopy = 0;
     }
     else if (!strcmp(argv[i], "-d")) {
       (*cwtools_print_welcome_message)(argv[0]);
@@ -844,6 +905,11 @@ int cwdaily_parse_command_line(int argc, char *argv[])
     }
     else if (!strcmp(argv[i], "-ft")) {
       ascii = 0;
+      pgcopy = 0;
+    }
+    else if (!strcmp(argv[i], "-fp")) {
+      ascii = 1;
+      pgcopy = 1;
     }
     else if (!strcmp(argv[i], "-s")) {
       if (++i < argc) {
@@ -861,6 +927,12 @@ int cwdaily_parse_command_line(int argc, char *argv[])
         data_dir[sizeof(data_dir) - 1] = '\0';
       }
     }
+    else if (!strcmp(argv[i], "-C")) {
+      if (++i < argc) {
+        strncpy(catalog_file, argv[i], sizeof(catalog_file) - 1);
+        catalog_file[sizeof(catalog_file) - 1] = '\0';
+      }
+    }
     else if (argv[i][0] == '-') {
       fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
       exit(1);
@@ -31,12 +31,18 @@
 
 #include "cwlib/chadwick.h"
 #include "buffer.h"
+#include "arrowwrite.h"
+#include "jsonwrite.h"
+#include "iddict.h"
+#include "pgcopy.h"
 
 /*************************************************************************
  * Global variables for command-line options
  *************************************************************************/
 
 extern int ascii;
+extern int pgcopy;
+extern int output_by_file;
 
 /* Fields to display (-f) */
 int fields[97] = {1, 1, 1, 1, 1, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0,
@@ -57,6 +63,20 @@ char program_name[20] = "cwevent";
 
 int print_header = 0;
 
+/* Write an Arrow IPC stream instead of text (-fa), in batches of (-b) rows */
+int arrow_output = 0;
+int arrow_batch_size = ARROW_DEFAULT_BATCH_SIZE;
+ArrowStream *arrow_stream = NULL;
+
+/* Write one JSON object per event instead of text (-J) */
+int json_output = 0;
+JSONWriter *json_writer = NULL;
+
+/* Write player and team IDs as integer keys, listed in a side table file (-k) */
+char *id_keys_file = NULL;
+FILE *id_keys = NULL;
+IDDictionary *id_dictionary = NULL;
+
 /*************************************************************************
  * Writing to buffer abstraction
  *************************************************************************/
@@ -80,7 +100,7 @@ int cwevent_future_runs(CWGameIterator *orig_gameiter)
   }
 
   cw_gameiter_cleanup(gameiter);
-  free(gameiter);
+  cw_free(CW_ALLOC_GAMEITER, gameiter);
   return runs;
 }
 
@@ -100,6 +120,7 @@ typedef int (*field_func)(CWBuffer *, CWGameIterator *, CWRoster *, CWRoster *);
 typedef struct field_struct {
   field_func f;
   char *header, *description;
+  CWFieldType type;
 } field_struct;
 
 /*
@@ -816,119 +837,133 @@ DECLARE_FIELDFUNC(cwevent_event_number)
 }
 
 static field_struct field_data[] = {
-  /*  0 */ {cwevent_game_id, "GAME_ID", "game id*"},
-  /*  1 */ {cwevent_visiting_team, "AWAY_TEAM_ID", "visiting team*"},
-  /*  2 */ {cwevent_inning, "INN_CT", "inning*"},
-  /*  3 */ {cwevent_batting_team, "BAT_HOME_ID", "batting_team*"},
-  /*  4 */ {cwevent_outs, "OUTS_CT", "outs*"},
-  /*  5 */ {cwevent_balls, "BALLS_CT", "balls*"},
-  /*  6 */ {cwevent_strikes, "STRIKES_CT", "strikes*"},
-  /*  7 */ {cwevent_pitches, "PITCH_SEQ_TX", "pitch sequence"},
-  /*  8 */ {cwevent_visitor_score, "AWAY_SCORE_CT", "vis score*"},
-  /*  9 */ {cwevent_home_score, "HOME_SCORE_CT", "home score*"},
-  /* 10 */ {cwevent_batter, "BAT_ID", "batter"},
-  /* 11 */ {cwevent_batter_hand, "BAT_HAND_CD", "batter hand"},
-  /* 12 */ {cwevent_res_batter, "RESP_BAT_ID", "res batter*"},
-  /* 13 */ {cwevent_res_batter_hand, "RESP_BAT_HAND_CD", "res batter hand*"},
-  /* 14 */ {cwevent_pitcher, "PIT_ID", "pitcher"},
-  /* 15 */ {cwevent_pitcher_hand, "PIT_HAND_CD", "pitcher hand"},
-  /* 16 */ {cwevent_res_pitcher, "RESP_PIT_ID", "res pitcher*"},
-  /* 17 */ {cwevent_res_pitcher_hand, "RESP_PIT_HAND_CD", "res pitcher hand*"},
-  /* 18 */ {cwevent_catcher, "POS2_FLD_ID", "catcher"},
-  /* 19 */ {cwevent_first_baseman, "POS3_FLD_ID", "first base"},
-  /* 20 */ {cwevent_second_baseman, "POS4_FLD_ID", "second base"},
-  /* 21 */ {cwevent_third_baseman, "POS5_FLD_ID", "third base"},
-  /* 22 */ {cwevent_shortstop, "POS6_FLD_ID", "shortstop"},
-  /* 23 */ {cwevent_left_fielder, "POS7_FLD_ID", "left field"},
-  /* 24 */ {cwevent_center_fielder, "POS8_FLD_ID", "center field"},
-  /* 25 */ {cwevent_right_fielder, "POS9_FLD_ID", "right field"},
-  /* 26 */ {cwevent_runner_first, "BASE1_RUN_ID", "first runner*"},
-  /* 27 */ {cwevent_runner_second, "BASE2_RUN_ID", "second runner*"},
-  /* 28 */ {cwevent_runner_third, "BASE3_RUN_ID", "third runner*"},
-  /* 29 */ {cwevent_event_text, "EVENT_TX", "event text*"},
-  /* 30 */ {cwevent_leadoff_flag, "LEADOFF_FL", "leadoff flag*"},
-  /* 31 */ {cwevent_ph_flag, "PH_FL", "pinchhit flag*"},
-  /* 32 */ {cwevent_defensive_position, "BAT_FLD_CD", "defensive position*"},
-  /* 33 */ {cwevent_lineup_position, "BAT_LINEUP_ID", "lineup position*"},
-  /* 34 */ {cwevent_event_type, "EVENT_CD", "event type*"},
-  /* 35 */ {cwevent_batter_event_flag, "BAT_EVENT_FL", "batter event flag*"},
-  /* 36 */ {cwevent_ab_flag, "AB_FL", "ab flag*"},
-  /* 37 */ {cwevent_hit_value, "H_CD", "hit value*"},
-  /* 38 */ {cwevent_sh_flag, "SH_FL", "SH flag*"},
-  /* 39 */ {cwevent_sf_flag, "SF_FL", "SF flag*"},
-  /* 40 */ {cwevent_outs_on_play, "EVENT_OUTS_CT", "outs on play*"},
-  /* 41 */ {cwevent_dp_flag, "DP_FL", "double play flag"},
-  /* 42 */ {cwevent_tp_flag, "TP_FL", "triple play flag"},
-  /* 43 */ {cwevent_rbi_on_play, "RBI_CT", "RBI on play*"},
-  /* 44 */ {cwevent_wp_flag, "WP_FL", "wild pitch flag*"},
-  /* 45 */ {cwevent_pb_flag, "PB_FL", "passed ball flag*"},
-  /* 46 */ {cwevent_fielded_by, "FLD_CD", "fielded by"},
-  /* 47 */ {cwevent_batted_ball_type, "BATTEDBALL_CD", "batted ball type"},
-  /* 48 */ {cwevent_bunt_flag, "BUNT_FL", "bunt flag"},
-  /* 49 */ {cwevent_foul_flag, "FOUL_FL", "foul flag"},
-  /* 50 */ {cwevent_hit_location, "BATTEDBALL_LOC_TX", "hit location"},
-  /* 51 */ {cwevent_num_errors, "ERR_CT", "num errors*"},
-  /* 52 */ {cwevent_error1_player, "ERR1_FLD_CD", "1st error player"},
-  /* 53 */ {cwevent_error1_type, "ERR1_CD", "1st error type"},
-  /* 54 */ {cwevent_error2_player, "ERR2_FLD_CD", "2nd error player"},
-  /* 55 */ {cwevent_error2_type, "ERR2_CD", "2nd error type"},
-  /* 56 */ {cwevent_error3_player, "ERR3_FLD_CD", "3rd error player"},
-  /* 57 */ {cwevent_error3_type, "ERR3_CD", "3rd error type"},
+  /*  0 */ {cwevent_game_id, "GAME_ID", "game id*", CW_FIELD_ID},
+  /*  1 */ {cwevent_visiting_team, "AWAY_TEAM_ID", "visiting team*", CW_FIELD_ID},
+  /*  2 */ {cwevent_inning, "INN_CT", "inning*", CW_FIELD_INT8},
+  /*  3 */ {cwevent_batting_team, "BAT_HOME_ID", "batting_team*", CW_FIELD_INT8},
+  /*  4 */ {cwevent_outs, "OUTS_CT", "outs*", CW_FIELD_INT8},
+  /*  5 */ {cwevent_balls, "BALLS_CT", "balls*", CW_FIELD_INT8},
+  /*  6 */ {cwevent_strikes, "STRIKES_CT", "strikes*", CW_FIELD_INT8},
+  /*  7 */ {cwevent_pitches, "PITCH_SEQ_TX", "pitch sequence", CW_FIELD_TEXT},
+  /*  8 */ {cwevent_visitor_score, "AWAY_SCORE_CT", "vis score*", CW_FIELD_INT8},
+  /*  9 */ {cwevent_home_score, "HOME_SCORE_CT", "home score*", CW_FIELD_INT8},
+  /* 10 */ {cwevent_batter, "BAT_ID", "batter", CW_FIELD_ID},
+  /* 11 */ {cwevent_batter_hand, "BAT_HAND_CD", "batter hand", CW_FIELD_TEXT},
+  /* 12 */ {cwevent_res_batter, "RESP_BAT_ID", "res batter*", CW_FIELD_ID},
+  /* 13 */ {cwevent_res_batter_hand, "RESP_BAT_HAND_CD", "res batter hand*", CW_FIELD_TEXT},
+  /* 14 */ {cwevent_pitcher, "PIT_ID", "pitcher", CW_FIELD_ID},
+  /* 15 */ {cwevent_pitcher_hand, "PIT_HAND_CD", "pitcher hand", CW_FIELD_TEXT},
+  /* 16 */ {cwevent_res_pitcher, "RESP_PIT_ID", "res pitcher*", CW_FIELD_ID},
+  /* 17 */ {cwevent_res_pitcher_hand, "RESP_PIT_HAND_CD", "res pitcher hand*", CW_FIELD_TEXT},
+  /* 18 */ {cwevent_catcher, "POS2_FLD_ID", "catcher", CW_FIELD_ID},
+  /* 19 */ {cwevent_first_baseman, "POS3_FLD_ID", "first base", CW_FIELD_ID},
+  /* 20 */ {cwevent_second_baseman, "POS4_FLD_ID", "second base", CW_FIELD_ID},
+  /* 21 */ {cwevent_third_baseman, "POS5_FLD_ID", "third base", CW_FIELD_ID},
+  /* 22 */ {cwevent_shortstop, "POS6_FLD_ID", "shortstop", CW_FIELD_ID},
+  /* 23 */ {cwevent_left_fielder, "POS7_FLD_ID", "left field", CW_FIELD_ID},
+  /* 24 */ {cwevent_center_fielder, "POS8_FLD_ID", "center field", CW_FIELD_ID},
+  /* 25 */ {cwevent_right_fielder, "POS9_FLD_ID", "right field", CW_FIELD_ID},
+  /* 26 */ {cwevent_runner_first, "BASE1_RUN_ID", "first runner*", CW_FIELD_ID},
+  /* 27 */ {cwevent_runner_second, "BASE2_RUN_ID", "second runner*", CW_FIELD_ID},
+  /* 28 */ {cwevent_runner_third, "BASE3_RUN_ID", "third runner*", CW_FIELD_ID},
+  /* 29 */ {cwevent_event_text, "EVENT_TX", "event text*", CW_FIELD_TEXT},
+  /* 30 */ {cwevent_leadoff_flag, "LEADOFF_FL", "leadoff flag*", CW_FIELD_FLAG},
+  /* 31 */ {cwevent_ph_flag, "PH_FL", "pinchhit flag*", CW_FIELD_FLAG},
+  /* 32 */ {cwevent_defensive_position, "BAT_FLD_CD", "defensive position*", CW_FIELD_INT8},
+  /* 33 */ {cwevent_lineup_position, "BAT_LINEUP_ID", "lineup position*", CW_FIELD_INT8},
+  /* 34 */ {cwevent_event_type, "EVENT_CD", "event type*", CW_FIELD_INT8},
+  /* 35 */ {cwevent_batter_event_flag, "BAT_EVENT_FL", "batter event flag*", CW_FIELD_FLAG},
+  /* 36 */ {cwevent_ab_flag, "AB_FL", "ab flag*", CW_FIELD_FLAG},
+  /* 37 */ {cwevent_hit_value, "H_CD", "hit value*", CW_FIELD_INT8},
+  /* 38 */ {cwevent_sh_flag, "SH_FL", "SH flag*", CW_FIELD_FLAG},
+  /* 39 */ {cwevent_sf_flag, "SF_FL", "SF flag*", CW_FIELD_FLAG},
+  /* 40 */ {cwevent_outs_on_play, "EVENT_OUTS_CT", "outs on play*", CW_FIELD_INT8},
+  /* 41 */ {cwevent_dp_flag, "DP_FL", "double play flag", CW_FIELD_FLAG},
+  /* 42 */ {cwevent_tp_flag, "TP_FL", "triple play flag", CW_FIELD_FLAG},
+  /* 43 */ {cwevent_rbi_on_play, "RBI_CT", "RBI on play*", CW_FIELD_INT8},
+  /* 44 */ {cwevent_wp_flag, "WP_FL", "wild pitch flag*", CW_FIELD_FLAG},
+  /* 45 */ {cwevent_pb_flag, "PB_FL", "passed ball flag*", CW_FIELD_FLAG},
+  /* 46 */ {cwevent_fielded_by, "FLD_CD", "fielded by", CW_FIELD_INT8},
+  /* 47 */ {cwevent_batted_ball_type, "BATTEDBALL_CD", "batted ball type", CW_FIELD_TEXT},
+  /* 48 */ {cwevent_bunt_flag, "BUNT_FL", "bunt flag", CW_FIELD_FLAG},
+  /* 49 */ {cwevent_foul_flag, "FOUL_FL", "foul flag", CW_FIELD_FLAG},
+  /* 50 */ {cwevent_hit_location, "BATTEDBALL_LOC_TX", "hit location", CW_FIELD_TEXT},
+  /* 51 */ {cwevent_num_errors, "ERR_CT", "num errors*", CW_FIELD_INT8},
+  /* 52 */ {cwevent_error1_player, "ERR1_FLD_CD", "1st error player", CW_FIELD_INT8},
+  /* 53 */ {cwevent_error1_type, "ERR1_CD", "1st error type", CW_FIELD_TEXT},
+  /* 54 */ {cwevent_error2_player, "ERR2_FLD_CD", "2nd error player", CW_FIELD_INT8},
+  /* 55 */ {cwevent_error2_type, "ERR2_CD", "2nd error type", CW_FIELD_TEXT},
+  /* 56 */ {cwevent_error3_player, "ERR3_FLD_CD", "3rd error player", CW_FIELD_INT8},
+  /* 57 */ {cwevent_error3_type, "ERR3_CD", "3rd error type", CW_FIELD_TEXT},
   /* 58 */
   {cwevent_batter_advance, "BAT_DEST_ID",
-   "batter dest* (5 if scores and unearned, 6 if team unearned)"},
+   "batter dest* (5 if scores and unearned, 6 if team unearned)", CW_FIELD_INT8},
   /* 59 */
   {cwevent_runner1_advance, "RUN1_DEST_ID",
-   "runner on 1st dest* (5 if scores and unearned, 6 if team unearned)"},
+   "runner on 1st dest* (5 if scores and unearned, 6 if team unearned)", CW_FIELD_INT8},
   /* 60 */
   {cwevent_runner2_advance, "RUN2_DEST_ID",
-   "runner on 2nd dest* (5 if scores and unearned, 6 if team unearned)"},
+   "runner on 2nd dest* (5 if scores and unearned, 6 if team unearned)", CW_FIELD_INT8},
   /* 61 */
   {cwevent_runner3_advance, "RUN3_DEST_ID",
-   "runner on 3rd dest* (5 if scores and unearned, 6 if team unearned)"},
-  /* 62 */ {cwevent_play_on_batter, "BAT_PLAY_TX", "play on batter"},
-  /* 63 */ {cwevent_play_on_runner1, "RUN1_PLAY_TX", "play on runner on first"},
-  /* 64 */ {cwevent_play_on_runner2, "RUN2_PLAY_TX", "play on runner on second"},
-  /* 65 */ {cwevent_play_on_runner3, "RUN3_PLAY_TX", "play on runner on third"},
-  /* 66 */ {cwevent_sb2_flag, "RUN1_SB_FL", "SB for runner on 1st flag"},
-  /* 67 */ {cwevent_sb3_flag, "RUN2_SB_FL", "SB for runner on 2nd flag"},
-  /* 68 */ {cwevent_sbh_flag, "RUN3_SB_FL", "SB for runner on 3rd flag"},
-  /* 69 */ {cwevent_cs2_flag, "RUN1_CS_FL", "CS for runner on 1st flag"},
-  /* 70 */ {cwevent_cs3_flag, "RUN2_CS_FL", "CS for runner on 2nd flag"},
-  /* 71 */ {cwevent_csh_flag, "RUN3_CS_FL", "CS for runner on 3rd flag"},
-  /* 72 */ {cwevent_po1_flag, "RUN1_PK_FL", "PO for runner on 1st flag"},
-  /* 73 */ {cwevent_po2_flag, "RUN2_PK_FL", "PO for runner on 2nd flag"},
-  /* 74 */ {cwevent_po3_flag, "RUN3_PK_FL", "PO for runner on 3rd flag"},
+   "runner on 3rd dest* (5 if scores and unearned, 6 if team unearned)", CW_FIELD_INT8},
+  /* 62 */ {cwevent_play_on_batter, "BAT_PLAY_TX", "play on batter", CW_FIELD_TEXT},
+  /* 63 */ {cwevent_play_on_runner1, "RUN1_PLAY_TX", "play on runner on first", CW_FIELD_TEXT},
+  /* 64 */ {cwevent_play_on_runner2, "RUN2_PLAY_TX", "play on runner on second", CW_FIELD_TEXT},
+  /* 65 */ {cwevent_play_on_runner3, "RUN3_PLAY_TX", "play on runner on third", CW_FIELD_TEXT},
+  /* 66 */ {cwevent_sb2_flag, "RUN1_SB_FL", "SB for runner on 1st flag", CW_FIELD_FLAG},
+  /* 67 */ {cwevent_sb3_flag, "RUN2_SB_FL", "SB for runner on 2nd flag", CW_FIELD_FLAG},
+  /* 68 */ {cwevent_sbh_flag, "RUN3_SB_FL", "SB for runner on 3rd flag", CW_FIELD_FLAG},
+  /* 69 */ {cwevent_cs2_flag, "RUN1_CS_FL", "CS for runner on 1st flag", CW_FIELD_FLAG},
+  /* 70 */ {cwevent_cs3_flag, "RUN2_CS_FL", "CS for runner on 2nd flag", CW_FIELD_FLAG},
+  /* 71 */ {cwevent_csh_flag, "RUN3_CS_FL", "CS for runner on 3rd flag", CW_FIELD_FLAG},
+  /* 72 */ {cwevent_po1_flag, "RUN1_PK_FL", "PO for runner on 1st flag", CW_FIELD_FLAG},
+  /* 73 */ {cwevent_po2_flag, "RUN2_PK_FL", "PO for runner on 2nd flag", CW_FIELD_FLAG},
+  /* 74 */ {cwevent_po3_flag, "RUN3_PK_FL", "PO for runner on 3rd flag", CW_FIELD_FLAG},
   /* 75 */
-  {cwevent_responsible_pitcher1, "RUN1_RESP_PIT_ID", "Responsible pitcher for runner on 1st"},
+  {cwevent_responsible_pitcher1, "RUN1_RESP_PIT_ID",
+   "Responsible pitcher for runner on 1st", CW_FIELD_ID},
   /* 76 */
-  {cwevent_responsible_pitcher2, "RUN2_RESP_PIT_ID", "Responsible pitcher for runner on 2nd"},
+  {cwevent_responsible_pitcher2, "RUN2_RESP_PIT_ID",
+   "Responsible pitcher for runner on 2nd", CW_FIELD_ID},
   /* 77 */
-  {cwevent_responsible_pitcher3, "RUN3_RESP_PIT_ID", "Responsible pitcher for runner on 3rd"},
-  /* 78 */ {cwevent_new_game_flag, "GAME_NEW_FL", "New Game Flag"},
-  /* 79 */ {cwevent_end_game_flag, "GAME_END_FL", "End Game Flag"},
-  /* 80 */ {cwevent_pr1_flag, "PR_RUN1_FL", "Pinch-runner on 1st"},
-  /* 81 */ {cwevent_pr2_flag, "PR_RUN2_FL", "Pinch-runner on 2nd"},
-  /* 82 */ {cwevent_pr3_flag, "PR_RUN3_FL", "Pinch-runner on 3rd"},
+  {cwevent_responsible_pitcher3, "RUN3_RESP_PIT_ID",
+   "Responsible pitcher for runner on 3rd", CW_FIELD_ID},
+  /* 78 */ {cwevent_new_game_flag, "GAME_NEW_FL", "New Game Flag", CW_FIELD_FLAG},
+  /* 79 */ {cwevent_end_game_flag, "GAME_END_FL", "End Game Flag", CW_FIELD_FLAG},
+  /* 80 */ {cwevent_pr1_flag, "PR_RUN1_FL", "Pinch-runner on 1st", CW_FIELD_FLAG},
+  /* 81 */ {cwevent_pr2_flag, "PR_RUN2_FL", "Pinch-runner on 2nd", CW_FIELD_FLAG},
+  /* 82 */ {cwevent_pr3_flag, "PR_RUN3_FL", "Pinch-runner on 3rd", CW_FIELD_FLAG},
   /* 83 */
-  {cwevent_removed_runner1, "REMOVED_FOR_PR_RUN1_ID", "Runner removed for pinch-runner on 1st"},
+  {cwevent_removed_runner1, "REMOVED_FOR_PR_RUN1_ID",
+   "Runner removed for pinch-runner on 1st", CW_FIELD_ID},
   /* 84 */
-  {cwevent_removed_runner2, "REMOVED_FOR_PR_RUN2_ID", "Runner removed for pinch-runner on 2nd"},
+  {cwevent_removed_runner2, "REMOVED_FOR_PR_RUN2_ID",
+   "Runner removed for pinch-runner on 2nd", CW_FIELD_ID},
   /* 85 */
-  {cwevent_removed_runner3, "REMOVED_FOR_PR_RUN3_ID", "Runner removed for pinch-runner on 3rd"},
-  /* 86 */ {cwevent_removed_batter, "REMOVED_FOR_PH_BAT_ID", "Batter removed for pinch-hitter "},
+  {cwevent_removed_runner3, "REMOVED_FOR_PR_RUN3_ID",
+   "Runner removed for pinch-runner on 3rd", CW_FIELD_ID},
+  /* 86 */
+  {cwevent_removed_batter, "REMOVED_FOR_PH_BAT_ID",
+   "Batter removed for pinch-hitter ", CW_FIELD_ID},
   /* 87 */
   {cwevent_removed_batter_position, "REMOVED_FOR_PH_BAT_FLD_CD",
-   "Position of batter removed for pinch-hitter"},
-  /* 88 */ {cwevent_putout1, "PO1_FLD_CD", "Fielder with First Putout (0 if none)"},
-  /* 89 */ {cwevent_putout2, "PO2_FLD_CD", "Fielder with Second Putout (0 if none)"},
-  /* 90 */ {cwevent_putout3, "PO3_FLD_CD", "Fielder with Third Putout (0 if none)"},
-  /* 91 */ {cwevent_assist1, "ASS1_FLD_CD", "Fielder with First Assist (0 if none)"},
-  /* 92 */ {cwevent_assist2, "ASS2_FLD_CD", "Fielder with Second Assist (0 if none)"},
-  /* 93 */ {cwevent_assist3, "ASS3_FLD_CD", "Fielder with Third Assist (0 if none)"},
-  /* 94 */ {cwevent_assist4, "ASS4_FLD_CD", "Fielder with Fourth Assist (0 if none)"},
-  /* 95 */ {cwevent_assist5, "ASS5_FLD_CD", "Fielder with Fifth Assist (0 if none)"},
-  /* 96 */ {cwevent_event_number, "EVENT_ID", "event num"}};
+   "Position of batter removed for pinch-hitter", CW_FIELD_INT8},
+  /* 88 */ {cwevent_putout1, "PO1_FLD_CD", "Fielder with First Putout (0 if none)", CW_FIELD_INT8},
+  /* 89 */
+  {cwevent_putout2, "PO2_FLD_CD", "Fielder with Second Putout (0 if none)", CW_FIELD_INT8},
+  /* 90 */ {cwevent_putout3, "PO3_FLD_CD", "Fielder with Third Putout (0 if none)", CW_FIELD_INT8},
+  /* 91 */
+  {cwevent_assist1, "ASS1_FLD_CD", "Fielder with First Assist (0 if none)", CW_FIELD_INT8},
+  /* 92 */
+  {cwevent_assist2, "ASS2_FLD_CD", "Fielder with Second Assist (0 if none)", CW_FIELD_INT8},
+  /* 93 */
+  {cwevent_assist3, "ASS3_FLD_CD", "Fielder with Third Assist (0 if none)", CW_FIELD_INT8},
+  /* 94 */
+  {cwevent_assist4, "ASS4_FLD_CD", "Fielder with Fourth Assist (0 if none)", CW_FIELD_INT8},
+  /* 95 */
+  {cwevent_assist5, "ASS5_FLD_CD", "Fielder with Fifth Assist (0 if none)", CW_FIELD_INT8},
+  /* 96 */ {cwevent_event_number, "EVENT_ID", "event num", CW_FIELD_INT16}};
 
 /*************************************************************************
  * Implementation of "extended" fields
@@ -1069,7 +1104,7 @@ DECLARE_FIELDFUNC(cwevent_truncated_pa_flag)
     if (strcmp(gi->event->event_text, "NP") != 0) {
       if (cw_event_is_batter(gi->event_data)) {
         cw_gameiter_cleanup(gi);
-        free(gi);
+        cw_free(CW_ALLOC_GAMEITER, gi);
         return cw_buffer_emit_flag(buffer, 0);
       }
     }
@@ -1077,7 +1112,7 @@ DECLARE_FIELDFUNC(cwevent_truncated_pa_flag)
   }
 
   cw_gameiter_cleanup(gi);
-  free(gi);
+  cw_free(CW_ALLOC_GAMEITER, gi);
   return cw_buffer_emit_flag(buffer, 1);
 }
 
@@ -1568,123 +1603,207 @@ DECLARE_FIELDFUNC(cwevent_runner3_auto)
 }
 
 static field_struct ext_field_data[] = {
-  /*  0 */ {cwevent_home_team_id, "HOME_TEAM_ID", "home team id"},
-  /*  1 */ {cwevent_batting_team_id, "BAT_TEAM_ID", "batting team id"},
-  /*  2 */ {cwevent_fielding_team_id, "FLD_TEAM_ID", "fielding team id"},
+  /*  0 */ {cwevent_home_team_id, "HOME_TEAM_ID", "home team id", CW_FIELD_ID},
+  /*  1 */ {cwevent_batting_team_id, "BAT_TEAM_ID", "batting team id", CW_FIELD_ID},
+  /*  2 */ {cwevent_fielding_team_id, "FLD_TEAM_ID", "fielding team id", CW_FIELD_ID},
   /*  3 */
   {cwevent_half_inning, "BAT_LAST_ID",
-   "half inning (differs from batting team if home team bats first"},
-  /*  4 */ {cwevent_start_half_inning, "INN_NEW_FL", "start of half inning flag"},
-  /*  5 */ {cwevent_end_half_inning, "INN_END_FL", "end of half inning flag"},
-  /*  6 */ {cwevent_offense_score, "START_BAT_SCORE_CT", "score for team on offense"},
-  /*  7 */ {cwevent_defense_score, "START_FLD_SCORE_CT", "score for team on defense"},
-  /*  8 */ {cwevent_offense_score_inning, "INN_RUNS_CT", "runs scored in this half inning"},
+   "half inning (differs from batting team if home team bats first", CW_FIELD_INT8},
+  /*  4 */ {cwevent_start_half_inning, "INN_NEW_FL", "start of half inning flag", CW_FIELD_FLAG},
+  /*  5 */ {cwevent_end_half_inning, "INN_END_FL", "end of half inning flag", CW_FIELD_FLAG},
+  /*  6 */
+  {cwevent_offense_score, "START_BAT_SCORE_CT", "score for team on offense", CW_FIELD_INT8},
+  /*  7 */
+  {cwevent_defense_score, "START_FLD_SCORE_CT", "score for team on defense", CW_FIELD_INT8},
+  /*  8 */
+  {cwevent_offense_score_inning, "INN_RUNS_CT", "runs scored in this half inning", CW_FIELD_INT8},
   /*  9 */
   {cwevent_offense_batters_game, "GAME_PA_CT",
-   "number of plate appearances in game for team on offense"},
+   "number of plate appearances in game for team on offense", CW_FIELD_INT16},
   /* 10 */
   {cwevent_offense_batters_inning, "INN_PA_CT",
-   "number of plate appearances in inning for team on offense"},
-  /* 11 */ {cwevent_start_pa_flag, "PA_NEW_FL", "start of plate appearance flag"},
-  /* 12 */ {cwevent_truncated_pa_flag, "PA_TRUNC_FL", "truncated plate appearance flag"},
-  /* 13 */ {cwevent_base_state_start, "START_BASES_CD", "base state at start of play"},
-  /* 14 */ {cwevent_base_state_end, "END_BASES_CD", "base state at end of play"},
-  /* 15 */ {cwevent_batter_is_starter, "BAT_START_FL", "batter is starter flag"},
-  /* 16 */ {cwevent_res_batter_is_starter, "RESP_BAT_START_FL", "result batter is starter flag"},
-  /* 17 */ {cwevent_batter_on_deck, "BAT_ON_DECK_ID", "ID of batter on deck"},
-  /* 18 */ {cwevent_batter_in_the_hold, "BAT_IN_HOLD_ID", "ID of batter in the hold"},
-  /* 19 */ {cwevent_pitcher_is_starter, "PIT_START_FL", "pitcher is starter flag"},
-  /* 20 */ {cwevent_res_pitcher_is_starter, "RESP_PIT_START_FL", "result pitcher is starter flag"},
+   "number of plate appearances in inning for team on offense", CW_FIELD_INT8},
+  /* 11 */ {cwevent_start_pa_flag, "PA_NEW_FL", "start of plate appearance flag", CW_FIELD_FLAG},
+  /* 12 */
+  {cwevent_truncated_pa_flag, "PA_TRUNC_FL", "truncated plate appearance flag", CW_FIELD_FLAG},
+  /* 13 */
+  {cwevent_base_state_start, "START_BASES_CD", "base state at start of play", CW_FIELD_INT8},
+  /* 14 */ {cwevent_base_state_end, "END_BASES_CD", "base state at end of play", CW_FIELD_INT8},
+  /* 15 */ {cwevent_batter_is_starter, "BAT_START_FL", "batter is starter flag", CW_FIELD_FLAG},
+  /* 16 */
+  {cwevent_res_batter_is_starter, "RESP_BAT_START_FL",
+   "result batter is starter flag", CW_FIELD_FLAG},
+  /* 17 */ {cwevent_batter_on_deck, "BAT_ON_DECK_ID", "ID of batter on deck", CW_FIELD_ID},
+  /* 18 */ {cwevent_batter_in_the_hold, "BAT_IN_HOLD_ID", "ID of batter in the hold", CW_FIELD_ID},
+  /* 19 */ {cwevent_pitcher_is_starter, "PIT_START_FL", "pitcher is starter flag", CW_FIELD_FLAG},
+  /* 20 */
+  {cwevent_res_pitcher_is_starter, "RESP_PIT_START_FL",
+   "result pitcher is starter flag", CW_FIELD_FLAG},
   /* 21 */
-  {cwevent_runner1_defensive_position, "RUN1_FLD_CD", "defensive position of runner on first"},
+  {cwevent_runner1_defensive_position, "RUN1_FLD_CD",
+   "defensive position of runner on first", CW_FIELD_INT8},
   /* 22 */
-  {cwevent_runner1_lineup_position, "RUN1_LINEUP_CD", "lineup position of runner on first"},
+  {cwevent_runner1_lineup_position, "RUN1_LINEUP_CD",
+   "lineup position of runner on first", CW_FIELD_INT8},
   /* 23 */
   {cwevent_runner1_src_event, "RUN1_ORIGIN_EVENT_ID",
-   "event number on which runner on first reached base"},
+   "event number on which runner on first reached base", CW_FIELD_INT16},
   /* 24 */
-  {cwevent_runner2_defensive_position, "RUN2_FLD_CD", "defensive position of runner on second"},
+  {cwevent_runner2_defensive_position, "RUN2_FLD_CD",
+   "defensive position of runner on second", CW_FIELD_INT8},
   /* 25 */
-  {cwevent_runner2_lineup_position, "RUN2_LINEUP_CD", "lineup position of runner on second"},
+  {cwevent_runner2_lineup_position, "RUN2_LINEUP_CD",
+   "lineup position of runner on second", CW_FIELD_INT8},
   /* 26 */
   {cwevent_runner2_src_event, "RUN2_ORIGIN_EVENT_ID",
-   "event number on which runner on second reached base"},
+   "event number on which runner on second reached base", CW_FIELD_INT16},
   /* 27 */
-  {cwevent_runner3_defensive_position, "RUN3_FLD_CD", "defensive position of runner on third"},
+  {cwevent_runner3_defensive_position, "RUN3_FLD_CD",
+   "defensive position of runner on third", CW_FIELD_INT8},
   /* 28 */
-  {cwevent_runner3_lineup_position, "RUN3_LINEUP_CD", "lineup position of runner on third"},
+  {cwevent_runner3_lineup_position, "RUN3_LINEUP_CD",
+   "lineup position of runner on third", CW_FIELD_INT8},
   /* 29 */
   {cwevent_runner3_src_event, "RUN3_ORIGIN_EVENT_ID",
-   "event number on which runner on third reached base"},
+   "event number on which runner on third reached base", CW_FIELD_INT16},
   /* 30 */
-  {cwevent_responsible_catcher1, "RUN1_RESP_CAT_ID", "Responsible catcher for runner on 1st"},
+  {cwevent_responsible_catcher1, "RUN1_RESP_CAT_ID",
+   "Responsible catcher for runner on 1st", CW_FIELD_ID},
   /* 31 */
-  {cwevent_responsible_catcher2, "RUN2_RESP_CAT_ID", "Responsible catcher for runner on 2nd"},
+  {cwevent_responsible_catcher2, "RUN2_RESP_CAT_ID",
+   "Responsible catcher for runner on 2nd", CW_FIELD_ID},
   /* 32 */
-  {cwevent_responsible_catcher3, "RUN3_RESP_CAT_ID", "Responsible catcher for runner on 3rd"},
-  /* 33 */ {cwevent_pitches_balls, "PA_BALL_CT", "number of balls thrown in plate appearance"},
+  {cwevent_responsible_catcher3, "RUN3_RESP_CAT_ID",
+   "Responsible catcher for runner on 3rd", CW_FIELD_ID},
+  /* 33 */
+  {cwevent_pitches_balls, "PA_BALL_CT",
+   "number of balls thrown in plate appearance", CW_FIELD_INT8},
   /* 34 */
   {cwevent_pitches_balls_called, "PA_CALLED_BALL_CT",
-   "number of called balls in plate appearance"},
+   "number of called balls in plate appearance", CW_FIELD_INT8},
   /* 35 */
   {cwevent_pitches_balls_intentional, "PA_INTENT_BALL_CT",
-   "number of intentional balls in plate appearance"},
+   "number of intentional balls in plate appearance", CW_FIELD_INT8},
   /* 36 */
   {cwevent_pitches_balls_pitchout, "PA_PITCHOUT_BALL_CT",
-   "number of pitchouts in plate appearance"},
+   "number of pitchouts in plate appearance", CW_FIELD_INT8},
   /* 37 */
   {cwevent_pitches_balls_hit_batter, "PA_HITBATTER_BALL_CT",
-   "number of pitches hitting batter in plate appearance"},
+   "number of pitches hitting batter in plate appearance", CW_FIELD_INT8},
   /* 38 */
-  {cwevent_pitches_balls_other, "PA_OTHER_BALL_CT", "number of other balls in plate appearance"},
+  {cwevent_pitches_balls_other, "PA_OTHER_BALL_CT",
+   "number of other balls in plate appearance", CW_FIELD_INT8},
   /* 39 */
-  {cwevent_pitches_strikes, "PA_STRIKE_CT", "number of strikes thrown in plate appearance"},
+  {cwevent_pitches_strikes, "PA_STRIKE_CT",
+   "number of strikes thrown in plate appearance", CW_FIELD_INT8},
   /* 40 */
   {cwevent_pitches_strikes_called, "PA_CALLED_STRIKE_CT",
-   "number of called strikes in plate appearance"},
+   "number of called strikes in plate appearance", CW_FIELD_INT8},
   /* 41 */
   {cwevent_pitches_strikes_swinging, "PA_SWINGMISS_STRIKE_CT",
-   "number of swinging strikes in plate appearance"},
+   "number of swinging strikes in plate appearance", CW_FIELD_INT8},
   /* 42 */
-  {cwevent_pitches_strikes_foul, "PA_FOUL_STRIKE_CT", "number of foul balls in plate appearance"},
+  {cwevent_pitches_strikes_foul, "PA_FOUL_STRIKE_CT",
+   "number of foul balls in plate appearance", CW_FIELD_INT8},
   /* 43 */
   {cwevent_pitches_strikes_inplay, "PA_INPLAY_STRIKE_CT",
-   "number of balls in play in plate appearance"},
+   "number of balls in play in plate appearance", CW_FIELD_INT8},
   /* 44 */
   {cwevent_pitches_strikes_other, "PA_OTHER_STRIKE_CT",
-   "number of other strikes in plate appearance"},
-  /* 45 */ {cwevent_runs_on_play, "EVENT_RUNS_CT", "number of runs on play"},
-  /* 46 */ {cwevent_fielded_by_id, "FLD_ID", "id of player fielding batted ball"},
-  /* 47 */ {cwevent_force_second_flag, "BASE2_FORCE_FL", "force play at second flag"},
-  /* 48 */ {cwevent_force_third_flag, "BASE3_FORCE_FL", "force play at third flag"},
-  /* 49 */ {cwevent_force_home_flag, "BASE4_FORCE_FL", "force play at home flag"},
-  /* 50 */ {cwevent_safe_on_error_flag, "BAT_SAFE_ERR_FL", "batter safe on error flag"},
-  /* 51 */ {cwevent_batter_fate, "BAT_FATE_ID", "fate of batter (base ultimately advanced to)"},
-  /* 52 */ {cwevent_runner1_fate, "RUN1_FATE_ID", "fate of runner on first"},
-  /* 53 */ {cwevent_runner2_fate, "RUN2_FATE_ID", "fate of runner on second"},
-  /* 54 */ {cwevent_runner3_fate, "RUN3_FATE_ID", "fate of runner on third"},
+   "number of other strikes in plate appearance", CW_FIELD_INT8},
+  /* 45 */ {cwevent_runs_on_play, "EVENT_RUNS_CT", "number of runs on play", CW_FIELD_INT8},
+  /* 46 */ {cwevent_fielded_by_id, "FLD_ID", "id of player fielding batted ball", CW_FIELD_ID},
+  /* 47 */
+  {cwevent_force_second_flag, "BASE2_FORCE_FL", "force play at second flag", CW_FIELD_FLAG},
+  /* 48 */ {cwevent_force_third_flag, "BASE3_FORCE_FL", "force play at third flag", CW_FIELD_FLAG},
+  /* 49 */ {cwevent_force_home_flag, "BASE4_FORCE_FL", "force play at home flag", CW_FIELD_FLAG},
+  /* 50 */
+  {cwevent_safe_on_error_flag, "BAT_SAFE_ERR_FL", "batter safe on error flag", CW_FIELD_FLAG},
+  /* 51 */
+  {cwevent_batter_fate, "BAT_FATE_ID",
+   "fate of batter (base ultimately advanced to)", CW_FIELD_INT8},
+  /* 52 */ {cwevent_runner1_fate, "RUN1_FATE_ID", "fate of runner on first", CW_FIELD_INT8},
+  /* 53 */ {cwevent_runner2_fate, "RUN2_FATE_ID", "fate of runner on second", CW_FIELD_INT8},
+  /* 54 */ {cwevent_runner3_fate, "RUN3_FATE_ID", "fate of runner on third", CW_FIELD_INT8},
   /* 55 */
-  {cwevent_inning_future_runs, "FATE_RUNS_CT", "runs scored in half inning after this event"},
-  /* 56 */ {cwevent_assist6, "ASS6_FLD_CD", "fielder with sixth assist"},
-  /* 57 */ {cwevent_assist7, "ASS7_FLD_CD", "fielder with seventh assist"},
-  /* 58 */ {cwevent_assist8, "ASS8_FLD_CD", "fielder with eighth assist"},
-  /* 59 */ {cwevent_assist9, "ASS9_FLD_CD", "fielder with ninth assist"},
-  /* 60 */ {cwevent_assist10, "ASS10_FLD_CD", "fielder with tenth assist"},
-  /* 61 */ {cwevent_unknown_out_flag, "UNKNOWN_OUT_EXC_FL", "unknown fielding credit flag"},
-  /* 62 */ {cwevent_uncertain_play_flag, "UNCERTAIN_PLAY_EXC_FL", "uncertain play flag"},
-  /* 63 */ {cwevent_count_text, "COUNT_TX", "text of count as appears in event file"},
+  {cwevent_inning_future_runs, "FATE_RUNS_CT",
+   "runs scored in half inning after this event", CW_FIELD_INT8},
+  /* 56 */ {cwevent_assist6, "ASS6_FLD_CD", "fielder with sixth assist", CW_FIELD_INT8},
+  /* 57 */ {cwevent_assist7, "ASS7_FLD_CD", "fielder with seventh assist", CW_FIELD_INT8},
+  /* 58 */ {cwevent_assist8, "ASS8_FLD_CD", "fielder with eighth assist", CW_FIELD_INT8},
+  /* 59 */ {cwevent_assist9, "ASS9_FLD_CD", "fielder with ninth assist", CW_FIELD_INT8},
+  /* 60 */ {cwevent_assist10, "ASS10_FLD_CD", "fielder with tenth assist", CW_FIELD_INT8},
+  /* 61 */
+  {cwevent_unknown_out_flag, "UNKNOWN_OUT_EXC_FL", "unknown fielding credit flag", CW_FIELD_FLAG},
+  /* 62 */
+  {cwevent_uncertain_play_flag, "UNCERTAIN_PLAY_EXC_FL", "uncertain play flag", CW_FIELD_FLAG},
+  /* 63 */
+  {cwevent_count_text, "COUNT_TX", "text of count as appears in event file", CW_FIELD_TEXT},
   /* 64 */
-  {cwevent_runner1_auto, "RUN1_AUTO_FL", "whether runner on first is an automatic runner"},
+  {cwevent_runner1_auto, "RUN1_AUTO_FL",
+   "whether runner on first is an automatic runner", CW_FIELD_FLAG},
   /* 65 */
-  {cwevent_runner2_auto, "RUN2_AUTO_FL", "whether runner on second is an automatic runner"},
+  {cwevent_runner2_auto, "RUN2_AUTO_FL",
+   "whether runner on second is an automatic runner", CW_FIELD_FLAG},
   /* 66 */
-  {cwevent_runner3_auto, "RUN3_AUTO_FL", "whether runner on third is an automatic runner"}};
+  {cwevent_runner3_auto, "RUN3_AUTO_FL",
+   "whether runner on third is an automatic runner", CW_FIELD_FLAG}};
+
+/* Number of fields, standard and extended, which can be selected */
+#define CWEVENT_MAX_COLUMNS                                                                      \
+  ((int) (sizeof(field_data) / sizeof(field_data[0]) +                                           \
+          sizeof(ext_field_data) / sizeof(ext_field_data[0])))
+
+/*
+ * For typed output formats (Arrow, binary COPY and JSON), the line is
+ * formatted in delimited mode as usual, then split into the text of each
+ * selected field, which is converted according to the field's type.
+ */
+static char *column_values[CWEVENT_MAX_COLUMNS];
+static CWFieldType column_types[CWEVENT_MAX_COLUMNS];
+static int num_columns = 0;
+
+/* With -k, which columns hold player or team IDs to be replaced by keys */
+static int column_keyed[CWEVENT_MAX_COLUMNS];
+
+static void cwevent_write_arrow_row(int count)
+{
+  int i;
+
+  for (i = 0; i < count; i++) {
+    arrow_stream_append(arrow_stream, i, column_values[i]);
+  }
+  arrow_stream_end_row(arrow_stream);
+}
+
+/*
+ * Keys are never longer than the quoted IDs they replace, so the keyed
+ * line fits in a buffer the size of the original one.
+ */
+static void cwevent_write_keyed_line(int count)
+{
+  char output_line[4096 + 1];
+  char *p = output_line;
+  size_t length;
+  int i;
+
+  for (i = 0; i < count; i++) {
+    if (i > 0) {
+      *(p++) = ',';
+    }
+    length = strlen(column_values[i]);
+    memcpy(p, column_values[i], length);
+    p += length;
+  }
+  *(p++) = '\n';
+  fwrite(output_line, 1, (size_t) (p - output_line), stdout);
+}
 
 void cwevent_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
 {
   char output_line[4096];
   CWBuffer buf;
-  int i;
+  int i, count = 0;
 
   CWGameIterator *gameiter = cw_gameiter_create(game);
 
@@ -1697,6 +1816,9 @@ void cwevent_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
     }
 
     cw_buffer_init(&buf, output_line, sizeof(output_line), ascii, ',');
+    if (arrow_output || pgcopy || json_output || id_dictionary != NULL) {
+      cw_buffer_track_fields(&buf, column_values, num_columns);
+    }
     for (i = 0; i <= max_field; i++) {
       if (fields[i]) {
         (*field_data[i].f)(&buf, gameiter, visitors, home);
@@ -1715,14 +1837,40 @@ void cwevent_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
       exit(1);
     }
 
-    printf("%s", output_line);
-    printf("\n");
+    if (buf.field_starts != NULL) {
+      count = cw_buffer_split_fields(&buf);
+    }
+    if (id_dictionary != NULL) {
+      for (i = 0; i < count; i++) {
+        if (column_keyed[i]) {
+          column_values[i] =
+            (char *) id_dictionary_key(id_dictionary, column_values[i], visitors, home);
+        }
+      }
+    }
+
+    if (arrow_output) {
+      cwevent_write_arrow_row(count);
+    }
+    else if (pgcopy) {
+      cw_pgcopy_write_row(stdout, column_values, column_types, count);
+    }
+    else if (json_output) {
+      json_writer_write_row(json_writer, column_values, count);
+    }
+    else if (id_dictionary != NULL) {
+      cwevent_write_keyed_line(count);
+    }
+    else {
+      printf("%s", output_line);
+      printf("\n");
+    }
 
     cw_gameiter_next(gameiter);
   }
 
   cw_gameiter_cleanup(gameiter);
-  free(gameiter);
+  cw_free(CW_ALLOC_GAMEITER, gameiter);
 }
 
 void (*cwtools_process_game)(CWGame *, CWRoster *, CWRoster *) = cwevent_process_game;
@@ -1739,16 +1887,32 @@ void cwevent_print_help(void)
   fprintf(stderr, "  -y year   Year to process (for teamyyyy and aaayyyy.ros).\n");
   fprintf(stderr,
           "  -D dir    Directory to find team and roster files (default is current directory)\n");
+  fprintf(stderr, "  -C file   Catalog of games (from cwcatalog), to read only selected games\n");
   fprintf(stderr, "  -s start  Earliest date to process (mmdd).\n");
   fprintf(stderr, "  -e end    Last date to process (mmdd).\n");
   fprintf(stderr, "  -a        generate Ascii-delimited format files (default)\n");
   fprintf(stderr, "  -ft       generate Fortran format files\n");
+  fprintf(stderr, "  -fa       generate an Apache Arrow IPC stream\n");
+  fprintf(stderr, "  -fp       generate PostgreSQL binary COPY format\n");
+  fprintf(stderr, "  -J        generate JSON Lines, one object per event\n");
+  fprintf(stderr, "  -k file   write player and team IDs as integer keys, listed in file\n");
+  fprintf(stderr, "  -b rows   number of rows in each Arrow record batch (default %d)\n",
+          ARROW_DEFAULT_BATCH_SIZE);
   fprintf(stderr, "  -f flist  give list of fields to output\n");
   fprintf(stderr, "              Default is 0-6,8-9,12-13,16-17,26-40,43-45,51,58-61\n");
   fprintf(stderr, "  -x flist  give list of extended fields to output\n");
   fprintf(stderr, "              Default is none\n");
   fprintf(stderr, "  -d        print list of field numbers and descriptions\n");
   fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n");
+  fprintf(stderr, "  --team=list  only process games of the teams listed (IDs separated\n");
+  fprintf(stderr, "            by commas)\n");
+  fprintf(stderr, "  --park=list  only process games at the parks listed\n");
+  fprintf(stderr, "  --stats[=file]  report counts and phase timings at exit,\n");
+  fprintf(stderr, "            to stderr, or as JSON to file\n");
+  fprintf(stderr, "  --serve=socket  read the games once, and answer requests\n");
+  fprintf(stderr, "            for them on a Unix-domain socket\n");
+  fprintf(stderr, "  --incremental=dir  keep the output for each file in dir,\n");
+  fprintf(stderr, "            and reuse it while the file is unchanged\n");
   fprintf(stderr, "  -n        print field names in first row of output\n\n");
 
   exit(0);
@@ -1799,13 +1963,67 @@ void cwevent_print_welcome_message(char *argv0)
 
 void (*cwtools_print_welcome_message)(char *) = cwevent_print_welcome_message;
 
+static void cwevent_add_column(field_struct *field)
+{
+  column_types[num_columns] = field->type;
+  if (id_keys_file != NULL && field->type == CW_FIELD_ID && strcmp(field->header, "GAME_ID")) {
+    column_keyed[num_columns] = 1;
+    column_types[num_columns] = CW_FIELD_INT32;
+  }
+  if (arrow_stream != NULL) {
+    arrow_stream_add_column(arrow_stream, field->header, column_types[num_columns]);
+  }
+  if (json_writer != NULL) {
+    json_writer_add_column(json_writer, field->header, column_types[num_columns]);
+  }
+  num_columns++;
+}
+
 void cwevent_initialize(void)
 {
   int i;
   char output_line[4096];
   CWBuffer buf;
 
-  if (!ascii || !print_header) {
+  if (id_keys_file != NULL) {
+    if (!ascii) {
+      fprintf(stderr, "*** Integer ID keys (-k) are not available with -ft.\n");
+      exit(1);
+    }
+    id_keys = fopen(id_keys_file, "w");
+    if (id_keys == NULL) {
+      fprintf(stderr, "*** Unable to open '%s' to write ID keys.\n", id_keys_file);
+      exit(1);
+    }
+    id_dictionary = id_dictionary_create();
+    /* Keys are numbered over all the files */
+    output_by_file = 0;
+  }
+  if (arrow_output) {
+    /* Batches and the stream's footer span files */
+    arrow_stream = arrow_stream_create(stdout, arrow_batch_size);
+    output_by_file = 0;
+  }
+  else if (json_output) {
+    json_writer = json_writer_create(stdout);
+  }
+
+  for (i = 0; i <= max_field; i++) {
+    if (fields[i]) {
+      cwevent_add_column(&field_data[i]);
+    }
+  }
+  for (i = 0; i <= max_ext_field; i++) {
+    if (ext_fields[i]) {
+      cwevent_add_column(&ext_field_data[i]);
+    }
+  }
+
+  if (arrow_output || json_output) {
+    return;
+  }
+
+  if (!ascii || pgcopy || !print_header) {
     return;
   }
 
@@ -1835,6 +2053,21 @@ void (*cwtools_initialize)(void) = cwevent_initialize;
 
 void cwevent_cleanup(void)
 {
+  if (arrow_stream != NULL) {
+    arrow_stream_cleanup(arrow_stream);
+    arrow_stream = NULL;
+  }
+  if (json_writer != NULL) {
+    json_writer_cleanup(json_writer);
+    json_writer = NULL;
+  }
+  if (id_dictionary != NULL) {
+    id_dictionary_write(id_dictionary, id_keys);
+    fclose(id_keys);
+    id_keys = NULL;
+    id_dictionary_cleanup(id_dictionary);
+    id_dictionary = NULL;
+  }
 }
 
 void (*cwtools_cleanup)(void) = cwevent_cleanup;
@@ -1844,6 +2077,7 @@ extern char first_date[5];
 extern char last_date[5];
 extern char game_id[20];
 extern char data_dir[1024];
+extern char catalog_file[1024];
 extern int quiet;
 
 extern void cwtools_parse_field_list(char *text, int max_field, int *fields);
@@ -1856,6 +2090,9 @@ int cwevent_parse_command_line(int argc, char *argv[])
   for (i = 1; i < argc; i++) {
     if (!strcmp(argv[i], "-a")) {
       ascii = 1;
+      arrow_output = 0;
+      pgcopy = 0;
+      json_output = 0;
     }
     else if (!strcmp(argv[i], "-d")) {
       (*cwtools_print_welcome_message)(argv[0]);
@@ -1888,6 +2125,41 @@ int cwevent_parse_command_line(int argc, char *argv[])
     }
     else if (!strcmp(argv[i], "-ft")) {
       ascii = 0;
+      arrow_output = 0;
+      pgcopy = 0;
+      json_output = 0;
+    }
+    else if (!strcmp(argv[i], "-fa")) {
+      ascii = 1;
+      arrow_output = 1;
+      pgcopy = 0;
+      json_output = 0;
+    }
+    else if (!strcmp(argv[i], "-fp")) {
+      ascii = 1;
+      arrow_output = 0;
+      pgcopy = 1;
+      json_output = 0;
+    }
+    else if (!strcmp(argv[i], "-J")) {
+      ascii = 1;
+      arrow_output = 0;
+      pgcopy = 0;
+      json_output = 1;
+    }
+    else if (!strcmp(argv[i], "-k")) {
+      if (++i < argc) {
+        id_keys_file = argv[i];
+      }
+    }
+    else if (!strcmp(argv[i], "-b")) {
+      if (++i < argc) {
+        arrow_batch_size = atoi(argv[i]);
+        if (arrow_batch_size <= 0) {
+          fprintf(stderr, "*** Invalid batch size '%s'.\n", argv[i]);
+          exit(1);
+        }
+      }
     }
     else if (!strcmp(argv[i], "-s")) {
       if (++i < argc) {
@@ -1910,6 +2182,12 @@ int cwevent_parse_command_line(int argc, char *argv[])
         data_dir[sizeof(data_dir) - 1] = '\0';
       }
     }
+    else if (!strcmp(argv[i], "-C")) {
+      if (++i < argc) {
+        strncpy(catalog_file, argv[i], sizeof(catalog_file) - 1);
+        catalog_file[sizeof(catalog_file) - 1] = '\0';
+      }
+    }
     else if (argv[i][0] == '-') {
       fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
       exit(1);
@@ -0,0 +1,583 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/cwexpect.c
+ * Chadwick run and win expectancy table generator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cwlib/chadwick.h"
+#include "buffer.h"
+#include "pgcopy.h"
+
+/*************************************************************************
+ * Global variables for command-line options
+ *************************************************************************/
+
+extern int ascii;
+extern int pgcopy;
+extern int output_by_file;
+extern void *(*cwtools_create_partial)(void);
+extern void (*cwtools_process_game_partial)(void *, CWGame *, CWRoster *, CWRoster *);
+extern void (*cwtools_merge_partial)(void *);
+
+/* Fields to display (-f) */
+int fields[8] = {1, 1, 1, 1, 1, 1, 1, 1};
+
+/* The maximum field number of the table selected (-T) */
+int max_field = 6;
+
+char program_name[20] = "cwexpect";
+
+int print_header = 0;
+
+/* If 'win_table', write the win expectancy table instead of run expectancy (-T) */
+int win_table = 0;
+
+/* The field list given with -f, parsed once the table is known */
+char *field_list = NULL;
+
+/* Range of years of games to count (-Y); zero for no limit */
+int first_year = 0, last_year = 0;
+
+/* League of the home team of games to count (-L); empty for all */
+char league_id[20] = "";
+
+/* The tables, accumulated as games are read and written at the end */
+CWExpectancy *expect = NULL;
+
+/*
+ * One cell of either table.  For the run expectancy table only the
+ * base-out state, 'events', 'runs' and 'scored' are set.
+ */
+typedef struct cwexpect_row_struct {
+  int inning, half, lead, bases, outs;
+  int events, runs, scored, wins;
+} CWExpectRow;
+
+/*
+ * typedef to declare the pointer-to-function type
+ */
+typedef int (*field_func)(char *, CWExpectRow *);
+
+/*
+ * convenient structure to hold all information relating to a field
+ * together in one place
+ */
+typedef struct field_struct {
+  field_func f;
+  char *header, *description;
+  CWFieldType type;
+} field_struct;
+
+/*
+ * preprocessor directive for conveniently declaring function signature
+ */
+
+#define DECLARE_FIELDFUNC(funcname) int funcname(char *buffer, CWExpectRow *row)
+
+/* Runners on base: the occupied bases, with an underscore for each empty one */
+DECLARE_FIELDFUNC(cwexpect_bases)
+{
+  return sprintf(buffer, (ascii) ? "\"%c%c%c\"" : "%c%c%c", (row->bases & 1) ? '1' : '_',
+                 (row->bases & 2) ? '2' : '_', (row->bases & 4) ? '3' : '_');
+}
+
+DECLARE_FIELDFUNC(cwexpect_outs)
+{
+  return sprintf(buffer, "%d", row->outs);
+}
+
+DECLARE_FIELDFUNC(cwexpect_events)
+{
+  return sprintf(buffer, (ascii) ? "%d" : "%9d", row->events);
+}
+
+DECLARE_FIELDFUNC(cwexpect_runs)
+{
+  return sprintf(buffer, (ascii) ? "%d" : "%9d", row->runs);
+}
+
+DECLARE_FIELDFUNC(cwexpect_scored)
+{
+  return sprintf(buffer, (ascii) ? "%d" : "%9d", row->scored);
+}
+
+DECLARE_FIELDFUNC(cwexpect_run_expectancy)
+{
+  if (row->events == 0) {
+    return sprintf(buffer, "%*s", (ascii) ? 0 : 6, "");
+  }
+  return sprintf(buffer, (ascii) ? "%.3f" : "%6.3f", (double) row->runs / (double) row->events);
+}
+
+DECLARE_FIELDFUNC(cwexpect_score_probability)
+{
+  if (row->events == 0) {
+    return sprintf(buffer, "%*s", (ascii) ? 0 : 6, "");
+  }
+  return sprintf(buffer, (ascii) ? "%.3f" : "%6.3f", (double) row->scored / (double) row->events);
+}
+
+DECLARE_FIELDFUNC(cwexpect_inning)
+{
+  return sprintf(buffer, (ascii) ? "%d" : "%2d", row->inning);
+}
+
+DECLARE_FIELDFUNC(cwexpect_half)
+{
+  return sprintf(buffer, "%d", row->half);
+}
+
+DECLARE_FIELDFUNC(cwexpect_lead)
+{
+  return sprintf(buffer, (ascii) ? "%d" : "%3d", row->lead);
+}
+
+DECLARE_FIELDFUNC(cwexpect_wins)
+{
+  return sprintf(buffer, (ascii) ? "%d" : "%9d", row->wins);
+}
+
+DECLARE_FIELDFUNC(cwexpect_win_expectancy)
+{
+  return sprintf(buffer, (ascii) ? "%.3f" : "%6.3f", (double) row->wins / (double) row->events);
+}
+
+static field_struct run_field_data[] = {
+  /* 0 */ {cwexpect_bases, "BASES_CD", "runners on base (e.g. 1_3)", CW_FIELD_TEXT},
+  /* 1 */ {cwexpect_outs, "OUTS_CT", "outs", CW_FIELD_INT8},
+  /* 2 */ {cwexpect_events, "EVENTS_CT", "events starting in the state", CW_FIELD_INT32},
+  /* 3 */
+  {cwexpect_runs, "RUNS_CT", "runs scored from the state to the end of the inning",
+   CW_FIELD_INT32},
+  /* 4 */
+  {cwexpect_scored, "SCORED_CT", "events after which at least one run scored", CW_FIELD_INT32},
+  /* 5 */ {cwexpect_run_expectancy, "RUNS_EXP", "run expectancy", CW_FIELD_TEXT},
+  /* 6 */
+  {cwexpect_score_probability, "SCORE_PROB", "probability of scoring", CW_FIELD_TEXT}};
+
+static field_struct win_field_data[] = {
+  /* 0 */ {cwexpect_inning, "INN_CT", "inning (10 = extra innings)", CW_FIELD_INT8},
+  /* 1 */ {cwexpect_half, "BAT_HOME_ID", "batting team (0 = visitor, 1 = home)", CW_FIELD_INT8},
+  /* 2 */
+  {cwexpect_lead, "HOME_LEAD_CT", "home team's lead (+/-10 = 10 or more)", CW_FIELD_INT8},
+  /* 3 */ {cwexpect_bases, "BASES_CD", "runners on base (e.g. 1_3)", CW_FIELD_TEXT},
+  /* 4 */ {cwexpect_outs, "OUTS_CT", "outs", CW_FIELD_INT8},
+  /* 5 */ {cwexpect_events, "EVENTS_CT", "events starting in the state", CW_FIELD_INT32},
+  /* 6 */ {cwexpect_wins, "HOME_WINS_CT", "events after which home team won", CW_FIELD_INT32},
+  /* 7 */ {cwexpect_win_expectancy, "WIN_EXP", "home team's win expectancy", CW_FIELD_TEXT}};
+
+/* The fields of the table selected */
+static field_struct *field_data = run_field_data;
+
+/*
+ * For PostgreSQL binary COPY output, fields are separated by a null
+ * character instead of a comma, and the start of each is recorded here.
+ */
+static char *column_values[sizeof(win_field_data) / sizeof(win_field_data[0])];
+static CWFieldType column_types[sizeof(win_field_data) / sizeof(win_field_data[0])];
+
+/* Whether the game is in the years and league selected */
+static int cwexpect_select_game(CWGame *game, CWRoster *home)
+{
+  char *date = cw_game_info_lookup(game, "date");
+  char year_text[5] = "";
+  int game_year;
+
+  if (date != NULL) {
+    strncpy(year_text, date, 4);
+    year_text[4] = '\0';
+  }
+  game_year = cw_atoi(year_text, NULL);
+  if ((first_year > 0 && game_year < first_year) || (last_year > 0 && game_year > last_year)) {
+    return 0;
+  }
+  if (strcmp(league_id, "") != 0 &&
+      (home == NULL || home->league == NULL || strcmp(home->league, league_id) != 0)) {
+    return 0;
+  }
+  return 1;
+}
+
+void cwexpect_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
+{
+  if (cwexpect_select_game(game, home)) {
+    cw_expect_add_game(expect, game);
+  }
+}
+
+void (*cwtools_process_game)(CWGame *, CWRoster *, CWRoster *) = cwexpect_process_game;
+
+/* The tables for one file, when files are processed on several threads */
+static void *cwexpect_create_partial(void)
+{
+  return cw_expect_create();
+}
+
+static void cwexpect_process_game_partial(void *partial, CWGame *game, CWRoster *visitors,
+                                          CWRoster *home)
+{
+  if (cwexpect_select_game(game, home)) {
+    cw_expect_add_game((CWExpectancy *) partial, game);
+  }
+}
+
+static void cwexpect_merge_partial(void *partial)
+{
+  cw_expect_merge(expect, (CWExpectancy *) partial);
+  cw_expect_cleanup((CWExpectancy *) partial);
+  cw_free(CW_ALLOC_EXPECT, partial);
+}
+
+void cwexpect_print_help(void)
+{
+  fprintf(stderr,
+          "\n\ncwexpect generates files suitable for use by dBase or Lotus-like programs\n");
+  fprintf(stderr, "Each record gives one cell of a run or win expectancy table.\n");
+  fprintf(stderr, "Usage: cwexpect [options] eventfile...\n");
+  fprintf(stderr, "options:\n");
+  fprintf(stderr, "  -h        print this help\n");
+  fprintf(stderr, "  -i id     only process game given by id\n");
+  fprintf(stderr, "  -y year   Year to process (for teamyyyy and aaayyyy.ros).\n");
+  fprintf(stderr,
+          "  -D dir    Directory to find team and roster files (default is current directory)\n");
+  fprintf(stderr, "  -C file   Catalog of games (from cwcatalog), to read only selected games\n");
+  fprintf(stderr, "  -s start  Earliest date to process (mmdd).\n");
+  fprintf(stderr, "  -e end    Last date to process (mmdd).\n");
+  fprintf(stderr, "  -Y range  Years of games to count (yyyy or yyyy-yyyy).\n");
+  fprintf(stderr, "  -L league Only count games whose home team is in league (from teamyyyy).\n");
+  fprintf(stderr, "  -T table  Table to generate: re (run expectancy, default)\n");
+  fprintf(stderr, "              or we (win expectancy)\n");
+  fprintf(stderr, "  -a        generate Ascii-delimited format files (default)\n");
+  fprintf(stderr, "  -ft       generate Fortran format files\n");
+  fprintf(stderr, "  -fp       generate PostgreSQL binary COPY format\n");
+  fprintf(stderr, "  -f flist  give list of fields to output\n");
+  fprintf(stderr, "              Default is 0-6 (re) or 0-7 (we)\n");
+  fprintf(stderr, "  -d        print list of field numbers and descriptions\n");
+  fprintf(stderr, "              for the table given by an earlier -T\n");
+  fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n");
+  fprintf(stderr, "  --team=list  only process games of the teams listed (IDs separated\n");
+  fprintf(stderr, "            by commas)\n");
+  fprintf(stderr, "  --park=list  only process games at the parks listed\n");
+  fprintf(stderr, "  --stats[=file]  report counts and phase timings at exit,\n");
+  fprintf(stderr, "            to stderr, or as JSON to file\n");
+  fprintf(stderr, "  --serve=socket  read the games once, and answer requests\n");
+  fprintf(stderr, "            for them on a Unix-domain socket\n");
+  fprintf(stderr, "  --threads=n  process the files on n threads at once\n");
+  fprintf(stderr, "  -n        print field names in first row of output\n\n");
+
+  exit(0);
+}
+
+void (*cwtools_print_help)(void) = cwexpect_print_help;
+
+void cwexpect_print_field_list(void)
+{
+  int i;
+
+  fprintf(stderr, "\nThese are the available fields and the numbers to use with the -f option\n");
+  fprintf(stderr, "to name them.  All are included by default.\n");
+  fprintf(stderr, "\n");
+  fprintf(stderr, "number  field\n");
+  fprintf(stderr, "------  -----\n");
+  for (i = 0; i <= max_field; i++) {
+    fprintf(stderr, "%-3d     %s\n", i, field_data[i].description);
+  }
+  fprintf(stderr, "\n");
+
+  exit(0);
+}
+
+void (*cwtools_print_field_list)(void) = cwexpect_print_field_list;
+
+void cwexpect_print_welcome_message(char *argv0)
+{
+  fprintf(stderr, "\nChadwick run and win expectancy table generator, version " VERSION);
+  fprintf(stderr, "\n  Type '%s -h' for help.\n", argv0);
+  fprintf(
+    stderr,
+    "Copyright (c) 2002-2026\nDr T L Turocy, Chadwick Baseball Bureau (ted.turocy@gmail.com)\n");
+  fprintf(stderr, "This is free software, "
+                  "subject to the terms of the GNU GPL license.\n\n");
+}
+
+void (*cwtools_print_welcome_message)(char *) = cwexpect_print_welcome_message;
+
+void cwexpect_initialize(void)
+{
+  int i, comma = 0, column = 0;
+  char output_line[4096];
+  char *buf;
+
+  expect = cw_expect_create();
+  /* The table is written at the end, from all the files */
+  output_by_file = 0;
+  cwtools_create_partial = cwexpect_create_partial;
+  cwtools_process_game_partial = cwexpect_process_game_partial;
+  cwtools_merge_partial = cwexpect_merge_partial;
+
+  for (i = 0; i <= max_field; i++) {
+    if (fields[i]) {
+      column_types[column++] = field_data[i].type;
+    }
+  }
+
+  if (!ascii || pgcopy || !print_header) {
+    return;
+  }
+
+  strcpy(output_line, "");
+  buf = output_line;
+
+  for (i = 0; i <= max_field; i++) {
+    if (fields[i]) {
+      if (ascii && comma) {
+        *(buf++) = ',';
+      }
+      else {
+        comma = 1;
+      }
+      buf += sprintf(buf, "\"%s\"", field_data[i].header);
+    }
+  }
+
+  printf("%s", output_line);
+  printf("\n");
+}
+
+void (*cwtools_initialize)(void) = cwexpect_initialize;
+
+static void cwexpect_write_row(CWExpectRow *row)
+{
+  char output_line[4096];
+  char *buf = output_line;
+  int i, comma = 0, column = 0;
+
+  strcpy(output_line, "");
+  for (i = 0; i <= max_field; i++) {
+    if (fields[i]) {
+      if (ascii && comma) {
+        *(buf++) = pgcopy ? '\0' : ',';
+      }
+      else {
+        comma = 1;
+      }
+      column_values[column++] = buf;
+      buf += (*field_data[i].f)(buf, row);
+    }
+  }
+  if (pgcopy) {
+    cw_pgcopy_write_row(stdout, column_values, column_types, column);
+  }
+  else {
+    printf("%s\n", output_line);
+  }
+}
+
+void cwexpect_cleanup(void)
+{
+  CWExpectRow row;
+  int state, inning, half, lead;
+
+  memset(&row, 0, sizeof(CWExpectRow));
+  if (!win_table) {
+    /* Every base-out state is written, so the table is always complete */
+    for (state = 0; state < CW_EXPECT_BASE_OUT_STATES; state++) {
+      row.bases = state / 3;
+      row.outs = state % 3;
+      row.events = expect->runs[state].events;
+      row.runs = expect->runs[state].runs;
+      row.scored = expect->runs[state].scored;
+      cwexpect_write_row(&row);
+    }
+  }
+  else {
+    for (inning = 1; inning <= CW_EXPECT_INNINGS; inning++) {
+      for (half = 0; half <= 1; half++) {
+        for (lead = -CW_EXPECT_MAX_LEAD; lead <= CW_EXPECT_MAX_LEAD; lead++) {
+          for (state = 0; state < CW_EXPECT_BASE_OUT_STATES; state++) {
+            CWExpectWins *cell =
+              &expect->wins[inning - 1][half][lead + CW_EXPECT_MAX_LEAD][state];
+
+            if (cell->events == 0) {
+              continue;
+            }
+            row.inning = inning;
+            row.half = half;
+            row.lead = lead;
+            row.bases = state / 3;
+            row.outs = state % 3;
+            row.events = cell->events;
+            row.wins = cell->wins;
+            cwexpect_write_row(&row);
+          }
+        }
+      }
+    }
+  }
+
+  cw_expect_cleanup(expect);
+  cw_free(CW_ALLOC_EXPECT, expect);
+  expect = NULL;
+}
+
+void (*cwtools_cleanup)(void) = cwexpect_cleanup;
+
+extern char year[5];
+extern char first_date[5];
+extern char last_date[5];
+extern char game_id[20];
+extern char data_dir[1024];
+extern char catalog_file[1024];
+extern int quiet;
+
+extern void cwtools_parse_field_list(char *text, int max_field, int *fields);
+
+/* Parse the range of years given with -Y, as yyyy or yyyy-yyyy */
+static void cwexpect_parse_year_range(char *text)
+{
+  char *dash = strchr(text, '-');
+
+  first_year = cw_atoi(text, NULL);
+  last_year = (dash != NULL) ? cw_atoi(dash + 1, NULL) : first_year;
+  if (first_year <= 0 || last_year < first_year) {
+    fprintf(stderr, "*** Invalid year range '%s'.\n", text);
+    exit(1);
+  }
+}
+
+int cwexpect_parse_command_line(int argc, char *argv[])
+{
+  int i;
+  strcpy(year, "");
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-a")) {
+      ascii = 1;
+      pgcopy = 0;
+    }
+    else if (!strcmp(argv[i], "-d")) {
+      (*cwtools_print_welcome_message)(argv[0]);
+      (*cwtools_print_field_list)();
+    }
+    else if (!strcmp(argv[i], "-e")) {
+      if (++i < argc) {
+        strncpy(last_date, argv[i], 4);
+      }
+    }
+    else if (!strcmp(argv[i], "-h")) {
+      (*cwtools_print_welcome_message)(argv[0]);
+      (*cwtools_print_help)();
+    }
+    else if (!strcmp(argv[i], "-Q")) {
+      quiet = 1;
+    }
+    else if (!strcmp(argv[i], "-i")) {
+      if (++i < argc) {
+        strncpy(game_id, argv[i], 19);
+      }
+    }
+    else if (!strcmp(argv[i], "-f")) {
+      if (++i < argc) {
+        field_list = argv[i];
+      }
+    }
+    else if (!strcmp(argv[i], "-n")) {
+      print_header = 1;
+    }
+    else if (!strcmp(argv[i], "-ft")) {
+      ascii = 0;
+      pgcopy = 0;
+    }
+    else if (!strcmp(argv[i], "-fp")) {
+      ascii = 1;
+      pgcopy = 1;
+    }
+    else if (!strcmp(argv[i], "-s")) {
+      if (++i < argc) {
+        strncpy(first_date, argv[i], 4);
+      }
+    }
+    else if (!strcmp(argv[i], "-y")) {
+      if (++i < argc) {
+        strncpy(year, argv[i], 5);
+      }
+    }
+    else if (!strcmp(argv[i], "-D")) {
+      if (++i < argc) {
+        strncpy(data_dir, argv[i], sizeof(data_dir) - 1);
+        data_dir[sizeof(data_dir) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-C")) {
+      if (++i < argc) {
+        strncpy(catalog_file, argv[i], sizeof(catalog_file) - 1);
+        catalog_file[sizeof(catalog_file) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-Y")) {
+      if (++i < argc) {
+        cwexpect_parse_year_range(argv[i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-L")) {
+      if (++i < argc) {
+        strncpy(league_id, argv[i], sizeof(league_id) - 1);
+        league_id[sizeof(league_id) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-T")) {
+      if (++i < argc) {
+        if (!strcmp(argv[i], "re")) {
+          win_table = 0;
+          field_data = run_field_data;
+          max_field = 6;
+        }
+        else if (!strcmp(argv[i], "we")) {
+          win_table = 1;
+          field_data = win_field_data;
+          max_field = 7;
+        }
+        else {
+          fprintf(stderr, "*** Invalid table '%s'.\n", argv[i]);
+          exit(1);
+        }
+      }
+    }
+    else if (argv[i][0] == '-') {
+      fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
+      exit(1);
+    }
+    else {
+      break;
+    }
+  }
+
+  if (field_list != NULL) {
+    cwtools_parse_field_list(field_list, max_field, fields);
+  }
+
+  return i;
+}
+
+int (*cwtools_parse_command_line)(int, char *argv[]) = cwexpect_parse_command_line;
@@ -30,12 +30,15 @@
 
 #include "cwlib/chadwick.h"
 #include "buffer.h"
+#include "pgcopy.h"
+#include "jsonwrite.h"
 
 /*************************************************************************
  * Global variables for command-line options
  *************************************************************************/
 
 extern int ascii;
+extern int pgcopy;
 
 /* Fields to display (-f) */
 int fields[86] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
@@ -68,6 +71,10 @@ int print_header = 0;
 
 int date_format = CWGAME_DATE_NOSLASH_FULL;
 
+/* Write one JSON object per game instead of text (-J) */
+int json_output = 0;
+JSONWriter *json_writer = NULL;
+
 /* Auxiliary function: negative numbers in the boxscore structure
  * correspond to nulls, which should be rendered as blanks in output.
  */
@@ -189,6 +196,7 @@ typedef int (*field_func)(CWBuffer *, CWGameIterator *, CWBoxscore *, CWRoster *
 typedef struct field_struct {
   field_func f;
   char *header, *description;
+  CWFieldType type;
 } field_struct;
 
 /*
@@ -637,92 +645,92 @@ DECLARE_FIELDFUNC(cwgame_game_type)
 }
 
 static field_struct field_data[] = {
-  /*  0 */ {cwgame_game_id, "GAME_ID", "game id"},
-  /*  1 */ {cwgame_date, "GAME_DT", "date"},
-  /*  2 */ {cwgame_number, "GAME_CT", "game number (0 = no double header)"},
-  /*  3 */ {cwgame_day_of_week, "GAME_DY", "day of week"},
-  /*  4 */ {cwgame_start_time, "START_GAME_TM", "start time"},
-  /*  5 */ {cwgame_use_dh, "DH_FL", "DH used flag"},
-  /*  6 */ {cwgame_day_night, "DAYNIGHT_PARK_CD", "day/night flag"},
-  /*  7 */ {cwgame_visitors, "AWAY_TEAM_ID", "visiting team"},
-  /*  8 */ {cwgame_home, "HOME_TEAM_ID", "home team"},
-  /*  9 */ {cwgame_site, "PARK_ID", "game site"},
-  /* 10 */ {cwgame_visitors_pitcher, "AWAY_START_PIT_ID", "vis. starting pitcher"},
-  /* 11 */ {cwgame_home_pitcher, "HOME_START_PIT_ID", "home starting pitcher"},
-  /* 12 */ {cwgame_umpire_home, "BASE4_UMP_ID", "home plate umpire"},
-  /* 13 */ {cwgame_umpire_1b, "BASE1_UMP_ID", "first base umpire"},
-  /* 14 */ {cwgame_umpire_2b, "BASE2_UMP_ID", "second base umpire"},
-  /* 15 */ {cwgame_umpire_3b, "BASE3_UMP_ID", "third base umpire"},
-  /* 16 */ {cwgame_umpire_lf, "LF_UMP_ID", "left field umpire"},
-  /* 17 */ {cwgame_umpire_rf, "RF_UMP_ID", "right field umpire"},
-  /* 18 */ {cwgame_attendance, "ATTEND_PARK_CT", "attendance"},
-  /* 19 */ {cwgame_scorer, "SCORER_RECORD_ID", "PS scorer"},
-  /* 20 */ {cwgame_translator, "TRANSLATOR_RECORD_ID", "translator"},
-  /* 21 */ {cwgame_inputter, "INPUTTER_RECORD_ID", "inputter"},
-  /* 22 */ {cwgame_inputtime, "INPUT_RECORD_TS", "input time"},
-  /* 23 */ {cwgame_edittime, "EDIT_RECORD_TS", "edit time"},
-  /* 24 */ {cwgame_howscored, "METHOD_RECORD_CD", "how scored"},
-  /* 25 */ {cwgame_pitches, "PITCHES_RECORD_CD", "pitches entered?"},
-  /* 26 */ {cwgame_temperature, "TEMP_PARK_CT", "temperature"},
-  /* 27 */ {cwgame_wind_direction, "WIND_DIRECTION_PARK_CD", "wind direction"},
-  /* 28 */ {cwgame_wind_speed, "WIND_SPEED_PARK_CT", "wind speed"},
-  /* 29 */ {cwgame_field_condition, "FIELD_PARK_CD", "field condition"},
-  /* 30 */ {cwgame_precipitation, "PRECIP_PARK_CD", "precipitation"},
-  /* 31 */ {cwgame_sky, "SKY_PARK_CD", "sky"},
-  /* 32 */ {cwgame_time_of_game, "MINUTES_GAME_CT", "time of game"},
-  /* 33 */ {cwgame_innings, "INN_CT", "number of innings"},
-  /* 34 */ {cwgame_visitor_score, "AWAY_SCORE_CT", "visitor final score"},
-  /* 35 */ {cwgame_home_score, "HOME_SCORE_CT", "home final score"},
-  /* 36 */ {cwgame_visitor_hits, "AWAY_HITS_CT", "visitor hits"},
-  /* 37 */ {cwgame_home_hits, "HOME_HITS_CT", "home hits"},
-  /* 38 */ {cwgame_visitor_errors, "AWAY_ERR_CT", "visitor errors"},
-  /* 39 */ {cwgame_home_errors, "HOME_ERR_CT", "home errors"},
-  /* 40 */ {cwgame_visitor_lob, "AWAY_LOB_CT", "visitor left on base"},
-  /* 41 */ {cwgame_home_lob, "HOME_LOB_CT", "home left on base"},
-  /* 42 */ {cwgame_winning_pitcher, "WIN_PIT_ID", "winning pitcher"},
-  /* 43 */ {cwgame_losing_pitcher, "LOSE_PIT_ID", "losing pitcher"},
-  /* 44 */ {cwgame_save, "SAVE_PIT_ID", "save for"},
-  /* 45 */ {cwgame_gwrbi, "GWRBI_BAT_ID", "GW RBI"},
-  /* 46 */ {NULL, "AWAY_LINEUP1_BAT_ID", "visitor batter 1"},
-  /* 47 */ {NULL, "AWAY_LINEUP1_FLD_CD", "visitor position 1"},
-  /* 48 */ {NULL, "AWAY_LINEUP2_BAT_ID", "visitor batter 2"},
-  /* 49 */ {NULL, "AWAY_LINEUP2_FLD_CD", "visitor position 2"},
-  /* 50 */ {NULL, "AWAY_LINEUP3_BAT_ID", "visitor batter 3"},
-  /* 51 */ {NULL, "AWAY_LINEUP3_FLD_CD", "visitor position 3"},
-  /* 52 */ {NULL, "AWAY_LINEUP4_BAT_ID", "visitor batter 4"},
-  /* 53 */ {NULL, "AWAY_LINEUP4_FLD_CD", "visitor position 4"},
-  /* 54 */ {NULL, "AWAY_LINEUP5_BAT_ID", "visitor batter 5"},
-  /* 55 */ {NULL, "AWAY_LINEUP5_FLD_CD", "visitor position 5"},
-  /* 56 */ {NULL, "AWAY_LINEUP6_BAT_ID", "visitor batter 6"},
-  /* 57 */ {NULL, "AWAY_LINEUP6_FLD_CD", "visitor position 6"},
-  /* 58 */ {NULL, "AWAY_LINEUP7_BAT_ID", "visitor batter 7"},
-  /* 59 */ {NULL, "AWAY_LINEUP7_FLD_CD", "visitor position 7"},
-  /* 60 */ {NULL, "AWAY_LINEUP8_BAT_ID", "visitor batter 8"},
-  /* 61 */ {NULL, "AWAY_LINEUP8_FLD_CD", "visitor position 8"},
-  /* 62 */ {NULL, "AWAY_LINEUP9_BAT_ID", "visitor batter 9"},
-  /* 63 */ {NULL, "AWAY_LINEUP9_FLD_CD", "visitor position 9"},
-  /* 64 */ {NULL, "HOME_LINEUP1_BAT_ID", "home batter 1"},
-  /* 65 */ {NULL, "HOME_LINEUP1_FLD_CD", "home position 1"},
-  /* 66 */ {NULL, "HOME_LINEUP2_BAT_ID", "home batter 2"},
-  /* 67 */ {NULL, "HOME_LINEUP2_FLD_CD", "home position 2"},
-  /* 68 */ {NULL, "HOME_LINEUP3_BAT_ID", "home batter 3"},
-  /* 69 */ {NULL, "HOME_LINEUP3_FLD_CD", "home position 3"},
-  /* 70 */ {NULL, "HOME_LINEUP4_BAT_ID", "home batter 4"},
-  /* 71 */ {NULL, "HOME_LINEUP4_FLD_CD", "home position 4"},
-  /* 72 */ {NULL, "HOME_LINEUP5_BAT_ID", "home batter 5"},
-  /* 73 */ {NULL, "HOME_LINEUP5_FLD_CD", "home position 5"},
-  /* 74 */ {NULL, "HOME_LINEUP6_BAT_ID", "home batter 6"},
-  /* 75 */ {NULL, "HOME_LINEUP6_FLD_CD", "home position 6"},
-  /* 76 */ {NULL, "HOME_LINEUP7_BAT_ID", "home batter 7"},
-  /* 77 */ {NULL, "HOME_LINEUP7_FLD_CD", "home position 7"},
-  /* 78 */ {NULL, "HOME_LINEUP8_BAT_ID", "home batter 8"},
-  /* 79 */ {NULL, "HOME_LINEUP8_FLD_CD", "home position 8"},
-  /* 80 */ {NULL, "HOME_LINEUP9_BAT_ID", "home batter 9"},
-  /* 81 */ {NULL, "HOME_LINEUP9_FLD_CD", "home position 9"},
-  /* 82 */ {NULL, "AWAY_FINISH_PIT_ID", "visiting finisher (NULL if complete game)"},
-  /* 83 */ {NULL, "HOME_FINISH_PIT_ID", "home finisher (NULL if complete game)"},
-  /* 84 */ {cwgame_official_scorer, "OFFICIAL_SCORER_ID", "official scorer"},
-  /* 85 */ {cwgame_game_type, "GAME_TYPE_TX", "game type"}};
+  /*  0 */ {cwgame_game_id, "GAME_ID", "game id", CW_FIELD_ID},
+  /*  1 */ {cwgame_date, "GAME_DT", "date", CW_FIELD_TEXT},
+  /*  2 */ {cwgame_number, "GAME_CT", "game number (0 = no double header)", CW_FIELD_INT16},
+  /*  3 */ {cwgame_day_of_week, "GAME_DY", "day of week", CW_FIELD_TEXT},
+  /*  4 */ {cwgame_start_time, "START_GAME_TM", "start time", CW_FIELD_INT16},
+  /*  5 */ {cwgame_use_dh, "DH_FL", "DH used flag", CW_FIELD_FLAG},
+  /*  6 */ {cwgame_day_night, "DAYNIGHT_PARK_CD", "day/night flag", CW_FIELD_TEXT},
+  /*  7 */ {cwgame_visitors, "AWAY_TEAM_ID", "visiting team", CW_FIELD_ID},
+  /*  8 */ {cwgame_home, "HOME_TEAM_ID", "home team", CW_FIELD_ID},
+  /*  9 */ {cwgame_site, "PARK_ID", "game site", CW_FIELD_ID},
+  /* 10 */ {cwgame_visitors_pitcher, "AWAY_START_PIT_ID", "vis. starting pitcher", CW_FIELD_ID},
+  /* 11 */ {cwgame_home_pitcher, "HOME_START_PIT_ID", "home starting pitcher", CW_FIELD_ID},
+  /* 12 */ {cwgame_umpire_home, "BASE4_UMP_ID", "home plate umpire", CW_FIELD_ID},
+  /* 13 */ {cwgame_umpire_1b, "BASE1_UMP_ID", "first base umpire", CW_FIELD_ID},
+  /* 14 */ {cwgame_umpire_2b, "BASE2_UMP_ID", "second base umpire", CW_FIELD_ID},
+  /* 15 */ {cwgame_umpire_3b, "BASE3_UMP_ID", "third base umpire", CW_FIELD_ID},
+  /* 16 */ {cwgame_umpire_lf, "LF_UMP_ID", "left field umpire", CW_FIELD_ID},
+  /* 17 */ {cwgame_umpire_rf, "RF_UMP_ID", "right field umpire", CW_FIELD_ID},
+  /* 18 */ {cwgame_attendance, "ATTEND_PARK_CT", "attendance", CW_FIELD_INT32},
+  /* 19 */ {cwgame_scorer, "SCORER_RECORD_ID", "PS scorer", CW_FIELD_ID},
+  /* 20 */ {cwgame_translator, "TRANSLATOR_RECORD_ID", "translator", CW_FIELD_ID},
+  /* 21 */ {cwgame_inputter, "INPUTTER_RECORD_ID", "inputter", CW_FIELD_ID},
+  /* 22 */ {cwgame_inputtime, "INPUT_RECORD_TS", "input time", CW_FIELD_TEXT},
+  /* 23 */ {cwgame_edittime, "EDIT_RECORD_TS", "edit time", CW_FIELD_TEXT},
+  /* 24 */ {cwgame_howscored, "METHOD_RECORD_CD", "how scored", CW_FIELD_INT8},
+  /* 25 */ {cwgame_pitches, "PITCHES_RECORD_CD", "pitches entered?", CW_FIELD_INT8},
+  /* 26 */ {cwgame_temperature, "TEMP_PARK_CT", "temperature", CW_FIELD_INT16},
+  /* 27 */ {cwgame_wind_direction, "WIND_DIRECTION_PARK_CD", "wind direction", CW_FIELD_INT8},
+  /* 28 */ {cwgame_wind_speed, "WIND_SPEED_PARK_CT", "wind speed", CW_FIELD_INT16},
+  /* 29 */ {cwgame_field_condition, "FIELD_PARK_CD", "field condition", CW_FIELD_INT8},
+  /* 30 */ {cwgame_precipitation, "PRECIP_PARK_CD", "precipitation", CW_FIELD_INT8},
+  /* 31 */ {cwgame_sky, "SKY_PARK_CD", "sky", CW_FIELD_INT8},
+  /* 32 */ {cwgame_time_of_game, "MINUTES_GAME_CT", "time of game", CW_FIELD_INT16},
+  /* 33 */ {cwgame_innings, "INN_CT", "number of innings", CW_FIELD_INT16},
+  /* 34 */ {cwgame_visitor_score, "AWAY_SCORE_CT", "visitor final score", CW_FIELD_INT16},
+  /* 35 */ {cwgame_home_score, "HOME_SCORE_CT", "home final score", CW_FIELD_INT16},
+  /* 36 */ {cwgame_visitor_hits, "AWAY_HITS_CT", "visitor hits", CW_FIELD_INT16},
+  /* 37 */ {cwgame_home_hits, "HOME_HITS_CT", "home hits", CW_FIELD_INT16},
+  /* 38 */ {cwgame_visitor_errors, "AWAY_ERR_CT", "visitor errors", CW_FIELD_INT16},
+  /* 39 */ {cwgame_home_errors, "HOME_ERR_CT", "home errors", CW_FIELD_INT16},
+  /* 40 */ {cwgame_visitor_lob, "AWAY_LOB_CT", "visitor left on base", CW_FIELD_INT16},
+  /* 41 */ {cwgame_home_lob, "HOME_LOB_CT", "home left on base", CW_FIELD_INT16},
+  /* 42 */ {cwgame_winning_pitcher, "WIN_PIT_ID", "winning pitcher", CW_FIELD_ID},
+  /* 43 */ {cwgame_losing_pitcher, "LOSE_PIT_ID", "losing pitcher", CW_FIELD_ID},
+  /* 44 */ {cwgame_save, "SAVE_PIT_ID", "save for", CW_FIELD_ID},
+  /* 45 */ {cwgame_gwrbi, "GWRBI_BAT_ID", "GW RBI", CW_FIELD_ID},
+  /* 46 */ {NULL, "AWAY_LINEUP1_BAT_ID", "visitor batter 1", CW_FIELD_ID},
+  /* 47 */ {NULL, "AWAY_LINEUP1_FLD_CD", "visitor position 1", CW_FIELD_INT8},
+  /* 48 */ {NULL, "AWAY_LINEUP2_BAT_ID", "visitor batter 2", CW_FIELD_ID},
+  /* 49 */ {NULL, "AWAY_LINEUP2_FLD_CD", "visitor position 2", CW_FIELD_INT8},
+  /* 50 */ {NULL, "AWAY_LINEUP3_BAT_ID", "visitor batter 3", CW_FIELD_ID},
+  /* 51 */ {NULL, "AWAY_LINEUP3_FLD_CD", "visitor position 3", CW_FIELD_INT8},
+  /* 52 */ {NULL, "AWAY_LINEUP4_BAT_ID", "visitor batter 4", CW_FIELD_ID},
+  /* 53 */ {NULL, "AWAY_LINEUP4_FLD_CD", "visitor position 4", CW_FIELD_INT8},
+  /* 54 */ {NULL, "AWAY_LINEUP5_BAT_ID", "visitor batter 5", CW_FIELD_ID},
+  /* 55 */ {NULL, "AWAY_LINEUP5_FLD_CD", "visitor position 5", CW_FIELD_INT8},
+  /* 56 */ {NULL, "AWAY_LINEUP6_BAT_ID", "visitor batter 6", CW_FIELD_ID},
+  /* 57 */ {NULL, "AWAY_LINEUP6_FLD_CD", "visitor position 6", CW_FIELD_INT8},
+  /* 58 */ {NULL, "AWAY_LINEUP7_BAT_ID", "visitor batter 7", CW_FIELD_ID},
+  /* 59 */ {NULL, "AWAY_LINEUP7_FLD_CD", "visitor position 7", CW_FIELD_INT8},
+  /* 60 */ {NULL, "AWAY_LINEUP8_BAT_ID", "visitor batter 8", CW_FIELD_ID},
+  /* 61 */ {NULL, "AWAY_LINEUP8_FLD_CD", "visitor position 8", CW_FIELD_INT8},
+  /* 62 */ {NULL, "AWAY_LINEUP9_BAT_ID", "visitor batter 9", CW_FIELD_ID},
+  /* 63 */ {NULL, "AWAY_LINEUP9_FLD_CD", "visitor position 9", CW_FIELD_INT8},
+  /* 64 */ {NULL, "HOME_LINEUP1_BAT_ID", "home batter 1", CW_FIELD_ID},
+  /* 65 */ {NULL, "HOME_LINEUP1_FLD_CD", "home position 1", CW_FIELD_INT8},
+  /* 66 */ {NULL, "HOME_LINEUP2_BAT_ID", "home batter 2", CW_FIELD_ID},
+  /* 67 */ {NULL, "HOME_LINEUP2_FLD_CD", "home position 2", CW_FIELD_INT8},
+  /* 68 */ {NULL, "HOME_LINEUP3_BAT_ID", "home batter 3", CW_FIELD_ID},
+  /* 69 */ {NULL, "HOME_LINEUP3_FLD_CD", "home position 3", CW_FIELD_INT8},
+  /* 70 */ {NULL, "HOME_LINEUP4_BAT_ID", "home batter 4", CW_FIELD_ID},
+  /* 71 */ {NULL, "HOME_LINEUP4_FLD_CD", "home position 4", CW_FIELD_INT8},
+  /* 72 */ {NULL, "HOME_LINEUP5_BAT_ID", "home batter 5", CW_FIELD_ID},
+  /* 73 */ {NULL, "HOME_LINEUP5_FLD_CD", "home position 5", CW_FIELD_INT8},
+  /* 74 */ {NULL, "HOME_LINEUP6_BAT_ID", "home batter 6", CW_FIELD_ID},
+  /* 75 */ {NULL, "HOME_LINEUP6_FLD_CD", "home position 6", CW_FIELD_INT8},
+  /* 76 */ {NULL, "HOME_LINEUP7_BAT_ID", "home batter 7", CW_FIELD_ID},
+  /* 77 */ {NULL, "HOME_LINEUP7_FLD_CD", "home position 7", CW_FIELD_INT8},
+  /* 78 */ {NULL, "HOME_LINEUP8_BAT_ID", "home batter 8", CW_FIELD_ID},
+  /* 79 */ {NULL, "HOME_LINEUP8_FLD_CD", "home position 8", CW_FIELD_INT8},
+  /* 80 */ {NULL, "HOME_LINEUP9_BAT_ID", "home batter 9", CW_FIELD_ID},
+  /* 81 */ {NULL, "HOME_LINEUP9_FLD_CD", "home position 9", CW_FIELD_INT8},
+  /* 82 */ {NULL, "AWAY_FINISH_PIT_ID", "visiting finisher (NULL if complete game)", CW_FIELD_ID},
+  /* 83 */ {NULL, "HOME_FINISH_PIT_ID", "home finisher (NULL if complete game)", CW_FIELD_ID},
+  /* 84 */ {cwgame_official_scorer, "OFFICIAL_SCORER_ID", "official scorer", CW_FIELD_ID},
+  /* 85 */ {cwgame_game_type, "GAME_TYPE_TX", "game type", CW_FIELD_TEXT}};
 
 #define DECLARE_TABULATED_BATTER_FUNC(funcname, alignment, fieldname)                             \
   DECLARE_FIELDFUNC(funcname)                                                                     \
@@ -1309,103 +1317,131 @@ DECLARE_FIELDFUNC(cwgame_tiebreaker)
 }
 
 static field_struct ext_field_data[] = {
-  {cwgame_visitors_league, "AWAY_TEAM_LEAGUE_ID", "visiting team league"},
-  {cwgame_home_league, "HOME_TEAM_LEAGUE_ID", "home team league"},
-  {cwgame_visitors_game, "AWAY_TEAM_GAME_CT", "visiting team game number"},
-  {cwgame_home_game, "HOME_TEAM_GAME_CT", "home team game number"},
-  {cwgame_length_outs, "OUTS_CT", "length of game in outs"},
-  {cwgame_completion_info, "COMPLETION_TX", "information on completion of game"},
-  {cwgame_forfeit_info, "FORFEIT_TX", "information on forfeit of game"},
-  {cwgame_protest_info, "PROTEST_TX", "information on protest of game"},
-  {cwgame_visitors_line, "AWAY_LINE_TX", "visiting team linescore"},
-  {cwgame_home_line, "HOME_LINE_TX", "home team linescore"},
-  {cwgame_visitors_ab, "AWAY_AB_CT", "visiting team AB"},
-  {cwgame_visitors_2b, "AWAY_2B_CT", "visiting team 2B"},
-  {cwgame_visitors_3b, "AWAY_3B_CT", "visiting team 3B"},
-  {cwgame_visitors_hr, "AWAY_HR_CT", "visiting team HR"},
-  {cwgame_visitors_bi, "AWAY_BI_CT", "visiting team RBI"},
-  {cwgame_visitors_sh, "AWAY_SH_CT", "visiting team SH"},
-  {cwgame_visitors_sf, "AWAY_SF_CT", "visiting team SF"},
-  {cwgame_visitors_hp, "AWAY_HP_CT", "visiting team HP"},
-  {cwgame_visitors_bb, "AWAY_BB_CT", "visiting team BB"},
-  {cwgame_visitors_ibb, "AWAY_IBB_CT", "visiting team IBB"},
-  {cwgame_visitors_so, "AWAY_SO_CT", "visiting team SO"},
-  {cwgame_visitors_sb, "AWAY_SB_CT", "visiting team SB"},
-  {cwgame_visitors_cs, "AWAY_CS_CT", "visiting team CS"},
-  {cwgame_visitors_gdp, "AWAY_GDP_CT", "visiting team GDP"},
-  {cwgame_visitors_xi, "AWAY_XI_CT", "visiting team reach on interference"},
-  {cwgame_visitors_pitchers, "AWAY_PITCHER_CT", "number of pitchers used by visiting team"},
-  {cwgame_visitors_er, "AWAY_ER_CT", "visiting team individual ER allowed"},
-  {cwgame_visitors_ter, "AWAY_TER_CT", "visiting team team ER allowed"},
-  {cwgame_visitors_wp, "AWAY_WP_CT", "visiting team WP"},
-  {cwgame_visitors_bk, "AWAY_BK_CT", "visiting team BK"},
-  {cwgame_visitors_po, "AWAY_PO_CT", "visiting team PO"},
-  {cwgame_visitors_a, "AWAY_A_CT", "visiting team A"},
-  {cwgame_visitors_pb, "AWAY_PB_CT", "visiting team PB"},
-  {cwgame_visitors_dp, "AWAY_DP_CT", "visiting team DP"},
-  {cwgame_visitors_tp, "AWAY_TP_CT", "visiting team TP"},
-  {cwgame_home_ab, "HOME_AB_CT", "home team AB"},
-  {cwgame_home_2b, "HOME_2B_CT", "home team 2B"},
-  {cwgame_home_3b, "HOME_3B_CT", "home team 3B"},
-  {cwgame_home_hr, "HOME_HR_CT", "home team HR"},
-  {cwgame_home_bi, "HOME_BI_CT", "home team RBI"},
-  {cwgame_home_sh, "HOME_SH_CT", "home team SH"},
-  {cwgame_home_sf, "HOME_SF_CT", "home team SF"},
-  {cwgame_home_hp, "HOME_HP_CT", "home team HP"},
-  {cwgame_home_bb, "HOME_BB_CT", "home team BB"},
-  {cwgame_home_ibb, "HOME_IBB_CT", "home team IBB"},
-  {cwgame_home_so, "HOME_SO_CT", "home team SO"},
-  {cwgame_home_sb, "HOME_SB_CT", "home team SB"},
-  {cwgame_home_cs, "HOME_CS_CT", "home team CS"},
-  {cwgame_home_gdp, "HOME_GDP_CT", "home team GDP"},
-  {cwgame_home_xi, "HOME_XI_CT", "home team reach on interference"},
-  {cwgame_home_pitchers, "HOME_PITCHER_CT", "number of pitchers used by home team"},
-  {cwgame_home_er, "HOME_ER_CT", "home team individual ER allowed"},
-  {cwgame_home_ter, "HOME_TER_CT", "home team team ER allowed"},
-  {cwgame_home_wp, "HOME_WP_CT", "home team WP"},
-  {cwgame_home_bk, "HOME_BK_CT", "home team BK"},
-  {cwgame_home_po, "HOME_PO_CT", "home team PO"},
-  {cwgame_home_a, "HOME_A_CT", "home team A"},
-  {cwgame_home_pb, "HOME_PB_CT", "home team PB"},
-  {cwgame_home_dp, "HOME_DP_CT", "home team DP"},
-  {cwgame_home_tp, "HOME_TP_CT", "home team TP"},
-  {cwgame_umpire_home_name, "UMP_HOME_NAME_TX", "home plate umpire name"},
-  {cwgame_umpire_1b_name, "UMP_1B_NAME_TX", "first base umpire name"},
-  {cwgame_umpire_2b_name, "UMP_2B_NAME_TX", "second base umpire name"},
-  {cwgame_umpire_3b_name, "UMP_3B_NAME_TX", "third base umpire name"},
-  {cwgame_umpire_lf_name, "UMP_LF_NAME_TX", "left field umpire name"},
-  {cwgame_umpire_rf_name, "UMP_RF_NAME_TX", "right field umpire name"},
-  {cwgame_visitors_manager_id, "AWAY_MANAGER_ID", "visitors manager ID"},
-  {cwgame_visitors_manager_name, "AWAY_MANAGER_NAME_TX", "visitors manager name"},
-  {cwgame_home_manager_id, "HOME_MANAGER_ID", "home manager ID"},
-  {cwgame_home_manager_name, "HOME_MANAGER_NAME_TX", "home manager name"},
-  {cwgame_winning_pitcher_name, "WIN_PIT_NAME_TX", "winning pitcher name"},
-  {cwgame_losing_pitcher_name, "LOSE_PIT_NAME_TX", "losing pitcher name"},
-  {cwgame_save_pitcher_name, "SAVE_PIT_NAME_TX", "save pitcher name"},
-  {cwgame_goahead_rbi_id, "GOAHEAD_RBI_ID", "batter with goahead RBI ID"},
-  {cwgame_goahead_rbi_name, "GOAHEAD_RBI_NAME_TX", "batter with goahead RBI"},
-  {cwgame_visitors_batter1_name, "AWAY_LINEUP1_BAT_NAME_TX", "visitor batter 1 name"},
-  {cwgame_visitors_batter2_name, "AWAY_LINEUP2_BAT_NAME_TX", "visitor batter 2 name"},
-  {cwgame_visitors_batter3_name, "AWAY_LINEUP3_BAT_NAME_TX", "visitor batter 3 name"},
-  {cwgame_visitors_batter4_name, "AWAY_LINEUP4_BAT_NAME_TX", "visitor batter 4 name"},
-  {cwgame_visitors_batter5_name, "AWAY_LINEUP5_BAT_NAME_TX", "visitor batter 5 name"},
-  {cwgame_visitors_batter6_name, "AWAY_LINEUP6_BAT_NAME_TX", "visitor batter 6 name"},
-  {cwgame_visitors_batter7_name, "AWAY_LINEUP7_BAT_NAME_TX", "visitor batter 7 name"},
-  {cwgame_visitors_batter8_name, "AWAY_LINEUP8_BAT_NAME_TX", "visitor batter 8 name"},
-  {cwgame_visitors_batter9_name, "AWAY_LINEUP9_BAT_NAME_TX", "visitor batter 9 name"},
-  {cwgame_home_batter1_name, "HOME_LINEUP1_BAT_NAME_TX", "home batter 1 name"},
-  {cwgame_home_batter2_name, "HOME_LINEUP2_BAT_NAME_TX", "home batter 2 name"},
-  {cwgame_home_batter3_name, "HOME_LINEUP3_BAT_NAME_TX", "home batter 3 name"},
-  {cwgame_home_batter4_name, "HOME_LINEUP4_BAT_NAME_TX", "home batter 4 name"},
-  {cwgame_home_batter5_name, "HOME_LINEUP5_BAT_NAME_TX", "home batter 5 name"},
-  {cwgame_home_batter6_name, "HOME_LINEUP6_BAT_NAME_TX", "home batter 6 name"},
-  {cwgame_home_batter7_name, "HOME_LINEUP7_BAT_NAME_TX", "home batter 7 name"},
-  {cwgame_home_batter8_name, "HOME_LINEUP8_BAT_NAME_TX", "home batter 8 name"},
-  {cwgame_home_batter9_name, "HOME_LINEUP9_BAT_NAME_TX", "home batter 9 name"},
-  {cwgame_additional_info, "ADD_INFO_TX", "additional information"},
-  {cwgame_acquisition_info, "ACQ_INFO_TX", "acquisition information"},
-  {cwgame_scheduled_innings, "SCHED_INN_CT", "scheduled length of game in innings "},
-  {cwgame_tiebreaker, "TIEBREAK_CD", "tiebreaker rule type in use"}};
+  {cwgame_visitors_league, "AWAY_TEAM_LEAGUE_ID", "visiting team league", CW_FIELD_ID},
+  {cwgame_home_league, "HOME_TEAM_LEAGUE_ID", "home team league", CW_FIELD_ID},
+  {cwgame_visitors_game, "AWAY_TEAM_GAME_CT", "visiting team game number", CW_FIELD_TEXT},
+  {cwgame_home_game, "HOME_TEAM_GAME_CT", "home team game number", CW_FIELD_TEXT},
+  {cwgame_length_outs, "OUTS_CT", "length of game in outs", CW_FIELD_INT16},
+  {cwgame_completion_info, "COMPLETION_TX", "information on completion of game", CW_FIELD_TEXT},
+  {cwgame_forfeit_info, "FORFEIT_TX", "information on forfeit of game", CW_FIELD_TEXT},
+  {cwgame_protest_info, "PROTEST_TX", "information on protest of game", CW_FIELD_TEXT},
+  {cwgame_visitors_line, "AWAY_LINE_TX", "visiting team linescore", CW_FIELD_TEXT},
+  {cwgame_home_line, "HOME_LINE_TX", "home team linescore", CW_FIELD_TEXT},
+  {cwgame_visitors_ab, "AWAY_AB_CT", "visiting team AB", CW_FIELD_INT16},
+  {cwgame_visitors_2b, "AWAY_2B_CT", "visiting team 2B", CW_FIELD_INT16},
+  {cwgame_visitors_3b, "AWAY_3B_CT", "visiting team 3B", CW_FIELD_INT16},
+  {cwgame_visitors_hr, "AWAY_HR_CT", "visiting team HR", CW_FIELD_INT16},
+  {cwgame_visitors_bi, "AWAY_BI_CT", "visiting team RBI", CW_FIELD_INT16},
+  {cwgame_visitors_sh, "AWAY_SH_CT", "visiting team SH", CW_FIELD_INT16},
+  {cwgame_visitors_sf, "AWAY_SF_CT", "visiting team SF", CW_FIELD_INT16},
+  {cwgame_visitors_hp, "AWAY_HP_CT", "visiting team HP", CW_FIELD_INT16},
+  {cwgame_visitors_bb, "AWAY_BB_CT", "visiting team BB", CW_FIELD_INT16},
+  {cwgame_visitors_ibb, "AWAY_IBB_CT", "visiting team IBB", CW_FIELD_INT16},
+  {cwgame_visitors_so, "AWAY_SO_CT", "visiting team SO", CW_FIELD_INT16},
+  {cwgame_visitors_sb, "AWAY_SB_CT", "visiting team SB", CW_FIELD_INT16},
+  {cwgame_visitors_cs, "AWAY_CS_CT", "visiting team CS", CW_FIELD_INT16},
+  {cwgame_visitors_gdp, "AWAY_GDP_CT", "visiting team GDP", CW_FIELD_INT16},
+  {cwgame_visitors_xi, "AWAY_XI_CT", "visiting team reach on interference", CW_FIELD_INT16},
+  {cwgame_visitors_pitchers, "AWAY_PITCHER_CT",
+   "number of pitchers used by visiting team", CW_FIELD_INT16},
+  {cwgame_visitors_er, "AWAY_ER_CT", "visiting team individual ER allowed", CW_FIELD_INT16},
+  {cwgame_visitors_ter, "AWAY_TER_CT", "visiting team team ER allowed", CW_FIELD_INT16},
+  {cwgame_visitors_wp, "AWAY_WP_CT", "visiting team WP", CW_FIELD_INT16},
+  {cwgame_visitors_bk, "AWAY_BK_CT", "visiting team BK", CW_FIELD_INT16},
+  {cwgame_visitors_po, "AWAY_PO_CT", "visiting team PO", CW_FIELD_INT16},
+  {cwgame_visitors_a, "AWAY_A_CT", "visiting team A", CW_FIELD_INT16},
+  {cwgame_visitors_pb, "AWAY_PB_CT", "visiting team PB", CW_FIELD_INT16},
+  {cwgame_visitors_dp, "AWAY_DP_CT", "visiting team DP", CW_FIELD_INT16},
+  {cwgame_visitors_tp, "AWAY_TP_CT", "visiting team TP", CW_FIELD_INT16},
+  {cwgame_home_ab, "HOME_AB_CT", "home team AB", CW_FIELD_INT16},
+  {cwgame_home_2b, "HOME_2B_CT", "home team 2B", CW_FIELD_INT16},
+  {cwgame_home_3b, "HOME_3B_CT", "home team 3B", CW_FIELD_INT16},
+  {cwgame_home_hr, "HOME_HR_CT", "home team HR", CW_FIELD_INT16},
+  {cwgame_home_bi, "HOME_BI_CT", "home team RBI", CW_FIELD_INT16},
+  {cwgame_home_sh, "HOME_SH_CT", "home team SH", CW_FIELD_INT16},
+  {cwgame_home_sf, "HOME_SF_CT", "home team SF", CW_FIELD_INT16},
+  {cwgame_home_hp, "HOME_HP_CT", "home team HP", CW_FIELD_INT16},
+  {cwgame_home_bb, "HOME_BB_CT", "home team BB", CW_FIELD_INT16},
+  {cwgame_home_ibb, "HOME_IBB_CT", "home team IBB", CW_FIELD_INT16},
+  {cwgame_home_so, "HOME_SO_CT", "home team SO", CW_FIELD_INT16},
+  {cwgame_home_sb, "HOME_SB_CT", "home team SB", CW_FIELD_INT16},
+  {cwgame_home_cs, "HOME_CS_CT", "home team CS", CW_FIELD_INT16},
+  {cwgame_home_gdp, "HOME_GDP_CT", "home team GDP", CW_FIELD_INT16},
+  {cwgame_home_xi, "HOME_XI_CT", "home team reach on interference", CW_FIELD_INT16},
+  {cwgame_home_pitchers, "HOME_PITCHER_CT",
+   "number of pitchers used by home team", CW_FIELD_INT16},
+  {cwgame_home_er, "HOME_ER_CT", "home team individual ER allowed", CW_FIELD_INT16},
+  {cwgame_home_ter, "HOME_TER_CT", "home team team ER allowed", CW_FIELD_INT16},
+  {cwgame_home_wp, "HOME_WP_CT", "home team WP", CW_FIELD_INT16},
+  {cwgame_home_bk, "HOME_BK_CT", "home team BK", CW_FIELD_INT16},
+  {cwgame_home_po, "HOME_PO_CT", "home team PO", CW_FIELD_INT16},
+  {cwgame_home_a, "HOME_A_CT", "home team A", CW_FIELD_INT16},
+  {cwgame_home_pb, "HOME_PB_CT", "home team PB", CW_FIELD_INT16},
+  {cwgame_home_dp, "HOME_DP_CT", "home team DP", CW_FIELD_INT16},
+  {cwgame_home_tp, "HOME_TP_CT", "home team TP", CW_FIELD_INT16},
+  {cwgame_umpire_home_name, "UMP_HOME_NAME_TX", "home plate umpire name", CW_FIELD_TEXT},
+  {cwgame_umpire_1b_name, "UMP_1B_NAME_TX", "first base umpire name", CW_FIELD_TEXT},
+  {cwgame_umpire_2b_name, "UMP_2B_NAME_TX", "second base umpire name", CW_FIELD_TEXT},
+  {cwgame_umpire_3b_name, "UMP_3B_NAME_TX", "third base umpire name", CW_FIELD_TEXT},
+  {cwgame_umpire_lf_name, "UMP_LF_NAME_TX", "left field umpire name", CW_FIELD_TEXT},
+  {cwgame_umpire_rf_name, "UMP_RF_NAME_TX", "right field umpire name", CW_FIELD_TEXT},
+  {cwgame_visitors_manager_id, "AWAY_MANAGER_ID", "visitors manager ID", CW_FIELD_ID},
+  {cwgame_visitors_manager_name, "AWAY_MANAGER_NAME_TX", "visitors manager name", CW_FIELD_TEXT},
+  {cwgame_home_manager_id, "HOME_MANAGER_ID", "home manager ID", CW_FIELD_ID},
+  {cwgame_home_manager_name, "HOME_MANAGER_NAME_TX", "home manager name", CW_FIELD_TEXT},
+  {cwgame_winning_pitcher_name, "WIN_PIT_NAME_TX", "winning pitcher name", CW_FIELD_TEXT},
+  {cwgame_losing_pitcher_name, "LOSE_PIT_NAME_TX", "losing pitcher name", CW_FIELD_TEXT},
+  {cwgame_save_pitcher_name, "SAVE_PIT_NAME_TX", "save pitcher name", CW_FIELD_TEXT},
+  {cwgame_goahead_rbi_id, "GOAHEAD_RBI_ID", "batter with goahead RBI ID", CW_FIELD_ID},
+  {cwgame_goahead_rbi_name, "GOAHEAD_RBI_NAME_TX", "batter with goahead RBI", CW_FIELD_TEXT},
+  {cwgame_visitors_batter1_name, "AWAY_LINEUP1_BAT_NAME_TX",
+   "visitor batter 1 name", CW_FIELD_TEXT},
+  {cwgame_visitors_batter2_name, "AWAY_LINEUP2_BAT_NAME_TX",
+   "visitor batter 2 name", CW_FIELD_TEXT},
+  {cwgame_visitors_batter3_name, "AWAY_LINEUP3_BAT_NAME_TX",
+   "visitor batter 3 name", CW_FIELD_TEXT},
+  {cwgame_visitors_batter4_name, "AWAY_LINEUP4_BAT_NAME_TX",
+   "visitor batter 4 name", CW_FIELD_TEXT},
+  {cwgame_visitors_batter5_name, "AWAY_LINEUP5_BAT_NAME_TX",
+   "visitor batter 5 name", CW_FIELD_TEXT},
+  {cwgame_visitors_batter6_name, "AWAY_LINEUP6_BAT_NAME_TX",
+   "visitor batter 6 name", CW_FIELD_TEXT},
+  {cwgame_visitors_batter7_name, "AWAY_LINEUP7_BAT_NAME_TX",
+   "visitor batter 7 name", CW_FIELD_TEXT},
+  {cwgame_visitors_batter8_name, "AWAY_LINEUP8_BAT_NAME_TX",
+   "visitor batter 8 name", CW_FIELD_TEXT},
+  {cwgame_visitors_batter9_name, "AWAY_LINEUP9_BAT_NAME_TX",
+   "visitor batter 9 name", CW_FIELD_TEXT},
+  {cwgame_home_batter1_name, "HOME_LINEUP1_BAT_NAME_TX", "home batter 1 name", CW_FIELD_TEXT},
+  {cwgame_home_batter2_name, "HOME_LINEUP2_BAT_NAME_TX", "home batter 2 name", CW_FIELD_TEXT},
+  {cwgame_home_batter3_name, "HOME_LINEUP3_BAT_NAME_TX", "home batter 3 name", CW_FIELD_TEXT},
+  {cwgame_home_batter4_name, "HOME_LINEUP4_BAT_NAME_TX", "home batter 4 name", CW_FIELD_TEXT},
+  {cwgame_home_batter5_name, "HOME_LINEUP5_BAT_NAME_TX", "home batter 5 name", CW_FIELD_TEXT},
+  {cwgame_home_batter6_name, "HOME_LINEUP6_BAT_NAME_TX", "home batter 6 name", CW_FIELD_TEXT},
+  {cwgame_home_batter7_name, "HOME_LINEUP7_BAT_NAME_TX", "home batter 7 name", CW_FIELD_TEXT},
+  {cwgame_home_batter8_name, "HOME_LINEUP8_BAT_NAME_TX", "home batter 8 name", CW_FIELD_TEXT},
+  {cwgame_home_batter9_name, "HOME_LINEUP9_BAT_NAME_TX", "home batter 9 name", CW_FIELD_TEXT},
+  {cwgame_additional_info, "ADD_INFO_TX", "additional information", CW_FIELD_TEXT},
+  {cwgame_acquisition_info, "ACQ_INFO_TX", "acquisition information", CW_FIELD_TEXT},
+  {cwgame_scheduled_innings, "SCHED_INN_CT",
+   "scheduled length of game in innings ", CW_FIELD_INT16},
+  {cwgame_tiebreaker, "TIEBREAK_CD", "tiebreaker rule type in use", CW_FIELD_TEXT}};
+
+/* Number of fields, standard and extended, which can be selected */
+#define CWGAME_MAX_COLUMNS                                                                       \
+  ((int) (sizeof(field_data) / sizeof(field_data[0]) +                                           \
+          sizeof(ext_field_data) / sizeof(ext_field_data[0])))
+
+/*
+ * For typed output formats (binary COPY and JSON), the line is formatted
+ * in delimited mode as usual, then split into the text of each selected field.
+ */
+static char *column_values[CWGAME_MAX_COLUMNS];
+static CWFieldType column_types[CWGAME_MAX_COLUMNS];
+static int num_columns = 0;
+
+/* One boxscore is rebuilt for each game, so its memory is reused */
+static CWBoxscore *game_box = NULL;
 
 void cwgame_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
 {
@@ -1413,13 +1449,23 @@ void cwgame_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
   CWBuffer buf;
   int i, j, t;
   CWGameIterator *gameiter = cw_gameiter_create(game);
-  CWBoxscore *box = cw_box_create(game);
+  CWBoxscore *box;
 
   while (gameiter->event != NULL) {
     cw_gameiter_next(gameiter);
   }
+  if (game_box == NULL) {
+    game_box = cw_box_create(game);
+  }
+  else {
+    cw_box_rebuild(game_box, game);
+  }
+  box = game_box;
 
   cw_buffer_init(&buf, output_line, sizeof(output_line), ascii, ',');
+  if (pgcopy || json_output) {
+    cw_buffer_track_fields(&buf, column_values, num_columns);
+  }
   for (i = 0; i < 46; i++) {
     if (fields[i]) {
       (*field_data[i].f)(&buf, gameiter, box, visitors, home);
@@ -1462,11 +1508,19 @@ void cwgame_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
     exit(1);
   }
 
-  printf("%s", output_line);
-  printf("\n");
+  if (pgcopy) {
+    cw_pgcopy_write_row(stdout, column_values, column_types, cw_buffer_split_fields(&buf));
+  }
+  else if (json_output) {
+    json_writer_write_row(json_writer, column_values, cw_buffer_split_fields(&buf));
+  }
+  else {
+    printf("%s", output_line);
+    printf("\n");
+  }
 
   cw_gameiter_cleanup(gameiter);
-  free(gameiter);
+  cw_free(CW_ALLOC_GAMEITER, gameiter);
 }
 
 void (*cwtools_process_game)(CWGame *, CWRoster *, CWRoster *) = cwgame_process_game;
@@ -1482,10 +1536,13 @@ void cwgame_print_help(void)
   fprintf(stderr, "  -y year   Year to process (for teamyyyy and aaayyyy.ros).\n");
   fprintf(stderr,
           "  -D dir    Directory to find team and roster files (default is current directory)\n");
+  fprintf(stderr, "  -C file   Catalog of games (from cwcatalog), to read only selected games\n");
   fprintf(stderr, "  -s start  Earliest date to process (mmdd).\n");
   fprintf(stderr, "  -e end    Last date to process (mmdd).\n");
   fprintf(stderr, "  -a        generate Ascii-delimited format files (default)\n");
   fprintf(stderr, "  -ft       generate Fortran format files\n");
+  fprintf(stderr, "  -fp       generate PostgreSQL binary COPY format\n");
+  fprintf(stderr, "  -J        generate JSON Lines, one object per game\n");
   fprintf(stderr, "  -f flist  give list of fields to output\n");
   fprintf(stderr, "              Default is 0-84\n");
   fprintf(stderr, "  -x flist  give list of extended fields to output\n");
@@ -1497,6 +1554,15 @@ void cwgame_print_help(void)
   fprintf(stderr, "  -dnf      no slashes, full year: yyyymmdd (the default)\n");
   fprintf(stderr, "  -dnp      no slashes, partial year: yymmdd\n");
   fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n");
+  fprintf(stderr, "  --team=list  only process games of the teams listed (IDs separated\n");
+  fprintf(stderr, "            by commas)\n");
+  fprintf(stderr, "  --park=list  only process games at the parks listed\n");
+  fprintf(stderr, "  --stats[=file]  report counts and phase timings at exit,\n");
+  fprintf(stderr, "            to stderr, or as JSON to file\n");
+  fprintf(stderr, "  --serve=socket  read the games once, and answer requests\n");
+  fprintf(stderr, "            for them on a Unix-domain socket\n");
+  fprintf(stderr, "  --incremental=dir  keep the output for each file in dir,\n");
+  fprintf(stderr, "            and reuse it while the file is unchanged\n");
   fprintf(stderr, "  -n        print field names in first row of output\n\n");
 
   exit(0);
@@ -1553,7 +1619,33 @@ void cwgame_initialize(void)
   char output_line[4096];
   CWBuffer buf;
 
-  if (!ascii || !print_header) {
+  for (i = 0; i <= max_field; i++) {
+    if (fields[i]) {
+      column_types[num_columns++] = field_data[i].type;
+    }
+  }
+  for (i = 0; i <= max_ext_field; i++) {
+    if (ext_fields[i]) {
+      column_types[num_columns++] = ext_field_data[i].type;
+    }
+  }
+
+  if (json_output) {
+    json_writer = json_writer_create(stdout);
+    for (i = 0; i <= max_field; i++) {
+      if (fields[i]) {
+        json_writer_add_column(json_writer, field_data[i].header, field_data[i].type);
+      }
+    }
+    for (i = 0; i <= max_ext_field; i++) {
+      if (ext_fields[i]) {
+        json_writer_add_column(json_writer, ext_field_data[i].header, ext_field_data[i].type);
+      }
+    }
+    return;
+  }
+
+  if (!ascii || pgcopy || !print_header) {
     return;
   }
   cw_buffer_init(&buf, output_line, sizeof(output_line), ascii, ',');
@@ -1583,6 +1675,15 @@ void (*cwtools_initialize)(void) = cwgame_initialize;
 
 void cwgame_cleanup(void)
 {
+  if (game_box != NULL) {
+    cw_box_cleanup(game_box);
+    cw_free(CW_ALLOC_BOX, game_box);
+    game_box = NULL;
+  }
+  if (json_writer != NULL) {
+    json_writer_cleanup(json_writer);
+    json_writer = NULL;
+  }
 }
 
 void (*cwtools_cleanup)(void) = cwgame_cleanup;
@@ -1592,6 +1693,7 @@ extern char first_date[5];
 extern char last_date[5];
 extern char game_id[20];
 extern char data_dir[1024];
+extern char catalog_file[1024];
 extern int quiet;
 
 extern void cwtools_parse_field_list(char *text, int max_field, int *fields);
@@ -1604,6 +1706,8 @@ int cwgame_parse_command_line(int argc, char *argv[])
   for (i = 1; i < argc; i++) {
     if (!strcmp(argv[i], "-a")) {
       ascii = 1;
+      pgcopy = 0;
+      json_output = 0;
     }
     else if (!strcmp(argv[i], "-d")) {
       (*cwtools_print_welcome_message)(argv[0]);
@@ -1648,6 +1752,18 @@ int cwgame_parse_command_line(int argc, char *argv[])
     }
     else if (!strcmp(argv[i], "-ft")) {
       ascii = 0;
+      pgcopy = 0;
+      json_output = 0;
+    }
+    else if (!strcmp(argv[i], "-fp")) {
+      ascii = 1;
+      pgcopy = 1;
+      json_output = 0;
+    }
+    else if (!strcmp(argv[i], "-J")) {
+      ascii = 1;
+      pgcopy = 0;
+      json_output = 1;
     }
     else if (!strcmp(argv[i], "-s")) {
       if (++i < argc) {
@@ -1670,6 +1786,12 @@ int cwgame_parse_command_line(int argc, char *argv[])
         data_dir[sizeof(data_dir) - 1] = '\0';
       }
     }
+    else if (!strcmp(argv[i], "-C")) {
+      if (++i < argc) {
+        strncpy(catalog_file, argv[i], sizeof(catalog_file) - 1);
+        catalog_file[sizeof(catalog_file) - 1] = '\0';
+      }
+    }
     else if (argv[i][0] == '-') {
       fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
       exit(1);
@@ -0,0 +1,132 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/cwindex.c
+ * Chadwick player index builder
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Unlike the other tools, cwindex does not use the common driver in
+ * cwtools.c, since it needs the offset of each game in its file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cwlib/chadwick.h"
+
+/* File to write the index to (-o); standard output if empty */
+char output_file[1024] = "";
+
+/* If 'quiet', write no status messages to stderr (-Q) */
+int quiet = 0;
+
+void cwindex_print_welcome_message(char *argv0)
+{
+  fprintf(stderr, "\nChadwick player index builder, version " VERSION);
+  fprintf(stderr, "\n  Type '%s -h' for help.\n", argv0);
+  fprintf(
+    stderr,
+    "Copyright (c) 2002-2026\nDr T L Turocy, Chadwick Baseball Bureau (ted.turocy@gmail.com)\n");
+  fprintf(stderr, "This is free software, "
+                  "subject to the terms of the GNU GPL license.\n\n");
+}
+
+void cwindex_print_help(void)
+{
+  fprintf(stderr, "\n\ncwindex builds an index of the games and events each player\n");
+  fprintf(stderr, "appears in, for use by cwquery.\n");
+  fprintf(stderr, "Usage: cwindex [options] eventfile...\n");
+  fprintf(stderr, "options:\n");
+  fprintf(stderr, "  -h        print this help\n");
+  fprintf(stderr, "  -o file   write the index to file (default is standard output)\n");
+  fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n\n");
+
+  exit(0);
+}
+
+int cwindex_parse_command_line(int argc, char *argv[])
+{
+  int i;
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-h")) {
+      cwindex_print_welcome_message(argv[0]);
+      cwindex_print_help();
+    }
+    else if (!strcmp(argv[i], "-o")) {
+      if (++i < argc) {
+        strncpy(output_file, argv[i], sizeof(output_file) - 1);
+        output_file[sizeof(output_file) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-Q")) {
+      quiet = 1;
+    }
+    else if (argv[i][0] == '-') {
+      fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
+      exit(1);
+    }
+    else {
+      break;
+    }
+  }
+
+  return i;
+}
+
+int main(int argc, char *argv[])
+{
+  CWPlayerIndex *index;
+  FILE *output = stdout;
+  int i;
+
+  i = cwindex_parse_command_line(argc, argv);
+  if (!quiet) {
+    cwindex_print_welcome_message(argv[0]);
+  }
+
+  index = cw_index_create();
+  for (; i < argc; i++) {
+    if (!quiet) {
+      fprintf(stderr, "[Processing file %s.]\n", argv[i]);
+    }
+    if (cw_index_add_file(index, argv[i]) < 0) {
+      fprintf(stderr, "Warning: could not open file '%s'\n", argv[i]);
+    }
+  }
+
+  if (strcmp(output_file, "") != 0) {
+    output = fopen(output_file, "w");
+    if (output == NULL) {
+      fprintf(stderr, "Error: could not open index file '%s' for writing\n", output_file);
+      exit(1);
+    }
+  }
+  cw_index_write(index, output);
+  if (output != stdout) {
+    fclose(output);
+  }
+
+  cw_index_cleanup(index);
+  cw_free(CW_ALLOC_INDEX, index);
+
+  return 0;
+}
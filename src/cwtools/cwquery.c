@@ -0,0 +1,282 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/cwquery.c
+ * Chadwick player event finder, using an index built by cwindex
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Like cwindex, cwquery does not use the common driver in cwtools.c:
+ * it reads only the games named in the index, rather than whole files.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cwlib/chadwick.h"
+
+/* The index file (-I) */
+char index_file[1024] = "";
+
+/* The roles to report (-r), as CW_INDEX_* bits */
+int roles = CW_INDEX_BATTING | CW_INDEX_PITCHING | CW_INDEX_FIELDING | CW_INDEX_RUNNING;
+
+/* If 'print_header', the first row gives the field names (-n) */
+int print_header = 0;
+
+/* If 'quiet', write no status messages to stderr (-Q) */
+int quiet = 0;
+
+static char role_codes[CW_INDEX_ROLES + 1] = "BPFR";
+
+void cwquery_print_welcome_message(char *argv0)
+{
+  fprintf(stderr, "\nChadwick player event finder, version " VERSION);
+  fprintf(stderr, "\n  Type '%s -h' for help.\n", argv0);
+  fprintf(
+    stderr,
+    "Copyright (c) 2002-2026\nDr T L Turocy, Chadwick Baseball Bureau (ted.turocy@gmail.com)\n");
+  fprintf(stderr, "This is free software, "
+                  "subject to the terms of the GNU GPL license.\n\n");
+}
+
+void cwquery_print_help(void)
+{
+  fprintf(stderr, "\n\ncwquery lists the events each player took part in, reading only\n");
+  fprintf(stderr, "the games in which the index built by cwindex shows the player.\n");
+  fprintf(stderr, "Each record gives one event and the player's role in it.\n");
+  fprintf(stderr, "Usage: cwquery [options] -I indexfile playerid...\n");
+  fprintf(stderr, "options:\n");
+  fprintf(stderr, "  -h        print this help\n");
+  fprintf(stderr, "  -I file   read the index from file\n");
+  fprintf(stderr, "  -r roles  roles to report, from B (batting), P (pitching),\n");
+  fprintf(stderr, "              F (fielding) and R (running); default is BPFR\n");
+  fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n");
+  fprintf(stderr, "  -n        print field names in first row of output\n\n");
+
+  exit(0);
+}
+
+static void cwquery_parse_roles(char *text)
+{
+  char *c, *code;
+
+  roles = 0;
+  for (c = text; *c != '\0'; c++) {
+    code = strchr(role_codes, *c);
+    if (code == NULL) {
+      fprintf(stderr, "*** Invalid role list '%s'.\n", text);
+      exit(1);
+    }
+    roles |= 1 << (code - role_codes);
+  }
+}
+
+int cwquery_parse_command_line(int argc, char *argv[])
+{
+  int i;
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-h")) {
+      cwquery_print_welcome_message(argv[0]);
+      cwquery_print_help();
+    }
+    else if (!strcmp(argv[i], "-I")) {
+      if (++i < argc) {
+        strncpy(index_file, argv[i], sizeof(index_file) - 1);
+        index_file[sizeof(index_file) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-r")) {
+      if (++i < argc) {
+        cwquery_parse_roles(argv[i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-n")) {
+      print_header = 1;
+    }
+    else if (!strcmp(argv[i], "-Q")) {
+      quiet = 1;
+    }
+    else if (argv[i][0] == '-') {
+      fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
+      exit(1);
+    }
+    else {
+      break;
+    }
+  }
+
+  return i;
+}
+
+/* Whether the player has 'role' in the current event */
+static int cwquery_has_role(CWGameIterator *gameiter, char *player_id, int role)
+{
+  CWGameState *state = gameiter->state;
+  int fielding_team = 1 - state->batting_team, pos, base;
+
+  switch (role) {
+  case CW_INDEX_BATTING:
+    return !strcmp(gameiter->event->batter, player_id);
+  case CW_INDEX_PITCHING:
+    return (state->fielders[1][fielding_team] != NULL &&
+            !strcmp(state->fielders[1][fielding_team], player_id));
+  case CW_INDEX_FIELDING:
+    for (pos = 2; pos <= 9; pos++) {
+      if (state->fielders[pos][fielding_team] != NULL &&
+          !strcmp(state->fielders[pos][fielding_team], player_id)) {
+        return 1;
+      }
+    }
+    return 0;
+  case CW_INDEX_RUNNING:
+    for (base = 1; base <= 3; base++) {
+      if (!strcmp(state->runners[base].runner, player_id)) {
+        return 1;
+      }
+    }
+    return 0;
+  default:
+    return 0;
+  }
+}
+
+/*
+ * Write the events of 'game' from 'first_event' to 'last_event' in
+ * which the player has any of the roles 'game_roles'
+ */
+static void cwquery_write_game(CWGame *game, char *player_id, int game_roles, int first_event,
+                               int last_event)
+{
+  CWGameIterator *gameiter = cw_gameiter_create(game);
+  int event = 0, role;
+
+  for (; gameiter->event != NULL && event <= last_event; cw_gameiter_next(gameiter), event++) {
+    if (event < first_event || !strcmp(gameiter->event->event_text, "NP")) {
+      continue;
+    }
+    for (role = 0; role < CW_INDEX_ROLES; role++) {
+      if ((game_roles & (1 << role)) && cwquery_has_role(gameiter, player_id, 1 << role)) {
+        printf("\"%s\",\"%s\",%d,%d,%d,\"%c\",%d,\"%s\",\"%s\",\"%s\"\n", player_id,
+               game->game_id, event, gameiter->state->inning, gameiter->state->batting_team,
+               role_codes[role], gameiter->state->outs, gameiter->event->batter,
+               (gameiter->state->fielders[1][1 - gameiter->state->batting_team] != NULL)
+                 ? gameiter->state->fielders[1][1 - gameiter->state->batting_team]
+                 : "",
+               gameiter->event->event_text);
+      }
+    }
+  }
+
+  cw_gameiter_cleanup(gameiter);
+  cw_free(CW_ALLOC_GAMEITER, gameiter);
+}
+
+/*
+ * Write the events of the player in the roles selected.  A player's
+ * postings for one game are consecutive, so each game is read once.
+ */
+static void cwquery_write_player(CWPlayerIndex *index, char *player_id)
+{
+  CWIndexPlayer *player = cw_index_find_player(index, player_id);
+  int i = 0;
+
+  if (player == NULL) {
+    if (!quiet) {
+      fprintf(stderr, "Warning: player '%s' is not in the index\n", player_id);
+    }
+    return;
+  }
+
+  while (i < player->num_postings) {
+    int number = player->postings[i].game, game_roles = 0;
+    int first_event = -1, last_event = -1;
+    CWGame *game;
+
+    for (; i < player->num_postings && player->postings[i].game == number; i++) {
+      CWIndexPosting *posting = &player->postings[i];
+
+      if (!(roles & posting->role)) {
+        continue;
+      }
+      game_roles |= posting->role;
+      if (first_event < 0 || posting->first_event < first_event) {
+        first_event = posting->first_event;
+      }
+      if (posting->last_event > last_event) {
+        last_event = posting->last_event;
+      }
+    }
+    if (game_roles == 0) {
+      continue;
+    }
+
+    game = cw_index_read_game(index, number);
+    if (game == NULL) {
+      fprintf(stderr, "Warning: could not read game %d of the index\n", number);
+      continue;
+    }
+    cwquery_write_game(game, player_id, game_roles, first_event, last_event);
+    cw_game_cleanup(game);
+    cw_free(CW_ALLOC_GAME, game);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  CWPlayerIndex *index;
+  FILE *file;
+  int i;
+
+  i = cwquery_parse_command_line(argc, argv);
+  if (!quiet) {
+    cwquery_print_welcome_message(argv[0]);
+  }
+
+  if (!strcmp(index_file, "")) {
+    fprintf(stderr, "Error: no index file given (use -I)\n");
+    exit(1);
+  }
+  file = fopen(index_file, "r");
+  if (file == NULL) {
+    fprintf(stderr, "Error: could not open index file '%s'\n", index_file);
+    exit(1);
+  }
+  index = cw_index_create();
+  if (cw_index_read(index, file) < 0) {
+    fprintf(stderr, "Error: '%s' is not an index file\n", index_file);
+    exit(1);
+  }
+  fclose(file);
+
+  if (print_header) {
+    printf("\"PLAYER_ID\",\"GAME_ID\",\"EVENT_ID\",\"INN_CT\",\"BAT_HOME_ID\",\"ROLE_CD\","
+           "\"OUTS_CT\",\"BAT_ID\",\"PIT_ID\",\"EVENT_TX\"\n");
+  }
+  for (; i < argc; i++) {
+    cwquery_write_player(index, argv[i]);
+  }
+
+  cw_index_cleanup(index);
+  cw_free(CW_ALLOC_INDEX, index);
+
+  return 0;
+}
@@ -0,0 +1,221 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/cwremap.c
+ * Chadwick player ID remapper
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+
+/*
+ * Like cwcatalog, cwremap does not use the common driver in cwtools.c,
+ * since it rewrites event files rather than reporting on their games.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cwlib/chadwick.h"
+
+/* File of replacements, one "old_id,new_id" to a record (-m) */
+char map_file[1024] = "";
+
+/* Directory to write the rewritten files to (-o); empty to rewrite in place */
+char output_dir[1024] = "";
+
+/* If 'quiet', write no status messages to stderr (-Q) */
+int quiet = 0;
+
+void cwremap_print_welcome_message(char *argv0)
+{
+  fprintf(stderr, "\nChadwick player ID remapper, version " VERSION);
+  fprintf(stderr, "\n  Type '%s -h' for help.\n", argv0);
+  fprintf(
+    stderr,
+    "Copyright (c) 2002-2026\nDr T L Turocy, Chadwick Baseball Bureau (ted.turocy@gmail.com)\n");
+  fprintf(stderr, "This is free software, "
+                  "subject to the terms of the GNU GPL license.\n\n");
+}
+
+void cwremap_print_help(void)
+{
+  fprintf(stderr, "\n\ncwremap replaces player IDs in event files, as given by a map file\n");
+  fprintf(stderr, "of records 'old_id,new_id', and writes the files back out.\n");
+  fprintf(stderr, "Usage: cwremap -m mapfile [options] eventfile...\n");
+  fprintf(stderr, "options:\n");
+  fprintf(stderr, "  -h        print this help\n");
+  fprintf(stderr, "  -m file   read the replacements from file\n");
+  fprintf(stderr, "  -o dir    write the files to dir (default is to rewrite them in place)\n");
+  fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n\n");
+
+  exit(0);
+}
+
+int cwremap_parse_command_line(int argc, char *argv[])
+{
+  int i;
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-h")) {
+      cwremap_print_welcome_message(argv[0]);
+      cwremap_print_help();
+    }
+    else if (!strcmp(argv[i], "-m")) {
+      if (++i < argc) {
+        strncpy(map_file, argv[i], sizeof(map_file) - 1);
+        map_file[sizeof(map_file) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-o")) {
+      if (++i < argc) {
+        strncpy(output_dir, argv[i], sizeof(output_dir) - 1);
+        output_dir[sizeof(output_dir) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-Q")) {
+      quiet = 1;
+    }
+    else if (argv[i][0] == '-') {
+      fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
+      exit(1);
+    }
+    else {
+      break;
+    }
+  }
+
+  return i;
+}
+
+/*
+ * The name to write 'filename' to: in output_dir if set, or else a
+ * temporary name beside it, to be renamed over it once written.
+ * Result is malloc'd and must be freed by the caller.
+ */
+char *cwremap_output_filename(char *filename)
+{
+  char *base = strrchr(filename, '/');
+  size_t size;
+  char *path;
+
+  base = (base != NULL) ? base + 1 : filename;
+  size = strlen(output_dir) + strlen(filename) + sizeof("/.tmp");
+  path = (char *) malloc(size);
+  if (path == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for filename\n");
+    exit(1);
+  }
+  if (strcmp(output_dir, "") != 0) {
+    snprintf(path, size, "%s/%s", output_dir, base);
+  }
+  else {
+    snprintf(path, size, "%s.tmp", filename);
+  }
+  return path;
+}
+
+/*
+ * Replace the player IDs in the games of 'filename' and write it out.
+ * Returns the number of IDs replaced, or -1 if the file could not be
+ * read or written.
+ */
+int cwremap_process_file(CWPlayerMap *map, char *filename)
+{
+  CWScorebook *scorebook = cw_scorebook_create();
+  CWGame *game;
+  FILE *file = fopen(filename, "r");
+  char *output_filename;
+  int count = 0;
+
+  if (file == NULL || cw_scorebook_read(scorebook, file) < 0) {
+    fprintf(stderr, "Warning: could not open file '%s'\n", filename);
+    if (file != NULL) {
+      fclose(file);
+    }
+    cw_scorebook_cleanup(scorebook);
+    cw_free(CW_ALLOC_BOOK, scorebook);
+    return -1;
+  }
+  fclose(file);
+
+  for (game = scorebook->first_game; game != NULL; game = game->next) {
+    count += cw_game_remap_players(game, map);
+  }
+
+  output_filename = cwremap_output_filename(filename);
+  file = fopen(output_filename, "w");
+  if (file == NULL) {
+    fprintf(stderr, "Warning: could not open file '%s' for writing\n", output_filename);
+    count = -1;
+  }
+  else {
+    cw_scorebook_write(scorebook, file);
+    if (fclose(file) != 0 ||
+        (!strcmp(output_dir, "") && rename(output_filename, filename) != 0)) {
+      fprintf(stderr, "Warning: could not write file '%s'\n", filename);
+      remove(output_filename);
+      count = -1;
+    }
+  }
+
+  free(output_filename);
+  cw_scorebook_cleanup(scorebook);
+  cw_free(CW_ALLOC_BOOK, scorebook);
+  return count;
+}
+
+int main(int argc, char *argv[])
+{
+  CWPlayerMap *map;
+  FILE *file;
+  int i, count;
+
+  i = cwremap_parse_command_line(argc, argv);
+  if (!quiet) {
+    cwremap_print_welcome_message(argv[0]);
+  }
+
+  if (!strcmp(map_file, "")) {
+    fprintf(stderr, "Error: no map file given; use -m mapfile\n");
+    exit(1);
+  }
+  file = fopen(map_file, "r");
+  if (file == NULL) {
+    fprintf(stderr, "Can't find map file (%s)\n", map_file);
+    exit(1);
+  }
+  map = cw_player_map_create();
+  cw_player_map_read(map, file);
+  fclose(file);
+
+  for (; i < argc; i++) {
+    if (!quiet) {
+      fprintf(stderr, "[Processing file %s.]\n", argv[i]);
+    }
+    count = cwremap_process_file(map, argv[i]);
+    if (!quiet && count >= 0) {
+      fprintf(stderr, "  %d player IDs replaced\n", count);
+    }
+  }
+
+  cw_player_map_cleanup(map);
+  cw_free(CW_ALLOC_REMAP, map);
+
+  return 0;
+}
@@ -0,0 +1,840 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/cwseason.c
+ * Chadwick player season totals generator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cwlib/chadwick.h"
+#include "buffer.h"
+#include "pgcopy.h"
+
+/*************************************************************************
+ * Global variables for command-line options
+ *************************************************************************/
+
+extern int ascii;
+extern int pgcopy;
+extern int output_by_file;
+extern void *(*cwtools_create_partial)(void);
+extern void (*cwtools_process_game_partial)(void *, CWGame *, CWRoster *, CWRoster *);
+extern void (*cwtools_merge_partial)(void *);
+
+/* Fields to display (-f) */
+int fields[146] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                   1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                   1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                   1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                   1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                   1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+
+int max_field = 145;
+
+char program_name[20] = "cwseason";
+
+int print_header = 0;
+
+/* The totals, accumulated as games are read and written at the end */
+CWSeason *season = NULL;
+
+/* Auxiliary function: negative totals correspond to nulls, which should
+ * be rendered as blanks in output.
+ */
+int cwseason_print_integer_or_null(char *buffer, int value)
+{
+  if (value >= 0) {
+    return sprintf(buffer, "%d", value);
+  }
+  else {
+    return sprintf(buffer, "%s", "");
+  }
+}
+
+/*
+ * typedef to declare the pointer-to-function type
+ */
+typedef int (*field_func)(char *, CWSeasonPlayer *);
+
+/*
+ * convenient structure to hold all information relating to a field
+ * together in one place
+ */
+typedef struct field_struct {
+  field_func f;
+  char *header, *description;
+  CWFieldType type;
+} field_struct;
+
+/*
+ * preprocessor directive for conveniently declaring function signature
+ */
+
+#define DECLARE_FIELDFUNC(funcname) int funcname(char *buffer, CWSeasonPlayer *player)
+
+/* Field 0 */
+DECLARE_FIELDFUNC(cwseason_year)
+{
+  return sprintf(buffer, (ascii) ? "%d" : "%4d", player->year);
+}
+
+/* Field 1 */
+DECLARE_FIELDFUNC(cwseason_team_id)
+{
+  return sprintf(buffer, (ascii) ? "\"%s\"" : "%-3s", player->team_id);
+}
+
+/* Field 2 */
+DECLARE_FIELDFUNC(cwseason_player_id)
+{
+  return sprintf(buffer, (ascii) ? "\"%s\"" : "%-8s", player->player_id);
+}
+
+#define DECLARE_BATTING_TOTAL(funcname, cat)                                                      \
+  DECLARE_FIELDFUNC(funcname)                                                                     \
+  {                                                                                               \
+    return cwseason_print_integer_or_null(buffer, player->batting.cat);                           \
+  }
+
+DECLARE_FIELDFUNC(cwseason_B_TB)
+{
+  if (player->batting.h < 0 || player->batting.b2 < 0 || player->batting.b3 < 0 ||
+      player->batting.hr < 0) {
+    return cwseason_print_integer_or_null(buffer, -1);
+  }
+  return cwseason_print_integer_or_null(buffer, player->batting.h + player->batting.b2 +
+                                                  2 * player->batting.b3 +
+                                                  3 * player->batting.hr);
+}
+
+DECLARE_FIELDFUNC(cwseason_B_G_DH)
+{
+  return sprintf(buffer, "%d", player->g_dh);
+}
+
+DECLARE_FIELDFUNC(cwseason_B_G_PH)
+{
+  return sprintf(buffer, "%d", player->g_ph);
+}
+
+DECLARE_FIELDFUNC(cwseason_B_G_PR)
+{
+  return sprintf(buffer, "%d", player->g_pr);
+}
+
+#define DECLARE_PITCHING_TOTAL(funcname, cat)                                                     \
+  DECLARE_FIELDFUNC(funcname)                                                                     \
+  {                                                                                               \
+    return cwseason_print_integer_or_null(buffer, player->pitching.cat);                          \
+  }
+
+DECLARE_FIELDFUNC(cwseason_P_TB)
+{
+  if (player->pitching.h < 0 || player->pitching.b2 < 0 || player->pitching.b3 < 0 ||
+      player->pitching.hr < 0) {
+    return cwseason_print_integer_or_null(buffer, -1);
+  }
+  return cwseason_print_integer_or_null(buffer, player->pitching.h + player->pitching.b2 +
+                                                  2 * player->pitching.b3 +
+                                                  3 * player->pitching.hr);
+}
+
+#define DECLARE_FIELDING_TOTAL(funcname, pos, cat)                                                \
+  DECLARE_FIELDFUNC(funcname)                                                                     \
+  {                                                                                               \
+    return cwseason_print_integer_or_null(buffer, player->fielding[pos].cat);                     \
+  }
+
+#define DECLARE_FIELDING_STARTS(funcname, pos)                                                    \
+  DECLARE_FIELDFUNC(funcname)                                                                     \
+  {                                                                                               \
+    return sprintf(buffer, "%d", player->gs[pos]);                                                \
+  }
+
+#define DECLARE_FIELDING_TC(funcname, pos)                                                        \
+  DECLARE_FIELDFUNC(funcname)                                                                     \
+  {                                                                                               \
+    if ((player->fielding[pos].po < 0) || (player->fielding[pos].a < 0) ||                        \
+        (player->fielding[pos].e < 0)) {                                                          \
+      return cwseason_print_integer_or_null(buffer, -1);                                          \
+    }                                                                                             \
+    return cwseason_print_integer_or_null(buffer, player->fielding[pos].po +                      \
+                                                    player->fielding[pos].a +                     \
+                                                    player->fielding[pos].e);                     \
+  }
+
+DECLARE_BATTING_TOTAL(cwseason_B_G, g)
+DECLARE_BATTING_TOTAL(cwseason_B_PA, pa)
+DECLARE_BATTING_TOTAL(cwseason_B_AB, ab)
+DECLARE_BATTING_TOTAL(cwseason_B_R, r)
+DECLARE_BATTING_TOTAL(cwseason_B_H, h)
+DECLARE_BATTING_TOTAL(cwseason_B_2B, b2)
+DECLARE_BATTING_TOTAL(cwseason_B_3B, b3)
+DECLARE_BATTING_TOTAL(cwseason_B_HR, hr)
+DECLARE_BATTING_TOTAL(cwseason_B_HR4, hrslam)
+DECLARE_BATTING_TOTAL(cwseason_B_RBI, bi)
+DECLARE_BATTING_TOTAL(cwseason_B_GW, gw)
+DECLARE_BATTING_TOTAL(cwseason_B_BB, bb)
+DECLARE_BATTING_TOTAL(cwseason_B_IBB, ibb)
+DECLARE_BATTING_TOTAL(cwseason_B_SO, so)
+DECLARE_BATTING_TOTAL(cwseason_B_GDP, gdp)
+DECLARE_BATTING_TOTAL(cwseason_B_HP, hp)
+DECLARE_BATTING_TOTAL(cwseason_B_SH, sh)
+DECLARE_BATTING_TOTAL(cwseason_B_SF, sf)
+DECLARE_BATTING_TOTAL(cwseason_B_SB, sb)
+DECLARE_BATTING_TOTAL(cwseason_B_CS, cs)
+DECLARE_BATTING_TOTAL(cwseason_B_XI, xi)
+
+DECLARE_PITCHING_TOTAL(cwseason_P_G, g)
+DECLARE_PITCHING_TOTAL(cwseason_P_GS, gs)
+DECLARE_PITCHING_TOTAL(cwseason_P_CG, cg)
+DECLARE_PITCHING_TOTAL(cwseason_P_SHO, sho)
+DECLARE_PITCHING_TOTAL(cwseason_P_GF, gf)
+DECLARE_PITCHING_TOTAL(cwseason_P_W, w)
+DECLARE_PITCHING_TOTAL(cwseason_P_L, l)
+DECLARE_PITCHING_TOTAL(cwseason_P_SV, sv)
+DECLARE_PITCHING_TOTAL(cwseason_P_OUT, outs)
+DECLARE_PITCHING_TOTAL(cwseason_P_TBF, bf)
+DECLARE_PITCHING_TOTAL(cwseason_P_AB, ab)
+DECLARE_PITCHING_TOTAL(cwseason_P_R, r)
+DECLARE_PITCHING_TOTAL(cwseason_P_ER, er)
+DECLARE_PITCHING_TOTAL(cwseason_P_H, h)
+DECLARE_PITCHING_TOTAL(cwseason_P_2B, b2)
+DECLARE_PITCHING_TOTAL(cwseason_P_3B, b3)
+DECLARE_PITCHING_TOTAL(cwseason_P_HR, hr)
+DECLARE_PITCHING_TOTAL(cwseason_P_HR4, hrslam)
+DECLARE_PITCHING_TOTAL(cwseason_P_BB, bb)
+DECLARE_PITCHING_TOTAL(cwseason_P_IBB, ibb)
+DECLARE_PITCHING_TOTAL(cwseason_P_SO, so)
+DECLARE_PITCHING_TOTAL(cwseason_P_GDP, gdp)
+DECLARE_PITCHING_TOTAL(cwseason_P_HP, hb)
+DECLARE_PITCHING_TOTAL(cwseason_P_SH, sh)
+DECLARE_PITCHING_TOTAL(cwseason_P_SF, sf)
+DECLARE_PITCHING_TOTAL(cwseason_P_XI, xi)
+DECLARE_PITCHING_TOTAL(cwseason_P_WP, wp)
+DECLARE_PITCHING_TOTAL(cwseason_P_BK, bk)
+DECLARE_PITCHING_TOTAL(cwseason_P_IR, inr)
+DECLARE_PITCHING_TOTAL(cwseason_P_IRS, inrs)
+DECLARE_PITCHING_TOTAL(cwseason_P_GO, gb)
+DECLARE_PITCHING_TOTAL(cwseason_P_AO, fb)
+DECLARE_PITCHING_TOTAL(cwseason_P_PITCH, pitches)
+DECLARE_PITCHING_TOTAL(cwseason_P_STRIKE, strikes)
+
+/* As in cwdaily, a pitcher has a game at P even if no out was recorded */
+DECLARE_FIELDFUNC(cwseason_F_P_G)
+{
+  return sprintf(buffer, "%d", player->g_p);
+}
+
+DECLARE_FIELDING_STARTS(cwseason_F_P_GS, 1)
+DECLARE_FIELDING_TOTAL(cwseason_F_P_OUT, 1, outs)
+DECLARE_FIELDING_TC(cwseason_F_P_TC, 1)
+DECLARE_FIELDING_TOTAL(cwseason_F_P_PO, 1, po)
+DECLARE_FIELDING_TOTAL(cwseason_F_P_A, 1, a)
+DECLARE_FIELDING_TOTAL(cwseason_F_P_E, 1, e)
+DECLARE_FIELDING_TOTAL(cwseason_F_P_DP, 1, dp)
+DECLARE_FIELDING_TOTAL(cwseason_F_P_TP, 1, tp)
+
+DECLARE_FIELDING_TOTAL(cwseason_F_C_G, 2, g)
+DECLARE_FIELDING_STARTS(cwseason_F_C_GS, 2)
+DECLARE_FIELDING_TOTAL(cwseason_F_C_OUT, 2, outs)
+DECLARE_FIELDING_TC(cwseason_F_C_TC, 2)
+DECLARE_FIELDING_TOTAL(cwseason_F_C_PO, 2, po)
+DECLARE_FIELDING_TOTAL(cwseason_F_C_A, 2, a)
+DECLARE_FIELDING_TOTAL(cwseason_F_C_E, 2, e)
+DECLARE_FIELDING_TOTAL(cwseason_F_C_DP, 2, dp)
+DECLARE_FIELDING_TOTAL(cwseason_F_C_TP, 2, tp)
+DECLARE_FIELDING_TOTAL(cwseason_F_C_PB, 2, pb)
+DECLARE_FIELDING_TOTAL(cwseason_F_C_XI, 2, xi)
+
+DECLARE_FIELDING_TOTAL(cwseason_F_1B_G, 3, g)
+DECLARE_FIELDING_STARTS(cwseason_F_1B_GS, 3)
+DECLARE_FIELDING_TOTAL(cwseason_F_1B_OUT, 3, outs)
+DECLARE_FIELDING_TC(cwseason_F_1B_TC, 3)
+DECLARE_FIELDING_TOTAL(cwseason_F_1B_PO, 3, po)
+DECLARE_FIELDING_TOTAL(cwseason_F_1B_A, 3, a)
+DECLARE_FIELDING_TOTAL(cwseason_F_1B_E, 3, e)
+DECLARE_FIELDING_TOTAL(cwseason_F_1B_DP, 3, dp)
+DECLARE_FIELDING_TOTAL(cwseason_F_1B_TP, 3, tp)
+
+DECLARE_FIELDING_TOTAL(cwseason_F_2B_G, 4, g)
+DECLARE_FIELDING_STARTS(cwseason_F_2B_GS, 4)
+DECLARE_FIELDING_TOTAL(cwseason_F_2B_OUT, 4, outs)
+DECLARE_FIELDING_TC(cwseason_F_2B_TC, 4)
+DECLARE_FIELDING_TOTAL(cwseason_F_2B_PO, 4, po)
+DECLARE_FIELDING_TOTAL(cwseason_F_2B_A, 4, a)
+DECLARE_FIELDING_TOTAL(cwseason_F_2B_E, 4, e)
+DECLARE_FIELDING_TOTAL(cwseason_F_2B_DP, 4, dp)
+DECLARE_FIELDING_TOTAL(cwseason_F_2B_TP, 4, tp)
+
+DECLARE_FIELDING_TOTAL(cwseason_F_3B_G, 5, g)
+DECLARE_FIELDING_STARTS(cwseason_F_3B_GS, 5)
+DECLARE_FIELDING_TOTAL(cwseason_F_3B_OUT, 5, outs)
+DECLARE_FIELDING_TC(cwseason_F_3B_TC, 5)
+DECLARE_FIELDING_TOTAL(cwseason_F_3B_PO, 5, po)
+DECLARE_FIELDING_TOTAL(cwseason_F_3B_A, 5, a)
+DECLARE_FIELDING_TOTAL(cwseason_F_3B_E, 5, e)
+DECLARE_FIELDING_TOTAL(cwseason_F_3B_DP, 5, dp)
+DECLARE_FIELDING_TOTAL(cwseason_F_3B_TP, 5, tp)
+
+DECLARE_FIELDING_TOTAL(cwseason_F_SS_G, 6, g)
+DECLARE_FIELDING_STARTS(cwseason_F_SS_GS, 6)
+DECLARE_FIELDING_TOTAL(cwseason_F_SS_OUT, 6, outs)
+DECLARE_FIELDING_TC(cwseason_F_SS_TC, 6)
+DECLARE_FIELDING_TOTAL(cwseason_F_SS_PO, 6, po)
+DECLARE_FIELDING_TOTAL(cwseason_F_SS_A, 6, a)
+DECLARE_FIELDING_TOTAL(cwseason_F_SS_E, 6, e)
+DECLARE_FIELDING_TOTAL(cwseason_F_SS_DP, 6, dp)
+DECLARE_FIELDING_TOTAL(cwseason_F_SS_TP, 6, tp)
+
+DECLARE_FIELDING_TOTAL(cwseason_F_LF_G, 7, g)
+DECLARE_FIELDING_STARTS(cwseason_F_LF_GS, 7)
+DECLARE_FIELDING_TOTAL(cwseason_F_LF_OUT, 7, outs)
+DECLARE_FIELDING_TC(cwseason_F_LF_TC, 7)
+DECLARE_FIELDING_TOTAL(cwseason_F_LF_PO, 7, po)
+DECLARE_FIELDING_TOTAL(cwseason_F_LF_A, 7, a)
+DECLARE_FIELDING_TOTAL(cwseason_F_LF_E, 7, e)
+DECLARE_FIELDING_TOTAL(cwseason_F_LF_DP, 7, dp)
+DECLARE_FIELDING_TOTAL(cwseason_F_LF_TP, 7, tp)
+
+DECLARE_FIELDING_TOTAL(cwseason_F_CF_G, 8, g)
+DECLARE_FIELDING_STARTS(cwseason_F_CF_GS, 8)
+DECLARE_FIELDING_TOTAL(cwseason_F_CF_OUT, 8, outs)
+DECLARE_FIELDING_TC(cwseason_F_CF_TC, 8)
+DECLARE_FIELDING_TOTAL(cwseason_F_CF_PO, 8, po)
+DECLARE_FIELDING_TOTAL(cwseason_F_CF_A, 8, a)
+DECLARE_FIELDING_TOTAL(cwseason_F_CF_E, 8, e)
+DECLARE_FIELDING_TOTAL(cwseason_F_CF_DP, 8, dp)
+DECLARE_FIELDING_TOTAL(cwseason_F_CF_TP, 8, tp)
+
+DECLARE_FIELDING_TOTAL(cwseason_F_RF_G, 9, g)
+DECLARE_FIELDING_STARTS(cwseason_F_RF_GS, 9)
+DECLARE_FIELDING_TOTAL(cwseason_F_RF_OUT, 9, outs)
+DECLARE_FIELDING_TC(cwseason_F_RF_TC, 9)
+DECLARE_FIELDING_TOTAL(cwseason_F_RF_PO, 9, po)
+DECLARE_FIELDING_TOTAL(cwseason_F_RF_A, 9, a)
+DECLARE_FIELDING_TOTAL(cwseason_F_RF_E, 9, e)
+DECLARE_FIELDING_TOTAL(cwseason_F_RF_DP, 9, dp)
+DECLARE_FIELDING_TOTAL(cwseason_F_RF_TP, 9, tp)
+
+static field_struct field_data[] = {
+  /*  0 */ {cwseason_year, "YEAR_ID", "year", CW_FIELD_INT16},
+  /*  1 */ {cwseason_team_id, "TEAM_ID", "team id", CW_FIELD_ID},
+  /*  2 */ {cwseason_player_id, "PLAYER_ID", "player id", CW_FIELD_ID},
+  {cwseason_B_G, "B_G", "B_G: games played", CW_FIELD_INT16},
+  {cwseason_B_PA, "B_PA", "B_PA: plate appearances", CW_FIELD_INT16},
+  {cwseason_B_AB, "B_AB", "B_AB: at bats", CW_FIELD_INT16},
+  {cwseason_B_R, "B_R", "B_R: runs", CW_FIELD_INT16},
+  {cwseason_B_H, "B_H", "B_H: hits", CW_FIELD_INT16},
+  {cwseason_B_TB, "B_TB", "B_TB: total bases", CW_FIELD_INT16},
+  {cwseason_B_2B, "B_2B", "B_2B: doubles", CW_FIELD_INT16},
+  {cwseason_B_3B, "B_3B", "B_3B: triples", CW_FIELD_INT16},
+  {cwseason_B_HR, "B_HR", "B_HR: home runs", CW_FIELD_INT16},
+  {cwseason_B_HR4, "B_HR4", "B_HR4: grand slams", CW_FIELD_INT16},
+  {cwseason_B_RBI, "B_RBI", "B_RBI: runs batted in", CW_FIELD_INT16},
+  {cwseason_B_GW, "B_GW", "B_GW: game winning RBI", CW_FIELD_INT16},
+  {cwseason_B_BB, "B_BB", "B_BB: walks", CW_FIELD_INT16},
+  {cwseason_B_IBB, "B_IBB", "B_IBB: intentional walks", CW_FIELD_INT16},
+  {cwseason_B_SO, "B_SO", "B_SO: strikeouts", CW_FIELD_INT16},
+  {cwseason_B_GDP, "B_GDP", "B_GDP: grounded into DP", CW_FIELD_INT16},
+  {cwseason_B_HP, "B_HP", "B_HP: hit by pitch", CW_FIELD_INT16},
+  {cwseason_B_SH, "B_SH", "B_SH: sacrifice hits", CW_FIELD_INT16},
+  {cwseason_B_SF, "B_SF", "B_SF: sacrifice flies", CW_FIELD_INT16},
+  {cwseason_B_SB, "B_SB", "B_SB: stolen bases", CW_FIELD_INT16},
+  {cwseason_B_CS, "B_CS", "B_CS: caught stealing", CW_FIELD_INT16},
+  {cwseason_B_XI, "B_XI", "B_XI: reached on interference", CW_FIELD_INT16},
+  {cwseason_B_G_DH, "B_G_DH", "B_G_DH: games as DH", CW_FIELD_INT16},
+  {cwseason_B_G_PH, "B_G_PH", "B_G_PH: games as PH", CW_FIELD_INT16},
+  {cwseason_B_G_PR, "B_G_PR", "B_G_PR: games as PR", CW_FIELD_INT16},
+  {cwseason_P_G, "P_G", "P_G: games pitched", CW_FIELD_INT16},
+  {cwseason_P_GS, "P_GS", "P_GS: games started", CW_FIELD_INT16},
+  {cwseason_P_CG, "P_CG", "P_CG: complete games", CW_FIELD_INT16},
+  {cwseason_P_SHO, "P_SHO", "P_SHO: shutouts", CW_FIELD_INT16},
+  {cwseason_P_GF, "P_GF", "P_GF: games finished", CW_FIELD_INT16},
+  {cwseason_P_W, "P_W", "P_W: wins", CW_FIELD_INT16},
+  {cwseason_P_L, "P_L", "P_L: losses", CW_FIELD_INT16},
+  {cwseason_P_SV, "P_SV", "P_SV: saves", CW_FIELD_INT16},
+  {cwseason_P_OUT, "P_OUT", "P_OUT: outs recorded (innings pitched times 3)", CW_FIELD_INT16},
+  {cwseason_P_TBF, "P_TBF", "P_TBF: batters faced", CW_FIELD_INT16},
+  {cwseason_P_AB, "P_AB", "P_AB: at bats", CW_FIELD_INT16},
+  {cwseason_P_R, "P_R", "P_R: runs allowed", CW_FIELD_INT16},
+  {cwseason_P_ER, "P_ER", "P_ER: earned runs allowed", CW_FIELD_INT16},
+  {cwseason_P_H, "P_H", "P_H: hits allowed", CW_FIELD_INT16},
+  {cwseason_P_TB, "P_TB", "P_TB: total bases allowed", CW_FIELD_INT16},
+  {cwseason_P_2B, "P_2B", "P_2B: doubles allowed", CW_FIELD_INT16},
+  {cwseason_P_3B, "P_3B", "P_3B: triples allowed", CW_FIELD_INT16},
+  {cwseason_P_HR, "P_HR", "P_HR: home runs allowed", CW_FIELD_INT16},
+  {cwseason_P_HR4, "P_HR4", "P_HR4: grand slams allowed", CW_FIELD_INT16},
+  {cwseason_P_BB, "P_BB", "P_BB: walks allowed", CW_FIELD_INT16},
+  {cwseason_P_IBB, "P_IBB", "P_IBB: intentional walks allowed", CW_FIELD_INT16},
+  {cwseason_P_SO, "P_SO", "P_SO: strikeouts", CW_FIELD_INT16},
+  {cwseason_P_GDP, "P_GDP", "P_GDP: grounded into double play", CW_FIELD_INT16},
+  {cwseason_P_HP, "P_HP", "P_HP: hit batsmen", CW_FIELD_INT16},
+  {cwseason_P_SH, "P_SH", "P_SH: sacrifice hits against", CW_FIELD_INT16},
+  {cwseason_P_SF, "P_SF", "P_SF: sacrifice flies against", CW_FIELD_INT16},
+  {cwseason_P_XI, "P_XI", "P_XI: reached on interference", CW_FIELD_INT16},
+  {cwseason_P_WP, "P_WP", "P_WP: wild pitches", CW_FIELD_INT16},
+  {cwseason_P_BK, "P_BK", "P_BK: balks", CW_FIELD_INT16},
+  {cwseason_P_IR, "P_IR", "P_IR: inherited runners", CW_FIELD_INT16},
+  {cwseason_P_IRS, "P_IRS", "P_IRS: inherited runners scored", CW_FIELD_INT16},
+  {cwseason_P_GO, "P_GO", "P_GO: ground outs", CW_FIELD_INT16},
+  {cwseason_P_AO, "P_AO", "P_AO: air outs", CW_FIELD_INT16},
+  {cwseason_P_PITCH, "P_PITCH", "P_PITCH: pitches", CW_FIELD_INT16},
+  {cwseason_P_STRIKE, "P_STRIKE", "P_STRIKE: strikes", CW_FIELD_INT16},
+  {cwseason_F_P_G, "F_P_G", "F_P_G: games at P", CW_FIELD_INT16},
+  {cwseason_F_P_GS, "F_P_GS", "F_P_GS: games started at P", CW_FIELD_INT16},
+  {cwseason_F_P_OUT, "F_P_OUT",
+   "F_P_OUT: outs recorded at P (innings fielded times 3)", CW_FIELD_INT16},
+  {cwseason_F_P_TC, "F_P_TC", "F_P_TC: total chances at P", CW_FIELD_INT16},
+  {cwseason_F_P_PO, "F_P_PO", "F_P_PO: putouts at P", CW_FIELD_INT16},
+  {cwseason_F_P_A, "F_P_A", "F_P_A: assists at P", CW_FIELD_INT16},
+  {cwseason_F_P_E, "F_P_E", "F_P_E: errors at P", CW_FIELD_INT16},
+  {cwseason_F_P_DP, "F_P_DP", "F_P_DP: double plays at P", CW_FIELD_INT16},
+  {cwseason_F_P_TP, "F_P_TP", "F_P_TP: triple plays at P", CW_FIELD_INT16},
+  {cwseason_F_C_G, "F_C_G", "F_C_G: games at C", CW_FIELD_INT16},
+  {cwseason_F_C_GS, "F_C_GS", "F_C_GS: games started at C", CW_FIELD_INT16},
+  {cwseason_F_C_OUT, "F_C_OUT",
+   "F_C_OUT: outs recorded at C (innings fielded times 3)", CW_FIELD_INT16},
+  {cwseason_F_C_TC, "F_C_TC", "F_C_TC: total chances at C", CW_FIELD_INT16},
+  {cwseason_F_C_PO, "F_C_PO", "F_C_PO: putouts at C", CW_FIELD_INT16},
+  {cwseason_F_C_A, "F_C_A", "F_C_A: assists at C", CW_FIELD_INT16},
+  {cwseason_F_C_E, "F_C_E", "F_C_E: errors at C", CW_FIELD_INT16},
+  {cwseason_F_C_DP, "F_C_DP", "F_C_DP: double plays at C", CW_FIELD_INT16},
+  {cwseason_F_C_TP, "F_C_TP", "F_C_TP: triple plays at C", CW_FIELD_INT16},
+  {cwseason_F_C_PB, "F_C_PB", "F_C_PB: passed balls at C", CW_FIELD_INT16},
+  {cwseason_F_C_XI, "F_C_XI", "F_C_XI: catcher's interference at C", CW_FIELD_INT16},
+  {cwseason_F_1B_G, "F_1B_G", "F_1B_G: games at 1B", CW_FIELD_INT16},
+  {cwseason_F_1B_GS, "F_1B_GS", "F_1B_GS: games started at 1B", CW_FIELD_INT16},
+  {cwseason_F_1B_OUT, "F_1B_OUT",
+   "F_1B_OUT: outs recorded at 1B (innings fielded times 3)", CW_FIELD_INT16},
+  {cwseason_F_1B_TC, "F_1B_TC", "F_1B_TC: total chances at 1B", CW_FIELD_INT16},
+  {cwseason_F_1B_PO, "F_1B_PO", "F_1B_PO: putouts at 1B", CW_FIELD_INT16},
+  {cwseason_F_1B_A, "F_1B_A", "F_1B_A: assists at 1B", CW_FIELD_INT16},
+  {cwseason_F_1B_E, "F_1B_E", "F_1B_E: errors at 1B", CW_FIELD_INT16},
+  {cwseason_F_1B_DP, "F_1B_DP", "F_1B_DP: double plays at 1B", CW_FIELD_INT16},
+  {cwseason_F_1B_TP, "F_1B_TP", "F_1B_TP: triple plays at 1B", CW_FIELD_INT16},
+  {cwseason_F_2B_G, "F_2B_G", "F_2B_G: games at 2B", CW_FIELD_INT16},
+  {cwseason_F_2B_GS, "F_2B_GS", "F_2B_GS: games started at 2B", CW_FIELD_INT16},
+  {cwseason_F_2B_OUT, "F_2B_OUT",
+   "F_2B_OUT: outs recorded at 2B (innings fielded times 3)", CW_FIELD_INT16},
+  {cwseason_F_2B_TC, "F_2B_TC", "F_2B_TC: total chances at 2B", CW_FIELD_INT16},
+  {cwseason_F_2B_PO, "F_2B_PO", "F_2B_PO: putouts at 2B", CW_FIELD_INT16},
+  {cwseason_F_2B_A, "F_2B_A", "F_2B_A: assists at 2B", CW_FIELD_INT16},
+  {cwseason_F_2B_E, "F_2B_E", "F_2B_E: errors at 2B", CW_FIELD_INT16},
+  {cwseason_F_2B_DP, "F_2B_DP", "F_2B_DP: double plays at 2B", CW_FIELD_INT16},
+  {cwseason_F_2B_TP, "F_2B_TP", "F_2B_TP: triple plays at 2B", CW_FIELD_INT16},
+  {cwseason_F_3B_G, "F_3B_G", "F_3B_G: games at 3B", CW_FIELD_INT16},
+  {cwseason_F_3B_GS, "F_3B_GS", "F_3B_GS: games started at 3B", CW_FIELD_INT16},
+  {cwseason_F_3B_OUT, "F_3B_OUT",
+   "F_3B_OUT: outs recorded at 3B (innings fielded times 3)", CW_FIELD_INT16},
+  {cwseason_F_3B_TC, "F_3B_TC", "F_3B_TC: total chances at 3B", CW_FIELD_INT16},
+  {cwseason_F_3B_PO, "F_3B_PO", "F_3B_PO: putouts at 3B", CW_FIELD_INT16},
+  {cwseason_F_3B_A, "F_3B_A", "F_3B_A: assists at 3B", CW_FIELD_INT16},
+  {cwseason_F_3B_E, "F_3B_E", "F_3B_E: errors at 3B", CW_FIELD_INT16},
+  {cwseason_F_3B_DP, "F_3B_DP", "F_3B_DP: double plays at 3B", CW_FIELD_INT16},
+  {cwseason_F_3B_TP, "F_3B_TP", "F_3B_TP: triple plays at 3B", CW_FIELD_INT16},
+  {cwseason_F_SS_G, "F_SS_G", "F_SS_G: games at SS", CW_FIELD_INT16},
+  {cwseason_F_SS_GS, "F_SS_GS", "F_SS_GS: games started at SS", CW_FIELD_INT16},
+  {cwseason_F_SS_OUT, "F_SS_OUT",
+   "F_SS_OUT: outs recorded at SS (innings fielded times 3)", CW_FIELD_INT16},
+  {cwseason_F_SS_TC, "F_SS_TC", "F_SS_TC: total chances at SS", CW_FIELD_INT16},
+  {cwseason_F_SS_PO, "F_SS_PO", "F_SS_PO: putouts at SS", CW_FIELD_INT16},
+  {cwseason_F_SS_A, "F_SS_A", "F_SS_A: assists at SS", CW_FIELD_INT16},
+  {cwseason_F_SS_E, "F_SS_E", "F_SS_E: errors at SS", CW_FIELD_INT16},
+  {cwseason_F_SS_DP, "F_SS_DP", "F_SS_DP: double plays at SS", CW_FIELD_INT16},
+  {cwseason_F_SS_TP, "F_SS_TP", "F_SS_TP: triple plays at SS", CW_FIELD_INT16},
+  {cwseason_F_LF_G, "F_LF_G", "F_LF_G: games at LF", CW_FIELD_INT16},
+  {cwseason_F_LF_GS, "F_LF_GS", "F_LF_GS: games started at LF", CW_FIELD_INT16},
+  {cwseason_F_LF_OUT, "F_LF_OUT",
+   "F_LF_OUT: outs recorded at LF (innings fielded times 3)", CW_FIELD_INT16},
+  {cwseason_F_LF_TC, "F_LF_TC", "F_LF_TC: total chances at LF", CW_FIELD_INT16},
+  {cwseason_F_LF_PO, "F_LF_PO", "F_LF_PO: putouts at LF", CW_FIELD_INT16},
+  {cwseason_F_LF_A, "F_LF_A", "F_LF_A: assists at LF", CW_FIELD_INT16},
+  {cwseason_F_LF_E, "F_LF_E", "F_LF_E: errors at LF", CW_FIELD_INT16},
+  {cwseason_F_LF_DP, "F_LF_DP", "F_LF_DP: double plays at LF", CW_FIELD_INT16},
+  {cwseason_F_LF_TP, "F_LF_TP", "F_LF_TP: triple plays at LF", CW_FIELD_INT16},
+  {cwseason_F_CF_G, "F_CF_G", "F_CF_G: games at CF", CW_FIELD_INT16},
+  {cwseason_F_CF_GS, "F_CF_GS", "F_CF_GS: games started at CF", CW_FIELD_INT16},
+  {cwseason_F_CF_OUT, "F_CF_OUT",
+   "F_CF_OUT: outs recorded at CF (innings fielded times 3)", CW_FIELD_INT16},
+  {cwseason_F_CF_TC, "F_CF_TC", "F_CF_TC: total chances at CF", CW_FIELD_INT16},
+  {cwseason_F_CF_PO, "F_CF_PO", "F_CF_PO: putouts at CF", CW_FIELD_INT16},
+  {cwseason_F_CF_A, "F_CF_A", "F_CF_A: assists at CF", CW_FIELD_INT16},
+  {cwseason_F_CF_E, "F_CF_E", "F_CF_E: errors at CF", CW_FIELD_INT16},
+  {cwseason_F_CF_DP, "F_CF_DP", "F_CF_DP: double plays at CF", CW_FIELD_INT16},
+  {cwseason_F_CF_TP, "F_CF_TP", "F_CF_TP: triple plays at CF", CW_FIELD_INT16},
+  {cwseason_F_RF_G, "F_RF_G", "F_RF_G: games at RF", CW_FIELD_INT16},
+  {cwseason_F_RF_GS, "F_RF_GS", "F_RF_GS: games started at RF", CW_FIELD_INT16},
+  {cwseason_F_RF_OUT, "F_RF_OUT",
+   "F_RF_OUT: outs recorded at RF (innings fielded times 3)", CW_FIELD_INT16},
+  {cwseason_F_RF_TC, "F_RF_TC", "F_RF_TC: total chances at RF", CW_FIELD_INT16},
+  {cwseason_F_RF_PO, "F_RF_PO", "F_RF_PO: putouts at RF", CW_FIELD_INT16},
+  {cwseason_F_RF_A, "F_RF_A", "F_RF_A: assists at RF", CW_FIELD_INT16},
+  {cwseason_F_RF_E, "F_RF_E", "F_RF_E: errors at RF", CW_FIELD_INT16},
+  {cwseason_F_RF_DP, "F_RF_DP", "F_RF_DP: double plays at RF", CW_FIELD_INT16},
+  {cwseason_F_RF_TP, "F_RF_TP", "F_RF_TP: triple plays at RF", CW_FIELD_INT16}};
+
+/*
+ * For PostgreSQL binary COPY output, fields are separated by a null
+ * character instead of a comma, and the start of each is recorded here.
+ */
+static char *column_values[sizeof(field_data) / sizeof(field_data[0])];
+static CWFieldType column_types[sizeof(field_data) / sizeof(field_data[0])];
+
+/* One boxscore is rebuilt for each game, so its memory is reused */
+static CWBoxscore *game_box = NULL;
+
+/* Add 'game' to 'totals', rebuilding '*box' for it */
+static void cwseason_add_game(CWSeason *totals, CWBoxscore **box, CWGame *game)
+{
+  if (*box == NULL) {
+    *box = cw_box_create(game);
+  }
+  else {
+    cw_box_rebuild(*box, game);
+  }
+  cw_season_add_boxscore(totals, game, *box);
+}
+
+void cwseason_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
+{
+  cwseason_add_game(season, &game_box, game);
+}
+
+void (*cwtools_process_game)(CWGame *, CWRoster *, CWRoster *) = cwseason_process_game;
+
+/* The totals for one file, when files are processed on several threads */
+typedef struct cwseason_partial_struct {
+  CWSeason *season;
+  CWBoxscore *box;
+} CWSeasonPartial;
+
+static void *cwseason_create_partial(void)
+{
+  CWSeasonPartial *partial = (CWSeasonPartial *) calloc(1, sizeof(CWSeasonPartial));
+
+  if (partial != NULL && (partial->season = cw_season_create()) == NULL) {
+    free(partial);
+    return NULL;
+  }
+  return partial;
+}
+
+static void cwseason_process_game_partial(void *partial, CWGame *game, CWRoster *visitors,
+                                          CWRoster *home)
+{
+  CWSeasonPartial *totals = (CWSeasonPartial *) partial;
+
+  cwseason_add_game(totals->season, &totals->box, game);
+}
+
+static void cwseason_merge_partial(void *partial)
+{
+  CWSeasonPartial *totals = (CWSeasonPartial *) partial;
+
+  cw_season_merge(season, totals->season);
+  cw_season_cleanup(totals->season);
+  cw_free(CW_ALLOC_SEASON, totals->season);
+  if (totals->box != NULL) {
+    cw_box_cleanup(totals->box);
+    cw_free(CW_ALLOC_BOX, totals->box);
+  }
+  free(totals);
+}
+
+void cwseason_print_help(void)
+{
+  fprintf(stderr,
+          "\n\ncwseason generates files suitable for use by dBase or Lotus-like programs\n");
+  fprintf(stderr, "Each record gives one player's season totals for one team.\n");
+  fprintf(stderr, "Usage: cwseason [options] eventfile...\n");
+  fprintf(stderr, "options:\n");
+  fprintf(stderr, "  -h        print this help\n");
+  fprintf(stderr, "  -i id     only process game given by id\n");
+  fprintf(stderr, "  -y year   Year to process (for teamyyyy and aaayyyy.ros).\n");
+  fprintf(stderr,
+          "  -D dir    Directory to find team and roster files (default is current directory)\n");
+  fprintf(stderr, "  -C file   Catalog of games (from cwcatalog), to read only selected games\n");
+  fprintf(stderr, "  -s start  Earliest date to process (mmdd).\n");
+  fprintf(stderr, "  -e end    Last date to process (mmdd).\n");
+  fprintf(stderr, "  -a        generate Ascii-delimited format files (default)\n");
+  fprintf(stderr, "  -ft       generate Fortran format files\n");
+  fprintf(stderr, "  -fp       generate PostgreSQL binary COPY format\n");
+  fprintf(stderr, "  -f flist  give list of fields to output\n");
+  fprintf(stderr, "              Default is 0-145\n");
+  fprintf(stderr, "  -d        print list of field numbers and descriptions\n");
+  fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n");
+  fprintf(stderr, "  --team=list  only process games of the teams listed (IDs separated\n");
+  fprintf(stderr, "            by commas)\n");
+  fprintf(stderr, "  --park=list  only process games at the parks listed\n");
+  fprintf(stderr, "  --stats[=file]  report counts and phase timings at exit,\n");
+  fprintf(stderr, "            to stderr, or as JSON to file\n");
+  fprintf(stderr, "  --serve=socket  read the games once, and answer requests\n");
+  fprintf(stderr, "            for them on a Unix-domain socket\n");
+  fprintf(stderr, "  --threads=n  process the files on n threads at once\n");
+  fprintf(stderr, "  -n        print field names in first row of output\n\n");
+
+  exit(0);
+}
+
+void (*cwtools_print_help)(void) = cwseason_print_help;
+
+void cwseason_print_field_list(void)
+{
+  int i;
+
+  fprintf(stderr, "\nThese are the available fields and the numbers to use with the -f option\n");
+  fprintf(stderr, "to name them.  All are included by default.\n");
+  fprintf(stderr, "\n");
+  fprintf(stderr, "number  field\n");
+  fprintf(stderr, "------  -----\n");
+  for (i = 0; i <= max_field; i++) {
+    fprintf(stderr, "%-3d     %s\n", i, field_data[i].description);
+  }
+  fprintf(stderr, "\n");
+
+  exit(0);
+}
+
+void (*cwtools_print_field_list)(void) = cwseason_print_field_list;
+
+void cwseason_print_welcome_message(char *argv0)
+{
+  fprintf(stderr, "\nChadwick player season totals generator, version " VERSION);
+  fprintf(stderr, "\n  Type '%s -h' for help.\n", argv0);
+  fprintf(
+    stderr,
+    "Copyright (c) 2002-2026\nDr T L Turocy, Chadwick Baseball Bureau (ted.turocy@gmail.com)\n");
+  fprintf(stderr, "This is free software, "
+                  "subject to the terms of the GNU GPL license.\n\n");
+}
+
+void (*cwtools_print_welcome_message)(char *) = cwseason_print_welcome_message;
+
+void cwseason_initialize(void)
+{
+  int i, comma = 0, column = 0;
+  char output_line[4096];
+  char *buf;
+
+  season = cw_season_create();
+  /* Totals are written at the end, over all the files */
+  output_by_file = 0;
+  cwtools_create_partial = cwseason_create_partial;
+  cwtools_process_game_partial = cwseason_process_game_partial;
+  cwtools_merge_partial = cwseason_merge_partial;
+
+  for (i = 0; i <= max_field; i++) {
+    if (fields[i]) {
+      column_types[column++] = field_data[i].type;
+    }
+  }
+
+  if (!ascii || pgcopy || !print_header) {
+    return;
+  }
+
+  strcpy(output_line, "");
+  buf = output_line;
+
+  for (i = 0; i <= max_field; i++) {
+    if (fields[i]) {
+      if (ascii && comma) {
+        *(buf++) = ',';
+      }
+      else {
+        comma = 1;
+      }
+      buf += sprintf(buf, "\"%s\"", field_data[i].header);
+    }
+  }
+
+  printf("%s", output_line);
+  printf("\n");
+}
+
+void (*cwtools_initialize)(void) = cwseason_initialize;
+
+/* Order totals by year, then team, then player */
+static int cwseason_compare_players(const void *a, const void *b)
+{
+  const CWSeasonPlayer *player1 = *(const CWSeasonPlayer *const *) a;
+  const CWSeasonPlayer *player2 = *(const CWSeasonPlayer *const *) b;
+  int cmp;
+
+  if (player1->year != player2->year) {
+    return (player1->year < player2->year) ? -1 : 1;
+  }
+  if ((cmp = strcmp(player1->team_id, player2->team_id)) != 0) {
+    return cmp;
+  }
+  return strcmp(player1->player_id, player2->player_id);
+}
+
+void cwseason_cleanup(void)
+{
+  char output_line[4096];
+  char *buf;
+  int i, n, comma, column;
+  CWSeasonPlayer *player;
+  CWSeasonPlayer **players =
+    (CWSeasonPlayer **) malloc((size_t) (season->num_players + 1) * sizeof(CWSeasonPlayer *));
+
+  if (players == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for season totals\n");
+    exit(1);
+  }
+  for (n = 0, player = season->first_player; player != NULL; player = player->next) {
+    players[n++] = player;
+  }
+  qsort(players, (size_t) n, sizeof(CWSeasonPlayer *), cwseason_compare_players);
+
+  for (n = 0; n < season->num_players; n++) {
+    strcpy(output_line, "");
+    buf = output_line;
+    comma = 0;
+    column = 0;
+    for (i = 0; i <= max_field; i++) {
+      if (fields[i]) {
+        if (ascii && comma) {
+          *(buf++) = pgcopy ? '\0' : ',';
+        }
+        else {
+          comma = 1;
+        }
+        column_values[column++] = buf;
+        buf += (*field_data[i].f)(buf, players[n]);
+      }
+    }
+    if (pgcopy) {
+      cw_pgcopy_write_row(stdout, column_values, column_types, column);
+    }
+    else {
+      printf("%s\n", output_line);
+    }
+  }
+
+  free(players);
+  if (game_box != NULL) {
+    cw_box_cleanup(game_box);
+    cw_free(CW_ALLOC_BOX, game_box);
+    game_box = NULL;
+  }
+  cw_season_cleanup(season);
+  cw_free(CW_ALLOC_SEASON, season);
+  season = NULL;
+}
+
+void (*cwtools_cleanup)(void) = cwseason_cleanup;
+
+extern char year[5];
+extern char first_date[5];
+extern char last_date[5];
+extern char game_id[20];
+extern char data_dir[1024];
+extern char catalog_file[1024];
+extern int quiet;
+
+extern void cwtools_parse_field_list(char *text, int max_field, int *fields);
+
+int cwseason_parse_command_line(int argc, char *argv[])
+{
+  int i;
+  strcpy(year, "");
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-a")) {
+      ascii = 1;
+      pgcopy = 0;
+    }
+    else if (!strcmp(argv[i], "-d")) {
+      (*cwtools_print_welcome_message)(argv[0]);
+      (*cwtools_print_field_list)();
+    }
+    else if (!strcmp(argv[i], "-e")) {
+      if (++i < argc) {
+        strncpy(last_date, argv[i], 4);
+      }
+    }
+    else if (!strcmp(argv[i], "-h")) {
+      (*cwtools_print_welcome_message)(argv[0]);
+      (*cwtools_print_help)();
+    }
+    else if (!strcmp(argv[i], "-Q")) {
+      quiet = 1;
+    }
+    else if (!strcmp(argv[i], "-i")) {
+      if (++i < argc) {
+        strncpy(game_id, argv[i], 19);
+      }
+    }
+    else if (!strcmp(argv[i], "-f")) {
+      if (++i < argc) {
+        cwtools_parse_field_list(argv[i], max_field, fields);
+      }
+    }
+    else if (!strcmp(argv[i], "-n")) {
+      print_header = 1;
+    }
+    else if (!strcmp(argv[i], "-ft")) {
+      ascii = 0;
+      pgcopy = 0;
+    }
+    else if (!strcmp(argv[i], "-fp")) {
+      ascii = 1;
+      pgcopy = 1;
+    }
+    else if (!strcmp(argv[i], "-s")) {
+      if (++i < argc) {
+        strncpy(first_date, argv[i], 4);
+      }
+    }
+    else if (!strcmp(argv[i], "-y")) {
+      if (++i < argc) {
+        strncpy(year, argv[i], 5);
+      }
+    }
+    else if (!strcmp(argv[i], "-D")) {
+      if (++i < argc) {
+        strncpy(data_dir, argv[i], sizeof(data_dir) - 1);
+        data_dir[sizeof(data_dir) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-C")) {
+      if (++i < argc) {
+        strncpy(catalog_file, argv[i], sizeof(catalog_file) - 1);
+        catalog_file[sizeof(catalog_file) - 1] = '\0';
+      }
+    }
+    else if (argv[i][0] == '-') {
+      fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
+      exit(1);
+    }
+    else {
+      break;
+    }
+  }
+
+  return i;
+}
+
+int (*cwtools_parse_command_line)(int, char *argv[]) = cwseason_parse_command_line;
@@ -0,0 +1,677 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/cwsplit.c
+ * Chadwick player split statistics generator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cwlib/chadwick.h"
+#include "buffer.h"
+#include "pgcopy.h"
+
+/*************************************************************************
+ * Global variables for command-line options
+ *************************************************************************/
+
+extern int ascii;
+extern int pgcopy;
+extern int output_by_file;
+extern void *(*cwtools_create_partial)(void);
+extern void (*cwtools_process_game_partial)(void *, CWGame *, CWRoster *, CWRoster *);
+extern void (*cwtools_merge_partial)(void *);
+
+/* Fields to display (-f) */
+int fields[21] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+
+int max_field = 20;
+
+char program_name[20] = "cwsplit";
+
+int print_header = 0;
+
+/* The splits, accumulated as games are read and written at the end */
+CWSplits *splits = NULL;
+
+/*
+ * The groups of splits which can be selected with -S
+ */
+#define CWSPLIT_GROUP_TOTAL (1 << 0)
+#define CWSPLIT_GROUP_RISP (1 << 1)
+#define CWSPLIT_GROUP_BASES (1 << 2)
+#define CWSPLIT_GROUP_OUTS (1 << 3)
+#define CWSPLIT_GROUP_BASE_OUT (1 << 4)
+#define CWSPLIT_GROUP_COUNT (1 << 5)
+#define CWSPLIT_GROUP_INNING (1 << 6)
+#define CWSPLIT_GROUP_LATE_CLOSE (1 << 7)
+
+static struct {
+  char *name;
+  int group;
+} group_names[] = {{"total", CWSPLIT_GROUP_TOTAL},        {"risp", CWSPLIT_GROUP_RISP},
+                   {"bases", CWSPLIT_GROUP_BASES},        {"outs", CWSPLIT_GROUP_OUTS},
+                   {"baseout", CWSPLIT_GROUP_BASE_OUT},   {"count", CWSPLIT_GROUP_COUNT},
+                   {"inning", CWSPLIT_GROUP_INNING},      {"lc", CWSPLIT_GROUP_LATE_CLOSE},
+                   {NULL, 0}};
+
+/* Groups of splits to output (-S) */
+int groups = ~0;
+
+/*
+ * A split in the output: the situations of the library's splits whose
+ * lines are summed to give it.
+ */
+typedef struct cwsplit_def_struct {
+  char code[16];
+  int group, num_situations;
+  int situations[CW_SPLIT_SITUATIONS];
+} CWSplitDef;
+
+static CWSplitDef split_defs[64];
+static int num_split_defs = 0;
+
+/*
+ * One output record: a player's line as batter ('B') or pitcher ('P')
+ * in one split, against opponents with one hand (or all, if 'hand' is
+ * negative).
+ */
+typedef struct cwsplit_row_struct {
+  CWSplitPlayer *player;
+  char role;
+  int hand;
+  CWSplitDef *split;
+  CWSplitLine line;
+} CWSplitRow;
+
+/*
+ * typedef to declare the pointer-to-function type
+ */
+typedef int (*field_func)(char *, CWSplitRow *);
+
+/*
+ * convenient structure to hold all information relating to a field
+ * together in one place
+ */
+typedef struct field_struct {
+  field_func f;
+  char *header, *description;
+  CWFieldType type;
+} field_struct;
+
+/*
+ * preprocessor directive for conveniently declaring function signature
+ */
+
+#define DECLARE_FIELDFUNC(funcname) int funcname(char *buffer, CWSplitRow *row)
+
+/* Field 0 */
+DECLARE_FIELDFUNC(cwsplit_year)
+{
+  return sprintf(buffer, (ascii) ? "%d" : "%4d", row->player->year);
+}
+
+/* Field 1 */
+DECLARE_FIELDFUNC(cwsplit_player_id)
+{
+  return sprintf(buffer, (ascii) ? "\"%s\"" : "%-8s", row->player->player_id);
+}
+
+/* Field 2 */
+DECLARE_FIELDFUNC(cwsplit_role)
+{
+  return sprintf(buffer, (ascii) ? "\"%c\"" : "%c", row->role);
+}
+
+/* Field 3 */
+DECLARE_FIELDFUNC(cwsplit_opp_hand)
+{
+  static char *hands[] = {"L", "R", "?"};
+
+  return sprintf(buffer, (ascii) ? "\"%s\"" : "%-1s", (row->hand >= 0) ? hands[row->hand] : "");
+}
+
+/* Field 4 */
+DECLARE_FIELDFUNC(cwsplit_split)
+{
+  return sprintf(buffer, (ascii) ? "\"%s\"" : "%-14s", row->split->code);
+}
+
+#define DECLARE_SPLIT_STAT(funcname, cat)                                                         \
+  DECLARE_FIELDFUNC(funcname)                                                                     \
+  {                                                                                               \
+    return sprintf(buffer, "%d", row->line.cat);                                                  \
+  }
+
+DECLARE_SPLIT_STAT(cwsplit_pa, pa)
+DECLARE_SPLIT_STAT(cwsplit_ab, ab)
+DECLARE_SPLIT_STAT(cwsplit_h, h)
+DECLARE_SPLIT_STAT(cwsplit_2b, b2)
+DECLARE_SPLIT_STAT(cwsplit_3b, b3)
+DECLARE_SPLIT_STAT(cwsplit_hr, hr)
+DECLARE_SPLIT_STAT(cwsplit_rbi, bi)
+DECLARE_SPLIT_STAT(cwsplit_bb, bb)
+DECLARE_SPLIT_STAT(cwsplit_ibb, ibb)
+DECLARE_SPLIT_STAT(cwsplit_hp, hp)
+DECLARE_SPLIT_STAT(cwsplit_so, so)
+DECLARE_SPLIT_STAT(cwsplit_sh, sh)
+DECLARE_SPLIT_STAT(cwsplit_sf, sf)
+DECLARE_SPLIT_STAT(cwsplit_gdp, gdp)
+DECLARE_SPLIT_STAT(cwsplit_xi, xi)
+DECLARE_SPLIT_STAT(cwsplit_outs, outs)
+
+static field_struct field_data[] = {
+  /* 0 */ {cwsplit_year, "YEAR_ID", "year", CW_FIELD_INT16},
+  /* 1 */ {cwsplit_player_id, "PLAYER_ID", "player id", CW_FIELD_ID},
+  /* 2 */
+  {cwsplit_role, "ROLE_CD", "role (B = as batter, P = as pitcher)", CW_FIELD_TEXT},
+  /* 3 */
+  {cwsplit_opp_hand, "OPP_HAND_CD", "opponent's hand (L, R, ?; blank for all)", CW_FIELD_TEXT},
+  /* 4 */ {cwsplit_split, "SPLIT_CD", "split", CW_FIELD_TEXT},
+  /* 5 */ {cwsplit_pa, "PA", "plate appearances", CW_FIELD_INT16},
+  /* 6 */ {cwsplit_ab, "AB", "at bats", CW_FIELD_INT16},
+  /* 7 */ {cwsplit_h, "H", "hits", CW_FIELD_INT16},
+  /* 8 */ {cwsplit_2b, "2B", "doubles", CW_FIELD_INT16},
+  /* 9 */ {cwsplit_3b, "3B", "triples", CW_FIELD_INT16},
+  /* 10 */ {cwsplit_hr, "HR", "home runs", CW_FIELD_INT16},
+  /* 11 */ {cwsplit_rbi, "RBI", "runs batted in", CW_FIELD_INT16},
+  /* 12 */ {cwsplit_bb, "BB", "walks", CW_FIELD_INT16},
+  /* 13 */ {cwsplit_ibb, "IBB", "intentional walks", CW_FIELD_INT16},
+  /* 14 */ {cwsplit_hp, "HBP", "hit by pitch", CW_FIELD_INT16},
+  /* 15 */ {cwsplit_so, "SO", "strikeouts", CW_FIELD_INT16},
+  /* 16 */ {cwsplit_sh, "SH", "sacrifice hits", CW_FIELD_INT16},
+  /* 17 */ {cwsplit_sf, "SF", "sacrifice flies", CW_FIELD_INT16},
+  /* 18 */ {cwsplit_gdp, "GDP", "grounded into double play", CW_FIELD_INT16},
+  /* 19 */ {cwsplit_xi, "XI", "reached on interference", CW_FIELD_INT16},
+  /* 20 */ {cwsplit_outs, "OUTS", "outs made on the plays", CW_FIELD_INT16}};
+
+/*
+ * For PostgreSQL binary COPY output, fields are separated by a null
+ * character instead of a comma, and the start of each is recorded here.
+ */
+static char *column_values[sizeof(field_data) / sizeof(field_data[0])];
+static CWFieldType column_types[sizeof(field_data) / sizeof(field_data[0])];
+
+/* Add an empty split to the table, returning it for its situations to be filled in */
+static CWSplitDef *cwsplit_add_def(char *code, int group)
+{
+  CWSplitDef *def = split_defs + num_split_defs++;
+
+  strncpy(def->code, code, sizeof(def->code) - 1);
+  def->code[sizeof(def->code) - 1] = '\0';
+  def->group = group;
+  def->num_situations = 0;
+  return def;
+}
+
+/*
+ * Runners on base, as shown in split codes: the occupied bases, with
+ * an underscore for each empty one
+ */
+static char *cwsplit_bases_text(int bases, char *text)
+{
+  text[0] = (bases & 1) ? '1' : '_';
+  text[1] = (bases & 2) ? '2' : '_';
+  text[2] = (bases & 4) ? '3' : '_';
+  text[3] = '\0';
+  return text;
+}
+
+static void cwsplit_define_splits(void)
+{
+  CWSplitDef *def;
+  char code[16], bases_text[4];
+  int bases, outs, balls, strikes, inning;
+
+  def = cwsplit_add_def("TOTAL", CWSPLIT_GROUP_TOTAL);
+  for (bases = 0; bases < 8; bases++) {
+    for (outs = 0; outs <= 2; outs++) {
+      def->situations[def->num_situations++] = CW_SPLIT_BASE_OUT + 3 * bases + outs;
+    }
+  }
+
+  def = cwsplit_add_def("RISP", CWSPLIT_GROUP_RISP);
+  for (bases = 0; bases < 8; bases++) {
+    for (outs = 0; outs <= 2; outs++) {
+      if (bases & 6) {
+        def->situations[def->num_situations++] = CW_SPLIT_BASE_OUT + 3 * bases + outs;
+      }
+    }
+  }
+
+  for (bases = 0; bases < 8; bases++) {
+    sprintf(code, "BASES_%s", cwsplit_bases_text(bases, bases_text));
+    def = cwsplit_add_def(code, CWSPLIT_GROUP_BASES);
+    for (outs = 0; outs <= 2; outs++) {
+      def->situations[def->num_situations++] = CW_SPLIT_BASE_OUT + 3 * bases + outs;
+    }
+  }
+
+  for (outs = 0; outs <= 2; outs++) {
+    sprintf(code, "OUTS_%d", outs);
+    def = cwsplit_add_def(code, CWSPLIT_GROUP_OUTS);
+    for (bases = 0; bases < 8; bases++) {
+      def->situations[def->num_situations++] = CW_SPLIT_BASE_OUT + 3 * bases + outs;
+    }
+  }
+
+  for (bases = 0; bases < 8; bases++) {
+    for (outs = 0; outs <= 2; outs++) {
+      sprintf(code, "BASE_OUT_%s_%d", cwsplit_bases_text(bases, bases_text), outs);
+      def = cwsplit_add_def(code, CWSPLIT_GROUP_BASE_OUT);
+      def->situations[def->num_situations++] = CW_SPLIT_BASE_OUT + 3 * bases + outs;
+    }
+  }
+
+  for (balls = 0; balls <= 3; balls++) {
+    for (strikes = 0; strikes <= 2; strikes++) {
+      sprintf(code, "COUNT_%d_%d", balls, strikes);
+      def = cwsplit_add_def(code, CWSPLIT_GROUP_COUNT);
+      def->situations[def->num_situations++] = CW_SPLIT_COUNT + 3 * balls + strikes;
+    }
+  }
+  def = cwsplit_add_def("COUNT_UNKNOWN", CWSPLIT_GROUP_COUNT);
+  def->situations[def->num_situations++] = CW_SPLIT_COUNT_UNKNOWN;
+
+  for (inning = 1; inning <= 9; inning++) {
+    sprintf(code, "INNING_%d", inning);
+    def = cwsplit_add_def(code, CWSPLIT_GROUP_INNING);
+    def->situations[def->num_situations++] = CW_SPLIT_INNING + inning - 1;
+  }
+  def = cwsplit_add_def("INNING_EXTRA", CWSPLIT_GROUP_INNING);
+  def->situations[def->num_situations++] = CW_SPLIT_EXTRA_INNINGS;
+
+  def = cwsplit_add_def("LATE_CLOSE", CWSPLIT_GROUP_LATE_CLOSE);
+  def->situations[def->num_situations++] = CW_SPLIT_LATE_CLOSE;
+}
+
+void cwsplit_process_game(CWGame *game, CWRoster *visitors, CWRoster *home)
+{
+  cw_splits_add_game(splits, game, visitors, home);
+}
+
+void (*cwtools_process_game)(CWGame *, CWRoster *, CWRoster *) = cwsplit_process_game;
+
+/* The splits for one file, when files are processed on several threads */
+static void *cwsplit_create_partial(void)
+{
+  return cw_splits_create();
+}
+
+static void cwsplit_process_game_partial(void *partial, CWGame *game, CWRoster *visitors,
+                                         CWRoster *home)
+{
+  cw_splits_add_game((CWSplits *) partial, game, visitors, home);
+}
+
+static void cwsplit_merge_partial(void *partial)
+{
+  cw_splits_merge(splits, (CWSplits *) partial);
+  cw_splits_cleanup((CWSplits *) partial);
+  cw_free(CW_ALLOC_SPLIT, partial);
+}
+
+void cwsplit_print_help(void)
+{
+  fprintf(stderr,
+          "\n\ncwsplit generates files suitable for use by dBase or Lotus-like programs\n");
+  fprintf(stderr, "Each record gives one player's line as batter or pitcher in one split.\n");
+  fprintf(stderr, "Usage: cwsplit [options] eventfile...\n");
+  fprintf(stderr, "options:\n");
+  fprintf(stderr, "  -h        print this help\n");
+  fprintf(stderr, "  -i id     only process game given by id\n");
+  fprintf(stderr, "  -y year   Year to process (for teamyyyy and aaayyyy.ros).\n");
+  fprintf(stderr,
+          "  -D dir    Directory to find team and roster files (default is current directory)\n");
+  fprintf(stderr, "  -C file   Catalog of games (from cwcatalog), to read only selected games\n");
+  fprintf(stderr, "  -s start  Earliest date to process (mmdd).\n");
+  fprintf(stderr, "  -e end    Last date to process (mmdd).\n");
+  fprintf(stderr, "  -a        generate Ascii-delimited format files (default)\n");
+  fprintf(stderr, "  -ft       generate Fortran format files\n");
+  fprintf(stderr, "  -fp       generate PostgreSQL binary COPY format\n");
+  fprintf(stderr, "  -f flist  give list of fields to output\n");
+  fprintf(stderr, "              Default is 0-20\n");
+  fprintf(stderr, "  -S slist  give list of splits to output, from total, risp, bases,\n");
+  fprintf(stderr, "              outs, baseout, count, inning and lc (late and close)\n");
+  fprintf(stderr, "              Default is all\n");
+  fprintf(stderr, "  -d        print list of field numbers and descriptions\n");
+  fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n");
+  fprintf(stderr, "  --team=list  only process games of the teams listed (IDs separated\n");
+  fprintf(stderr, "            by commas)\n");
+  fprintf(stderr, "  --park=list  only process games at the parks listed\n");
+  fprintf(stderr, "  --stats[=file]  report counts and phase timings at exit,\n");
+  fprintf(stderr, "            to stderr, or as JSON to file\n");
+  fprintf(stderr, "  --serve=socket  read the games once, and answer requests\n");
+  fprintf(stderr, "            for them on a Unix-domain socket\n");
+  fprintf(stderr, "  --threads=n  process the files on n threads at once\n");
+  fprintf(stderr, "  -n        print field names in first row of output\n\n");
+
+  exit(0);
+}
+
+void (*cwtools_print_help)(void) = cwsplit_print_help;
+
+void cwsplit_print_field_list(void)
+{
+  int i;
+
+  fprintf(stderr, "\nThese are the available fields and the numbers to use with the -f option\n");
+  fprintf(stderr, "to name them.  All are included by default.\n");
+  fprintf(stderr, "\n");
+  fprintf(stderr, "number  field\n");
+  fprintf(stderr, "------  -----\n");
+  for (i = 0; i <= max_field; i++) {
+    fprintf(stderr, "%-3d     %s\n", i, field_data[i].description);
+  }
+  fprintf(stderr, "\n");
+
+  exit(0);
+}
+
+void (*cwtools_print_field_list)(void) = cwsplit_print_field_list;
+
+void cwsplit_print_welcome_message(char *argv0)
+{
+  fprintf(stderr, "\nChadwick player split statistics generator, version " VERSION);
+  fprintf(stderr, "\n  Type '%s -h' for help.\n", argv0);
+  fprintf(
+    stderr,
+    "Copyright (c) 2002-2026\nDr T L Turocy, Chadwick Baseball Bureau (ted.turocy@gmail.com)\n");
+  fprintf(stderr, "This is free software, "
+                  "subject to the terms of the GNU GPL license.\n\n");
+}
+
+void (*cwtools_print_welcome_message)(char *) = cwsplit_print_welcome_message;
+
+void cwsplit_initialize(void)
+{
+  int i, comma = 0, column = 0;
+  char output_line[4096];
+  char *buf;
+
+  splits = cw_splits_create();
+  /* Splits are written at the end, over all the files */
+  output_by_file = 0;
+  cwtools_create_partial = cwsplit_create_partial;
+  cwtools_process_game_partial = cwsplit_process_game_partial;
+  cwtools_merge_partial = cwsplit_merge_partial;
+  cwsplit_define_splits();
+
+  for (i = 0; i <= max_field; i++) {
+    if (fields[i]) {
+      column_types[column++] = field_data[i].type;
+    }
+  }
+
+  if (!ascii || pgcopy || !print_header) {
+    return;
+  }
+
+  strcpy(output_line, "");
+  buf = output_line;
+
+  for (i = 0; i <= max_field; i++) {
+    if (fields[i]) {
+      if (ascii && comma) {
+        *(buf++) = ',';
+      }
+      else {
+        comma = 1;
+      }
+      buf += sprintf(buf, "\"%s\"", field_data[i].header);
+    }
+  }
+
+  printf("%s", output_line);
+  printf("\n");
+}
+
+void (*cwtools_initialize)(void) = cwsplit_initialize;
+
+/* Order players by year, then player */
+static int cwsplit_compare_players(const void *a, const void *b)
+{
+  const CWSplitPlayer *player1 = *(const CWSplitPlayer *const *) a;
+  const CWSplitPlayer *player2 = *(const CWSplitPlayer *const *) b;
+
+  if (player1->year != player2->year) {
+    return (player1->year < player2->year) ? -1 : 1;
+  }
+  return strcmp(player1->player_id, player2->player_id);
+}
+
+static void cwsplit_write_row(CWSplitRow *row)
+{
+  char output_line[4096];
+  char *buf = output_line;
+  int i, comma = 0, column = 0;
+
+  strcpy(output_line, "");
+  for (i = 0; i <= max_field; i++) {
+    if (fields[i]) {
+      if (ascii && comma) {
+        *(buf++) = pgcopy ? '\0' : ',';
+      }
+      else {
+        comma = 1;
+      }
+      column_values[column++] = buf;
+      buf += (*field_data[i].f)(buf, row);
+    }
+  }
+  if (pgcopy) {
+    cw_pgcopy_write_row(stdout, column_values, column_types, column);
+  }
+  else {
+    printf("%s\n", output_line);
+  }
+}
+
+/*
+ * Write the rows for 'player' in 'role', with lines taken from 'lines',
+ * for each selected split with at least one plate appearance
+ */
+static void cwsplit_write_player(CWSplitPlayer *player, char role,
+                                 CWSplitLine lines[CW_SPLIT_HANDS][CW_SPLIT_SITUATIONS])
+{
+  CWSplitRow row;
+  int hand, d, i, h;
+
+  row.player = player;
+  row.role = role;
+  for (hand = -1; hand < CW_SPLIT_HANDS; hand++) {
+    row.hand = hand;
+    for (d = 0; d < num_split_defs; d++) {
+      if (!(groups & split_defs[d].group)) {
+        continue;
+      }
+      row.split = split_defs + d;
+      memset(&row.line, 0, sizeof(CWSplitLine));
+      for (h = 0; h < CW_SPLIT_HANDS; h++) {
+        if (hand >= 0 && h != hand) {
+          continue;
+        }
+        for (i = 0; i < split_defs[d].num_situations; i++) {
+          cw_splits_add_line(&row.line, &lines[h][split_defs[d].situations[i]]);
+        }
+      }
+      if (row.line.pa > 0) {
+        cwsplit_write_row(&row);
+      }
+    }
+  }
+}
+
+void cwsplit_cleanup(void)
+{
+  int n;
+  CWSplitPlayer *player;
+  CWSplitPlayer **players =
+    (CWSplitPlayer **) malloc((size_t) (splits->num_players + 1) * sizeof(CWSplitPlayer *));
+
+  if (players == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for splits\n");
+    exit(1);
+  }
+  for (n = 0, player = splits->first_player; player != NULL; player = player->next) {
+    players[n++] = player;
+  }
+  qsort(players, (size_t) n, sizeof(CWSplitPlayer *), cwsplit_compare_players);
+
+  for (n = 0; n < splits->num_players; n++) {
+    cwsplit_write_player(players[n], 'B', players[n]->batting);
+    cwsplit_write_player(players[n], 'P', players[n]->pitching);
+  }
+
+  free(players);
+  cw_splits_cleanup(splits);
+  cw_free(CW_ALLOC_SPLIT, splits);
+  splits = NULL;
+}
+
+void (*cwtools_cleanup)(void) = cwsplit_cleanup;
+
+extern char year[5];
+extern char first_date[5];
+extern char last_date[5];
+extern char game_id[20];
+extern char data_dir[1024];
+extern char catalog_file[1024];
+extern int quiet;
+
+extern void cwtools_parse_field_list(char *text, int max_field, int *fields);
+
+/* Parse the comma-separated list of split groups given with -S */
+static void cwsplit_parse_group_list(char *text)
+{
+  char *name = text, *end;
+  int i;
+
+  groups = 0;
+  while (*name != '\0') {
+    size_t length;
+
+    end = strchr(name, ',');
+    length = (end != NULL) ? (size_t) (end - name) : strlen(name);
+    for (i = 0; group_names[i].name != NULL; i++) {
+      if (strlen(group_names[i].name) == length && !strncmp(group_names[i].name, name, length)) {
+        groups |= group_names[i].group;
+        break;
+      }
+    }
+    if (group_names[i].name == NULL) {
+      fprintf(stderr, "*** Invalid split list '%s'.\n", text);
+      exit(1);
+    }
+    if (end == NULL) {
+      break;
+    }
+    name = end + 1;
+  }
+}
+
+int cwsplit_parse_command_line(int argc, char *argv[])
+{
+  int i;
+  strcpy(year, "");
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-a")) {
+      ascii = 1;
+      pgcopy = 0;
+    }
+    else if (!strcmp(argv[i], "-d")) {
+      (*cwtools_print_welcome_message)(argv[0]);
+      (*cwtools_print_field_list)();
+    }
+    else if (!strcmp(argv[i], "-e")) {
+      if (++i < argc) {
+        strncpy(last_date, argv[i], 4);
+      }
+    }
+    else if (!strcmp(argv[i], "-h")) {
+      (*cwtools_print_welcome_message)(argv[0]);
+      (*cwtools_print_help)();
+    }
+    else if (!strcmp(argv[i], "-Q")) {
+      quiet = 1;
+    }
+    else if (!strcmp(argv[i], "-i")) {
+      if (++i < argc) {
+        strncpy(game_id, argv[i], 19);
+      }
+    }
+    else if (!strcmp(argv[i], "-f")) {
+      if (++i < argc) {
+        cwtools_parse_field_list(argv[i], max_field, fields);
+      }
+    }
+    else if (!strcmp(argv[i], "-S")) {
+      if (++i < argc) {
+        cwsplit_parse_group_list(argv[i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-n")) {
+      print_header = 1;
+    }
+    else if (!strcmp(argv[i], "-ft")) {
+      ascii = 0;
+      pgcopy = 0;
+    }
+    else if (!strcmp(argv[i], "-fp")) {
+      ascii = 1;
+      pgcopy = 1;
+    }
+    else if (!strcmp(argv[i], "-s")) {
+      if (++i < argc) {
+        strncpy(first_date, argv[i], 4);
+      }
+    }
+    else if (!strcmp(argv[i], "-y")) {
+      if (++i < argc) {
+        strncpy(year, argv[i], 5);
+      }
+    }
+    else if (!strcmp(argv[i], "-D")) {
+      if (++i < argc) {
+        strncpy(data_dir, argv[i], sizeof(data_dir) - 1);
+        data_dir[sizeof(data_dir) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-C")) {
+      if (++i < argc) {
+        strncpy(catalog_file, argv[i], sizeof(catalog_file) - 1);
+        catalog_file[sizeof(catalog_file) - 1] = '\0';
+      }
+    }
+    else if (argv[i][0] == '-') {
+      fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
+      exit(1);
+    }
+    else {
+      break;
+    }
+  }
+
+  return i;
+}
+
+int (*cwtools_parse_command_line)(int, char *argv[]) = cwsplit_parse_command_line;
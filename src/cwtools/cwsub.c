@@ -28,6 +28,7 @@
 
 #include "cwlib/chadwick.h"
 #include "buffer.h"
+#include "jsonwrite.h"
 
 /*************************************************************************
  * Global variables for command-line options
@@ -44,6 +45,10 @@ char program_name[20] = "cwsub";
 
 int print_header = 0;
 
+/* Write one JSON object per substitution instead of text (-J) */
+int json_output = 0;
+JSONWriter *json_writer = NULL;
+
 /*************************************************************************
  * Functions to output fields
  *************************************************************************/
@@ -60,6 +65,7 @@ typedef int (*field_func)(CWBuffer *, CWGameIterator *, CWAppearance *);
 typedef struct field_struct {
   field_func f;
   char *header, *description;
+  CWFieldType type;
 } field_struct;
 
 /*
@@ -264,38 +270,49 @@ DECLARE_FIELDFUNC(cwsub_count_text)
 }
 
 static field_struct field_data[] = {
-  {cwsub_game_id, "GAME_ID", "game id"},
-  {cwsub_inning, "INN_CT", "inning"},
-  {cwsub_batting_team, "BAT_HOME_ID", "batting team"},
-  {cwsub_player, "SUB_ID", "substitute"},
-  {cwsub_team, "SUB_HOME_ID", "team"},
-  {cwsub_slot, "SUB_LINEUP_ID", "lineup position"},
-  {cwsub_position, "SUB_FLD_CD", "fielding position"},
-  {cwsub_removed_player, "REMOVED_ID", "removed player"},
-  {cwsub_removed_position, "REMOVED_FLD_CD", "position of removed player"},
-  {cwsub_event_number, "EVENT_ID", "event number"},
-  {cwsub_balls, "BALLS_CT", "balls"},
-  {cwsub_strikes, "STRIKES_CT", "strikes"},
-  {cwsub_pitches, "PITCH_SEQ_TX", "pitch sequence"},
-  {cwsub_pitches_balls, "PA_BALL_CT", "number of balls thrown in plate appearance"},
-  {cwsub_pitches_balls_called, "PA_CALLED_BALL_CT", "number of called balls in plate appearance"},
+  {cwsub_game_id, "GAME_ID", "game id", CW_FIELD_ID},
+  {cwsub_inning, "INN_CT", "inning", CW_FIELD_INT8},
+  {cwsub_batting_team, "BAT_HOME_ID", "batting team", CW_FIELD_INT8},
+  {cwsub_player, "SUB_ID", "substitute", CW_FIELD_ID},
+  {cwsub_team, "SUB_HOME_ID", "team", CW_FIELD_INT8},
+  {cwsub_slot, "SUB_LINEUP_ID", "lineup position", CW_FIELD_INT8},
+  {cwsub_position, "SUB_FLD_CD", "fielding position", CW_FIELD_INT8},
+  {cwsub_removed_player, "REMOVED_ID", "removed player", CW_FIELD_ID},
+  {cwsub_removed_position, "REMOVED_FLD_CD", "position of removed player", CW_FIELD_INT8},
+  {cwsub_event_number, "EVENT_ID", "event number", CW_FIELD_INT16},
+  {cwsub_balls, "BALLS_CT", "balls", CW_FIELD_INT8},
+  {cwsub_strikes, "STRIKES_CT", "strikes", CW_FIELD_INT8},
+  {cwsub_pitches, "PITCH_SEQ_TX", "pitch sequence", CW_FIELD_TEXT},
+  {cwsub_pitches_balls, "PA_BALL_CT", "number of balls thrown in plate appearance", CW_FIELD_INT8},
+  {cwsub_pitches_balls_called, "PA_CALLED_BALL_CT",
+   "number of called balls in plate appearance", CW_FIELD_INT8},
   {cwsub_pitches_balls_intentional, "PA_INTENT_BALL_CT",
-   "number of intentional balls in plate appearance"},
-  {cwsub_pitches_balls_pitchout, "PA_PITCHOUT_BALL_CT", "number of pitchouts in plate appearance"},
+   "number of intentional balls in plate appearance", CW_FIELD_INT8},
+  {cwsub_pitches_balls_pitchout, "PA_PITCHOUT_BALL_CT",
+   "number of pitchouts in plate appearance", CW_FIELD_INT8},
   {cwsub_pitches_balls_hit_batter, "PA_HITBATTER_BALL_CT",
-   "number of pitches hitting batter in plate appearance"},
-  {cwsub_pitches_balls_other, "PA_OTHER_BALL_CT", "number of other balls in plate appearance"},
-  {cwsub_pitches_strikes, "PA_STRIKE_CT", "number of strikes thrown in plate appearance"},
+   "number of pitches hitting batter in plate appearance", CW_FIELD_INT8},
+  {cwsub_pitches_balls_other, "PA_OTHER_BALL_CT",
+   "number of other balls in plate appearance", CW_FIELD_INT8},
+  {cwsub_pitches_strikes, "PA_STRIKE_CT",
+   "number of strikes thrown in plate appearance", CW_FIELD_INT8},
   {cwsub_pitches_strikes_called, "PA_CALLED_STRIKE_CT",
-   "number of called strikes in plate appearance"},
+   "number of called strikes in plate appearance", CW_FIELD_INT8},
   {cwsub_pitches_strikes_swinging, "PA_SWINGMISS_STRIKE_CT",
-   "number of swinging strikes in plate appearance"},
-  {cwsub_pitches_strikes_foul, "PA_FOUL_STRIKE_CT", "number of foul balls in plate appearance"},
+   "number of swinging strikes in plate appearance", CW_FIELD_INT8},
+  {cwsub_pitches_strikes_foul, "PA_FOUL_STRIKE_CT",
+   "number of foul balls in plate appearance", CW_FIELD_INT8},
   {cwsub_pitches_strikes_inplay, "PA_INPLAY_STRIKE_CT",
-   "number of balls in play in plate appearance"},
+   "number of balls in play in plate appearance", CW_FIELD_INT8},
   {cwsub_pitches_strikes_other, "PA_OTHER_STRIKE_CT",
-   "number of other strikes in plate appearance"},
-  {cwsub_count_text, "COUNT_TX", "text of count as appears in event file"}};
+   "number of other strikes in plate appearance", CW_FIELD_INT8},
+  {cwsub_count_text, "COUNT_TX", "text of count as appears in event file", CW_FIELD_TEXT}};
+
+/*
+ * For JSON output, the line is formatted in delimited mode as usual,
+ * then split into the text of each selected field.
+ */
+static char *column_values[sizeof(field_data) / sizeof(field_data[0])];
 
 void cwsub_process_game(CWGame *game, CWRoster *_visitors, CWRoster *_home)
 {
@@ -308,6 +325,9 @@ void cwsub_process_game(CWGame *game, CWRoster *_visitors, CWRoster *_home)
     CWAppearance *sub = gameiter->event->first_sub;
     while (sub) {
       cw_buffer_init(&buf, output_line, sizeof(output_line), ascii, ',');
+      if (json_output) {
+        cw_buffer_track_fields(&buf, column_values, max_field + 1);
+      }
       for (i = 0; i <= max_field; i++) {
         if (fields[i]) {
           (*field_data[i].f)(&buf, gameiter, sub);
@@ -319,8 +339,13 @@ void cwsub_process_game(CWGame *game, CWRoster *_visitors, CWRoster *_home)
         exit(1);
       }
 
-      printf("%s", output_line);
-      printf("\n");
+      if (json_output) {
+        json_writer_write_row(json_writer, column_values, cw_buffer_split_fields(&buf));
+      }
+      else {
+        printf("%s", output_line);
+        printf("\n");
+      }
       sub = sub->next;
     }
 
@@ -328,7 +353,7 @@ void cwsub_process_game(CWGame *game, CWRoster *_visitors, CWRoster *_home)
   }
 
   cw_gameiter_cleanup(gameiter);
-  free(gameiter);
+  cw_free(CW_ALLOC_GAMEITER, gameiter);
 }
 
 void (*cwtools_process_game)(CWGame *, CWRoster *, CWRoster *) = cwsub_process_game;
@@ -344,15 +369,26 @@ void cwsub_print_help(void)
   fprintf(stderr, "  -y year   Year to process (for teamyyyy and aaayyyy.ros).\n");
   fprintf(stderr,
           "  -D dir    Directory to find team and roster files (default is current directory)\n");
+  fprintf(stderr, "  -C file   Catalog of games (from cwcatalog), to read only selected games\n");
   fprintf(stderr, "  -s start  Earliest date to process (mmdd).\n");
   fprintf(stderr, "  -e end    Last date to process (mmdd).\n");
   fprintf(stderr, "  -a        generate Ascii-delimited format files (default)\n");
   fprintf(stderr, "  -ft       generate Fortran format files\n");
+  fprintf(stderr, "  -J        generate JSON Lines, one object per substitution\n");
   fprintf(stderr, "  -m        use master player file instead of local roster files\n");
   fprintf(stderr, "  -f flist  give list of fields to output\n");
   fprintf(stderr, "              Default is 0-9.\n");
   fprintf(stderr, "  -d        print list of field numbers and descriptions\n");
   fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n");
+  fprintf(stderr, "  --team=list  only process games of the teams listed (IDs separated\n");
+  fprintf(stderr, "            by commas)\n");
+  fprintf(stderr, "  --park=list  only process games at the parks listed\n");
+  fprintf(stderr, "  --stats[=file]  report counts and phase timings at exit,\n");
+  fprintf(stderr, "            to stderr, or as JSON to file\n");
+  fprintf(stderr, "  --serve=socket  read the games once, and answer requests\n");
+  fprintf(stderr, "            for them on a Unix-domain socket\n");
+  fprintf(stderr, "  --incremental=dir  keep the output for each file in dir,\n");
+  fprintf(stderr, "            and reuse it while the file is unchanged\n");
   fprintf(stderr, "  -n        print field names in first row of output\n\n");
 
   exit(0);
@@ -396,6 +432,16 @@ void cwsub_initialize(void)
   char output_line[4096];
   CWBuffer buf;
 
+  if (json_output) {
+    json_writer = json_writer_create(stdout);
+    for (i = 0; i <= max_field; i++) {
+      if (fields[i]) {
+        json_writer_add_column(json_writer, field_data[i].header, field_data[i].type);
+      }
+    }
+    return;
+  }
+
   if (!ascii || !print_header) {
     return;
   }
@@ -421,6 +467,10 @@ void (*cwtools_initialize)(void) = cwsub_initialize;
 
 void cwsub_cleanup(void)
 {
+  if (json_writer != NULL) {
+    json_writer_cleanup(json_writer);
+    json_writer = NULL;
+  }
 }
 
 void (*cwtools_cleanup)(void) = cwsub_cleanup;
@@ -430,6 +480,7 @@ extern char first_date[5];
 extern char last_date[5];
 extern char game_id[20];
 extern char data_dir[1024];
+extern char catalog_file[1024];
 extern int quiet;
 
 extern void cwtools_parse_field_list(char *text, int max_field, int *fields);
@@ -442,6 +493,7 @@ int cwsub_parse_command_line(int argc, char *argv[])
   for (i = 1; i < argc; i++) {
     if (!strcmp(argv[i], "-a")) {
       ascii = 1;
+      json_output = 0;
     }
     else if (!strcmp(argv[i], "-d")) {
       (*cwtools_print_welcome_message)(argv[0]);
@@ -474,6 +526,11 @@ int cwsub_parse_command_line(int argc, char *argv[])
     }
     else if (!strcmp(argv[i], "-ft")) {
       ascii = 0;
+      json_output = 0;
+    }
+    else if (!strcmp(argv[i], "-J")) {
+      ascii = 1;
+      json_output = 1;
     }
     else if (!strcmp(argv[i], "-s")) {
       if (++i < argc) {
@@ -491,6 +548,12 @@ int cwsub_parse_command_line(int argc, char *argv[])
         data_dir[sizeof(data_dir) - 1] = '\0';
       }
     }
+    else if (!strcmp(argv[i], "-C")) {
+      if (++i < argc) {
+        strncpy(catalog_file, argv[i], sizeof(catalog_file) - 1);
+        catalog_file[sizeof(catalog_file) - 1] = '\0';
+      }
+    }
     else if (argv[i][0] == '-') {
       fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
       exit(1);
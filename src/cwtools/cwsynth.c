@@ -0,0 +1,991 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/cwsynth.c
+ * Chadwick synthetic event file generator
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * cwsynth writes event files rather than reading them, so it does not
+ * use the common driver in cwtools.c.  Games are built as CWGame objects
+ * and written with cw_game_write(); rosters and the team file are built
+ * as CWRoster and CWLeague objects.
+ *
+ * The generator is deterministic: the schedule and rosters depend only
+ * on the seed, and each game on the seed and its place in the schedule.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "cwlib/chadwick.h"
+
+/* The year of the files written (-y) */
+char year[5] = "2023";
+
+/* The number of games (-g) and teams (-t) */
+int num_games = 2430;
+int num_teams = 30;
+
+/* The seed of the random numbers (-s) */
+uint64_t seed = 1;
+
+/* The directory the files are written to (-d) */
+char output_dir[1024] = ".";
+
+/*
+ * The probability of a substitution before each plate appearance (-S),
+ * and of a comment after each event (-c)
+ */
+double sub_rate = 0.05;
+double comment_rate = 0.01;
+
+/* If 'quiet', write no status messages to stderr (-Q) */
+int quiet = 0;
+
+/*
+ * The kinds of events generated, and their relative frequencies (-M).
+ * Stolen bases and wild pitches are generated only with runners to
+ * advance; the others are plate appearances.
+ */
+enum {
+  CWSYNTH_STRIKEOUT,
+  CWSYNTH_WALK,
+  CWSYNTH_HIT_BY_PITCH,
+  CWSYNTH_SINGLE,
+  CWSYNTH_DOUBLE,
+  CWSYNTH_TRIPLE,
+  CWSYNTH_HOME_RUN,
+  CWSYNTH_GROUND_OUT,
+  CWSYNTH_FLY_OUT,
+  CWSYNTH_ERROR,
+  CWSYNTH_STOLEN_BASE,
+  CWSYNTH_WILD_PITCH,
+  CWSYNTH_KINDS
+};
+
+static char *kind_names[CWSYNTH_KINDS] = {"k", "bb", "hbp", "1b", "2b", "3b", "hr", "go", "fo",
+                                          "e", "sb", "wp"};
+
+int mix[CWSYNTH_KINDS] = {225, 85, 12, 140, 45, 4, 30, 190, 190, 15, 20, 10};
+
+/*
+ * Each team has the same numbers of position players (the first nine
+ * start every game, the others pinch-hit) and pitchers (the first five
+ * start in rotation, the others relieve).
+ */
+#define CWSYNTH_BATTERS 13
+#define CWSYNTH_PITCHERS 13
+#define CWSYNTH_PLAYERS (CWSYNTH_BATTERS + CWSYNTH_PITCHERS)
+#define CWSYNTH_ROTATION 5
+
+/* Games are scheduled from April 1 to September 30, at most ten times over */
+#define CWSYNTH_SEASON_DAYS 183
+#define CWSYNTH_MAX_NUMBER 10
+
+/* A game still tied after this many innings is left a tie */
+#define CWSYNTH_MAX_INNINGS 20
+
+typedef struct cwsynth_team_struct {
+  char team_id[4];
+  char player_id[CWSYNTH_PLAYERS][9];
+  char name[CWSYNTH_PLAYERS][40];
+} CWSynthTeam;
+
+typedef struct cwsynth_game_struct {
+  int day, number, visitors, home;
+  /* The number of games each team has played before this one */
+  int played[2];
+} CWSynthGame;
+
+/* A team's players during a game; players are indices into the team */
+typedef struct cwsynth_side_struct {
+  CWSynthTeam *team;
+  int slot_player[10], slot_pos[10];
+  int pitcher, next_slot, next_bench, next_reliever;
+  /* Slots in which a pinch hitter has batted, and needs a position */
+  int pinch_hit[10];
+  int pitchers[CWSYNTH_PITCHERS], earned_runs[CWSYNTH_PITCHERS], num_pitchers;
+} CWSynthSide;
+
+typedef struct cwsynth_runner_struct {
+  int player;
+  /* The pitcher (index into the fielding side's pitchers) charged */
+  int pitcher;
+  int earned;
+} CWSynthRunner;
+
+typedef struct cwsynth_state_struct {
+  CWGame *game;
+  uint64_t random;
+  int inning, batting_team, outs, score[2];
+  CWSynthSide sides[2];
+  CWSynthRunner runners[4];
+  int occupied[4];
+} CWSynthState;
+
+static CWSynthTeam *teams;
+static CWSynthGame *schedule;
+
+static char *first_names[] = {"Al", "Ben", "Carl", "Dan", "Ed", "Frank", "Gus", "Hal", "Ike",
+                              "Jack", "Ken", "Lou", "Mel", "Ned", "Otto", "Pete", "Ray", "Sam",
+                              "Ted", "Walt"};
+static char *name_starts[] = {"Ab", "Bel", "Cor", "Dal", "Ell", "Fen", "Gar", "Hol", "Jen", "Kel",
+                              "Lor", "Mor", "Nor", "Pel", "Ros", "Tal"};
+static char *name_ends[] = {"ton", "son", "ley", "man", "ford", "well", "er", "by", "ing", "dale",
+                            "more", "wick"};
+
+/*
+ * Random numbers: splitmix64, so that the same seed gives the same
+ * files on every platform
+ */
+static uint64_t cwsynth_random_next(uint64_t *state)
+{
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static double cwsynth_random_uniform(uint64_t *state)
+{
+  return (double) (cwsynth_random_next(state) >> 11) / 9007199254740992.0;
+}
+
+static int cwsynth_random_below(uint64_t *state, int n)
+{
+  return (int) (cwsynth_random_uniform(state) * n);
+}
+
+void cwsynth_print_welcome_message(char *argv0)
+{
+  fprintf(stderr, "\nChadwick synthetic event file generator, version " VERSION);
+  fprintf(stderr, "\n  Type '%s -h' for help.\n", argv0);
+  fprintf(
+    stderr,
+    "Copyright (c) 2002-2026\nDr T L Turocy, Chadwick Baseball Bureau (ted.turocy@gmail.com)\n");
+  fprintf(stderr, "This is free software, "
+                  "subject to the terms of the GNU GPL license.\n\n");
+}
+
+void cwsynth_print_help(void)
+{
+  fprintf(stderr, "\n\ncwsynth writes event files of made-up games, with the team and\n");
+  fprintf(stderr, "roster files for them.  The same options and seed give the same files.\n");
+  fprintf(stderr, "Usage: cwsynth [options]\n");
+  fprintf(stderr, "options:\n");
+  fprintf(stderr, "  -h        print this help\n");
+  fprintf(stderr, "  -y year   year of the games (default is 2023)\n");
+  fprintf(stderr, "  -g games  number of games (default is 2430)\n");
+  fprintf(stderr, "  -t teams  number of teams, which must be even (default is 30)\n");
+  fprintf(stderr, "  -s seed   seed of the random numbers (default is 1)\n");
+  fprintf(stderr, "  -d dir    write the files to dir (default is the current directory)\n");
+  fprintf(stderr, "  -M mix    relative frequencies of kinds of events, as kind=weight,...\n");
+  fprintf(stderr, "              kinds are k, bb, hbp, 1b, 2b, 3b, hr, go, fo, e, sb, wp\n");
+  fprintf(stderr, "  -S rate   probability of a substitution before each plate appearance\n");
+  fprintf(stderr, "              (default is 0.05)\n");
+  fprintf(stderr, "  -c rate   probability of a comment after each event (default is 0.01)\n");
+  fprintf(stderr, "  -Q        operate quietly; do not output progress messages\n\n");
+
+  exit(0);
+}
+
+static double cwsynth_parse_rate(char *text)
+{
+  char *end;
+  double rate = strtod(text, &end);
+
+  if (*end != '\0' || rate < 0.0 || rate > 1.0) {
+    fprintf(stderr, "*** Invalid rate '%s'.\n", text);
+    exit(1);
+  }
+  return rate;
+}
+
+static void cwsynth_parse_mix(char *text)
+{
+  char *copy, *item, *value, *next;
+  int kind;
+
+  copy = (char *) malloc(strlen(text) + 1);
+  if (copy == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for event mix\n");
+    exit(1);
+  }
+  strcpy(copy, text);
+  for (item = copy; item != NULL; item = next) {
+    next = strchr(item, ',');
+    if (next != NULL) {
+      *(next++) = '\0';
+    }
+    value = strchr(item, '=');
+    if (value != NULL) {
+      *(value++) = '\0';
+    }
+    for (kind = 0; kind < CWSYNTH_KINDS && strcmp(kind_names[kind], item); kind++)
+      ;
+    if (kind == CWSYNTH_KINDS || value == NULL || (mix[kind] = cw_atoi(value, NULL)) < 0) {
+      fprintf(stderr, "*** Invalid event mix '%s'.\n", text);
+      exit(1);
+    }
+  }
+  free(copy);
+
+  /* Innings end only if some plate appearances are outs */
+  if (mix[CWSYNTH_STRIKEOUT] + mix[CWSYNTH_GROUND_OUT] + mix[CWSYNTH_FLY_OUT] == 0) {
+    fprintf(stderr, "*** Event mix '%s' has no outs.\n", text);
+    exit(1);
+  }
+}
+
+int cwsynth_parse_command_line(int argc, char *argv[])
+{
+  int i;
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-h")) {
+      cwsynth_print_welcome_message(argv[0]);
+      cwsynth_print_help();
+    }
+    else if (!strcmp(argv[i], "-y")) {
+      if (++i < argc) {
+        strncpy(year, argv[i], sizeof(year) - 1);
+        year[sizeof(year) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-g")) {
+      if (++i < argc && (num_games = cw_atoi(argv[i], NULL)) < 0) {
+        fprintf(stderr, "*** Invalid number of games '%s'.\n", argv[i]);
+        exit(1);
+      }
+    }
+    else if (!strcmp(argv[i], "-t")) {
+      if (++i < argc && ((num_teams = cw_atoi(argv[i], NULL)) < 2 || num_teams % 2 != 0 ||
+                         num_teams > 26 * 26 * 26)) {
+        fprintf(stderr, "*** Invalid number of teams '%s'.\n", argv[i]);
+        exit(1);
+      }
+    }
+    else if (!strcmp(argv[i], "-s")) {
+      if (++i < argc) {
+        seed = strtoull(argv[i], NULL, 10);
+      }
+    }
+    else if (!strcmp(argv[i], "-d")) {
+      if (++i < argc) {
+        strncpy(output_dir, argv[i], sizeof(output_dir) - 1);
+        output_dir[sizeof(output_dir) - 1] = '\0';
+      }
+    }
+    else if (!strcmp(argv[i], "-M")) {
+      if (++i < argc) {
+        cwsynth_parse_mix(argv[i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-S")) {
+      if (++i < argc) {
+        sub_rate = cwsynth_parse_rate(argv[i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-c")) {
+      if (++i < argc) {
+        comment_rate = cwsynth_parse_rate(argv[i]);
+      }
+    }
+    else if (!strcmp(argv[i], "-Q")) {
+      quiet = 1;
+    }
+    else {
+      fprintf(stderr, "*** Invalid option '%s'.\n", argv[i]);
+      exit(1);
+    }
+  }
+
+  return i;
+}
+
+/* Open 'filename' in the output directory for writing */
+static FILE *cwsynth_open(char *filename)
+{
+  char path[2048];
+  FILE *file;
+
+  snprintf(path, sizeof(path), "%s/%s", output_dir, filename);
+  file = fopen(path, "w");
+  if (file == NULL) {
+    fprintf(stderr, "Error: could not open '%s' for writing\n", path);
+    exit(1);
+  }
+  if (!quiet) {
+    fprintf(stderr, "[Writing file %s.]\n", path);
+  }
+  return file;
+}
+
+/*
+ * Make up the teams and their players, and write the team file and a
+ * roster file for each team.  Teams are AAA, AAB, ..., all in league A.
+ */
+static void cwsynth_make_teams(void)
+{
+  CWLeague *league = cw_league_create();
+  uint64_t random = seed ^ 0x5445414D53ULL;
+  char filename[32], player_id[9], last_name[20], city[20], nickname[20];
+  FILE *file;
+  int t, p;
+
+  teams = (CWSynthTeam *) calloc((size_t) num_teams, sizeof(CWSynthTeam));
+  if (teams == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for teams\n");
+    exit(1);
+  }
+
+  for (t = 0; t < num_teams; t++) {
+    CWSynthTeam *team = &teams[t];
+    CWRoster *roster;
+
+    sprintf(team->team_id, "%c%c%c", 'A' + t / 676, 'A' + (t / 26) % 26, 'A' + t % 26);
+    sprintf(city, "City %s", team->team_id);
+    sprintf(nickname, "Team %s", team->team_id);
+    roster = cw_roster_create(team->team_id, atoi(year), "A", city, nickname);
+
+    for (p = 0; p < CWSYNTH_PLAYERS; p++) {
+      char *first_name = first_names[cwsynth_random_below(&random, 20)];
+      double hand = cwsynth_random_uniform(&random);
+
+      sprintf(player_id, "%c%c%c%c%04d", team->team_id[0] - 'A' + 'a',
+              team->team_id[1] - 'A' + 'a', team->team_id[2] - 'A' + 'a',
+              (p < CWSYNTH_BATTERS) ? 'b' : 'p', p);
+      sprintf(last_name, "%s%s", name_starts[cwsynth_random_below(&random, 16)],
+              name_ends[cwsynth_random_below(&random, 12)]);
+      strcpy(team->player_id[p], player_id);
+      sprintf(team->name[p], "%s %s", first_name, last_name);
+      cw_roster_player_append(roster,
+                              cw_player_create(player_id, last_name, first_name,
+                                               (hand < 0.6) ? 'R' : ((hand < 0.9) ? 'L' : 'B'),
+                                               (cwsynth_random_uniform(&random) < 0.75) ? 'R'
+                                                                                        : 'L'));
+    }
+
+    sprintf(filename, "%s%s.ROS", team->team_id, year);
+    file = cwsynth_open(filename);
+    cw_roster_write(roster, file);
+    fclose(file);
+    cw_league_roster_append(league, roster);
+  }
+
+  sprintf(filename, "TEAM%s", year);
+  file = cwsynth_open(filename);
+  cw_league_write(league, file);
+  fclose(file);
+
+  cw_league_cleanup(league);
+  cw_free(CW_ALLOC_LEAGUE, league);
+}
+
+/*
+ * Schedule the games: each day, the teams are paired at random, each
+ * team playing at most once.  After September 30 the season starts
+ * over, with the games numbered as the second and later of the day.
+ */
+static void cwsynth_make_schedule(void)
+{
+  uint64_t random = seed ^ 0x5343484544ULL;
+  int *order = (int *) malloc(sizeof(int) * (size_t) num_teams);
+  int *played = (int *) calloc((size_t) num_teams, sizeof(int));
+  int g = 0, day, t;
+
+  schedule = (CWSynthGame *) malloc(sizeof(CWSynthGame) * (size_t) (num_games + 1));
+  if (order == NULL || played == NULL || schedule == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for schedule\n");
+    exit(1);
+  }
+  if (num_games > CWSYNTH_SEASON_DAYS * CWSYNTH_MAX_NUMBER * (num_teams / 2)) {
+    fprintf(stderr, "Error: too many games for %d teams in a year; use more teams (-t)\n",
+            num_teams);
+    exit(1);
+  }
+
+  for (day = 0; g < num_games; day++) {
+    for (t = 0; t < num_teams; t++) {
+      order[t] = t;
+    }
+    for (t = num_teams - 1; t > 0; t--) {
+      int u = cwsynth_random_below(&random, t + 1), swap = order[t];
+
+      order[t] = order[u];
+      order[u] = swap;
+    }
+    for (t = 0; t < num_teams && g < num_games; t += 2, g++) {
+      schedule[g].day = day % CWSYNTH_SEASON_DAYS;
+      schedule[g].number = day / CWSYNTH_SEASON_DAYS;
+      schedule[g].visitors = order[t];
+      schedule[g].home = order[t + 1];
+      schedule[g].played[0] = played[order[t]]++;
+      schedule[g].played[1] = played[order[t + 1]]++;
+    }
+  }
+
+  free(order);
+  free(played);
+}
+
+/* The date of the 'day'th day of the season, as yyyy/mm/dd */
+static void cwsynth_date(int day, char *date)
+{
+  static int month_days[6] = {30, 31, 30, 31, 31, 30};
+  int month = 0;
+
+  while (day >= month_days[month]) {
+    day -= month_days[month++];
+  }
+  sprintf(date, "%s/%02d/%02d", year, month + 4, day + 1);
+}
+
+static char *cwsynth_player_id(CWSynthSide *side, int player)
+{
+  return side->team->player_id[player];
+}
+
+static char *cwsynth_player_name(CWSynthSide *side, int player)
+{
+  return side->team->name[player];
+}
+
+/*
+ * Add a substitution, after a no-play record for the batter due up, as
+ * event files do
+ */
+static void cwsynth_substitute(CWSynthState *state, int team, int player, int slot, int pos)
+{
+  CWSynthSide *batting = &state->sides[state->batting_team];
+  CWSynthSide *side = &state->sides[team];
+
+  cw_game_event_append(state->game, state->inning, state->batting_team,
+                       cwsynth_player_id(batting, batting->slot_player[batting->next_slot]),
+                       "??", "", "NP");
+  cw_game_substitute_append(state->game, cwsynth_player_id(side, player),
+                            cwsynth_player_name(side, player), team, slot, pos);
+}
+
+/* Substitutions before a plate appearance, at the rate given */
+static void cwsynth_maybe_substitute(CWSynthState *state)
+{
+  CWSynthSide *batting = &state->sides[state->batting_team];
+  CWSynthSide *fielding = &state->sides[1 - state->batting_team];
+
+  if (state->game->first_event == NULL || cwsynth_random_uniform(&state->random) >= sub_rate) {
+    return;
+  }
+
+  if (cwsynth_random_below(&state->random, 2) == 0) {
+    if (fielding->next_reliever < CWSYNTH_PLAYERS) {
+      fielding->pitcher = fielding->next_reliever++;
+      fielding->pitchers[fielding->num_pitchers++] = fielding->pitcher;
+      cwsynth_substitute(state, 1 - state->batting_team, fielding->pitcher, 0, 1);
+    }
+  }
+  else if (batting->next_bench < CWSYNTH_BATTERS) {
+    int slot = batting->next_slot;
+
+    cwsynth_substitute(state, state->batting_team, batting->next_bench, slot + 1, 11);
+    batting->slot_player[slot] = batting->next_bench++;
+    batting->pinch_hit[slot] = 1;
+  }
+}
+
+/* Pinch hitters who stay in the game take the position of the player replaced */
+static void cwsynth_take_field(CWSynthState *state)
+{
+  int team = 1 - state->batting_team, slot;
+  CWSynthSide *side = &state->sides[team];
+
+  for (slot = 0; slot < 9; slot++) {
+    if (side->pinch_hit[slot]) {
+      side->pinch_hit[slot] = 0;
+      cwsynth_substitute(state, team, side->slot_player[slot], slot + 1, side->slot_pos[slot]);
+    }
+  }
+}
+
+/* Pitches of a plate appearance ending with 'last', with the count before it */
+static void cwsynth_pitches(CWSynthState *state, int balls, int strikes, char last, char *count,
+                            char *pitches)
+{
+  int n = 0, fouls;
+
+  sprintf(count, "%d%d", balls, strikes);
+  while (balls > 0 || strikes > 0) {
+    if (cwsynth_random_below(&state->random, balls + strikes) < balls) {
+      pitches[n++] = 'B';
+      balls--;
+    }
+    else {
+      pitches[n++] = "CSF"[cwsynth_random_below(&state->random, 3)];
+      strikes--;
+    }
+  }
+  if (count[1] == '2') {
+    for (fouls = cwsynth_random_below(&state->random, 3); fouls > 0; fouls--) {
+      pitches[n++] = 'F';
+    }
+  }
+  pitches[n++] = last;
+  pitches[n] = '\0';
+}
+
+/* Append the advance of the runner from 'base' to 'dest' to the event text */
+static void cwsynth_advance_text(char *text, int base, int dest)
+{
+  char *s = text + strlen(text);
+
+  sprintf(s, "%c%d-%c", (strchr(text, '.') == NULL) ? '.' : ';', base,
+          (dest == 4) ? 'H' : '0' + dest);
+}
+
+/*
+ * Move the runners: 'dest' gives where each runner ends up (4 for
+ * home; 0 for put out, and written in the event text already), with
+ * the batter's in 'dest[0]'.  Advances are added to the event text
+ * from third base down.  Returns the number of runs scored.
+ */
+static int cwsynth_move_runners(CWSynthState *state, int *dest, int earned, char *text)
+{
+  CWSynthSide *fielding = &state->sides[1 - state->batting_team];
+  CWSynthSide *batting = &state->sides[state->batting_team];
+  CWSynthRunner moved[4];
+  int occupied[4] = {0, 0, 0, 0}, base, runs = 0;
+
+  for (base = 3; base >= 1; base--) {
+    if (state->occupied[base] && dest[base] > 0 && dest[base] != base) {
+      cwsynth_advance_text(text, base, dest[base]);
+    }
+  }
+
+  moved[0].player = batting->slot_player[batting->next_slot];
+  moved[0].pitcher = fielding->num_pitchers - 1;
+  moved[0].earned = earned;
+  for (base = 0; base <= 3; base++) {
+    if ((base == 0) ? dest[0] < 0 : !state->occupied[base]) {
+      continue;
+    }
+    if (base > 0) {
+      moved[base] = state->runners[base];
+    }
+    if (dest[base] == 4) {
+      runs++;
+      if (moved[base].earned) {
+        fielding->earned_runs[moved[base].pitcher]++;
+      }
+    }
+    else if (dest[base] > 0) {
+      occupied[dest[base]] = 1;
+    }
+  }
+  for (base = 3; base >= 0; base--) {
+    if (dest[base] > 0 && dest[base] < 4 && (base == 0 || state->occupied[base])) {
+      state->runners[dest[base]] = moved[base];
+    }
+  }
+  for (base = 1; base <= 3; base++) {
+    state->occupied[base] = occupied[base];
+  }
+  state->score[state->batting_team] += runs;
+  return runs;
+}
+
+/*
+ * Where the runners go when the batter reaches 'batter_dest': each
+ * advances 'bases' bases, plus one more with probability 'extra', and
+ * at least far enough not to be passed by the runner behind
+ */
+static void cwsynth_runner_dests(CWSynthState *state, int *dest, int batter_dest, int bases,
+                                 double extra)
+{
+  int base, behind = batter_dest;
+
+  dest[0] = batter_dest;
+  for (base = 1; base <= 3; base++) {
+    if (!state->occupied[base]) {
+      dest[base] = -1;
+      continue;
+    }
+    dest[base] = base + bases;
+    if (extra > 0.0 && cwsynth_random_uniform(&state->random) < extra) {
+      dest[base]++;
+    }
+    if (behind > 0 && dest[base] <= behind) {
+      dest[base] = behind + 1;
+    }
+    if (dest[base] > 4) {
+      dest[base] = 4;
+    }
+    behind = dest[base];
+  }
+}
+
+/* Whether the kind of event can happen with the bases as they are */
+static int cwsynth_possible(CWSynthState *state, int kind)
+{
+  if (kind == CWSYNTH_STOLEN_BASE) {
+    return ((state->occupied[1] && !state->occupied[2]) ||
+            (state->occupied[2] && !state->occupied[3]));
+  }
+  else if (kind == CWSYNTH_WILD_PITCH) {
+    return (state->occupied[1] || state->occupied[2] || state->occupied[3]);
+  }
+  return 1;
+}
+
+static int cwsynth_choose_kind(CWSynthState *state)
+{
+  int total = 0, kind, draw;
+
+  for (kind = 0; kind < CWSYNTH_KINDS; kind++) {
+    total += mix[kind];
+  }
+  while (1) {
+    draw = cwsynth_random_below(&state->random, total);
+    for (kind = 0; draw >= mix[kind]; kind++) {
+      draw -= mix[kind];
+    }
+    if (cwsynth_possible(state, kind)) {
+      return kind;
+    }
+  }
+}
+
+/*
+ * Generate one event.  Returns nonzero if it was a plate appearance,
+ * so that the next batter is up.
+ */
+static int cwsynth_event(CWSynthState *state)
+{
+  CWSynthSide *batting = &state->sides[state->batting_team];
+  char text[256], count[3], pitches[32];
+  char *fielders = "3456789";
+  int dest[4] = {0, -1, -1, -1}, kind = cwsynth_choose_kind(state), base, outs = 0;
+  int balls = cwsynth_random_below(&state->random, 4);
+  int strikes = cwsynth_random_below(&state->random, 3);
+  int fielder = fielders[cwsynth_random_below(&state->random, 7)] - '0';
+  int earned = 1, plate_appearance = 1;
+
+  for (base = 1; base <= 3; base++) {
+    dest[base] = (state->occupied[base]) ? base : -1;
+  }
+
+  switch (kind) {
+  case CWSYNTH_STRIKEOUT:
+    cwsynth_pitches(state, balls, 2, "SC"[cwsynth_random_below(&state->random, 2)], count,
+                    pitches);
+    strcpy(text, "K");
+    outs = 1;
+    break;
+  case CWSYNTH_WALK:
+  case CWSYNTH_HIT_BY_PITCH:
+    cwsynth_pitches(state, (kind == CWSYNTH_WALK) ? 3 : balls, strikes,
+                    (kind == CWSYNTH_WALK) ? 'B' : 'H', count, pitches);
+    strcpy(text, (kind == CWSYNTH_WALK) ? "W" : "HP");
+    cwsynth_runner_dests(state, dest, 1, 0, 0.0);
+    break;
+  case CWSYNTH_SINGLE:
+  case CWSYNTH_DOUBLE:
+  case CWSYNTH_TRIPLE:
+  case CWSYNTH_HOME_RUN:
+  case CWSYNTH_ERROR:
+    cwsynth_pitches(state, balls, strikes, 'X', count, pitches);
+    fielder = 7 + cwsynth_random_below(&state->random, 3);
+    if (kind == CWSYNTH_SINGLE) {
+      sprintf(text, "S%d/G", fielder);
+      cwsynth_runner_dests(state, dest, 1, 1, 0.4);
+    }
+    else if (kind == CWSYNTH_DOUBLE) {
+      sprintf(text, "D%d/L", fielder);
+      cwsynth_runner_dests(state, dest, 2, 2, 0.4);
+    }
+    else if (kind == CWSYNTH_TRIPLE) {
+      sprintf(text, "T%d/F", fielder);
+      cwsynth_runner_dests(state, dest, 3, 3, 0.0);
+    }
+    else if (kind == CWSYNTH_HOME_RUN) {
+      sprintf(text, "HR/F%d", fielder);
+      cwsynth_runner_dests(state, dest, 4, 4, 0.0);
+    }
+    else {
+      fielder = 1 + cwsynth_random_below(&state->random, 6);
+      sprintf(text, "E%d/G", fielder);
+      cwsynth_runner_dests(state, dest, 1, 1, 0.2);
+      earned = 0;
+    }
+    break;
+  case CWSYNTH_GROUND_OUT:
+    cwsynth_pitches(state, balls, strikes, 'X', count, pitches);
+    fielder = 3 + cwsynth_random_below(&state->random, 4);
+    if (fielder > 3 && state->occupied[1] && state->outs < 2 &&
+        cwsynth_random_uniform(&state->random) < 0.5) {
+      /* Force at second, turned into a double play or not */
+      int pivot = (fielder == 4) ? 6 : 4;
+
+      if (cwsynth_random_uniform(&state->random) < 0.6) {
+        sprintf(text, "%d%d(1)3/GDP/G%d", fielder, pivot, fielder);
+        outs = 2;
+        dest[0] = 0;
+      }
+      else {
+        sprintf(text, "%d%d(1)/FO/G%d", fielder, pivot, fielder);
+        outs = 1;
+        dest[0] = 1;
+      }
+      dest[1] = 0;
+    }
+    else {
+      sprintf(text, (fielder == 3) ? "3/G%d" : "%d3/G%d", fielder, fielder);
+      outs = 1;
+      if (state->outs < 2) {
+        cwsynth_runner_dests(state, dest, 0, 0, 0.4);
+      }
+    }
+    break;
+  case CWSYNTH_FLY_OUT:
+    cwsynth_pitches(state, balls, strikes, 'X', count, pitches);
+    outs = 1;
+    if (fielder >= 7 && state->occupied[3] && state->outs < 2 &&
+        cwsynth_random_uniform(&state->random) < 0.6) {
+      sprintf(text, "%d/SF/F%d", fielder, fielder);
+      dest[3] = 4;
+    }
+    else {
+      sprintf(text, "%d/F%d", fielder, fielder);
+    }
+    break;
+  case CWSYNTH_STOLEN_BASE:
+    strcpy(count, "??");
+    strcpy(pitches, "");
+    plate_appearance = 0;
+    base = (state->occupied[1] && !state->occupied[2]) ? 1 : 2;
+    if (cwsynth_random_uniform(&state->random) < 0.75) {
+      sprintf(text, "SB%d", base + 1);
+      dest[base] = base + 1;
+    }
+    else {
+      sprintf(text, "CS%d(2%d)", base + 1, (base == 1) ? 6 : 5);
+      dest[base] = 0;
+      outs = 1;
+    }
+    dest[0] = -1;
+    break;
+  default:
+    strcpy(count, "??");
+    strcpy(pitches, "");
+    plate_appearance = 0;
+    strcpy(text, "WP");
+    cwsynth_runner_dests(state, dest, -1, 1, 0.0);
+    dest[0] = -1;
+    break;
+  }
+
+  /* Runners do not move on the third out */
+  if (state->outs + outs >= 3) {
+    for (base = 1; base <= 3; base++) {
+      if (dest[base] > 0) {
+        dest[base] = base;
+      }
+    }
+  }
+  cwsynth_move_runners(state, dest, earned, text);
+  state->outs += outs;
+
+  cw_game_event_append(state->game, state->inning, state->batting_team,
+                       cwsynth_player_id(batting, batting->slot_player[batting->next_slot]),
+                       count, pitches, text);
+  if (cwsynth_random_uniform(&state->random) < comment_rate) {
+    char comment[80];
+
+    sprintf(comment, "Synthetic comment on %s in the %s of inning %d", text,
+            (state->batting_team == 0) ? "top" : "bottom", state->inning);
+    cw_game_comment_append(state->game, comment);
+  }
+  return plate_appearance;
+}
+
+/* Set up a side for the game, with its starters */
+static void cwsynth_start_side(CWSynthState *state, int team, CWSynthTeam *synth_team,
+                               int played)
+{
+  CWSynthSide *side = &state->sides[team];
+  int positions[9] = {2, 3, 4, 5, 6, 7, 8, 9, 10};
+  int slot, i;
+
+  memset(side, 0, sizeof(CWSynthSide));
+  side->team = synth_team;
+  for (i = 8; i > 0; i--) {
+    int j = cwsynth_random_below(&state->random, i + 1), swap = positions[i];
+
+    positions[i] = positions[j];
+    positions[j] = swap;
+  }
+  for (slot = 0; slot < 9; slot++) {
+    side->slot_player[slot] = slot;
+    side->slot_pos[slot] = positions[slot];
+    cw_game_starter_append(state->game, cwsynth_player_id(side, slot),
+                           cwsynth_player_name(side, slot), team, slot + 1, positions[slot]);
+  }
+  side->pitcher = CWSYNTH_BATTERS + played % CWSYNTH_ROTATION;
+  side->pitchers[side->num_pitchers++] = side->pitcher;
+  side->next_bench = 9;
+  side->next_reliever = CWSYNTH_BATTERS + CWSYNTH_ROTATION;
+  cw_game_starter_append(state->game, cwsynth_player_id(side, side->pitcher),
+                         cwsynth_player_name(side, side->pitcher), team, 0, 1);
+}
+
+/* Generate the game 'index' of the schedule */
+static CWGame *cwsynth_game(int index)
+{
+  CWSynthGame *scheduled = &schedule[index];
+  CWSynthTeam *visitors = &teams[scheduled->visitors], *home = &teams[scheduled->home];
+  CWSynthState state;
+  char game_id[16], date[32], number[4], site[8], buffer[16];
+  int team, i;
+
+  memset(&state, 0, sizeof(CWSynthState));
+  state.random = seed * 0x9E3779B97F4A7C15ULL + (uint64_t) index;
+  cwsynth_date(scheduled->day, date);
+  sprintf(game_id, "%s%c%c%c%c%c%c%c%c%d", home->team_id, date[0], date[1], date[2], date[3],
+          date[5], date[6], date[8], date[9], scheduled->number);
+  sprintf(number, "%d", scheduled->number);
+  sprintf(site, "%s01", home->team_id);
+
+  state.game = cw_game_create(game_id);
+  cw_game_set_version(state.game, "2");
+  cw_game_info_append(state.game, "visteam", visitors->team_id);
+  cw_game_info_append(state.game, "hometeam", home->team_id);
+  cw_game_info_append(state.game, "site", site);
+  cw_game_info_append(state.game, "date", date);
+  cw_game_info_append(state.game, "number", number);
+  cw_game_info_append(state.game, "starttime", "7:05PM");
+  cw_game_info_append(state.game, "daynight", "night");
+  cw_game_info_append(state.game, "usedh", "true");
+  cw_game_info_append(state.game, "umphome", "umpsyn01");
+  cw_game_info_append(state.game, "howscored", "park");
+  cw_game_info_append(state.game, "pitches", "pitches");
+  sprintf(buffer, "%d", 50 + cwsynth_random_below(&state.random, 40));
+  cw_game_info_append(state.game, "temp", buffer);
+  cw_game_info_append(state.game, "winddir", "unknown");
+  cw_game_info_append(state.game, "windspeed", "-1");
+  cw_game_info_append(state.game, "fieldcond", "unknown");
+  cw_game_info_append(state.game, "precip", "unknown");
+  cw_game_info_append(state.game, "sky", "unknown");
+  sprintf(buffer, "%d", 150 + cwsynth_random_below(&state.random, 60));
+  cw_game_info_append(state.game, "timeofgame", buffer);
+  sprintf(buffer, "%d", 10000 + cwsynth_random_below(&state.random, 30000));
+  cw_game_info_append(state.game, "attendance", buffer);
+
+  cwsynth_start_side(&state, 0, visitors, scheduled->played[0]);
+  cwsynth_start_side(&state, 1, home, scheduled->played[1]);
+  for (i = 1; i <= 3; i++) {
+    state.runners[i].player = -1;
+  }
+
+  for (state.inning = 1;; state.inning++) {
+    for (state.batting_team = 0; state.batting_team <= 1; state.batting_team++) {
+      CWSynthSide *batting = &state.sides[state.batting_team];
+
+      if (state.batting_team == 1 && state.inning >= 9 && state.score[1] > state.score[0]) {
+        break;
+      }
+      state.outs = 0;
+      for (i = 1; i <= 3; i++) {
+        state.occupied[i] = 0;
+        state.runners[i].player = -1;
+      }
+      if (state.game->first_event != NULL) {
+        cwsynth_take_field(&state);
+      }
+      while (state.outs < 3) {
+        cwsynth_maybe_substitute(&state);
+        if (cwsynth_event(&state)) {
+          batting->next_slot = (batting->next_slot + 1) % 9;
+        }
+        if (state.batting_team == 1 && state.inning >= 9 && state.score[1] > state.score[0]) {
+          break;
+        }
+      }
+    }
+    if ((state.inning >= 9 && state.score[0] != state.score[1]) ||
+        state.inning == CWSYNTH_MAX_INNINGS) {
+      break;
+    }
+  }
+
+  for (team = 0; team <= 1; team++) {
+    CWSynthSide *side = &state.sides[team];
+
+    for (i = 0; i < side->num_pitchers; i++) {
+      cw_game_data_set_er(state.game, cwsynth_player_id(side, side->pitchers[i]),
+                          side->earned_runs[i]);
+    }
+  }
+  return state.game;
+}
+
+int main(int argc, char *argv[])
+{
+  char filename[32];
+  int t, g;
+
+  cwsynth_parse_command_line(argc, argv);
+  if (!quiet) {
+    cwsynth_print_welcome_message(argv[0]);
+  }
+
+  cwsynth_make_teams();
+  cwsynth_make_schedule();
+
+  /* Each event file has the games of one home team, in order of date */
+  for (t = 0; t < num_teams; t++) {
+    FILE *file;
+
+    sprintf(filename, "%s%s.EVA", year, teams[t].team_id);
+    file = cwsynth_open(filename);
+    for (g = 0; g < num_games; g++) {
+      CWGame *game;
+
+      if (schedule[g].home != t) {
+        continue;
+      }
+      game = cwsynth_game(g);
+      if (!cw_game_lint(game)) {
+        fprintf(stderr, "Error: generated game %s is not valid\n", game->game_id);
+        exit(1);
+      }
+      cw_game_write(game, file);
+      cw_game_cleanup(game);
+      cw_free(CW_ALLOC_GAME, game);
+    }
+    fclose(file);
+  }
+
+  free(teams);
+  free(schedule);
+
+  return 0;
+}
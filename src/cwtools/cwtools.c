@@ -27,15 +27,32 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <ctype.h> /* for isdigit() */
+#include <sys/stat.h>
 #if HAVE_DIR_H
 #include <dos.h>
 #include <dir.h>
+#include <io.h>
 #elif defined(MSDOS)
 #include <dir.h>
+#include <io.h>
+#else
+#include <unistd.h>
 #endif /* HAVE_DIR_H/MSDOS */
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+#if HAVE_SYS_UN_H
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#endif /* HAVE_SYS_UN_H */
 
 #include "cwlib/chadwick.h"
+#include "pgcopy.h"
 
 /*************************************************************************
  * Global variables provided by individual programs
@@ -77,14 +94,199 @@ char first_date[5] = "0101";
 char last_date[5] = "1231";
 char game_id[20] = "";
 
+/* Teams and parks to select games by (--team=list, --park=list), as lists
+ * of IDs separated by commas (empty = any) */
+static char select_teams[256] = "";
+static char select_parks[256] = "";
+
 /* Directory in which to find TEAMyyyy and roster files (empty = current working directory) */
 char data_dir[1024] = "";
 
+/* Catalog of games written by cwcatalog (empty = none); games in files it
+ * lists are selected from the catalog, and read only if selected */
+char catalog_file[1024] = "";
+static CWCatalog *catalog = NULL;
+
 int ascii = 1;
 
+/* If 'pgcopy', programs write PostgreSQL binary COPY tuples instead of text lines;
+ * the header and trailer of the stream are written here */
+int pgcopy = 0;
+
 /* If 'quiet', programs should write no status messages to stderr */
 int quiet = 0;
 
+/* If 'stats', counts of the work done, the library's allocations and the
+ * time taken in each phase are reported at exit: to stderr, or as JSON to
+ * 'stats_file' if set */
+static int stats = 0;
+static char stats_file[1024] = "";
+
+/* If 'manifest_dir' is set (--incremental=dir), the output for each event
+ * file is kept in that directory, with a manifest of what each was made
+ * from; a file whose entry is unchanged is not read again, and the output
+ * kept for it is written instead */
+static char manifest_dir[1024] = "";
+
+/* Cleared by programs whose output for a file does not depend on that
+ * file alone, as when they summarize all the games, so that it cannot be
+ * kept by file */
+int output_by_file = 1;
+
+/* If 'serve_socket' is set, the games are read once, and requests for them
+ * are answered on the Unix-domain socket of that name */
+static char serve_socket[1024] = "";
+
+/* The number of threads on which to process files at once (--threads=n) */
+static int num_threads = 1;
+
+/*
+ * Programs which summarize all the games may have the files processed on
+ * several threads at once by setting these hooks in their initialization.
+ * The games of each file are then passed to 'cwtools_process_game_partial'
+ * with partial results for that file, made by 'cwtools_create_partial';
+ * 'cwtools_merge_partial' adds partial results to the program's own and
+ * frees them.  Partial results are merged one at a time, in the order of
+ * the files.
+ */
+void *(*cwtools_create_partial)(void) = NULL;
+void (*cwtools_process_game_partial)(void *, CWGame *, CWRoster *, CWRoster *) = NULL;
+void (*cwtools_merge_partial)(void *) = NULL;
+
+/* The partial results to which the games processed on this thread go, if any */
+static CW_THREAD_LOCAL void *thread_partial = NULL;
+
+enum {
+  CWTOOLS_PHASE_SETUP,
+  CWTOOLS_PHASE_LOAD,
+  CWTOOLS_PHASE_READ,
+  CWTOOLS_PHASE_PROCESS,
+  CWTOOLS_PHASE_FINISH,
+  CWTOOLS_NUM_PHASES
+};
+
+/* Setup is the command line and the program's initialization; load is
+ * reading rosters and catalog; read is reading (and selecting) games;
+ * process is the program's work on each game, including its output;
+ * finish is the program's cleanup, which writes any summary output */
+static char *phase_names[CWTOOLS_NUM_PHASES] = {"setup", "load", "read", "process", "finish"};
+static double phase_seconds[CWTOOLS_NUM_PHASES];
+static int phase = CWTOOLS_PHASE_SETUP;
+static double phase_start = 0.0, stats_start = 0.0;
+static long long files_reused = 0;
+
+/* Counts kept for each thread, as the library's are, and added up when
+ * the threads processing files are done */
+static CW_THREAD_LOCAL long long files_processed = 0;
+static CW_THREAD_LOCAL long long games_processed = 0, events_processed = 0;
+
+/* Seconds from some fixed point, by a monotonic clock where available */
+static double cwtools_clock(void)
+{
+#ifdef CLOCK_MONOTONIC
+  struct timespec now;
+
+  if (clock_gettime(CLOCK_MONOTONIC, &now) == 0) {
+    return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+  }
+#endif /* CLOCK_MONOTONIC */
+  return (double) clock() / CLOCKS_PER_SEC;
+}
+
+/* Charge the time since the last change of phase to the current phase,
+ * and start timing 'next'; threads processing files leave the phase as it is */
+static void cwtools_phase(int next)
+{
+  double now;
+
+  if (!stats || next == phase || thread_partial != NULL) {
+    return;
+  }
+  now = cwtools_clock();
+  phase_seconds[phase] += now - phase_start;
+  phase_start = now;
+  phase = next;
+}
+
+/*
+ * Incremental runs (--incremental=dir)
+ *
+ * The manifest records, for each event file, its size, modification time
+ * (to the nanosecond, where the system keeps it) and a hash of its
+ * contents, with the program and version, the options and a hash of the
+ * team and roster files the output was made with, and the name of the
+ * file in which that output is kept.
+ */
+typedef struct cwtools_manifest_entry_struct {
+  char *path, *output, *program, *options;
+  long long size, mtime;
+  long mtime_nsec;
+  unsigned long long hash, rosters;
+} CWToolsManifestEntry;
+
+static CWToolsManifestEntry *manifest = NULL;
+static int manifest_size = 0, manifest_max = 0;
+
+/* The modification time of the manifest read, that is, when it was written */
+static long long manifest_mtime = -1;
+static long manifest_mtime_nsec = 0;
+
+/* The program and version, and the options, of this run */
+static char manifest_program[64];
+static char manifest_options[4096];
+
+/* Hash of the team and roster files read */
+static unsigned long long rosters_hash;
+
+/* The nanoseconds of the modification time in 'info', or zero where the
+ * system keeps only seconds */
+static long cwtools_mtime_nsec(struct stat *info)
+{
+#if HAVE_STRUCT_STAT_ST_MTIM_TV_NSEC
+  return (long) info->st_mtim.tv_nsec;
+#else
+  return 0;
+#endif /* HAVE_STRUCT_STAT_ST_MTIM_TV_NSEC */
+}
+
+#define CWTOOLS_FNV_OFFSET 14695981039346656037ULL
+#define CWTOOLS_FNV_PRIME 1099511628211ULL
+
+/* Continue the FNV-1a hash 'hash' over the rest of 'file' */
+static unsigned long long cwtools_hash_stream(FILE *file, unsigned long long hash)
+{
+  unsigned char buffer[65536];
+  size_t count, k;
+
+  while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    for (k = 0; k < count; k++) {
+      hash = (hash ^ buffer[k]) * CWTOOLS_FNV_PRIME;
+    }
+  }
+  return hash;
+}
+
+/* FNV-1a hash of 'text' */
+static unsigned long long cwtools_hash_string(const char *text)
+{
+  unsigned long long hash = CWTOOLS_FNV_OFFSET;
+
+  for (; *text != '\0'; text++) {
+    hash = (hash ^ (unsigned char) *text) * CWTOOLS_FNV_PRIME;
+  }
+  return hash;
+}
+
+/* Hash the team or roster file 'file' into rosters_hash, if keeping output by file */
+static void cwtools_hash_rosters(FILE *file)
+{
+  if (!strcmp(manifest_dir, "")) {
+    return;
+  }
+  rosters_hash = cwtools_hash_stream(file, rosters_hash);
+  rewind(file);
+}
+
 /* Prepend data_dir to filename, if data_dir is set.  Result is malloc'd
  * and must be freed by the caller. */
 static char *cwtools_build_path(const char *filename)
@@ -168,6 +370,8 @@ void cwtools_read_rosters(CWLeague *league)
     free(filename);
   }
 
+  rosters_hash = CWTOOLS_FNV_OFFSET;
+  cwtools_hash_rosters(teamfile);
   cw_league_read(league, teamfile);
   fclose(teamfile);
 
@@ -184,24 +388,112 @@ void cwtools_read_rosters(CWLeague *league)
       continue;
     }
 
+    cwtools_hash_rosters(file);
     cw_roster_read(roster, file);
     fclose(file);
   }
 }
 
-int cwtools_game_in_range(CWGame *game, char *first, char *last)
+void cwtools_read_catalog(void)
+{
+  FILE *file;
+
+  if (!strcmp(catalog_file, "")) {
+    return;
+  }
+  file = fopen(catalog_file, "r");
+  if (file == NULL) {
+    fprintf(stderr, "Can't find catalog (%s)\n", catalog_file);
+    exit(1);
+  }
+  catalog = cw_catalog_create();
+  if (cw_catalog_read(catalog, file) < 0) {
+    fprintf(stderr, "Error: '%s' is not a catalog\n", catalog_file);
+    exit(1);
+  }
+  fclose(file);
+}
+
+/* Whether 'date' (yyyy/mm/dd) is between 'first' and 'last' (mmdd) */
+static int cwtools_date_in_range(char *date, char *first, char *last)
 {
   int g_month, g_day, g_year;
   char date_string[5];
-  sscanf(cw_game_info_lookup(game, "date"), "%d/%d/%d", &g_year, &g_month, &g_day);
+  sscanf(date, "%d/%d/%d", &g_year, &g_month, &g_day);
   sprintf(date_string, "%02d%02d", g_month, g_day);
   return (strcmp(date_string, first) >= 0 && strcmp(date_string, last) <= 0);
 }
 
+int cwtools_game_in_range(CWGame *game, char *first, char *last)
+{
+  return cwtools_date_in_range(cw_game_info_lookup(game, "date"), first, last);
+}
+
+/* Whether 'id' is in 'list', IDs separated by commas; any ID is in an empty list */
+static int cwtools_id_listed(char *list, char *id)
+{
+  size_t length;
+  char *found;
+
+  if (!strcmp(list, "")) {
+    return 1;
+  }
+  if (id == NULL || (length = strlen(id)) == 0) {
+    return 0;
+  }
+  for (found = strstr(list, id); found != NULL; found = strstr(found + 1, id)) {
+    if ((found == list || found[-1] == ',') && (found[length] == ',' || found[length] == '\0')) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
 int cwtools_select_game(CWGame *game)
 {
   return ((!strcmp(game_id, "") || !strcmp(game_id, game->game_id)) &&
-          cwtools_game_in_range(game, first_date, last_date));
+          cwtools_game_in_range(game, first_date, last_date) &&
+          (cwtools_id_listed(select_teams, cw_game_info_lookup(game, "visteam")) ||
+           cwtools_id_listed(select_teams, cw_game_info_lookup(game, "hometeam"))) &&
+          cwtools_id_listed(select_parks, cw_game_info_lookup(game, "site")));
+}
+
+/*
+ * Whether the catalogued game may be selected, judging from the catalog.
+ * A field the catalog leaves empty rejects nothing; the game is judged
+ * again when read.
+ */
+static int cwtools_select_catalog_entry(CWCatalogEntry *entry)
+{
+  return ((!strcmp(game_id, "") || !strcmp(game_id, entry->game_id)) &&
+          (!strcmp(entry->date, "") ||
+           cwtools_date_in_range(entry->date, first_date, last_date)) &&
+          (!strcmp(entry->visteam, "") || !strcmp(entry->hometeam, "") ||
+           cwtools_id_listed(select_teams, entry->visteam) ||
+           cwtools_id_listed(select_teams, entry->hometeam)) &&
+          (!strcmp(entry->site, "") || cwtools_id_listed(select_parks, entry->site)));
+}
+
+/* Pass a selected game to the program, counting it and its events */
+static void cwtools_process_selected_game(CWLeague *league, CWGame *game)
+{
+  CWEvent *event;
+
+  CWRoster *visitors = cw_league_roster_find(league, cw_game_info_lookup(game, "visteam"));
+  CWRoster *home = cw_league_roster_find(league, cw_game_info_lookup(game, "hometeam"));
+
+  cwtools_phase(CWTOOLS_PHASE_PROCESS);
+  games_processed++;
+  for (event = game->first_event; event != NULL; event = event->next) {
+    events_processed++;
+  }
+  if (thread_partial != NULL) {
+    (*cwtools_process_game_partial)(thread_partial, game, visitors, home);
+  }
+  else {
+    (*cwtools_process_game)(game, visitors, home);
+  }
+  cwtools_phase(CWTOOLS_PHASE_READ);
 }
 
 void cwtools_iterate_games(CWScorebook *scorebook, CWLeague *league)
@@ -210,29 +502,455 @@ void cwtools_iterate_games(CWScorebook *scorebook, CWLeague *league)
   CWGame *game;
 
   while ((game = cw_scorebook_iterator_next(iterator)) != NULL) {
-    (*cwtools_process_game)(game,
-                            cw_league_roster_find(league, cw_game_info_lookup(game, "visteam")),
-                            cw_league_roster_find(league, cw_game_info_lookup(game, "hometeam")));
+    cwtools_process_selected_game(league, game);
   }
+  cw_scorebook_iterator_cleanup(iterator);
+  cw_free(CW_ALLOC_BOOK, iterator);
 }
 
-void cwtools_process_scorebook(CWLeague *league, char *filename)
+/*
+ * Whether -i, -s, -e, --team or --park may reject some games, so that a
+ * file is better read with cw_scorebook_read_selected()
+ */
+static int cwtools_selecting(void)
 {
-  CWScorebook *scorebook = cw_scorebook_create();
-  FILE *file = fopen(filename, "r");
+  return (strcmp(game_id, "") != 0 || strcmp(first_date, "0101") != 0 ||
+          strcmp(last_date, "1231") != 0 || strcmp(select_teams, "") != 0 ||
+          strcmp(select_parks, "") != 0);
+}
+
+/*
+ * Process the games of a file listed in the catalog.  The file is
+ * opened only if the catalog selects some of its games, and only those
+ * games are read.
+ */
+static int cwtools_process_catalog_file(CWLeague *league, char *filename, CWCatalogFile *listed)
+{
+  FILE *file = NULL;
+  int i;
+
+  for (i = 0; i < listed->num_entries; i++) {
+    CWCatalogEntry *entry = &catalog->entries[listed->first_entry + i];
+    CWGame *game;
+
+    if (!cwtools_select_catalog_entry(entry)) {
+      continue;
+    }
+    if (file == NULL) {
+      if (!quiet) {
+        fprintf(stderr, "[Processing file %s.]\n", filename);
+      }
+      file = fopen(filename, "r");
+      if (file == NULL) {
+        fprintf(stderr, "Warning: could not open file '%s'\n", filename);
+        return -1;
+      }
+      files_processed++;
+    }
+
+    game = cw_catalog_read_game(entry, file);
+    if (game == NULL) {
+      fprintf(stderr, "Warning: game %s is not where the catalog gives it in '%s'\n",
+              entry->game_id, filename);
+      continue;
+    }
+    if (cwtools_select_game(game)) {
+      cwtools_process_selected_game(league, game);
+    }
+    cw_game_cleanup(game);
+    cw_free(CW_ALLOC_GAME, game);
+  }
+
+  if (file != NULL) {
+    fclose(file);
+  }
+  return 0;
+}
+
+/* Process the games of a file; returns -1 if it could not be read */
+static int cwtools_process_file(CWLeague *league, char *filename)
+{
+  CWScorebook *scorebook;
+  FILE *file;
+  int count = -1;
+  CWCatalogFile *listed = (catalog != NULL) ? cw_catalog_find_file(catalog, filename) : NULL;
+
+  cwtools_phase(CWTOOLS_PHASE_READ);
+  if (listed != NULL) {
+    return cwtools_process_catalog_file(league, filename, listed);
+  }
+
+  scorebook = cw_scorebook_create();
+  file = fopen(filename, "r");
 
   if (!quiet) {
     fprintf(stderr, "[Processing file %s.]\n", filename);
   }
 
-  if (!file || cw_scorebook_read(scorebook, file) < 0) {
+  /* When games may be rejected, those rejected are skipped unparsed */
+  if (file != NULL) {
+    if (cwtools_selecting()) {
+      count = cw_scorebook_read_selected(scorebook, file, cwtools_select_game);
+    }
+    else {
+      count = cw_scorebook_read(scorebook, file);
+    }
+  }
+
+  if (count < 0) {
     fprintf(stderr, "Warning: could not open file '%s'\n", filename);
   }
   else {
+    files_processed++;
     cwtools_iterate_games(scorebook, league);
   }
   cw_scorebook_cleanup(scorebook);
-  free(scorebook);
+  cw_free(CW_ALLOC_BOOK, scorebook);
+  return (count < 0) ? -1 : 0;
+}
+
+/* The name 'name' in manifest_dir; result is malloc'd */
+static char *cwtools_manifest_path(const char *name)
+{
+  size_t size = strlen(manifest_dir) + strlen(name) + 2;
+  char *path = malloc(size);
+
+  if (path == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for filename\n");
+    exit(1);
+  }
+  snprintf(path, size, "%s/%s", manifest_dir, name);
+  return path;
+}
+
+static char *cwtools_copy_string(const char *text)
+{
+  char *copy = malloc(strlen(text) + 1);
+
+  if (copy == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for manifest\n");
+    exit(1);
+  }
+  return strcpy(copy, text);
+}
+
+static void cwtools_manifest_set(char **field, const char *text)
+{
+  free(*field);
+  *field = cwtools_copy_string(text);
+}
+
+static CWToolsManifestEntry *cwtools_manifest_find(const char *path)
+{
+  int i;
+
+  for (i = 0; i < manifest_size; i++) {
+    if (!strcmp(manifest[i].path, path)) {
+      return &manifest[i];
+    }
+  }
+  return NULL;
+}
+
+static CWToolsManifestEntry *cwtools_manifest_add(const char *path)
+{
+  CWToolsManifestEntry *entry;
+
+  if (manifest_size == manifest_max) {
+    manifest_max = (manifest_max > 0) ? 2 * manifest_max : 64;
+    manifest = realloc(manifest, (size_t) manifest_max * sizeof(CWToolsManifestEntry));
+    if (manifest == NULL) {
+      fprintf(stderr, "Error: could not allocate memory for manifest\n");
+      exit(1);
+    }
+  }
+  entry = &manifest[manifest_size++];
+  memset(entry, 0, sizeof(CWToolsManifestEntry));
+  entry->path = cwtools_copy_string(path);
+  return entry;
+}
+
+/* Read the manifest in manifest_dir, if there is one */
+static void cwtools_read_manifest(void)
+{
+  struct stat info;
+  char *filename = cwtools_manifest_path("manifest");
+  FILE *file = (stat(filename, &info) == 0) ? fopen(filename, "r") : NULL;
+  CWRecordReader r;
+  CWTokenizer tok;
+  char *tag, *tokens[8], *end;
+  int i, first = 1;
+
+  free(filename);
+  if (file == NULL) {
+    return;
+  }
+  manifest_mtime = (long long) info.st_mtime;
+  manifest_mtime_nsec = cwtools_mtime_nsec(&info);
+  cw_record_reader_init(&r, file);
+  while (cw_record_reader_next(&r) == 1) {
+    cw_tokenizer_init(&tok, (char *) cw_record_reader_line(&r));
+    tag = cw_tokenizer_next(&tok);
+    for (i = 0; i < 8; i++) {
+      tokens[i] = (tag != NULL) ? cw_tokenizer_next(&tok) : NULL;
+    }
+    if (tag == NULL) {
+      continue;
+    }
+
+    if (first) {
+      if (strcmp(tag, "manifest") != 0 || tokens[0] == NULL || strcmp(tokens[0], "1") != 0) {
+        fprintf(stderr, "Warning: '%s' has no manifest; all files will be processed\n",
+                manifest_dir);
+        break;
+      }
+      first = 0;
+    }
+    else if (!strcmp(tag, "file") && tokens[7] != NULL &&
+             cwtools_manifest_find(tokens[0]) == NULL) {
+      CWToolsManifestEntry *entry = cwtools_manifest_add(tokens[0]);
+
+      entry->size = strtoll(tokens[1], NULL, 10);
+      entry->mtime = strtoll(tokens[2], &end, 10);
+      entry->mtime_nsec = (*end == '.') ? strtol(end + 1, NULL, 10) : 0;
+      entry->hash = strtoull(tokens[3], NULL, 16);
+      entry->program = cwtools_copy_string(tokens[4]);
+      entry->options = cwtools_copy_string(tokens[5]);
+      entry->rosters = strtoull(tokens[6], NULL, 16);
+      entry->output = cwtools_copy_string(tokens[7]);
+    }
+  }
+  cw_record_reader_cleanup(&r);
+  fclose(file);
+}
+
+/* Write the manifest to manifest_dir, replacing the one read */
+static void cwtools_write_manifest(void)
+{
+  char *filename = cwtools_manifest_path("manifest"), *temp = cwtools_manifest_path("manifest.tmp");
+  FILE *file = fopen(temp, "w");
+  int i;
+
+  if (file == NULL) {
+    fprintf(stderr, "Warning: could not write manifest '%s'\n", filename);
+  }
+  else {
+    fprintf(file, "manifest,1\n");
+    for (i = 0; i < manifest_size; i++) {
+      CWToolsManifestEntry *entry = &manifest[i];
+
+      fprintf(file, "file,\"%s\",%lld,%lld.%09ld,%016llx,\"%s\",\"%s\",%016llx,\"%s\"\n",
+              entry->path, entry->size, entry->mtime, entry->mtime_nsec, entry->hash,
+              entry->program, entry->options, entry->rosters, entry->output);
+    }
+    if (fclose(file) != 0 || rename(temp, filename) != 0) {
+      fprintf(stderr, "Warning: could not write manifest '%s'\n", filename);
+      remove(temp);
+    }
+  }
+  free(filename);
+  free(temp);
+
+  for (i = 0; i < manifest_size; i++) {
+    free(manifest[i].path);
+    free(manifest[i].output);
+    free(manifest[i].program);
+    free(manifest[i].options);
+  }
+  free(manifest);
+  manifest = NULL;
+  manifest_size = manifest_max = 0;
+}
+
+/* Copy the file 'filename' to standard output; returns -1 if it could not be read */
+static int cwtools_copy_to_stdout(const char *filename)
+{
+  char buffer[65536];
+  size_t count;
+  FILE *file = fopen(filename, "rb");
+
+  if (file == NULL) {
+    return -1;
+  }
+  while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    fwrite(buffer, 1, count, stdout);
+  }
+  fclose(file);
+  return 0;
+}
+
+/* Add 'option' to the options recorded, of which there are 'length' characters */
+static size_t cwtools_record_option(size_t length, const char *option)
+{
+  if (length + strlen(option) + 2 > sizeof(manifest_options) || strchr(option, '"')) {
+    fprintf(stderr, "Error: options cannot be recorded in the manifest\n");
+    exit(1);
+  }
+  return length + sprintf(manifest_options + length, "%s%s", (length > 0) ? " " : "", option);
+}
+
+/*
+ * Prepare an incremental run: record the program and its options, from
+ * the 'num_options' arguments after the program name and --team and
+ * --park, and read the manifest.  -Q changes only messages, so it is not
+ * recorded.
+ */
+static void cwtools_begin_manifest(int num_options, char *options[])
+{
+  struct stat info;
+  char selection[300];
+  size_t length = 0;
+  int i;
+
+  if (stat(manifest_dir, &info) != 0 || (info.st_mode & S_IFMT) != S_IFDIR) {
+    fprintf(stderr, "Error: '%s' is not a directory\n", manifest_dir);
+    exit(1);
+  }
+  snprintf(manifest_program, sizeof(manifest_program), "%s %s", program_name, VERSION);
+  strcpy(manifest_options, "");
+  for (i = 0; i < num_options; i++) {
+    if (!strcmp(options[i], "-Q")) {
+      continue;
+    }
+    length = cwtools_record_option(length, options[i]);
+  }
+  if (strcmp(select_teams, "") != 0) {
+    sprintf(selection, "--team=%s", select_teams);
+    length = cwtools_record_option(length, selection);
+  }
+  if (strcmp(select_parks, "") != 0) {
+    sprintf(selection, "--park=%s", select_parks);
+    length = cwtools_record_option(length, selection);
+  }
+  cwtools_read_manifest();
+}
+
+/*
+ * Whether the time recorded for 'entry' is not older than the manifest.
+ * The file may then have changed again within the resolution of the
+ * file system's times after it was read, without its time changing, so
+ * that only its contents can show whether it is as recorded (the
+ * "racily clean" entries of git).
+ */
+static int cwtools_manifest_racy(CWToolsManifestEntry *entry)
+{
+  return (entry->mtime > manifest_mtime ||
+          (entry->mtime == manifest_mtime && entry->mtime_nsec >= manifest_mtime_nsec));
+}
+
+/*
+ * Process the games of a file, keeping the output in manifest_dir, or
+ * write the output kept for it if the file and the run are as recorded
+ */
+static void cwtools_process_incremental(CWLeague *league, char *filename)
+{
+  CWToolsManifestEntry *entry = cwtools_manifest_find(filename);
+  struct stat info;
+  FILE *file, *output;
+  unsigned long long hash;
+  char *output_path, *temp_path, name[1024];
+  const char *base;
+  int saved, result;
+
+  if (stat(filename, &info) != 0 || (file = fopen(filename, "rb")) == NULL) {
+    fprintf(stderr, "Warning: could not open file '%s'\n", filename);
+    return;
+  }
+
+  if (entry != NULL && entry->program != NULL && !strcmp(entry->program, manifest_program) &&
+      !strcmp(entry->options, manifest_options) && entry->rosters == rosters_hash &&
+      entry->size == (long long) info.st_size) {
+    /* A file of the same size and time is taken to be the same, as by
+     * make, unless its entry is racy; otherwise the contents decide, so
+     * that a file touched but not changed is not processed again */
+    if ((entry->mtime == (long long) info.st_mtime &&
+         entry->mtime_nsec == cwtools_mtime_nsec(&info) && !cwtools_manifest_racy(entry)) ||
+        cwtools_hash_stream(file, CWTOOLS_FNV_OFFSET) == entry->hash) {
+      output_path = cwtools_manifest_path(entry->output);
+      fclose(file);
+      cwtools_phase(CWTOOLS_PHASE_READ);
+      result = cwtools_copy_to_stdout(output_path);
+      free(output_path);
+      if (result == 0) {
+        if (!quiet) {
+          fprintf(stderr, "[Reused output for file %s.]\n", filename);
+        }
+        entry->mtime = (long long) info.st_mtime;
+        entry->mtime_nsec = cwtools_mtime_nsec(&info);
+        files_reused++;
+        return;
+      }
+      file = fopen(filename, "rb");
+      if (file == NULL) {
+        fprintf(stderr, "Warning: could not open file '%s'\n", filename);
+        return;
+      }
+    }
+    rewind(file);
+  }
+  hash = cwtools_hash_stream(file, CWTOOLS_FNV_OFFSET);
+  fclose(file);
+
+  if (entry == NULL) {
+    /* Output is kept under the file's own name, made unique by a hash of its path */
+    for (base = filename + strlen(filename); base > filename; base--) {
+      if (base[-1] == '/' || base[-1] == '\\' || base[-1] == ':') {
+        break;
+      }
+    }
+    snprintf(name, sizeof(name), "%.900s.%016llx.out", base, cwtools_hash_string(filename));
+    entry = cwtools_manifest_add(filename);
+    cwtools_manifest_set(&entry->output, name);
+  }
+
+  /* The program writes to standard output, which is sent to the file
+   * kept while this file is processed */
+  output_path = cwtools_manifest_path(entry->output);
+  temp_path = cwtools_manifest_path("output.tmp");
+  fflush(stdout);
+  saved = dup(fileno(stdout));
+  output = fopen(temp_path, "wb");
+  if (saved < 0 || output == NULL || dup2(fileno(output), fileno(stdout)) < 0) {
+    fprintf(stderr, "Error: could not write output for '%s' to '%s'\n", filename, manifest_dir);
+    exit(1);
+  }
+  result = cwtools_process_file(league, filename);
+  fflush(stdout);
+  dup2(saved, fileno(stdout));
+  close(saved);
+  if (fclose(output) != 0) {
+    result = -1;
+  }
+
+  if (result == 0) {
+    if (rename(temp_path, output_path) != 0 || cwtools_copy_to_stdout(output_path) != 0) {
+      fprintf(stderr, "Error: could not write output for '%s' to '%s'\n", filename,
+              manifest_dir);
+      exit(1);
+    }
+    entry->size = (long long) info.st_size;
+    entry->mtime = (long long) info.st_mtime;
+    entry->mtime_nsec = cwtools_mtime_nsec(&info);
+    entry->hash = hash;
+    entry->rosters = rosters_hash;
+    cwtools_manifest_set(&entry->program, manifest_program);
+    cwtools_manifest_set(&entry->options, manifest_options);
+  }
+  else {
+    remove(temp_path);
+  }
+  free(output_path);
+  free(temp_path);
+}
+
+void cwtools_process_scorebook(CWLeague *league, char *filename)
+{
+  if (strcmp(manifest_dir, "") != 0) {
+    cwtools_process_incremental(league, filename);
+  }
+  else {
+    cwtools_process_file(league, filename);
+  }
 }
 
 #if HAVE_DIR_H
@@ -265,6 +983,116 @@ void cwtools_process_filespec(CWLeague *league, char *filespec)
 }
 #endif /* HAVE_DIR_H/MSDOS */
 
+#if HAVE_PTHREAD_H
+/*
+ * Processing files on several threads (--threads=n)
+ *
+ * Each thread takes the next file not yet taken, and processes its games
+ * into partial results for that file.  The results for a file are merged
+ * as soon as those for all the files before it have been, so that the
+ * program's results are the same however the files fall to the threads.
+ */
+typedef struct cwtools_thread_struct {
+  pthread_t thread;
+  CWLeague *league;
+  CWStats stats;
+  CWAllocCounts alloc_counts[CW_ALLOC_NUM_SUBSYSTEMS];
+  long long files_processed, games_processed, events_processed;
+} CWToolsThread;
+
+static pthread_mutex_t thread_lock = PTHREAD_MUTEX_INITIALIZER;
+static char **thread_files;
+static void **thread_results;
+static int thread_num_files, thread_next_file = 0, thread_next_merge = 0;
+
+static void *cwtools_thread_main(void *arg)
+{
+  CWToolsThread *thread = (CWToolsThread *) arg;
+  void *partial;
+  int file;
+
+  for (;;) {
+    pthread_mutex_lock(&thread_lock);
+    file = thread_next_file++;
+    pthread_mutex_unlock(&thread_lock);
+    if (file >= thread_num_files) {
+      break;
+    }
+
+    partial = (*cwtools_create_partial)();
+    if (partial == NULL) {
+      fprintf(stderr, "Error: could not allocate memory for results\n");
+      exit(1);
+    }
+    thread_partial = partial;
+    cwtools_process_filespec(thread->league, thread_files[file]);
+    thread_partial = NULL;
+
+    pthread_mutex_lock(&thread_lock);
+    thread_results[file] = partial;
+    while (thread_next_merge < thread_num_files && thread_results[thread_next_merge] != NULL) {
+      (*cwtools_merge_partial)(thread_results[thread_next_merge]);
+      thread_results[thread_next_merge++] = NULL;
+    }
+    pthread_mutex_unlock(&thread_lock);
+  }
+
+  /* The counts are handed back to be added to those of the main thread */
+  thread->stats = cw_stats;
+  memcpy(thread->alloc_counts, cw_alloc_counts, sizeof(thread->alloc_counts));
+  thread->files_processed = files_processed;
+  thread->games_processed = games_processed;
+  thread->events_processed = events_processed;
+  return NULL;
+}
+
+static void cwtools_process_files_threaded(CWLeague *league, int num_files, char *files[])
+{
+  CWToolsThread *pool = (CWToolsThread *) calloc((size_t) num_threads, sizeof(CWToolsThread));
+  int i, j;
+
+  thread_files = files;
+  thread_num_files = num_files;
+  thread_results = (void **) calloc((size_t) num_files + 1, sizeof(void *));
+  if (pool == NULL || thread_results == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for threads\n");
+    exit(1);
+  }
+  for (i = 0; i < num_threads; i++) {
+    pool[i].league = league;
+    if (pthread_create(&pool[i].thread, NULL, cwtools_thread_main, &pool[i]) != 0) {
+      fprintf(stderr, "Error: could not start thread\n");
+      exit(1);
+    }
+  }
+  for (i = 0; i < num_threads; i++) {
+    pthread_join(pool[i].thread, NULL);
+    cw_stats.bytes_read += pool[i].stats.bytes_read;
+    cw_stats.games_read += pool[i].stats.games_read;
+    cw_stats.events_read += pool[i].stats.events_read;
+    cw_stats.events_parsed += pool[i].stats.events_parsed;
+    cw_stats.parse_failures += pool[i].stats.parse_failures;
+    for (j = 0; j < CW_ALLOC_NUM_SUBSYSTEMS; j++) {
+      cw_alloc_counts[j].malloc_calls += pool[i].alloc_counts[j].malloc_calls;
+      cw_alloc_counts[j].realloc_calls += pool[i].alloc_counts[j].realloc_calls;
+      cw_alloc_counts[j].free_calls += pool[i].alloc_counts[j].free_calls;
+      cw_alloc_counts[j].bytes += pool[i].alloc_counts[j].bytes;
+    }
+    files_processed += pool[i].files_processed;
+    games_processed += pool[i].games_processed;
+    events_processed += pool[i].events_processed;
+  }
+  free(thread_results);
+  free(pool);
+}
+#else  /* not HAVE_PTHREAD_H */
+static void cwtools_process_files_threaded(CWLeague *league, int num_files, char *files[])
+{
+  fprintf(stderr, "Error: --threads is not supported on this system\n");
+  exit(1);
+}
+#endif /* HAVE_PTHREAD_H */
+
 void cwtools_parse_field_list(char *text, int maxfield, int *field)
 {
   unsigned int i = 0, j, firstNum, secondNum, err = 0;
@@ -346,6 +1174,12 @@ int cwtools_default_parse_command_line(int argc, char *argv[])
         data_dir[sizeof(data_dir) - 1] = '\0';
       }
     }
+    else if (!strcmp(argv[i], "-C")) {
+      if (++i < argc) {
+        strncpy(catalog_file, argv[i], sizeof(catalog_file) - 1);
+        catalog_file[sizeof(catalog_file) - 1] = '\0';
+      }
+    }
     else if (!strcmp(argv[i], "-e")) {
       if (++i < argc) {
         strncpy(last_date, argv[i], 4);
@@ -393,23 +1227,640 @@ int cwtools_default_parse_command_line(int argc, char *argv[])
   return i;
 }
 
+/*
+ * If 'arg' is --team=list or --park=list, take the list of teams or parks
+ * to select games by; returns whether it was
+ */
+static int cwtools_parse_selection_option(char *arg)
+{
+  if (!strncmp(arg, "--team=", 7)) {
+    strncpy(select_teams, arg + 7, sizeof(select_teams) - 1);
+    select_teams[sizeof(select_teams) - 1] = '\0';
+    return 1;
+  }
+  else if (!strncmp(arg, "--park=", 7)) {
+    strncpy(select_parks, arg + 7, sizeof(select_parks) - 1);
+    select_parks[sizeof(select_parks) - 1] = '\0';
+    return 1;
+  }
+  return 0;
+}
+
+/*
+ * Remove --stats, --stats=file, --incremental=dir, --serve=socket,
+ * --threads=n, --team=list and --park=list, which all programs accept,
+ * from the command line before the program parses it.  Returns the new
+ * argc.
+ */
+static int cwtools_parse_long_options(int argc, char *argv[])
+{
+  int i, j;
+
+  for (i = j = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--stats")) {
+      stats = 1;
+    }
+    else if (!strncmp(argv[i], "--stats=", 8)) {
+      stats = 1;
+      strncpy(stats_file, argv[i] + 8, sizeof(stats_file) - 1);
+      stats_file[sizeof(stats_file) - 1] = '\0';
+    }
+    else if (!strncmp(argv[i], "--incremental=", 14) && argv[i][14] != '\0') {
+      strncpy(manifest_dir, argv[i] + 14, sizeof(manifest_dir) - 1);
+      manifest_dir[sizeof(manifest_dir) - 1] = '\0';
+    }
+    else if (!strncmp(argv[i], "--threads=", 10)) {
+      if ((num_threads = cw_atoi(argv[i] + 10, "*** Invalid number of threads '%s'.\n")) < 1) {
+        exit(1);
+      }
+    }
+    else if (!strncmp(argv[i], "--serve=", 8) && argv[i][8] != '\0') {
+      strncpy(serve_socket, argv[i] + 8, sizeof(serve_socket) - 1);
+      serve_socket[sizeof(serve_socket) - 1] = '\0';
+    }
+    else if (!cwtools_parse_selection_option(argv[i])) {
+      argv[j++] = argv[i];
+    }
+  }
+  argv[j] = NULL;
+  return j;
+}
+
+/* Rate of 'count' per second over 'seconds' (zero if no time passed) */
+static double cwtools_rate(long long count, double seconds)
+{
+  return (seconds > 0.0) ? (double) count / seconds : 0.0;
+}
+
+static void cwtools_write_stats_text(FILE *file, double total)
+{
+  int i;
+
+  fprintf(file, "[%s statistics]\n", program_name);
+  fprintf(file, "  files processed   %lld\n", files_processed);
+  fprintf(file, "  files reused      %lld\n", files_reused);
+  fprintf(file, "  bytes read        %lld\n", cw_stats.bytes_read);
+  fprintf(file, "  games read        %lld\n", cw_stats.games_read);
+  fprintf(file, "  games processed   %lld\n", games_processed);
+  fprintf(file, "  events read       %lld\n", cw_stats.events_read);
+  fprintf(file, "  events processed  %lld\n", events_processed);
+  fprintf(file, "  events parsed     %lld\n", cw_stats.events_parsed);
+  fprintf(file, "  parse failures    %lld\n", cw_stats.parse_failures);
+  for (i = 0; i < CW_ALLOC_NUM_SUBSYSTEMS; i++) {
+    CWAllocCounts *counts = &cw_alloc_counts[i];
+
+    if (counts->malloc_calls + counts->realloc_calls + counts->free_calls > 0) {
+      fprintf(file, "  alloc %-11s %lld allocs, %lld reallocs, %lld frees, %lld bytes\n",
+              cw_alloc_subsystem_names[i], counts->malloc_calls, counts->realloc_calls,
+              counts->free_calls, counts->bytes);
+    }
+  }
+  for (i = 0; i < CWTOOLS_NUM_PHASES; i++) {
+    fprintf(file, "  %-17s %.6f s\n", phase_names[i], phase_seconds[i]);
+  }
+  fprintf(file, "  total             %.6f s\n", total);
+  fprintf(file, "  games/s           %.1f\n", cwtools_rate(games_processed, total));
+  fprintf(file, "  events/s          %.1f\n", cwtools_rate(events_processed, total));
+}
+
+static void cwtools_write_stats_json(FILE *file, double total)
+{
+  int i;
+
+  fprintf(file, "{\"program\":\"%s\",\"files_processed\":%lld,\"files_reused\":%lld,",
+          program_name, files_processed, files_reused);
+  fprintf(file, "\"bytes_read\":%lld,", cw_stats.bytes_read);
+  fprintf(file, "\"games_read\":%lld,\"games_processed\":%lld,", cw_stats.games_read,
+          games_processed);
+  fprintf(file, "\"events_read\":%lld,\"events_processed\":%lld,", cw_stats.events_read,
+          events_processed);
+  fprintf(file, "\"events_parsed\":%lld,\"parse_failures\":%lld,\"allocations\":{",
+          cw_stats.events_parsed, cw_stats.parse_failures);
+  for (i = 0; i < CW_ALLOC_NUM_SUBSYSTEMS; i++) {
+    CWAllocCounts *counts = &cw_alloc_counts[i];
+
+    fprintf(file, "%s\"%s\":{\"mallocs\":%lld,\"reallocs\":%lld,\"frees\":%lld,\"bytes\":%lld}",
+            (i > 0) ? "," : "", cw_alloc_subsystem_names[i], counts->malloc_calls,
+            counts->realloc_calls, counts->free_calls, counts->bytes);
+  }
+  fprintf(file, "},\"seconds\":{");
+  for (i = 0; i < CWTOOLS_NUM_PHASES; i++) {
+    fprintf(file, "\"%s\":%.6f,", phase_names[i], phase_seconds[i]);
+  }
+  fprintf(file, "\"total\":%.6f},\"games_per_second\":%.1f,\"events_per_second\":%.1f}\n",
+          total, cwtools_rate(games_processed, total), cwtools_rate(events_processed, total));
+}
+
+/* Report the counts and times for the run, as asked by --stats */
+static void cwtools_write_stats(void)
+{
+  double total;
+  FILE *file;
+
+  if (!stats) {
+    return;
+  }
+  cwtools_phase(CWTOOLS_NUM_PHASES);
+  total = phase_start - stats_start;
+
+  if (!strcmp(stats_file, "")) {
+    cwtools_write_stats_text(stderr, total);
+    return;
+  }
+  file = fopen(stats_file, "w");
+  if (file == NULL) {
+    fprintf(stderr, "Warning: could not write statistics to '%s'\n", stats_file);
+    return;
+  }
+  cwtools_write_stats_json(file, total);
+  fclose(file);
+}
+
+#if HAVE_SYS_UN_H
+/*
+ * Serving games on a socket (--serve=socket)
+ *
+ * The games of the event files are read once.  Each line a client sends
+ * is a request: options as on the program's command line, selecting
+ * games with -i, -s, -e, --team and --park from those read, and setting
+ * the program's own options.  The reply is a line "OK n" followed by the n bytes of
+ * output the program writes for the request, or a line "ERR message".
+ * Each client is served by a process of its own, and each request by a
+ * process forked from that, so that the options of one request leave
+ * nothing behind for the next, and the games are shared, not copied.
+ */
+
+/* The games read, indexed by ID in an open-addressed table */
+static CWGame **serve_table = NULL;
+static unsigned long serve_mask = 0;
+
+/* FNV-1a hash of a game ID */
+static unsigned long cwtools_serve_hash(const char *id)
+{
+  unsigned long hash = 2166136261UL;
+
+  for (; *id != '\0'; id++) {
+    hash = (hash ^ (unsigned char) *id) * 16777619UL;
+  }
+  return hash;
+}
+
+/* Index the games of 'scorebook'; of games with the same ID, the first is kept */
+static unsigned long cwtools_serve_index(CWScorebook *scorebook)
+{
+  CWGame *game;
+  unsigned long count = 0, size = 16, slot;
+
+  for (game = scorebook->first_game; game != NULL; game = game->next) {
+    count++;
+  }
+  while (size < 2 * count) {
+    size *= 2;
+  }
+  serve_table = (CWGame **) calloc(size, sizeof(CWGame *));
+  if (serve_table == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for games\n");
+    exit(1);
+  }
+  serve_mask = size - 1;
+
+  for (game = scorebook->first_game; game != NULL; game = game->next) {
+    slot = cwtools_serve_hash(game->game_id) & serve_mask;
+    while (serve_table[slot] != NULL && strcmp(serve_table[slot]->game_id, game->game_id) != 0) {
+      slot = (slot + 1) & serve_mask;
+    }
+    if (serve_table[slot] == NULL) {
+      serve_table[slot] = game;
+    }
+  }
+  return count;
+}
+
+static CWGame *cwtools_serve_find(const char *id)
+{
+  unsigned long slot = cwtools_serve_hash(id) & serve_mask;
+
+  while (serve_table[slot] != NULL) {
+    if (!strcmp(serve_table[slot]->game_id, id)) {
+      return serve_table[slot];
+    }
+    slot = (slot + 1) & serve_mask;
+  }
+  return NULL;
+}
+
+/* Results of a request, sent back by the process serving it */
+#define CWTOOLS_SERVE_DONE 'D'
+#define CWTOOLS_SERVE_NO_GAME 'N'
+#define CWTOOLS_SERVE_REJECTED 'R'
+
+/*
+ * Options a request may not give: those naming the team, roster and
+ * catalog files, which were read with the games at startup, and those
+ * writing files of their own, or messages to the server's standard
+ * error, rather than output for the client
+ */
+static const char *serve_rejected[] = {"-y", "-D", "-C", "-k", "-h", "-d", NULL};
+
+/*
+ * End the process serving a request: close its output, so that the
+ * reply may be sent at once, then report 'result' on 'control'
+ */
+static void cwtools_serve_finish(int control, char result)
+{
+  fflush(stdout);
+  close(STDOUT_FILENO);
+  _exit((write(control, &result, 1) == 1) ? 0 : 1);
+}
+
+/* End the process serving a request which gave 'option', reporting it on 'control' */
+static void cwtools_serve_reject(int control, const char *option)
+{
+  char result[32];
+
+  snprintf(result, sizeof(result), "%c%s", CWTOOLS_SERVE_REJECTED, option);
+  _exit((write(control, result, strlen(result)) == (ssize_t) strlen(result)) ? 0 : 1);
+}
+
+/*
+ * Run the program for 'request', writing its output to standard output.
+ * This is done in a process of its own, which exits when done; if the
+ * options are invalid, the program's parser exits without a result.
+ */
+static void cwtools_serve_request(CWLeague *league, CWScorebook *scorebook, char *request,
+                                  int control)
+{
+  char *args[64], *token, *state;
+  int argc = 0, i;
+
+  args[argc++] = program_name;
+  strcpy(game_id, "");
+  strcpy(first_date, "0101");
+  strcpy(last_date, "1231");
+  strcpy(select_teams, "");
+  strcpy(select_parks, "");
+  for (token = cw_strtok(request, " \t\r\n", &state); token != NULL && argc < 63;
+       token = cw_strtok(NULL, " \t\r\n", &state)) {
+    if (cwtools_parse_selection_option(token)) {
+      continue;
+    }
+    for (i = 0; serve_rejected[i] != NULL; i++) {
+      if (!strcmp(token, serve_rejected[i])) {
+        cwtools_serve_reject(control, token);
+      }
+    }
+    args[argc++] = token;
+  }
+  args[argc] = NULL;
+
+  if (cwtools_parse_command_line(argc, args) < argc) {
+    exit(1);
+  }
+  quiet = 1;
+
+  if (strcmp(game_id, "") != 0 && cwtools_serve_find(game_id) == NULL) {
+    cwtools_serve_finish(control, CWTOOLS_SERVE_NO_GAME);
+  }
+  if (pgcopy) {
+    cw_pgcopy_write_header(stdout);
+  }
+  cwtools_initialize();
+  if (strcmp(game_id, "") != 0) {
+    CWGame *game = cwtools_serve_find(game_id);
+
+    if (cwtools_select_game(game)) {
+      cwtools_process_selected_game(league, game);
+    }
+  }
+  else {
+    cwtools_iterate_games(scorebook, league);
+  }
+  cwtools_cleanup();
+  if (pgcopy) {
+    cw_pgcopy_write_trailer(stdout);
+  }
+  cwtools_serve_finish(control, CWTOOLS_SERVE_DONE);
+}
+
+/*
+ * Fork a process to serve the next request, before it arrives, so that
+ * the time taken to fork is spent between requests.  The process reads
+ * the request line from 'control', and writes the output to 'output'.
+ * Returns the process ID, or -1 on error.
+ */
+static pid_t cwtools_serve_spawn(CWLeague *league, CWScorebook *scorebook, int client,
+                                 int *control, int *output)
+{
+  int control_fds[2], output_fds[2];
+  char request[4096];
+  size_t length = 0;
+  ssize_t count;
+  pid_t pid;
+
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, control_fds) < 0) {
+    return -1;
+  }
+  if (pipe(output_fds) < 0) {
+    close(control_fds[0]);
+    close(control_fds[1]);
+    return -1;
+  }
+  pid = fork();
+  if (pid == 0) {
+    close(client);
+    close(control_fds[0]);
+    close(output_fds[0]);
+    dup2(output_fds[1], STDOUT_FILENO);
+    close(output_fds[1]);
+    while (length < sizeof(request) - 1 &&
+           (count = read(control_fds[1], request + length, sizeof(request) - 1 - length)) != 0) {
+      if (count < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        break;
+      }
+      length += (size_t) count;
+      if (request[length - 1] == '\n') {
+        break;
+      }
+    }
+    if (length == 0) {
+      /* The client has gone, with no request for this process */
+      _exit(0);
+    }
+    request[length] = '\0';
+    cwtools_serve_request(league, scorebook, request, control_fds[1]);
+  }
+
+  close(control_fds[1]);
+  close(output_fds[1]);
+  if (pid < 0) {
+    close(control_fds[0]);
+    close(output_fds[0]);
+    return -1;
+  }
+  *control = control_fds[0];
+  *output = output_fds[0];
+  return pid;
+}
+
+/* Write all 'size' bytes of 'data' to 'fd'; returns 0, or -1 on error */
+static int cwtools_serve_write(int fd, const char *data, size_t size)
+{
+  while (size > 0) {
+    ssize_t written = write(fd, data, size);
+
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    data += written;
+    size -= (size_t) written;
+  }
+  return 0;
+}
+
+/* Answer the requests of the client connected on 'client' until it closes */
+static void cwtools_serve_client(CWLeague *league, CWScorebook *scorebook, int client)
+{
+  FILE *requests = fdopen(client, "r");
+  char request[4096], reply[96], result[32];
+  char *output = NULL;
+  size_t size, max_size = 0;
+  ssize_t count;
+  int control, output_fd, closed;
+  pid_t pid;
+
+  if (requests == NULL) {
+    return;
+  }
+  pid = cwtools_serve_spawn(league, scorebook, client, &control, &output_fd);
+  while (pid > 0 && fgets(request, sizeof(request), requests) != NULL) {
+    if (strspn(request, " \t\r\n") == strlen(request)) {
+      continue;
+    }
+    if (strchr(request, '\n') == NULL) {
+      /* A request too long for the buffer is cut short */
+      request[sizeof(request) - 2] = '\n';
+      request[sizeof(request) - 1] = '\0';
+    }
+    cwtools_serve_write(control, request, strlen(request));
+
+    size = 0;
+    for (;;) {
+      if (size == max_size) {
+        max_size = (max_size > 0) ? 2 * max_size : 65536;
+        output = (char *) realloc(output, max_size);
+        if (output == NULL) {
+          fprintf(stderr, "Error: could not allocate memory for output\n");
+          exit(1);
+        }
+      }
+      count = read(output_fd, output + size, max_size - size);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        break;
+      }
+      size += (size_t) count;
+    }
+    count = read(control, result, sizeof(result) - 1);
+    result[(count > 0) ? count : 0] = '\0';
+    close(control);
+    close(output_fd);
+
+    if (result[0] == CWTOOLS_SERVE_DONE) {
+      sprintf(reply, "OK %lu\n", (unsigned long) size);
+    }
+    else if (result[0] == CWTOOLS_SERVE_NO_GAME) {
+      strcpy(reply, "ERR no such game\n");
+      size = 0;
+    }
+    else if (result[0] == CWTOOLS_SERVE_REJECTED) {
+      snprintf(reply, sizeof(reply), "ERR option not allowed in a request: %s\n", result + 1);
+      size = 0;
+    }
+    else {
+      strcpy(reply, "ERR invalid request\n");
+      size = 0;
+    }
+    closed = (cwtools_serve_write(client, reply, strlen(reply)) < 0 ||
+              cwtools_serve_write(client, output, size) < 0);
+    while (waitpid(pid, NULL, 0) < 0 && errno == EINTR)
+      ;
+    pid = closed ? -1 : cwtools_serve_spawn(league, scorebook, client, &control, &output_fd);
+  }
+  if (pid > 0) {
+    close(control);
+    close(output_fd);
+    waitpid(pid, NULL, 0);
+  }
+  free(output);
+  fclose(requests);
+}
+
+static void cwtools_serve_stop(int signal_number)
+{
+  unlink(serve_socket);
+  _exit(0);
+}
+
+/*
+ * Read the games of the event files 'files', and serve them on
+ * serve_socket until stopped.  Does not return.
+ */
+static void cwtools_serve(CWLeague *league, int num_files, char *files[])
+{
+  CWScorebook *scorebook = cw_scorebook_create();
+  struct sockaddr_un address;
+  unsigned long count;
+  int i, listener, client;
+  pid_t pid;
+
+  for (i = 0; i < num_files; i++) {
+    FILE *file = fopen(files[i], "r");
+
+    if (!quiet) {
+      fprintf(stderr, "[Reading file %s.]\n", files[i]);
+    }
+    if (file == NULL) {
+      fprintf(stderr, "Warning: could not open file '%s'\n", files[i]);
+      continue;
+    }
+    if (cwtools_selecting()) {
+      cw_scorebook_read_selected(scorebook, file, cwtools_select_game);
+    }
+    else {
+      cw_scorebook_read(scorebook, file);
+    }
+    fclose(file);
+  }
+  count = cwtools_serve_index(scorebook);
+
+  if (strlen(serve_socket) >= sizeof(address.sun_path)) {
+    fprintf(stderr, "Error: socket name '%s' is too long\n", serve_socket);
+    exit(1);
+  }
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, serve_socket);
+  unlink(serve_socket);
+  listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0 || bind(listener, (struct sockaddr *) &address, sizeof(address)) < 0 ||
+      listen(listener, SOMAXCONN) < 0) {
+    fprintf(stderr, "Error: could not listen on socket '%s': %s\n", serve_socket,
+            strerror(errno));
+    exit(1);
+  }
+
+  /* Clients' processes are not waited for; a client closing its
+   * connection early does not stop the server */
+  signal(SIGCHLD, SIG_IGN);
+  signal(SIGPIPE, SIG_IGN);
+  signal(SIGINT, cwtools_serve_stop);
+  signal(SIGTERM, cwtools_serve_stop);
+  if (!quiet) {
+    fprintf(stderr, "[Serving %lu games on %s.]\n", count, serve_socket);
+  }
+  fflush(stdout);
+  fflush(stderr);
+
+  for (;;) {
+    client = accept(listener, NULL, NULL);
+    if (client < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      fprintf(stderr, "Error: could not accept a client: %s\n", strerror(errno));
+      exit(1);
+    }
+    pid = fork();
+    if (pid == 0) {
+      close(listener);
+      signal(SIGCHLD, SIG_DFL);
+      signal(SIGINT, SIG_DFL);
+      signal(SIGTERM, SIG_DFL);
+      cwtools_serve_client(league, scorebook, client);
+      exit(0);
+    }
+    if (pid < 0) {
+      fprintf(stderr, "Warning: could not start a process for a client\n");
+    }
+    close(client);
+  }
+}
+#else  /* not HAVE_SYS_UN_H */
+static void cwtools_serve(CWLeague *league, int num_files, char *files[])
+{
+  fprintf(stderr, "Error: --serve is not supported on this system\n");
+  exit(1);
+}
+#endif /* HAVE_SYS_UN_H */
+
 int main(int argc, char *argv[])
 {
   int i;
-  CWLeague *league = cw_league_create();
+  CWLeague *league;
 
+  argc = cwtools_parse_long_options(argc, argv);
+  cw_alloc_set_counting(stats);
+  league = cw_league_create();
+  stats_start = phase_start = cwtools_clock();
   i = cwtools_parse_command_line(argc, argv);
   if (!quiet) {
     (*cwtools_print_welcome_message)(argv[0]);
   }
+  cwtools_phase(CWTOOLS_PHASE_LOAD);
   cwtools_read_rosters(league);
+  if (strcmp(serve_socket, "") != 0) {
+    cwtools_serve(league, argc - i, argv + i);
+  }
+  cwtools_read_catalog();
+  if (strcmp(manifest_dir, "") != 0) {
+    cwtools_begin_manifest(i - 1, argv + 1);
+  }
+  cwtools_phase(CWTOOLS_PHASE_SETUP);
+  if (pgcopy) {
+    cw_pgcopy_write_header(stdout);
+  }
   cwtools_initialize();
-  for (; i < argc; i++) {
-    cwtools_process_filespec(league, argv[i]);
+  if (strcmp(manifest_dir, "") != 0 && !output_by_file) {
+    fprintf(stderr, "Error: with these options, %s cannot keep its output by file\n",
+            program_name);
+    exit(1);
+  }
+  if (num_threads > 1 && cwtools_create_partial == NULL) {
+    fprintf(stderr, "Error: %s cannot process files on several threads\n", program_name);
+    exit(1);
   }
+  if (num_threads > 1) {
+    cwtools_phase(CWTOOLS_PHASE_READ);
+    cwtools_process_files_threaded(league, argc - i, argv + i);
+  }
+  else {
+    for (; i < argc; i++) {
+      cwtools_process_filespec(league, argv[i]);
+    }
+  }
+  cwtools_phase(CWTOOLS_PHASE_FINISH);
   cwtools_cleanup();
+  if (pgcopy) {
+    cw_pgcopy_write_trailer(stdout);
+  }
+  if (strcmp(manifest_dir, "") != 0) {
+    cwtools_write_manifest();
+  }
   cw_league_cleanup(league);
-  free(league);
+  cw_free(CW_ALLOC_LEAGUE, league);
+  if (catalog != NULL) {
+    cw_catalog_cleanup(catalog);
+    cw_free(CW_ALLOC_CATALOG, catalog);
+  }
+  cwtools_write_stats();
 
   return 0;
 }
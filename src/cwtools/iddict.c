@@ -0,0 +1,198 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/iddict.c
+ * Implementation of dictionary assigning integer keys to IDs
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "iddict.h"
+
+typedef struct id_entry_struct {
+  char *id, *name;
+  /* The key as decimal text, as it is written in place of the ID.  This is
+   * stored with the ID, not in the entry, so that it does not move when the
+   * entries are reallocated. */
+  char *key;
+} IDEntry;
+
+/*
+ * Entries are kept in the order they were added, which is the order of
+ * their keys; 'slots' is an open-addressed hash table of entry indexes
+ * (-1 for an empty slot), at most half full.
+ */
+struct id_dictionary_struct {
+  IDEntry *entries;
+  int count, capacity;
+  int *slots, num_slots;
+};
+
+static void *id_dictionary_alloc(void *ptr, size_t size)
+{
+  void *result = realloc(ptr, size);
+
+  if (result == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for ID dictionary\n");
+    exit(1);
+  }
+  return result;
+}
+
+static uint32_t id_dictionary_hash(const char *text, size_t length)
+{
+  uint32_t hash = 2166136261U;
+  size_t i;
+
+  for (i = 0; i < length; i++) {
+    hash = (hash ^ (unsigned char) text[i]) * 16777619U;
+  }
+  return hash;
+}
+
+static void id_dictionary_rehash(IDDictionary *dict, int num_slots)
+{
+  int i;
+
+  dict->slots = (int *) id_dictionary_alloc(dict->slots, (size_t) num_slots * sizeof(int));
+  dict->num_slots = num_slots;
+  for (i = 0; i < num_slots; i++) {
+    dict->slots[i] = -1;
+  }
+  for (i = 0; i < dict->count; i++) {
+    const char *id = dict->entries[i].id;
+    uint32_t slot = id_dictionary_hash(id, strlen(id)) & (uint32_t) (num_slots - 1);
+
+    while (dict->slots[slot] >= 0) {
+      slot = (slot + 1) & (uint32_t) (num_slots - 1);
+    }
+    dict->slots[slot] = i;
+  }
+}
+
+/* The name of the player or team with this ID, from either roster, if found */
+static char *id_dictionary_name(const char *id, CWRoster *visitors, CWRoster *home)
+{
+  CWRoster *rosters[2];
+  char *name;
+  int t;
+
+  rosters[0] = visitors;
+  rosters[1] = home;
+  for (t = 0; t <= 1; t++) {
+    CWPlayer *player = cw_roster_player_find(rosters[t], (char *) id);
+
+    if (player != NULL) {
+      name = (char *) id_dictionary_alloc(NULL, strlen(player->first_name) +
+                                                  strlen(player->last_name) + 2);
+      sprintf(name, "%s %s", player->first_name, player->last_name);
+      return name;
+    }
+    if (rosters[t] != NULL && !strcmp(rosters[t]->team_id, id)) {
+      name = (char *) id_dictionary_alloc(NULL, strlen(rosters[t]->city) +
+                                                  strlen(rosters[t]->nickname) + 2);
+      sprintf(name, "%s %s", rosters[t]->city, rosters[t]->nickname);
+      return name;
+    }
+  }
+  return NULL;
+}
+
+IDDictionary *id_dictionary_create(void)
+{
+  IDDictionary *dict = (IDDictionary *) calloc(1, sizeof(IDDictionary));
+
+  if (dict == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for ID dictionary\n");
+    exit(1);
+  }
+  id_dictionary_rehash(dict, 1024);
+  return dict;
+}
+
+const char *id_dictionary_key(IDDictionary *dict, const char *text, CWRoster *visitors,
+                              CWRoster *home)
+{
+  size_t length = strlen(text);
+  uint32_t slot;
+  IDEntry *entry;
+
+  if (length >= 2 && text[0] == '"' && text[length - 1] == '"') {
+    text++;
+    length -= 2;
+  }
+  if (length == 0) {
+    return "";
+  }
+
+  slot = id_dictionary_hash(text, length) & (uint32_t) (dict->num_slots - 1);
+  while (dict->slots[slot] >= 0) {
+    entry = dict->entries + dict->slots[slot];
+    if (!strncmp(entry->id, text, length) && entry->id[length] == '\0') {
+      return entry->key;
+    }
+    slot = (slot + 1) & (uint32_t) (dict->num_slots - 1);
+  }
+
+  if (dict->count == dict->capacity) {
+    dict->capacity = (dict->capacity > 0) ? 2 * dict->capacity : 1024;
+    dict->entries = (IDEntry *) id_dictionary_alloc(dict->entries,
+                                                    (size_t) dict->capacity * sizeof(IDEntry));
+  }
+  entry = dict->entries + dict->count;
+  entry->id = (char *) id_dictionary_alloc(NULL, length + 1 + 12);
+  memcpy(entry->id, text, length);
+  entry->id[length] = '\0';
+  entry->key = entry->id + length + 1;
+  entry->name = id_dictionary_name(entry->id, visitors, home);
+  sprintf(entry->key, "%d", dict->count + 1);
+  dict->slots[slot] = dict->count++;
+
+  if (2 * dict->count > dict->num_slots) {
+    id_dictionary_rehash(dict, 2 * dict->num_slots);
+  }
+  return entry->key;
+}
+
+void id_dictionary_write(IDDictionary *dict, FILE *f)
+{
+  int i;
+
+  fprintf(f, "\"KEY\",\"ID\",\"NAME_TX\"\n");
+  for (i = 0; i < dict->count; i++) {
+    fprintf(f, "%s,\"%s\",\"%s\"\n", dict->entries[i].key, dict->entries[i].id,
+            (dict->entries[i].name != NULL) ? dict->entries[i].name : "");
+  }
+}
+
+void id_dictionary_cleanup(IDDictionary *dict)
+{
+  int i;
+
+  for (i = 0; i < dict->count; i++) {
+    free(dict->entries[i].id);
+    free(dict->entries[i].name);
+  }
+  free(dict->entries);
+  free(dict->slots);
+  free(dict);
+}
@@ -0,0 +1,57 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/iddict.h
+ * Dictionary assigning integer keys to player and team IDs
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef IDDICT_H
+#define IDDICT_H
+
+#include <stdio.h>
+
+#include "cwlib/chadwick.h"
+
+/*
+ * For compact output, player and team IDs can be written as integer
+ * keys.  Keys are assigned from 1 in the order IDs are first seen, and
+ * the dictionary is written as a side table at the end of the run,
+ * giving each key's ID and the name of the player or team.
+ */
+
+typedef struct id_dictionary_struct IDDictionary;
+
+IDDictionary *id_dictionary_create(void);
+
+/*
+ * Return the key of an ID as decimal text, adding the ID if it is new.
+ * 'text' is the ID as written by a field function in delimited mode;
+ * surrounding quotes are removed.  An empty ID has an empty key.  The
+ * name of a new ID is found in the rosters of the game, either of
+ * which may be NULL.
+ */
+const char *id_dictionary_key(IDDictionary *dict, const char *text, CWRoster *visitors,
+                              CWRoster *home);
+
+/* Write the side table, as a comma-delimited file with a header row */
+void id_dictionary_write(IDDictionary *dict, FILE *f);
+
+void id_dictionary_cleanup(IDDictionary *dict);
+
+#endif /* IDDICT_H */
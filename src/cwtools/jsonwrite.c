@@ -0,0 +1,258 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/jsonwrite.c
+ * Implementation of utility API for generating JSON Lines output
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "jsonwrite.h"
+
+typedef struct json_column_struct {
+  /* The key, quoted and escaped, preceded by '{' or ',' and followed by ':' */
+  char *key;
+  size_t key_length;
+  CWFieldType type;
+} JSONColumn;
+
+struct json_writer_struct {
+  FILE *f;
+  JSONColumn *columns;
+  int num_columns, max_columns;
+  /* Each line is built here, then written at once */
+  char *line;
+  size_t length, capacity;
+};
+
+static void json_writer_reserve(JSONWriter *writer, size_t count)
+{
+  char *line;
+  size_t capacity = (writer->capacity > 0) ? writer->capacity : 1024;
+
+  if (writer->length + count <= writer->capacity) {
+    return;
+  }
+  while (capacity < writer->length + count) {
+    capacity *= 2;
+  }
+  line = (char *) realloc(writer->line, capacity);
+  if (line == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for JSON output\n");
+    exit(1);
+  }
+  writer->line = line;
+  writer->capacity = capacity;
+}
+
+static void json_writer_append(JSONWriter *writer, const char *text, size_t length)
+{
+  json_writer_reserve(writer, length);
+  memcpy(writer->line + writer->length, text, length);
+  writer->length += length;
+}
+
+/*
+ * Append 'text' as a JSON string.  Only quotes, backslashes and control
+ * characters need escaping; other bytes are copied as they are.
+ */
+static void json_writer_append_string(JSONWriter *writer, const char *text, size_t length)
+{
+  static const char hex[] = "0123456789abcdef";
+  char *p;
+  size_t i;
+
+  /* The longest escape is six characters, \u00XX */
+  json_writer_reserve(writer, 6 * length + 2);
+  p = writer->line + writer->length;
+  *(p++) = '"';
+  for (i = 0; i < length; i++) {
+    unsigned char c = (unsigned char) text[i];
+
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      *(p++) = (char) c;
+    }
+    else if (c == '"' || c == '\\') {
+      *(p++) = '\\';
+      *(p++) = (char) c;
+    }
+    else if (c == '\n') {
+      *(p++) = '\\';
+      *(p++) = 'n';
+    }
+    else if (c == '\r') {
+      *(p++) = '\\';
+      *(p++) = 'r';
+    }
+    else if (c == '\t') {
+      *(p++) = '\\';
+      *(p++) = 't';
+    }
+    else {
+      memcpy(p, "\\u00", 4);
+      p[4] = hex[c >> 4];
+      p[5] = hex[c & 0x0F];
+      p += 6;
+    }
+  }
+  *(p++) = '"';
+  writer->length = (size_t) (p - writer->line);
+}
+
+/* Whether 'text' is an integer as JSON writes numbers */
+static int json_is_integer(const char *text, size_t length)
+{
+  size_t i = 0;
+
+  if (length > 0 && text[0] == '-') {
+    i++;
+  }
+  if (i == length || (text[i] == '0' && length - i > 1)) {
+    return 0;
+  }
+  for (; i < length; i++) {
+    if (text[i] < '0' || text[i] > '9') {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static void json_writer_append_value(JSONWriter *writer, const char *text, CWFieldType type)
+{
+  size_t length = strlen(text);
+
+  if (length >= 2 && text[0] == '"' && text[length - 1] == '"') {
+    text++;
+    length -= 2;
+  }
+
+  switch (type) {
+  case CW_FIELD_INT8:
+  case CW_FIELD_INT16:
+  case CW_FIELD_INT32:
+    if (json_is_integer(text, length)) {
+      json_writer_append(writer, text, length);
+      return;
+    }
+    break;
+  case CW_FIELD_FLAG:
+    if (length == 1 && text[0] == 'T') {
+      json_writer_append(writer, "true", 4);
+      return;
+    }
+    else if (length == 1 && text[0] == 'F') {
+      json_writer_append(writer, "false", 5);
+      return;
+    }
+    break;
+  case CW_FIELD_ID:
+    if (length > 0) {
+      json_writer_append_string(writer, text, length);
+      return;
+    }
+    break;
+  default:
+    json_writer_append_string(writer, text, length);
+    return;
+  }
+
+  json_writer_append(writer, "null", 4);
+}
+
+/*
+ * Public interface
+ */
+JSONWriter *json_writer_create(FILE *f)
+{
+  JSONWriter *writer = (JSONWriter *) calloc(1, sizeof(JSONWriter));
+
+  if (writer == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for JSON output\n");
+    exit(1);
+  }
+  writer->f = f;
+  return writer;
+}
+
+void json_writer_add_column(JSONWriter *writer, const char *name, CWFieldType type)
+{
+  JSONColumn *column;
+
+  if (writer->num_columns == writer->max_columns) {
+    int max_columns = (writer->max_columns > 0) ? 2 * writer->max_columns : 64;
+    JSONColumn *columns =
+      (JSONColumn *) realloc(writer->columns, (size_t) max_columns * sizeof(JSONColumn));
+
+    if (columns == NULL) {
+      fprintf(stderr, "Error: could not allocate memory for JSON output\n");
+      exit(1);
+    }
+    writer->columns = columns;
+    writer->max_columns = max_columns;
+  }
+
+  /* The line buffer is used to render the key, which is then copied */
+  writer->length = 0;
+  json_writer_append(writer, (writer->num_columns == 0) ? "{" : ",", 1);
+  json_writer_append_string(writer, name, strlen(name));
+  json_writer_append(writer, ":", 1);
+
+  column = writer->columns + writer->num_columns;
+  column->key = (char *) malloc(writer->length);
+  if (column->key == NULL) {
+    fprintf(stderr, "Error: could not allocate memory for JSON output\n");
+    exit(1);
+  }
+  memcpy(column->key, writer->line, writer->length);
+  column->key_length = writer->length;
+  column->type = type;
+  writer->num_columns++;
+  writer->length = 0;
+}
+
+void json_writer_write_row(JSONWriter *writer, char **values, int count)
+{
+  int i;
+
+  writer->length = 0;
+  if (count == 0) {
+    json_writer_append(writer, "{", 1);
+  }
+  for (i = 0; i < count && i < writer->num_columns; i++) {
+    json_writer_append(writer, writer->columns[i].key, writer->columns[i].key_length);
+    json_writer_append_value(writer, values[i], writer->columns[i].type);
+  }
+  json_writer_append(writer, "}\n", 2);
+  fwrite(writer->line, 1, writer->length, writer->f);
+}
+
+void json_writer_cleanup(JSONWriter *writer)
+{
+  int i;
+
+  for (i = 0; i < writer->num_columns; i++) {
+    free(writer->columns[i].key);
+  }
+  free(writer->columns);
+  free(writer->line);
+  free(writer);
+}
@@ -0,0 +1,59 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/jsonwrite.h
+ * Utility API for generating JSON Lines output
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef JSONWRITE_H
+#define JSONWRITE_H
+
+#include <stdio.h>
+
+#include "buffer.h"
+
+/*
+ * This file defines a small API for writing one JSON object per line.
+ * Columns are declared once, and the key of each (with the punctuation
+ * which precedes it) is rendered and escaped at that point; each row
+ * then only copies the keys and converts the values.
+ *
+ * Values are given as the text the field functions write in delimited
+ * (-a) mode, and are written according to the CWFieldType of the field:
+ * - CW_FIELD_INT8, CW_FIELD_INT16 and CW_FIELD_INT32 as numbers;
+ * - CW_FIELD_FLAG as true or false ('T' or 'F');
+ * - CW_FIELD_TEXT and CW_FIELD_ID as strings, without surrounding quotes.
+ * An empty value is written as null, except in text columns, where it is
+ * an empty string.
+ */
+
+typedef struct json_writer_struct JSONWriter;
+
+JSONWriter *json_writer_create(FILE *f);
+
+/* Declare a column.  All columns must be added before the first row. */
+void json_writer_add_column(JSONWriter *writer, const char *name, CWFieldType type);
+
+/* Write a row of 'count' values, one per column, as a line */
+void json_writer_write_row(JSONWriter *writer, char **values, int count);
+
+/* Free the writer.  The file is not closed. */
+void json_writer_cleanup(JSONWriter *writer);
+
+#endif /* JSONWRITE_H */
@@ -0,0 +1,152 @@
+/*
+ * This file is part of Chadwick
+ * Copyright (c) 2002-2026, Dr T L Turocy (ted.turocy@gmail.com)
+ *                          Chadwick Baseball Bureau (http://www.chadwick-bureau.com)
+ *
+ * FILE: src/cwtools/pgcopy.h
+ * Writer for the PostgreSQL binary COPY format
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef PGCOPY_H
+#define PGCOPY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+#include "buffer.h"
+
+/*
+ * Output in the format read by PostgreSQL's COPY ... FROM ... WITH
+ * (FORMAT binary).  The stream is a header, then one tuple per row, then
+ * a trailer.  Each tuple is a 16-bit field count followed by each field
+ * as a 32-bit length and its bytes, all in network byte order.
+ *
+ * Values are given as the text the field functions write in delimited
+ * (-a) mode, and are converted according to the CWFieldType of the field:
+ * - CW_FIELD_INT8 and CW_FIELD_INT16 are written as smallint, and
+ *   CW_FIELD_INT32 as integer; an empty value is written as NULL;
+ * - CW_FIELD_FLAG is written as boolean ('T' or 'F'), an empty value
+ *   as NULL;
+ * - CW_FIELD_TEXT and CW_FIELD_ID are written as text.
+ */
+
+static inline void cw_pgcopy_put_int32(unsigned char *p, long value)
+{
+  unsigned long bits = (unsigned long) value;
+
+  p[0] = (unsigned char) ((bits >> 24) & 0xFF);
+  p[1] = (unsigned char) ((bits >> 16) & 0xFF);
+  p[2] = (unsigned char) ((bits >> 8) & 0xFF);
+  p[3] = (unsigned char) (bits & 0xFF);
+}
+
+static inline void cw_pgcopy_write_header(FILE *f)
+{
+  static const unsigned char header[19] = {'P', 'G', 'C', 'O', 'P', 'Y', '\n', 0xFF, '\r', '\n',
+                                           0,   0,   0,   0,   0,   0,   0,    0,    0};
+
+#if defined(_WIN32)
+  _setmode(_fileno(f), _O_BINARY);
+#endif
+  fwrite(header, 1, sizeof(header), f);
+}
+
+static inline void cw_pgcopy_write_trailer(FILE *f)
+{
+  static const unsigned char trailer[2] = {0xFF, 0xFF};
+
+  fwrite(trailer, 1, sizeof(trailer), f);
+}
+
+static inline void cw_pgcopy_write_value(FILE *f, const char *text, CWFieldType type)
+{
+  unsigned char field[8];
+  size_t length = strlen(text);
+  long value;
+
+  if (length >= 2 && text[0] == '"' && text[length - 1] == '"') {
+    text++;
+    length -= 2;
+  }
+
+  switch (type) {
+  case CW_FIELD_INT8:
+  case CW_FIELD_INT16:
+    if (!cw_parse_int(text, length, &value)) {
+      break;
+    }
+    if (value < -32768 || value > 32767) {
+      fprintf(stderr, "Error: value %ld out of range for smallint\n", value);
+      exit(1);
+    }
+    cw_pgcopy_put_int32(field, 2);
+    field[4] = (unsigned char) ((value >> 8) & 0xFF);
+    field[5] = (unsigned char) (value & 0xFF);
+    fwrite(field, 1, 6, f);
+    return;
+  case CW_FIELD_INT32:
+    if (!cw_parse_int(text, length, &value)) {
+      break;
+    }
+    cw_pgcopy_put_int32(field, 4);
+    cw_pgcopy_put_int32(field + 4, value);
+    fwrite(field, 1, 8, f);
+    return;
+  case CW_FIELD_FLAG:
+    if (length != 1 || (text[0] != 'T' && text[0] != 'F')) {
+      break;
+    }
+    cw_pgcopy_put_int32(field, 1);
+    field[4] = (unsigned char) (text[0] == 'T');
+    fwrite(field, 1, 5, f);
+    return;
+  default:
+    cw_pgcopy_put_int32(field, (long) length);
+    fwrite(field, 1, 4, f);
+    fwrite(text, 1, length, f);
+    return;
+  }
+
+  /* Missing or unparsable values are NULL */
+  cw_pgcopy_put_int32(field, -1);
+  fwrite(field, 1, 4, f);
+}
+
+/*
+ * Write a tuple of 'count' fields.  Each value is a string as written by
+ * a field function in delimited mode; surrounding quotes are removed.
+ */
+static inline void cw_pgcopy_write_row(FILE *f, char **values, const CWFieldType *types,
+                                       int count)
+{
+  unsigned char field_count[2];
+  int i;
+
+  field_count[0] = (unsigned char) ((count >> 8) & 0xFF);
+  field_count[1] = (unsigned char) (count & 0xFF);
+  fwrite(field_count, 1, sizeof(field_count), f);
+  for (i = 0; i < count; i++) {
+    cw_pgcopy_write_value(f, values[i], types[i]);
+  }
+}
+
+#endif /* PGCOPY_H */
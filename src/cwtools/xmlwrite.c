@@ -26,25 +26,148 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 
 #include "xmlwrite.h"
 
+/* Size of the output buffer owned by each document */
+#define XML_BUFFER_SIZE 65536
+
+/* Indentation is copied out of this table; deeper nesting is written in chunks */
+#define XML_INDENT_MAX 64
+static const char xml_indent[XML_INDENT_MAX + 1] =
+  "                                                                ";
+
+/*
+ * Private auxiliary functions for writing to the document buffer
+ */
+static void xml_document_flush(XMLDoc *doc)
+{
+  if (doc->current > doc->buffer) {
+    fwrite(doc->buffer, 1, (size_t) (doc->current - doc->buffer), doc->f);
+    doc->current = doc->buffer;
+  }
+}
+
+static void xml_write(XMLDoc *doc, const char *s, size_t len)
+{
+  if (len > (size_t) (doc->end - doc->current)) {
+    xml_document_flush(doc);
+    if (len > (size_t) (doc->end - doc->current)) {
+      fwrite(s, 1, len, doc->f);
+      return;
+    }
+  }
+  memcpy(doc->current, s, len);
+  doc->current += len;
+}
+
+static void xml_write_string(XMLDoc *doc, const char *s)
+{
+  xml_write(doc, s, strlen(s));
+}
+
+static void xml_write_char(XMLDoc *doc, char c)
+{
+  if (doc->current == doc->end) {
+    xml_document_flush(doc);
+  }
+  *(doc->current++) = c;
+}
+
+static void xml_write_indent(XMLDoc *doc, int depth)
+{
+  size_t width = 2U * (size_t) depth;
+
+  while (width > XML_INDENT_MAX) {
+    xml_write(doc, xml_indent, XML_INDENT_MAX);
+    width -= XML_INDENT_MAX;
+  }
+  xml_write(doc, xml_indent, width);
+}
+
+/*
+ * Writes 's', replacing characters which may not appear literally in
+ * attribute values or character data by their entity references.
+ */
+static void xml_write_escaped(XMLDoc *doc, const char *s)
+{
+  const char *run = s;
+
+  for (; *s != '\0'; s++) {
+    const char *entity;
+
+    switch (*s) {
+    case '&':
+      entity = "&amp;";
+      break;
+    case '<':
+      entity = "&lt;";
+      break;
+    case '>':
+      entity = "&gt;";
+      break;
+    case '"':
+      entity = "&quot;";
+      break;
+    default:
+      continue;
+    }
+    xml_write(doc, run, (size_t) (s - run));
+    xml_write_string(doc, entity);
+    run = s + 1;
+  }
+  xml_write(doc, run, (size_t) (s - run));
+}
+
+static void xml_write_int(XMLDoc *doc, int value)
+{
+  char digits[16], *p = digits + sizeof(digits);
+  unsigned int u = (value < 0) ? -(unsigned int) value : (unsigned int) value;
+
+  do {
+    *(--p) = (char) ('0' + u % 10);
+    u /= 10;
+  } while (u > 0);
+  if (value < 0) {
+    *(--p) = '-';
+  }
+  xml_write(doc, p, (size_t) (digits + sizeof(digits) - p));
+}
+
+/* Writes the opening ' attr="' of an attribute */
+static void xml_write_attribute_name(XMLDoc *doc, char *attr)
+{
+  xml_write_char(doc, ' ');
+  xml_write_string(doc, attr);
+  xml_write(doc, "=\"", 2);
+}
+
+static XMLNode *xml_node_create(XMLDoc *doc, int depth, char *name)
+{
+  XMLNode *node = (XMLNode *) malloc(sizeof(XMLNode));
+  node->depth = depth;
+  node->open = 0;
+  node->has_children = 0;
+  node->name = name;
+  node->doc = doc;
+  node->next = NULL;
+  return node;
+}
+
 XMLDoc *xml_document_create(FILE *f, char *root)
 {
   XMLDoc *doc = (XMLDoc *) malloc(sizeof(XMLDoc));
   doc->f = f;
-  doc->root = (XMLNode *) malloc(sizeof(XMLNode));
-  doc->root->depth = 0;
+  doc->buffer = (char *) malloc(XML_BUFFER_SIZE);
+  doc->current = doc->buffer;
+  doc->end = doc->buffer + XML_BUFFER_SIZE;
+  doc->root = xml_node_create(doc, 0, root);
   doc->root->open = 1;
-  doc->root->has_children = 0;
-  doc->root->name = root;
-  doc->root->indent = (char *) malloc(1);
-  doc->root->indent[0] = '\0';
-  doc->root->f = f;
-  doc->root->next = NULL;
 
-  fprintf(f, "<?xml version=\"1.0\"?>\n");
-  fprintf(f, "<%s", root);
+  xml_write_string(doc, "<?xml version=\"1.0\"?>\n");
+  xml_write_char(doc, '<');
+  xml_write_string(doc, root);
 
   return doc;
 }
@@ -56,19 +179,20 @@ void xml_document_cleanup(XMLDoc *doc)
   if (node->open) {
     xml_node_close(node);
   }
+  xml_document_flush(doc);
 
   while (node != NULL) {
     XMLNode *next = node->next;
-    free(node->indent);
     free(node);
     node = next;
   }
+  free(doc->buffer);
   free(doc);
 }
 
 XMLNode *xml_node_open(XMLNode *parent, char *name)
 {
-  size_t i;
+  XMLDoc *doc = parent->doc;
 
   if (parent->next) {
     /* A child node entry has been allocated.  Is it still open?
@@ -79,28 +203,20 @@ XMLNode *xml_node_open(XMLNode *parent, char *name)
     }
   }
   else {
-    parent->next = (XMLNode *) malloc(sizeof(XMLNode));
-    parent->next->depth = parent->depth + 1;
-    parent->next->has_children = 0;
-    parent->next->f = parent->f;
-    parent->next->next = NULL;
-    size_t indent_width = 2U * (size_t) parent->next->depth;
-    parent->next->indent = (char *) malloc(indent_width + 1);
-    for (i = 0; i < indent_width; i++) {
-      parent->next->indent[i] = ' ';
-    }
-    parent->next->indent[indent_width] = '\0';
+    parent->next = xml_node_create(doc, parent->depth + 1, name);
   }
 
   if (!parent->has_children) {
     /* We still need to close the opening tag */
-    fprintf(parent->f, ">\n");
+    xml_write(doc, ">\n", 2);
     parent->has_children = 1;
   }
 
   parent->next->name = name;
   parent->next->open = 1;
-  fprintf(parent->next->f, "%s<%s", parent->next->indent, name);
+  xml_write_indent(doc, parent->next->depth);
+  xml_write_char(doc, '<');
+  xml_write_string(doc, name);
   return parent->next;
 }
 
@@ -115,10 +231,13 @@ void xml_node_close(XMLNode *node)
   }
 
   if (node->has_children) {
-    fprintf(node->f, "%s</%s>\n", node->indent, node->name);
+    xml_write_indent(node->doc, node->depth);
+    xml_write(node->doc, "</", 2);
+    xml_write_string(node->doc, node->name);
+    xml_write(node->doc, ">\n", 2);
   }
   else {
-    fprintf(node->f, "/>\n");
+    xml_write(node->doc, "/>\n", 3);
   }
 
   node->has_children = 0;
@@ -133,10 +252,12 @@ void xml_node_cdata(XMLNode *node, char *data)
 
   if (!node->has_children) {
     /* We still need to close the opening tag */
-    fprintf(node->f, ">\n");
+    xml_write(node->doc, ">\n", 2);
     node->has_children = 1;
   }
-  fprintf(node->f, "%s  %s\n", node->indent, data);
+  xml_write_indent(node->doc, node->depth + 1);
+  xml_write_escaped(node->doc, data);
+  xml_write_char(node->doc, '\n');
 }
 
 void xml_node_attribute(XMLNode *node, char *attr, char *value)
@@ -144,7 +265,9 @@ void xml_node_attribute(XMLNode *node, char *attr, char *value)
   if (!node->open) {
     return;
   }
-  fprintf(node->f, " %s=\"%s\"", attr, value);
+  xml_write_attribute_name(node->doc, attr);
+  xml_write_escaped(node->doc, (value) ? value : "");
+  xml_write_char(node->doc, '"');
 }
 
 void xml_node_attribute_int(XMLNode *node, char *attr, int value)
@@ -152,7 +275,9 @@ void xml_node_attribute_int(XMLNode *node, char *attr, int value)
   if (!node->open) {
     return;
   }
-  fprintf(node->f, " %s=\"%d\"", attr, value);
+  xml_write_attribute_name(node->doc, attr);
+  xml_write_int(node->doc, value);
+  xml_write_char(node->doc, '"');
 }
 
 void xml_node_attribute_posint(XMLNode *node, char *attr, int value)
@@ -160,16 +285,48 @@ void xml_node_attribute_posint(XMLNode *node, char *attr, int value)
   if (!node->open || value < 0) {
     return;
   }
-  fprintf(node->f, " %s=\"%d\"", attr, value);
+  xml_write_attribute_name(node->doc, attr);
+  xml_write_int(node->doc, value);
+  xml_write_char(node->doc, '"');
 }
 
 void xml_node_attribute_fmt(XMLNode *node, char *attr, char *format, ...)
 {
   va_list argp;
-  char value[1024];
+  char buffer[256], *value = buffer;
+  int n;
+
+  if (!node->open) {
+    return;
+  }
 
   va_start(argp, format);
-  vsprintf(value, format, argp);
+  n = vsnprintf(buffer, sizeof(buffer), format, argp);
   va_end(argp);
-  fprintf(node->f, " %s=\"%s\"", attr, value);
+  if (n < 0) {
+    return;
+  }
+  if ((size_t) n >= sizeof(buffer)) {
+    value = (char *) malloc((size_t) n + 1);
+    va_start(argp, format);
+    vsnprintf(value, (size_t) n + 1, format, argp);
+    va_end(argp);
+  }
+
+  xml_node_attribute(node, attr, value);
+
+  if (value != buffer) {
+    free(value);
+  }
+}
+
+void xml_node_attribute_prefixed(XMLNode *node, char *attr, char *prefix, char *value)
+{
+  if (!node->open) {
+    return;
+  }
+  xml_write_attribute_name(node->doc, attr);
+  xml_write_string(node->doc, prefix);
+  xml_write_escaped(node->doc, (value) ? value : "");
+  xml_write_char(node->doc, '"');
 }
@@ -46,17 +46,25 @@
  *   allocation is done.  This means node names should not be changed in
  *   the calling code during the lifetime of the node.
  * - Pretty-printing is hardcoded to an indent of 2 spaces per level.
+ *   Indentation is copied out of a single static table of spaces.
+ * - Output is accumulated in a buffer owned by the document, and is
+ *   written to the file only when the buffer fills, or when the
+ *   document is closed.  Output written to the same file by other
+ *   means during the lifetime of the document will therefore not be
+ *   correctly interleaved.
+ * - Attribute values and character data are escaped as required by XML.
  */
 
 typedef struct xml_node_struct {
   int depth, open, has_children;
-  char *name, *indent;
-  FILE *f;
+  char *name;
+  struct xml_doc *doc;
   struct xml_node_struct *next;
 } XMLNode;
 
 typedef struct xml_doc {
   FILE *f;
+  char *buffer, *current, *end;
   struct xml_node_struct *root;
 } XMLDoc;
 
@@ -69,9 +77,9 @@ typedef struct xml_doc {
 XMLDoc *xml_document_create(FILE *f, char *root);
 
 /*
- * Closes any open nodes in the document, and cleans up memory allocated
- * for the document.  The XMLDoc structure itself is freed, but the
- * associated file is not closed.
+ * Closes any open nodes in the document, writes any buffered output,
+ * and cleans up memory allocated for the document.  The XMLDoc
+ * structure itself is freed, but the associated file is not closed.
  */
 void xml_document_cleanup(XMLDoc *doc);
 
@@ -127,4 +135,12 @@ void xml_node_attribute_posint(XMLNode *node, char *attr, int value);
  */
 void xml_node_attribute_fmt(XMLNode *node, char *attr, char *format, ...);
 
+/*
+ * Adds the attribute 'attr' with value 'prefix' followed by 'value'
+ * to the open node 'node'.  This is the common case of an ID reference
+ * (for example "p." followed by a player ID), and avoids the overhead
+ * of going through a format string.
+ */
+void xml_node_attribute_prefixed(XMLNode *node, char *attr, char *prefix, char *value);
+
 #endif /* XMLWRITE_H */